@@ -0,0 +1,56 @@
+"""
+Fixtures for the moderngl benchmarks.
+
+The benchmarks run on a standalone EGL context, LIBGL_ALWAYS_SOFTWARE selects llvmpipe
+so the numbers do not depend on the GPU of the machine. The shader cache of Mesa is
+disabled to measure the compilation and not the cache lookup.
+
+* ctx: A standalone context shared by all benchmarks
+* fbo: A 256x256 RGBA framebuffer in use
+* measure: Runs a benchmark and records the throughput of fixed workloads
+"""
+import os
+
+os.environ.setdefault("LIBGL_ALWAYS_SOFTWARE", "1")
+os.environ.setdefault("MESA_SHADER_CACHE_DISABLE", "true")
+
+import moderngl
+import pytest
+
+
+def pytest_addoption(parser):
+    parser.addoption("--gl-backend", default="egl", help="context backend, 'egl' or 'native-egl'")
+
+
+@pytest.fixture(scope="session")
+def ctx(request):
+    ctx = moderngl.create_context(standalone=True, backend=request.config.getoption("--gl-backend"))
+    yield ctx
+    ctx.release()
+
+
+@pytest.fixture(scope="session")
+def fbo(ctx):
+    fbo = ctx.simple_framebuffer((256, 256))
+    fbo.use()
+    return fbo
+
+
+@pytest.fixture
+def measure(benchmark):
+    """Runs func like benchmark and adds the bytes or items per second of the median round."""
+
+    def run(func, *args, nbytes=None, items=None, **kwargs):
+        result = benchmark(func, *args, **kwargs)
+        stats = benchmark.stats
+        if stats is not None:
+            median = stats.stats.median
+            if nbytes:
+                benchmark.extra_info["bytes"] = nbytes
+                benchmark.extra_info["bytes_per_second"] = nbytes / median
+            if items:
+                benchmark.extra_info["items"] = items
+                benchmark.extra_info["items_per_second"] = items / median
+        return result
+
+    return run
@@ -0,0 +1,771 @@
+"""Render representative scenes headless and report the frame rate and where the time goes.
+
+    python benchmarks/scenes.py --frames 300 --json moderngl-5.12.json
+    python benchmarks/scenes.py --frames 300 --compare moderngl-5.12.json
+
+The scenes are built from a fixed seed, every run renders the same frames.
+The frame time is split into the Python code, the moderngl calls and the driver:
+
+* native is the time spent in moderngl calls, recorded with Context.tracer, the tracer is
+  started with state=True so uniform writes, bindings, scopes and state changes count here too
+* driver is the time of the same OpenGL calls replayed from a Context.capture,
+  it includes waiting for the GPU in the finish at the end of the frames
+* python is the rest of the frame
+
+The frame time minus the driver time is the overhead of the application and of moderngl.
+"""
+
+import argparse
+import json
+import os
+import platform
+import statistics
+import sys
+import tempfile
+import time
+
+os.environ.setdefault("LIBGL_ALWAYS_SOFTWARE", "1")
+os.environ.setdefault("MESA_SHADER_CACHE_DISABLE", "true")
+
+import numpy as np
+
+import moderngl
+
+try:
+    import resource
+except ImportError:
+    resource = None
+
+
+def perspective(fovy, aspect, near, far):
+    f = 1.0 / np.tan(np.radians(fovy) / 2.0)
+    return np.array([
+        [f / aspect, 0.0, 0.0, 0.0],
+        [0.0, f, 0.0, 0.0],
+        [0.0, 0.0, (far + near) / (near - far), 2.0 * far * near / (near - far)],
+        [0.0, 0.0, -1.0, 0.0],
+    ])
+
+
+def look_at(eye, target, up=(0.0, 1.0, 0.0)):
+    eye = np.asarray(eye, "f8")
+    forward = np.asarray(target, "f8") - eye
+    forward /= np.linalg.norm(forward)
+    side = np.cross(forward, up)
+    side /= np.linalg.norm(side)
+    up = np.cross(side, forward)
+    res = np.identity(4)
+    res[0, :3] = side
+    res[1, :3] = up
+    res[2, :3] = -forward
+    res[:3, 3] = -res[:3, :3] @ eye
+    return res
+
+
+def model_matrix(position, angle, scale=1.0):
+    c, s = np.cos(angle), np.sin(angle)
+    res = np.identity(4)
+    res[:3, :3] = np.array([[c, 0.0, s], [0.0, 1.0, 0.0], [-s, 0.0, c]]) * scale
+    res[:3, 3] = position
+    return res
+
+
+def mat4(matrix):
+    # GLSL matrices are column major
+    return np.ascontiguousarray(matrix.T, "f4").tobytes()
+
+
+def box(rng=None, jitter=0.0, size=(1.0, 1.0, 1.0)):
+    """36 vertices of a box with normals and texture coordinates, the corners are moved by jitter."""
+    corners = np.array([[x, y, z] for x in (-0.5, 0.5) for y in (-0.5, 0.5) for z in (-0.5, 0.5)])
+    if jitter:
+        corners += rng.uniform(-jitter, jitter, corners.shape)
+    corners *= size
+    faces = [
+        ((1, 3, 7, 5), (1.0, 0.0, 0.0)),
+        ((4, 6, 2, 0), (-1.0, 0.0, 0.0)),
+        ((2, 6, 7, 3), (0.0, 1.0, 0.0)),
+        ((0, 1, 5, 4), (0.0, -1.0, 0.0)),
+        ((4, 5, 7, 6), (0.0, 0.0, 1.0)),
+        ((0, 2, 3, 1), (0.0, 0.0, -1.0)),
+    ]
+    uvs = ((0.0, 0.0), (1.0, 0.0), (1.0, 1.0), (0.0, 1.0))
+    vertices = []
+    for quad, normal in faces:
+        for i in (0, 1, 2, 0, 2, 3):
+            vertices.append([*corners[quad[i]], *normal, *uvs[i]])
+    return np.array(vertices, "f4")
+
+
+MESH_VERTEX_SHADER = """
+    #version 330
+    uniform mat4 view_proj;
+    uniform mat4 model;
+    in vec3 in_pos;
+    in vec3 in_norm;
+    in vec2 in_uv;
+    out vec3 v_norm;
+    out vec2 v_uv;
+    void main() {
+        gl_Position = view_proj * model * vec4(in_pos, 1.0);
+        v_norm = mat3(model) * in_norm;
+        v_uv = in_uv;
+    }
+"""
+
+TEXTURED_FRAGMENT_SHADER = """
+    #version 330
+    uniform sampler2D tex;
+    uniform vec4 color;
+    in vec3 v_norm;
+    in vec2 v_uv;
+    out vec4 fragColor;
+    void main() {
+        float lum = max(dot(normalize(v_norm), normalize(vec3(0.3, 1.0, 0.5))), 0.0);
+        fragColor = texture(tex, v_uv) * color * (0.25 + 0.75 * lum);
+    }
+"""
+
+CHECKER_FRAGMENT_SHADER = """
+    #version 330
+    uniform vec4 color;
+    uniform float tiles;
+    in vec3 v_norm;
+    in vec2 v_uv;
+    out vec4 fragColor;
+    void main() {
+        vec2 cell = floor(v_uv * tiles);
+        float checker = mod(cell.x + cell.y, 2.0) * 0.5 + 0.5;
+        float lum = max(dot(normalize(v_norm), normalize(vec3(-0.5, 1.0, 0.2))), 0.0);
+        fragColor = vec4(color.rgb * checker * (0.25 + 0.75 * lum), color.a);
+    }
+"""
+
+CROWD_VERTEX_SHADER = """
+    #version 330
+    uniform mat4 view_proj;
+    uniform float time;
+    in vec3 in_pos;
+    in vec3 in_norm;
+    in vec4 in_agent;
+    out vec3 v_norm;
+    out float v_shade;
+    void main() {
+        float c = cos(in_agent.z);
+        float s = sin(in_agent.z);
+        float bob = abs(sin(time * 6.0 + in_agent.w)) * 0.1;
+        vec3 pos = vec3(c * in_pos.x + s * in_pos.z, in_pos.y + bob, c * in_pos.z - s * in_pos.x);
+        gl_Position = view_proj * vec4(pos + vec3(in_agent.x, 0.9, in_agent.y), 1.0);
+        v_norm = vec3(c * in_norm.x + s * in_norm.z, in_norm.y, c * in_norm.z - s * in_norm.x);
+        v_shade = fract(in_agent.w);
+    }
+"""
+
+CROWD_FRAGMENT_SHADER = """
+    #version 330
+    in vec3 v_norm;
+    in float v_shade;
+    out vec4 fragColor;
+    void main() {
+        float lum = max(dot(normalize(v_norm), normalize(vec3(0.3, 1.0, 0.5))), 0.0);
+        fragColor = vec4(mix(vec3(0.8, 0.3, 0.2), vec3(0.2, 0.4, 0.8), v_shade) * (0.3 + 0.7 * lum), 1.0);
+    }
+"""
+
+INSTANCED_VERTEX_SHADER = """
+    #version 330
+    uniform mat4 view_proj;
+    uniform float time;
+    in vec3 in_pos;
+    in vec3 in_norm;
+    in vec4 in_instance;
+    out vec3 v_norm;
+    out vec3 v_color;
+    void main() {
+        float angle = time + in_instance.w;
+        float c = cos(angle);
+        float s = sin(angle);
+        vec3 pos = vec3(c * in_pos.x + s * in_pos.z, in_pos.y, c * in_pos.z - s * in_pos.x);
+        gl_Position = view_proj * vec4(pos + in_instance.xyz, 1.0);
+        v_norm = vec3(c * in_norm.x + s * in_norm.z, in_norm.y, c * in_norm.z - s * in_norm.x);
+        v_color = 0.5 + 0.5 * sin(in_instance.w * vec3(1.0, 2.0, 3.0));
+    }
+"""
+
+INSTANCED_FRAGMENT_SHADER = """
+    #version 330
+    in vec3 v_norm;
+    in vec3 v_color;
+    out vec4 fragColor;
+    void main() {
+        float lum = max(dot(normalize(v_norm), normalize(vec3(0.3, 1.0, 0.5))), 0.0);
+        fragColor = vec4(v_color * (0.2 + 4.0 * lum * lum), 1.0);
+    }
+"""
+
+FULLSCREEN_VERTEX_SHADER = """
+    #version 330
+    out vec2 v_uv;
+    void main() {
+        vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+        v_uv = pos;
+        gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+    }
+"""
+
+BRIGHT_FRAGMENT_SHADER = """
+    #version 330
+    uniform sampler2D image;
+    uniform float threshold;
+    in vec2 v_uv;
+    out vec4 fragColor;
+    void main() {
+        vec3 color = texture(image, v_uv).rgb;
+        fragColor = vec4(max(color - threshold, 0.0), 1.0);
+    }
+"""
+
+BLUR_FRAGMENT_SHADER = """
+    #version 330
+    uniform sampler2D image;
+    uniform vec2 direction;
+    in vec2 v_uv;
+    out vec4 fragColor;
+    const float weights[5] = float[](0.227027, 0.1945946, 0.1216216, 0.054054, 0.016216);
+    void main() {
+        vec2 step = direction / vec2(textureSize(image, 0));
+        vec3 color = texture(image, v_uv).rgb * weights[0];
+        for (int i = 1; i < 5; ++i) {
+            color += texture(image, v_uv + step * float(i)).rgb * weights[i];
+            color += texture(image, v_uv - step * float(i)).rgb * weights[i];
+        }
+        fragColor = vec4(color, 1.0);
+    }
+"""
+
+COMPOSITE_FRAGMENT_SHADER = """
+    #version 330
+    uniform sampler2D image;
+    uniform sampler2D bloom;
+    uniform float exposure;
+    in vec2 v_uv;
+    out vec4 fragColor;
+    void main() {
+        vec3 color = texture(image, v_uv).rgb + texture(bloom, v_uv).rgb;
+        color = vec3(1.0) - exp(-color * exposure);
+        fragColor = vec4(pow(color, vec3(1.0 / 2.2)), 1.0);
+    }
+"""
+
+PARTICLES_COMPUTE_SHADER = """
+    #version 430
+    layout(local_size_x = 256) in;
+    struct Particle {
+        vec4 pos;
+        vec4 vel;
+    };
+    layout(std430, binding = 0) buffer Particles {
+        Particle particles[];
+    };
+    uniform float dt;
+    void main() {
+        uint i = gl_GlobalInvocationID.x;
+        Particle p = particles[i];
+        p.vel.y -= 9.8 * dt;
+        p.pos.xyz += p.vel.xyz * dt;
+        if (p.pos.y < 0.0) {
+            p.pos.y = -p.pos.y;
+            p.vel.y = -p.vel.y * 0.8;
+        }
+        particles[i] = p;
+    }
+"""
+
+PARTICLES_VERTEX_SHADER = """
+    #version 330
+    uniform mat4 view_proj;
+    in vec4 in_pos;
+    out float v_height;
+    void main() {
+        gl_Position = view_proj * vec4(in_pos.xyz, 1.0);
+        gl_PointSize = 2.0;
+        v_height = in_pos.y;
+    }
+"""
+
+PARTICLES_FRAGMENT_SHADER = """
+    #version 330
+    in float v_height;
+    out vec4 fragColor;
+    void main() {
+        fragColor = vec4(mix(vec3(1.0, 0.4, 0.1), vec3(1.0, 1.0, 0.6), clamp(v_height * 0.2, 0.0, 1.0)), 1.0);
+    }
+"""
+
+
+class Scene:
+    name = None
+    requires = 330
+
+    def __init__(self, ctx, size, rng):
+        self.ctx = ctx
+        self.size = size
+        self.rng = rng
+        self.objects = []
+        self.fbo = self.keep(ctx.framebuffer(
+            self.keep(ctx.renderbuffer(size, 4)),
+            self.keep(ctx.depth_renderbuffer(size)),
+        ))
+        aspect = size[0] / size[1]
+        self.view_proj = perspective(60.0, aspect, 0.1, 200.0) @ look_at((0.0, 12.0, 30.0), (0.0, 0.0, 0.0))
+
+    def keep(self, obj):
+        self.objects.append(obj)
+        return obj
+
+    def render(self, frame):
+        raise NotImplementedError
+
+    def release(self):
+        for obj in reversed(self.objects):
+            obj.release()
+        self.objects = []
+
+
+class Meshes(Scene):
+    """Many small meshes, each with its own buffer, uniforms, texture and blending."""
+
+    name = "meshes"
+
+    def __init__(self, ctx, size, rng, count=400):
+        super().__init__(ctx, size, rng)
+        textured = self.keep(ctx.program(vertex_shader=MESH_VERTEX_SHADER, fragment_shader=TEXTURED_FRAGMENT_SHADER))
+        checker = self.keep(ctx.program(vertex_shader=MESH_VERTEX_SHADER, fragment_shader=CHECKER_FRAGMENT_SHADER))
+        textures = [
+            self.keep(ctx.texture((64, 64), 4, rng.integers(0, 256, 64 * 64 * 4, "u1").tobytes()))
+            for _ in range(8)
+        ]
+        for texture in textures:
+            texture.build_mipmaps()
+
+        self.items = []
+        for i in range(count):
+            prog = textured if i % 3 else checker
+            buf = self.keep(ctx.buffer(box(rng, 0.2, rng.uniform(0.3, 1.5, 3))))
+            vao = self.keep(ctx.vertex_array(prog, [(buf, "3f 3f 2f", "in_pos", "in_norm", "in_uv")]))
+            self.items.append({
+                "prog": prog,
+                "vao": vao,
+                "texture": textures[i % len(textures)],
+                "position": rng.uniform((-20.0, -2.0, -20.0), (20.0, 6.0, 10.0)),
+                "speed": rng.uniform(-2.0, 2.0),
+                "color": tuple(rng.uniform(0.3, 1.0, 4)) if i % 10 == 0 else (*rng.uniform(0.3, 1.0, 3), 1.0),
+                "blend": i % 10 == 0,
+            })
+        checker["tiles"] = 4.0
+
+    def render(self, frame):
+        ctx = self.ctx
+        self.fbo.use()
+        self.fbo.clear(0.1, 0.1, 0.12, 1.0, depth=1.0)
+        ctx.enable_only(ctx.DEPTH_TEST | ctx.CULL_FACE)
+        view_proj = mat4(self.view_proj)
+        time = frame / 60.0
+        for item in self.items:
+            prog = item["prog"]
+            prog["view_proj"].write(view_proj)
+            prog["model"].write(mat4(model_matrix(item["position"], time * item["speed"])))
+            prog["color"].value = item["color"]
+            item["texture"].use(0)
+            if item["blend"]:
+                ctx.enable(ctx.BLEND)
+            item["vao"].render()
+            if item["blend"]:
+                ctx.disable(ctx.BLEND)
+
+
+class Crowd(Scene):
+    """An instanced crowd, the agents move on the CPU and are uploaded every frame."""
+
+    name = "crowd"
+
+    def __init__(self, ctx, size, rng, count=20000):
+        super().__init__(ctx, size, rng)
+        self.prog = self.keep(ctx.program(vertex_shader=CROWD_VERTEX_SHADER, fragment_shader=CROWD_FRAGMENT_SHADER))
+        self.agents = np.zeros((count, 4), "f4")
+        self.agents[:, :2] = rng.uniform(-40.0, 40.0, (count, 2))
+        self.agents[:, 2] = rng.uniform(0.0, 2.0 * np.pi, count)
+        self.agents[:, 3] = rng.uniform(0.0, 10.0, count)
+        self.turns = rng.uniform(-0.02, 0.02, count).astype("f4")
+        mesh = self.keep(ctx.buffer(box(size=(0.5, 1.8, 0.3))))
+        self.instances = self.keep(ctx.buffer(self.agents, dynamic=True))
+        self.vao = self.keep(ctx.vertex_array(self.prog, [
+            (mesh, "3f 3f 8x", "in_pos", "in_norm"),
+            (self.instances, "4f/i", "in_agent"),
+        ]))
+        self.prog["view_proj"].write(mat4(self.view_proj))
+
+    def render(self, frame):
+        ctx = self.ctx
+        agents = self.agents
+        agents[:, 2] += self.turns
+        agents[:, 0] += np.sin(agents[:, 2]) * 0.05
+        agents[:, 1] += np.cos(agents[:, 2]) * 0.05
+        np.clip(agents[:, :2], -40.0, 40.0, out=agents[:, :2])
+        self.instances.orphan()
+        self.instances.write(agents)
+
+        self.fbo.use()
+        self.fbo.clear(0.3, 0.35, 0.3, 1.0, depth=1.0)
+        ctx.enable_only(ctx.DEPTH_TEST | ctx.CULL_FACE)
+        self.prog["time"].value = frame / 60.0
+        self.vao.render(instances=len(agents))
+
+
+class PostProcess(Scene):
+    """An HDR scene followed by a bloom chain through several framebuffers."""
+
+    name = "postprocess"
+
+    def __init__(self, ctx, size, rng, count=500):
+        super().__init__(ctx, size, rng)
+        half = (size[0] // 2, size[1] // 2)
+        self.hdr = self.keep(ctx.texture(size, 4, dtype="f2"))
+        self.hdr_fbo = self.keep(ctx.framebuffer(self.hdr, self.keep(ctx.depth_renderbuffer(size))))
+        self.ping = self.keep(ctx.texture(half, 4, dtype="f2"))
+        self.pong = self.keep(ctx.texture(half, 4, dtype="f2"))
+        self.ping_fbo = self.keep(ctx.framebuffer(self.ping))
+        self.pong_fbo = self.keep(ctx.framebuffer(self.pong))
+        for texture in (self.hdr, self.ping, self.pong):
+            texture.repeat_x = False
+            texture.repeat_y = False
+
+        self.prog = self.keep(ctx.program(vertex_shader=INSTANCED_VERTEX_SHADER, fragment_shader=INSTANCED_FRAGMENT_SHADER))
+        self.prog["view_proj"].write(mat4(self.view_proj))
+        instances = np.hstack([
+            rng.uniform((-20.0, -5.0, -20.0), (20.0, 10.0, 10.0), (count, 3)),
+            rng.uniform(0.0, 10.0, (count, 1)),
+        ]).astype("f4")
+        mesh = self.keep(ctx.buffer(box()))
+        self.scene = self.keep(ctx.vertex_array(self.prog, [
+            (mesh, "3f 3f 8x", "in_pos", "in_norm"),
+            (self.keep(ctx.buffer(instances)), "4f/i", "in_instance"),
+        ]))
+        self.count = count
+
+        self.bright = self.keep(ctx.program(vertex_shader=FULLSCREEN_VERTEX_SHADER, fragment_shader=BRIGHT_FRAGMENT_SHADER))
+        self.blur = self.keep(ctx.program(vertex_shader=FULLSCREEN_VERTEX_SHADER, fragment_shader=BLUR_FRAGMENT_SHADER))
+        self.composite = self.keep(ctx.program(vertex_shader=FULLSCREEN_VERTEX_SHADER, fragment_shader=COMPOSITE_FRAGMENT_SHADER))
+        self.bright["threshold"] = 1.0
+        self.composite["bloom"] = 1
+        self.bright_quad = self.keep(ctx.vertex_array(self.bright, []))
+        self.blur_quad = self.keep(ctx.vertex_array(self.blur, []))
+        self.composite_quad = self.keep(ctx.vertex_array(self.composite, []))
+
+    def render(self, frame):
+        ctx = self.ctx
+        self.hdr_fbo.use()
+        self.hdr_fbo.clear(0.02, 0.02, 0.05, 1.0, depth=1.0)
+        ctx.enable_only(ctx.DEPTH_TEST | ctx.CULL_FACE)
+        self.prog["time"].value = frame / 60.0
+        self.scene.render(instances=self.count)
+
+        ctx.enable_only(ctx.NOTHING)
+        self.ping_fbo.use()
+        self.hdr.use(0)
+        self.bright_quad.render(vertices=3)
+        for _ in range(2):
+            self.pong_fbo.use()
+            self.ping.use(0)
+            self.blur["direction"] = (1.0, 0.0)
+            self.blur_quad.render(vertices=3)
+            self.ping_fbo.use()
+            self.pong.use(0)
+            self.blur["direction"] = (0.0, 1.0)
+            self.blur_quad.render(vertices=3)
+
+        self.fbo.use()
+        self.hdr.use(0)
+        self.ping.use(1)
+        self.composite["exposure"] = 1.0 + 0.5 * np.sin(frame / 30.0)
+        self.composite_quad.render(vertices=3)
+
+
+class Particles(Scene):
+    """A compute shader moves particles in a storage buffer, they are drawn as points and partly read back."""
+
+    name = "particles"
+    requires = 430
+
+    def __init__(self, ctx, size, rng, count=65536, readback=4096):
+        super().__init__(ctx, size, rng)
+        particles = np.zeros((count, 8), "f4")
+        particles[:, :3] = rng.uniform((-10.0, 0.0, -10.0), (10.0, 20.0, 10.0), (count, 3))
+        particles[:, 4:7] = rng.uniform((-2.0, -1.0, -2.0), (2.0, 5.0, 2.0), (count, 3))
+        self.particles = self.keep(ctx.buffer(particles))
+        self.compute = self.keep(ctx.compute_shader(PARTICLES_COMPUTE_SHADER))
+        self.compute["dt"] = 1.0 / 60.0
+        self.prog = self.keep(ctx.program(vertex_shader=PARTICLES_VERTEX_SHADER, fragment_shader=PARTICLES_FRAGMENT_SHADER))
+        self.prog["view_proj"].write(mat4(self.view_proj))
+        self.vao = self.keep(ctx.vertex_array(self.prog, [(self.particles, "4f 16x", "in_pos")]))
+        self.count = count
+        self.readback = readback
+        self.result = None
+
+    def render(self, frame):
+        ctx = self.ctx
+        self.particles.bind_to_storage_buffer(0)
+        self.compute.run(self.count // 256)
+        ctx.memory_barrier()
+
+        self.fbo.use()
+        self.fbo.clear(0.0, 0.0, 0.0, 1.0, depth=1.0)
+        ctx.enable_only(ctx.DEPTH_TEST | ctx.PROGRAM_POINT_SIZE)
+        self.vao.render(ctx.POINTS)
+        self.result = np.frombuffer(self.particles.read(self.readback * 32), "f4")
+
+
+SCENES = {scene.name: scene for scene in (Meshes, Crowd, PostProcess, Particles)}
+
+
+def create_context(backend):
+    settings = {"backend": backend} if backend else {}
+    return moderngl.create_context(standalone=True, **settings)
+
+
+def api_time(events):
+    # Calls made from other calls overlap, only the covered time counts
+    total = 0
+    covered = None
+    for begin, end in sorted((event["cpu_begin"], event["cpu_end"]) for event in events):
+        if covered is None or begin > covered:
+            total += end - begin
+            covered = end
+        elif end > covered:
+            total += end - covered
+            covered = end
+    return total
+
+
+def trace_state(ctx):
+    try:
+        return ctx.tracer(capacity=1 << 18, gpu=False, state=True)
+    except TypeError:
+        return ctx.tracer(capacity=1 << 18, gpu=False)
+
+
+def driver_time(scene_type, args, frames):
+    """The median frame time of the OpenGL calls replayed without Python and moderngl.
+
+    The replay is repeated, a single pass is noisy when the frames are short.
+    """
+    fd, path = tempfile.mkstemp(suffix=".bin")
+    os.close(fd)
+    try:
+        ctx = create_context(args.backend)
+        try:
+            with ctx.capture(path) as capture:
+                scene = scene_type(ctx, args.size, np.random.default_rng(args.seed))
+                for frame in range(args.warmup):
+                    scene.render(frame)
+                ctx.finish()
+                for frame in range(frames):
+                    with capture.frame():
+                        scene.render(frame)
+                        ctx.finish()
+                scene.release()
+        finally:
+            ctx.release()
+
+        with open(path, "rb") as f:
+            data = f.read()
+    finally:
+        os.remove(path)
+
+    ctx = create_context(args.backend)
+    try:
+        stats = ctx.replay(data, loops=3)
+    finally:
+        ctx.release()
+    return statistics.median(stats["frames"])
+
+
+def run_scene(scene_type, args):
+    ctx = create_context(args.backend)
+    try:
+        if ctx.version_code < scene_type.requires:
+            return None
+
+        scene = scene_type(ctx, args.size, np.random.default_rng(args.seed))
+        for frame in range(args.warmup):
+            scene.render(frame)
+            ctx.finish()
+
+        # Older releases are compared without the stats, the split and the GPU memory
+        has_stats = hasattr(ctx, "reset_stats")
+        has_split = hasattr(ctx, "tracer") and hasattr(ctx, "capture")
+        if has_stats:
+            ctx.reset_stats()
+        wall = []
+        cpu = []
+        for frame in range(args.frames):
+            wall_begin = time.perf_counter_ns()
+            cpu_begin = time.thread_time_ns()
+            scene.render(frame)
+            ctx.finish()
+            cpu.append(time.thread_time_ns() - cpu_begin)
+            wall.append(time.perf_counter_ns() - wall_begin)
+        stats = ctx.reset_stats() if has_stats else None
+
+        # The split is measured on separate frames, tracing adds a little to every call
+        # Releases before the state category only trace the draws, dispatches and transfers
+        traced = min(args.frames, args.trace_frames)
+        if has_split:
+            with trace_state(ctx) as tracer:
+                begin = time.perf_counter_ns()
+                for frame in range(traced):
+                    scene.render(frame)
+                    ctx.finish()
+                traced_wall = (time.perf_counter_ns() - begin) / traced
+            native = api_time(tracer.events()) / traced
+
+        memory = ctx.memory_report(labels=False)["peak"] if hasattr(ctx, "memory_report") else None
+        scene.release()
+        renderer = ctx.info["GL_RENDERER"]
+    finally:
+        ctx.release()
+
+    result = {
+        "scene": scene_type.name,
+        "renderer": renderer,
+        "frames": args.frames,
+        "fps": args.frames / (sum(wall) / 1e9),
+        "frame_ms": statistics.mean(wall) / 1e6,
+        "median_ms": statistics.median(wall) / 1e6,
+        "p95_ms": sorted(wall)[min(len(wall) - 1, int(len(wall) * 0.95))] / 1e6,
+        "cpu_ms": statistics.mean(cpu) / 1e6,
+        "python_ms": None,
+        "native_ms": None,
+        "driver_ms": None,
+        "draws": None,
+        "dispatches": None,
+        "bytes_uploaded": None,
+        "bytes_downloaded": None,
+        "gpu_memory_peak": memory,
+        "rss_peak": peak_rss(),
+    }
+    if has_split:
+        driver = min(driver_time(scene_type, args, traced), native)
+        result["python_ms"] = max(traced_wall - native, 0.0) / 1e6
+        result["native_ms"] = (native - driver) / 1e6
+        result["driver_ms"] = driver / 1e6
+    if stats:
+        for name in ("draws", "dispatches", "bytes_uploaded", "bytes_downloaded"):
+            result[name] = stats[name] / args.frames
+    return result
+
+
+def peak_rss():
+    if resource is None:
+        return None
+    rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    return rss if sys.platform == "darwin" else rss * 1024
+
+
+COLUMNS = [
+    ("scene", "%-12s", "%-12s"),
+    ("fps", "%8s", "%8.1f"),
+    ("frame_ms", "%9s", "%9.3f"),
+    ("p95_ms", "%8s", "%8.3f"),
+    ("cpu_ms", "%8s", "%8.3f"),
+    ("python_ms", "%10s", "%10.3f"),
+    ("native_ms", "%10s", "%10.3f"),
+    ("driver_ms", "%10s", "%10.3f"),
+    ("draws", "%7s", "%7.0f"),
+    ("gpu_memory_peak", "%16s", "%16d"),
+]
+
+
+def ratio(result, old, name):
+    if not result[name] or not old.get(name):
+        return "-"
+    return "%.2fx" % (result[name] / old[name])
+
+
+def report(results, baseline=None):
+    lines = [" ".join(header % name for name, header, _ in COLUMNS)]
+    for result in results:
+        lines.append(" ".join(
+            header % "-" if result[name] is None else value % result[name]
+            for name, header, value in COLUMNS
+        ))
+
+    if baseline:
+        previous = {result["scene"]: result for result in baseline["scenes"]}
+        lines.append("")
+        lines.append("compared to moderngl %s" % baseline["moderngl"])
+        lines.append("%-12s %8s %9s %10s %10s" % ("scene", "fps", "frame_ms", "python_ms", "native_ms"))
+        for result in results:
+            old = previous.get(result["scene"])
+            if not old:
+                continue
+            ratios = [ratio(result, old, name) for name in ("fps", "frame_ms", "python_ms", "native_ms")]
+            lines.append("%-12s %8s %9s %10s %10s" % (result["scene"], *ratios))
+    return "\n".join(lines)
+
+
+def parse_size(value):
+    width, height = value.lower().split("x")
+    return int(width), int(height)
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(prog="python benchmarks/scenes.py", description=__doc__.splitlines()[0])
+    parser.add_argument("--scenes", default=",".join(SCENES), help="comma separated scenes: %s" % ", ".join(SCENES))
+    parser.add_argument("--frames", type=int, default=300, help="the frames measured for each scene")
+    parser.add_argument("--warmup", type=int, default=10, help="the frames rendered before measuring")
+    parser.add_argument("--trace-frames", type=int, default=30, help="the frames traced and replayed for the split")
+    parser.add_argument("--size", type=parse_size, default=(640, 360), help="the framebuffer size, WIDTHxHEIGHT")
+    parser.add_argument("--seed", type=int, default=0, help="the seed of the procedural scenes")
+    parser.add_argument("--backend", default=None, help="the context backend, for example native-egl")
+    parser.add_argument("--json", help="write the results to this file")
+    parser.add_argument("--compare", help="compare with the results of a previous run")
+    args = parser.parse_args(argv)
+
+    results = []
+    for name in args.scenes.split(","):
+        result = run_scene(SCENES[name], args)
+        if result is None:
+            print("%s: skipped, requires OpenGL %d" % (name, SCENES[name].requires), file=sys.stderr)
+            continue
+        results.append(result)
+
+    output = {
+        "moderngl": moderngl.__version__,
+        "python": platform.python_version(),
+        "platform": platform.platform(),
+        "renderer": results[0]["renderer"] if results else None,
+        "settings": {
+            "frames": args.frames,
+            "warmup": args.warmup,
+            "size": list(args.size),
+            "seed": args.seed,
+            "backend": args.backend,
+        },
+        "scenes": results,
+    }
+
+    baseline = None
+    if args.compare:
+        with open(args.compare) as f:
+            baseline = json.load(f)
+
+    print(report(results, baseline))
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(output, f, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,51 @@
+import pytest
+
+SIZES = [4 * 1024, 1024 * 1024, 16 * 1024 * 1024]
+
+
+@pytest.mark.benchmark(group="buffer")
+@pytest.mark.parametrize("size", SIZES)
+def test_buffer_write(ctx, measure, size):
+    buf = ctx.buffer(reserve=size)
+    data = bytes(size)
+    measure(buf.write, data, nbytes=size)
+    buf.release()
+
+
+@pytest.mark.benchmark(group="buffer")
+@pytest.mark.parametrize("size", SIZES)
+def test_buffer_orphan_write(ctx, measure, size):
+    buf = ctx.buffer(reserve=size, dynamic=True)
+    data = bytes(size)
+
+    def run():
+        buf.orphan()
+        buf.write(data)
+
+    measure(run, nbytes=size)
+    buf.release()
+
+
+@pytest.mark.benchmark(group="buffer")
+@pytest.mark.parametrize("size", SIZES)
+def test_buffer_read(ctx, measure, size):
+    buf = ctx.buffer(bytes(size))
+    measure(buf.read, nbytes=size)
+    buf.release()
+
+
+@pytest.mark.benchmark(group="buffer")
+@pytest.mark.parametrize("size", SIZES)
+def test_buffer_read_into(ctx, measure, size):
+    buf = ctx.buffer(bytes(size))
+    data = bytearray(size)
+    measure(buf.read_into, data, nbytes=size)
+    buf.release()
+
+
+@pytest.mark.benchmark(group="buffer")
+def test_buffer_create(ctx, benchmark):
+    def run():
+        ctx.buffer(reserve=1024).release()
+
+    benchmark(run)
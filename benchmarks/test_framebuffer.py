@@ -0,0 +1,40 @@
+import pytest
+
+SIZES = [64, 512, 1024]
+
+
+@pytest.fixture(scope="module", params=SIZES, ids=lambda size: "%dx%d" % (size, size))
+def target(request, ctx):
+    size = request.param
+    fbo = ctx.framebuffer([ctx.texture((size, size), 4), ctx.texture((size, size), 4, dtype="f4")])
+    fbo.clear(0.25, 0.5, 0.75, 1.0)
+    yield fbo
+    fbo.release()
+
+
+@pytest.mark.benchmark(group="framebuffer")
+def test_framebuffer_read(target, measure):
+    width, height = target.size
+    measure(target.read, components=4, nbytes=width * height * 4)
+
+
+@pytest.mark.benchmark(group="framebuffer")
+def test_framebuffer_read_float(target, measure):
+    width, height = target.size
+    measure(target.read, components=4, attachment=1, dtype="f4", nbytes=width * height * 16)
+
+
+@pytest.mark.benchmark(group="framebuffer")
+def test_framebuffer_read_into(target, measure):
+    width, height = target.size
+    data = bytearray(width * height * 4)
+    measure(target.read_into, data, components=4, nbytes=width * height * 4)
+
+
+@pytest.mark.benchmark(group="framebuffer")
+def test_framebuffer_clear(ctx, target, benchmark):
+    def run():
+        target.clear(0.25, 0.5, 0.75, 1.0)
+        ctx.finish()
+
+    benchmark(run)
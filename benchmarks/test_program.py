@@ -0,0 +1,50 @@
+import pytest
+
+VERTEX_SHADER = """
+    #version 330
+    uniform mat4 mvp;
+    in vec3 in_vert;
+    in vec3 in_norm;
+    in vec2 in_uv;
+    out vec3 v_norm;
+    out vec2 v_uv;
+    void main() {
+        gl_Position = mvp * vec4(in_vert, 1.0);
+        v_norm = in_norm;
+        v_uv = in_uv;
+    }
+"""
+
+FRAGMENT_SHADER = """
+    #version 330
+    uniform sampler2D tex;
+    uniform vec3 light;
+    in vec3 v_norm;
+    in vec2 v_uv;
+    out vec4 fragColor;
+    void main() {
+        float lum = max(dot(normalize(v_norm), normalize(light)), 0.0);
+        fragColor = texture(tex, v_uv) * (0.2 + 0.8 * lum);
+    }
+"""
+
+
+@pytest.mark.benchmark(group="program")
+def test_program_create(ctx, benchmark):
+    def run():
+        ctx.program(vertex_shader=VERTEX_SHADER, fragment_shader=FRAGMENT_SHADER).release()
+
+    benchmark(run)
+
+
+@pytest.mark.benchmark(group="program")
+def test_vertex_array_create(ctx, benchmark):
+    prog = ctx.program(vertex_shader=VERTEX_SHADER, fragment_shader=FRAGMENT_SHADER)
+    buf = ctx.buffer(reserve=32 * 1024)
+
+    def run():
+        ctx.vertex_array(prog, [(buf, "3f 3f 2f", "in_vert", "in_norm", "in_uv")]).release()
+
+    benchmark(run)
+    buf.release()
+    prog.release()
@@ -0,0 +1,79 @@
+import numpy as np
+import pytest
+
+VERTEX_SHADER = """
+    #version 330
+    in vec2 in_vert;
+    in vec2 in_offset;
+    void main() {
+        gl_Position = vec4(in_vert * 0.01 + in_offset, 0.0, 1.0);
+    }
+"""
+
+FRAGMENT_SHADER = """
+    #version 330
+    uniform vec4 color;
+    out vec4 fragColor;
+    void main() {
+        fragColor = color;
+    }
+"""
+
+
+@pytest.fixture(scope="module")
+def prog(ctx):
+    prog = ctx.program(vertex_shader=VERTEX_SHADER, fragment_shader=FRAGMENT_SHADER)
+    prog["color"].value = (1.0, 0.5, 0.25, 1.0)
+    return prog
+
+
+def mesh(ctx, prog, triangles):
+    # Small triangles at fixed random positions, the shader scales the corners by 0.01
+    rng = np.random.default_rng(0)
+    corners = rng.uniform(-1.0, 1.0, (triangles * 3, 2))
+    offsets = np.repeat(rng.uniform(-1.0, 1.0, (triangles, 2)), 3, axis=0)
+    buf = ctx.buffer(np.hstack([corners, offsets]).astype("f4"))
+    return ctx.vertex_array(prog, [(buf, "2f 2f", "in_vert", "in_offset")])
+
+
+@pytest.mark.benchmark(group="render")
+def test_render_quad(ctx, fbo, prog, benchmark):
+    vao = mesh(ctx, prog, 2)
+    benchmark(vao.render)
+    ctx.finish()
+
+
+@pytest.mark.benchmark(group="render")
+def test_render_quad_finish(ctx, fbo, prog, benchmark):
+    vao = mesh(ctx, prog, 2)
+
+    def run():
+        vao.render()
+        ctx.finish()
+
+    benchmark(run)
+
+
+@pytest.mark.benchmark(group="render")
+@pytest.mark.parametrize("triangles", [10000, 100000])
+def test_render_mesh(ctx, fbo, prog, measure, triangles):
+    vao = mesh(ctx, prog, triangles)
+
+    def run():
+        vao.render()
+        ctx.finish()
+
+    measure(run, items=triangles)
+
+
+@pytest.mark.benchmark(group="render")
+def test_render_instanced(ctx, fbo, prog, measure):
+    quad = ctx.buffer(np.array([-1, -1, 1, -1, -1, 1, 1, 1], "f4"))
+    offsets = ctx.buffer(np.random.default_rng(0).uniform(-1.0, 1.0, (1000, 2)).astype("f4"))
+    vao = ctx.vertex_array(prog, [(quad, "2f", "in_vert"), (offsets, "2f/i", "in_offset")])
+
+    def run():
+        vao.render(mode=ctx.TRIANGLE_STRIP, instances=1000)
+        ctx.finish()
+
+    measure(run, items=1000)
@@ -0,0 +1,24 @@
+import itertools
+
+import numpy as np
+import pytest
+
+import scenes
+
+
+@pytest.mark.benchmark(group="scenes")
+@pytest.mark.parametrize("name", list(scenes.SCENES))
+def test_scene(ctx, benchmark, name):
+    scene_type = scenes.SCENES[name]
+    if ctx.version_code < scene_type.requires:
+        pytest.skip("requires OpenGL %d" % scene_type.requires)
+
+    scene = scene_type(ctx, (320, 180), np.random.default_rng(0))
+    frames = itertools.count()
+
+    def frame():
+        scene.render(next(frames))
+        ctx.finish()
+
+    benchmark(frame)
+    scene.release()
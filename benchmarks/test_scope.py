@@ -0,0 +1,32 @@
+import pytest
+
+
+@pytest.mark.benchmark(group="scope")
+def test_scope_framebuffer(ctx, fbo, benchmark):
+    scope = ctx.scope(fbo, ctx.DEPTH_TEST | ctx.BLEND)
+
+    def run():
+        with scope:
+            pass
+
+    benchmark(run)
+    scope.release()
+
+
+@pytest.mark.benchmark(group="scope")
+def test_scope_bindings(ctx, fbo, benchmark):
+    textures = [(ctx.texture((4, 4), 4), i) for i in range(4)]
+    buffers = [(ctx.buffer(reserve=256), i) for i in range(4)]
+    scope = ctx.scope(fbo, ctx.DEPTH_TEST, textures=textures, uniform_buffers=buffers, storage_buffers=buffers)
+
+    def run():
+        with scope:
+            pass
+
+    benchmark(run)
+    scope.release()
+
+
+@pytest.mark.benchmark(group="scope")
+def test_framebuffer_use(ctx, fbo, benchmark):
+    benchmark(fbo.use)
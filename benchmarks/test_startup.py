@@ -0,0 +1,157 @@
+import numpy as np
+import pytest
+
+import moderngl
+
+PROGRAMS = 500
+TEXTURES = 1000
+
+VERTEX_SHADER = """
+    #version 330
+    uniform mat4 mvp;
+    uniform float scale_%(index)d;
+    in vec3 in_pos;
+    in vec3 in_norm;
+    in vec2 in_uv;
+    out vec3 v_norm;
+    out vec2 v_uv;
+    void main() {
+        gl_Position = mvp * vec4(in_pos * scale_%(index)d, 1.0);
+        v_norm = in_norm;
+        v_uv = in_uv * %(index)d.0;
+    }
+"""
+
+FRAGMENT_SHADER = """
+    #version 330
+    uniform sampler2D tex;
+    uniform vec4 colors[%(colors)d];
+    layout(std140) uniform Light {
+        vec4 direction;
+        vec4 color;
+    };
+    in vec3 v_norm;
+    in vec2 v_uv;
+    out vec4 fragColor;
+    void main() {
+        vec4 base = texture(tex, v_uv) * colors[int(v_uv.x) %% %(colors)d];
+        float lum = max(dot(normalize(v_norm), direction.xyz), 0.0) * %(index)d.0 / %(programs)d.0;
+        fragColor = base * color * lum;
+    }
+"""
+
+
+def program_sources(count):
+    # Every program is different, the driver cannot return a program it compiled before
+    return [
+        (
+            VERTEX_SHADER % {"index": index},
+            FRAGMENT_SHADER % {"index": index, "colors": index % 8 + 1, "programs": count},
+        )
+        for index in range(count)
+    ]
+
+
+def texture_data(count):
+    rng = np.random.default_rng(0)
+    sizes = [(16, 16), (32, 32), (64, 64), (128, 128), (256, 64)]
+    return [
+        (size, rng.integers(0, 256, size[0] * size[1] * 4, "u1").tobytes())
+        for size in (sizes[i % len(sizes)] for i in range(count))
+    ]
+
+
+@pytest.fixture(scope="module")
+def backend(request):
+    return request.config.getoption("--gl-backend")
+
+
+@pytest.fixture
+def new_context(ctx, backend):
+    """Creates profiled contexts and makes the shared context current again."""
+    contexts = []
+
+    def create():
+        new = moderngl.create_context(standalone=True, backend=backend, profile_startup=True)
+        contexts.append(new)
+        return new
+
+    yield create
+    for new in contexts:
+        new.release()
+    ctx.__enter__()
+
+
+def record_profile(benchmark, profile, before=None, rounds=1):
+    # The phase times of one round, the profile of a context adds up all the rounds
+    for phase, item in profile.items():
+        total = item["total"] - (before[phase]["total"] if before else 0)
+        if total:
+            benchmark.extra_info[phase + "_ms"] = total / rounds / 1e6
+
+
+@pytest.mark.benchmark(group="startup")
+def test_create_context(benchmark, new_context):
+    def create():
+        new = new_context()
+        new.finish()
+        return new
+
+    new = benchmark.pedantic(create, rounds=10)
+    record_profile(benchmark, new.startup_profile)
+
+
+@pytest.mark.benchmark(group="startup")
+def test_create_programs(benchmark, new_context):
+    sources = program_sources(PROGRAMS)
+    new = new_context()
+
+    def create():
+        programs = [new.program(vertex_shader=vs, fragment_shader=fs) for vs, fs in sources]
+        new.finish()
+        for prog in programs:
+            prog.release()
+
+    before = new.startup_profile
+    benchmark.pedantic(create, rounds=3)
+    benchmark.extra_info["programs"] = PROGRAMS
+    record_profile(benchmark, new.startup_profile, before, 3)
+
+
+@pytest.mark.benchmark(group="startup")
+def test_create_textures(benchmark, new_context):
+    data = texture_data(TEXTURES)
+    new = new_context()
+
+    def create():
+        textures = [new.texture(size, 4, pixels) for size, pixels in data]
+        new.finish()
+        for texture in textures:
+            texture.release()
+
+    before = new.startup_profile
+    benchmark.pedantic(create, rounds=3)
+    benchmark.extra_info["textures"] = TEXTURES
+    benchmark.extra_info["bytes"] = sum(len(pixels) for _, pixels in data)
+    record_profile(benchmark, new.startup_profile, before, 3)
+
+
+@pytest.mark.benchmark(group="startup")
+def test_cold_start(benchmark, new_context):
+    # A new context with the whole corpus, the profile of the last round is recorded
+    sources = program_sources(PROGRAMS)
+    data = texture_data(TEXTURES)
+    profiles = []
+
+    def start():
+        new = new_context()
+        for vs, fs in sources:
+            new.program(vertex_shader=vs, fragment_shader=fs)
+        for size, pixels in data:
+            new.texture(size, 4, pixels)
+        new.finish()
+        profiles.append(new.startup_profile)
+        new.release()
+
+    benchmark.pedantic(start, rounds=3)
+    record_profile(benchmark, profiles[-1])
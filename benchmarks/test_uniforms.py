@@ -0,0 +1,62 @@
+import struct
+
+import pytest
+
+VERTEX_SHADER = """
+    #version 330
+    uniform float scale;
+    uniform vec4 color;
+    uniform mat4 mvp;
+    in vec3 in_vert;
+    out vec4 v_color;
+    void main() {
+        gl_Position = mvp * vec4(in_vert * scale, 1.0);
+        v_color = color;
+    }
+"""
+
+FRAGMENT_SHADER = """
+    #version 330
+    in vec4 v_color;
+    out vec4 fragColor;
+    void main() {
+        fragColor = v_color;
+    }
+"""
+
+UNIFORMS = {
+    "scale": 0.5,
+    "color": (1.0, 0.5, 0.25, 1.0),
+    "mvp": tuple(float(i) for i in range(16)),
+}
+
+
+@pytest.fixture(scope="module")
+def prog(ctx):
+    return ctx.program(vertex_shader=VERTEX_SHADER, fragment_shader=FRAGMENT_SHADER)
+
+
+@pytest.mark.benchmark(group="uniforms")
+@pytest.mark.parametrize("name", list(UNIFORMS))
+def test_uniform_value(prog, benchmark, name):
+    uniform = prog[name]
+    value = UNIFORMS[name]
+
+    def run():
+        uniform.value = value
+
+    benchmark(run)
+
+
+@pytest.mark.benchmark(group="uniforms")
+@pytest.mark.parametrize("name", list(UNIFORMS))
+def test_uniform_write(prog, benchmark, name):
+    uniform = prog[name]
+    value = UNIFORMS[name]
+    data = struct.pack("%df" % len(value), *value) if isinstance(value, tuple) else struct.pack("f", value)
+    benchmark(uniform.write, data)
+
+
+@pytest.mark.benchmark(group="uniforms")
+def test_uniform_lookup(prog, benchmark):
+    benchmark(prog.__getitem__, "mvp")
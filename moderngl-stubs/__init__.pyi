@@ -1,7 +1,8 @@
 from __future__ import annotations
 
+from concurrent.futures import Future
 from contextlib import AbstractContextManager
-from typing import Any, Deque, Dict, Generator, List, Optional, Protocol, Set, Tuple, Union
+from typing import Any, Callable, Deque, Dict, Generator, Iterable, Iterator, List, NamedTuple, Optional, Protocol, Set, Tuple, Union
 
 class ConvertibleToShaderSource(Protocol):
     def to_shader_source(self) -> str | bytes: ...
@@ -177,6 +178,9 @@ ATOMIC_COUNTER_BARRIER_BIT: int
 SHADER_STORAGE_BARRIER_BIT: int
 """ctx.SHADER_STORAGE_BARRIER_BIT"""
 
+QUERY_BUFFER_BARRIER_BIT: int
+"""ctx.QUERY_BUFFER_BARRIER_BIT"""
+
 ALL_BARRIER_BITS: int
 """ctx.ALL_BARRIER_BITS"""
 
@@ -1028,6 +1032,11 @@ class Context:
     SHADER_STORAGE_BARRIER_BIT
     """
 
+    QUERY_BUFFER_BARRIER_BIT: int
+    """
+    QUERY_BUFFER_BARRIER_BIT
+    """
+
     ALL_BARRIER_BITS: int
     """
     ALL_BARRIER_BITS
@@ -1068,7 +1077,99 @@ class Context:
     These are deleted when calling :py:meth:`Context.gc`.
     """
 
-    def gc(self) -> int:
+    release_stats: Dict[str, int]
+    """
+    Counters of the objects deleted by :py:meth:`Context.gc`.
+
+    ``objects`` and ``bytes`` are running totals, the bytes are estimated
+    like in :py:meth:`Context.memory_report`.
+    ``pending`` is the number of names waiting for a fence.
+    """
+
+    stats: Dict[str, int]
+    """
+    Performance counters of the context since it was created or since the last
+    :py:meth:`Context.reset_stats`: ``draws``, ``dispatches``, ``program_binds``,
+    ``vertex_array_binds``, ``texture_binds``, ``sampler_binds``,
+    ``framebuffer_binds``, ``uniform_writes``, ``bytes_uploaded``,
+    ``bytes_downloaded``, ``objects_created`` and ``objects_released``.
+    """
+
+    def reset_stats(self) -> Dict[str, int]:
+        """
+        Returns :py:attr:`Context.stats` and sets the counters to zero.
+        """
+
+    def memory_report(self, labels: bool = True) -> Dict[str, Any]:
+        """
+        Returns the live buffers, textures and renderbuffers and their estimated size in bytes.
+
+        The report has the ``total`` and ``peak`` bytes, the ``alarm`` limit, ``types``
+        with the ``count`` and ``bytes`` per object type and with ``labels`` set
+        the same per object label.
+
+        Args:
+            labels (bool): Group the objects by their label.
+        """
+
+    def set_memory_alarm(self, limit: Optional[int], callback: Optional[Callable[[int, int], Any]] = None) -> None:
+        """
+        Calls ``callback(total, limit)`` when the estimated bytes of the live objects go above ``limit``,
+        without a callback a warning is logged to the ``moderngl`` logger.
+
+        Args:
+            limit (int): The limit in bytes, None removes the alarm.
+            callback (callable): Called with the total and the limit.
+        """
+
+    startup_profile: Optional[Dict[str, Dict[str, int]]]
+    """
+    The time of the context creation phases and of the programs, buffers, textures
+    and vertex arrays created since, or None without ``profile_startup=True``.
+    Every phase has the ``count``, the ``total``, the ``first`` and the ``max`` time in nanoseconds.
+    """
+
+    debug_message_counts: Dict[int, int]
+    """
+    The number of debug messages per id since :py:meth:`Context.enable_debug_output`,
+    including the messages dropped by the rate limit.
+    """
+
+    def enable_debug_output(
+        self,
+        severity: str = "medium",
+        types: Optional[Iterable[str]] = None,
+        sources: Optional[Iterable[str]] = None,
+        callback: Optional[Callable[[str, str, int, str, str], Any]] = None,
+        rate_limit: int = 10,
+        synchronous: bool = False,
+    ) -> None:
+        """
+        Installs a callback for the debug messages of the driver.
+
+        The messages are filtered, counted and rate limited without the GIL and delivered
+        to ``callback(source, type, id, severity, message)`` or the ``moderngl`` logger.
+
+        Args:
+            severity (str): The lowest severity delivered: high, medium, low or notification.
+            types (list): The types delivered, all by default.
+            sources (list): The sources delivered, all by default.
+            callback (callable): Called for each message instead of logging it.
+            rate_limit (int): The messages delivered per id and second, 0 for no limit.
+            synchronous (bool): Emit the messages from the OpenGL call causing them.
+        """
+
+    def disable_debug_output(self) -> None:
+        """
+        Removes the debug message callback, queued messages are delivered first.
+        """
+
+    def process_debug_output(self) -> int:
+        """
+        Delivers the queued debug messages on the calling thread and returns their number.
+        """
+
+    def gc(self, defer: bool = False) -> int:
         """
         Deletes OpenGL objects.
 
@@ -1078,6 +1179,13 @@ class Context:
         Calling this method with any other ``gc_mode`` configuration
         has no effect and is perfectly safe.
 
+        The names are deleted with one call per object type.
+        With ``defer`` set the names are kept until a fence shows the GPU
+        finished the commands issued so far, a later call deletes them.
+
+        Keyword Args:
+            defer (bool): Delete the names once the GPU is done with them.
+
         Returns:
             int: Number of objects deleted
         """
@@ -1361,6 +1469,20 @@ class Context:
     max_anisotropy: float
     """The maximum value supported for anisotropic filtering."""
 
+    dsa: bool
+    """
+    Use direct state access to create and update objects.
+
+    Enabled by default on OpenGL 4.5 contexts. Buffers, renderbuffers and
+    framebuffers are then created and updated without changing the bound
+    objects. Every texture type, including 3D, array and cube textures, is
+    written, read, mipmapped and configured the same way. Textures are still
+    created through the default texture unit so their storage stays mutable.
+    ``copy_framebuffer`` and ``detect_framebuffer``
+    at most touch the read framebuffer binding. Set it to ``False`` to use the
+    bind based code path.
+    """
+
     default_texture_unit: int
     """The default texture unit."""
 
@@ -1695,6 +1817,26 @@ class Context:
         """
     def finish(self) -> None:
         """Wait for all drawing commands to finish."""
+    def create_loader(self, require: Optional[int] = None, **settings: Any) -> ResourceLoader:
+        """
+        Create a :py:class:`ResourceLoader` with a context sharing objects with this one.
+
+        This context must be current when calling this method.
+
+        Args:
+            require (int): OpenGL version code.
+            settings: keyword config values for the context backend
+        """
+    def has_extension(self, name: str) -> bool:
+        """
+        Check if an extension is supported.
+
+        The extension names are queried on first use and kept in a sorted
+        table, the lookup does not build the :py:attr:`extensions` set.
+
+        Args:
+            name (str): The extension name with the ``GL_`` prefix.
+        """
     def copy_buffer(
         self,
         dst: Buffer,
@@ -1773,6 +1915,21 @@ class Context:
         Returns:
             :py:class:`Buffer` object
         """
+    def buffers(self, data: List[Union[Any, int]], dynamic: bool = False) -> List[Buffer]:
+        """
+        Create a :py:class:`Buffer` object for every item of ``data``.
+
+        An item is either the content of a buffer or the number of bytes to reserve.
+
+        Args:
+            data (list): Contents or sizes of the new buffers.
+
+        Keyword Args:
+            dynamic (bool): Treat the buffers as dynamic.
+
+        Returns:
+            list of :py:class:`Buffer` objects
+        """
     def external_buffer(self, glo: int, size: int) -> Buffer:
         """
         Create a :py:class:`Buffer` object.
@@ -2096,6 +2253,57 @@ class Context:
             time (bool): Query ``GL_TIME_ELAPSED`` or not.
             primitives (bool): Query ``GL_PRIMITIVES_GENERATED`` or not.
         """
+    def query_pool(
+        self,
+        samples: bool = False,
+        any_samples: bool = False,
+        time: bool = False,
+        primitives: bool = False,
+    ) -> "QueryPool":
+        """
+        Create a :py:class:`QueryPool` object.
+
+        Keyword Args:
+            samples (bool): Query ``GL_SAMPLES_PASSED`` or not.
+            any_samples (bool): Query ``GL_ANY_SAMPLES_PASSED`` or not.
+            time (bool): Query ``GL_TIME_ELAPSED`` or not.
+            primitives (bool): Query ``GL_PRIMITIVES_GENERATED`` or not.
+        """
+    def profiler(self, latency: int = 3, debug_scopes: bool = True) -> "Profiler":
+        """
+        Create a :py:class:`Profiler` object.
+
+        Keyword Args:
+            latency (int): Frames in flight before collecting waits for the GPU.
+            debug_scopes (bool): Push a debug group for every section.
+        """
+    def tracer(self, capacity: int = 65536, gpu: bool = True, state: bool = False) -> "Tracer":
+        """
+        Start tracing and create a :py:class:`Tracer` object.
+
+        Keyword Args:
+            capacity (int): The number of events kept.
+            gpu (bool): Record the GPU execution of every call.
+            state (bool): Also record bindings, uniform writes, scopes and state changes.
+        """
+    def capture(self, path: str) -> "Capture":
+        """
+        Start recording the OpenGL calls to a file.
+
+        Args:
+            path (str): The capture file.
+        """
+    def replay(self, data: bytes, loops: int = 1, finish: bool = False) -> Dict[str, Any]:
+        """
+        Replay a capture and return the timings in nanoseconds.
+
+        Args:
+            data (bytes): The content of a capture file.
+
+        Keyword Args:
+            loops (int): The number of times the frames are replayed.
+            finish (bool): Wait for the GPU at the end of every frame.
+        """
     def scope(
         self,
         framebuffer: Optional[Framebuffer] = None,
@@ -2293,6 +2501,9 @@ class Context:
 
         When exiting the context the previously bound context is activated again.
 
+        A context is used from the thread that created or last entered it.
+        Drawing, transfers and object creation from other threads raise an :py:class:`Error`.
+
         .. Warning:: Context switching can be risky unless you know what you are doing.
                      Use with care.
         """
@@ -2407,12 +2618,28 @@ def create_context(
         require (int): OpenGL version code (default: 330)
         standalone (bool): Headless flag
         share (bool): Attempt to create a shared context
-        **settings: Other backend specific settings
+        **settings: Other backend specific settings, ``backend='native-egl'``
+            selects the built-in headless EGL backend with the ``device`` and
+            ``libegl`` settings, ``profile_startup=True`` enables
+            :py:attr:`Context.startup_profile`, ``check_thread=False``
+            allows using the context from threads that did not enter it
 
     Returns:
         :py:class:`Context` object
     """
 
+def egl_devices(libegl: Optional[str] = None) -> List[Dict[str, Any]]:
+    """
+    List the EGL devices available to the ``native-egl`` backend.
+
+    Keyword Arguments:
+        libegl (str): The EGL library to load, it must match the library
+            loaded by earlier calls
+
+    Returns:
+        list: The ``index``, ``device_file`` and ``extensions`` of every device
+    """
+
 def create_standalone_context(
     require: Optional[int] = None,
     share: bool = False,
@@ -2450,6 +2677,52 @@ def get_context() -> Context:
         Return the previously created context
     """
 
+class RenderPool:
+    """
+    Runs callables on standalone contexts owned by dedicated worker threads.
+
+    Every job is called as ``fn(ctx, *args, **kwargs)`` with the context of the worker running it.
+    Idle workers take the jobs queued to busy ones.
+    """
+
+    workers: int
+    """int: The number of worker contexts."""
+
+    def __init__(self, workers: int, require: Optional[int] = None, **settings: Any) -> None: ...
+    def submit(self, fn: Callable[..., Any], *args: Any, **kwargs: Any) -> Future:
+        """
+        Schedule ``fn(ctx, *args, **kwargs)`` on a worker.
+
+        Returns:
+            :py:class:`concurrent.futures.Future` for the result
+        """
+    def map(self, fn: Callable[..., Any], *iterables: Iterable[Any]) -> Iterator[Any]:
+        """
+        Submit ``fn(ctx, *args)`` for every item and yield the results in order.
+        """
+    def shutdown(self, wait: bool = True, cancel_futures: bool = False) -> None:
+        """
+        Stop accepting jobs and release the worker contexts.
+
+        Keyword Args:
+            wait (bool): Wait for the workers to finish.
+            cancel_futures (bool): Cancel the jobs that did not start yet.
+        """
+    def __enter__(self) -> RenderPool: ...
+    def __exit__(self, *args: Any) -> None: ...
+
+class ResourceLoader(RenderPool):
+    """
+    Runs callables on a context sharing objects with :py:attr:`ctx`, see :py:meth:`Context.create_loader`.
+
+    Buffers, textures, renderbuffers, samplers and programs returned by a job
+    are moved to :py:attr:`ctx` by the ``result()`` of its future.
+    The GPU of :py:attr:`ctx` waits for the job with a fence, the calling thread does not.
+    """
+
+    ctx: Context
+    """Context: The context receiving the loaded objects."""
+
 class Framebuffer:
     """
     A :py:class:`Framebuffer` is a collection of buffers that can be used as the destination for rendering.
@@ -2624,6 +2897,10 @@ class Framebuffer:
         alignment: int = 1,
         dtype: str = "f1",
         clamp: bool = False,
+        flip_y: bool = False,
+        channels: Optional[str] = None,
+        scale: Optional[Tuple[int, int]] = None,
+        filter: str = "box",
     ) -> bytes:
         """
         Read the content of the framebuffer.
@@ -2638,6 +2915,10 @@ class Framebuffer:
             data = fbo.read(attachment=-1)
             # Read the lower left 10 x 10 pixels from the first color attachment
             data = fbo.read(viewport=(0, 0, 10, 10))
+            # Read an image ready to be saved, top row first in BGR order
+            data = fbo.read(flip_y=True, channels="BGR")
+            # Read a 160 x 90 thumbnail, the image is shrunk on the gpu
+            data = fbo.read(scale=(160, 90))
 
         Args:
             viewport (tuple): The viewport.
@@ -2648,6 +2929,13 @@ class Framebuffer:
             alignment (int): The byte alignment of the pixels.
             dtype (str): Data type.
             clamp (bool): Clamps floating point values to ``[0.0, 1.0]``
+            flip_y (bool): Return the rows top to bottom.
+            channels (str): The channels to return, overrides ``components``.
+            scale (tuple): The size of the returned image. The viewport is resized
+                on the gpu and only the small image is transferred.
+            filter (str): ``"box"`` averages every covered pixel, ``"linear"`` and
+                ``"nearest"`` resize with a single blit. Integer attachments always
+                use ``"nearest"``.
 
         Returns:
             bytes
@@ -2660,11 +2948,24 @@ class Framebuffer:
         attachment: int = 0,
         alignment: int = 1,
         dtype: str = "f1",
+        clamp: bool = False,
         write_offset: int = 0,
-    ) -> None:
+        flip_y: bool = False,
+        row_stride: int = 0,
+        channels: Optional[str] = None,
+        scale: Optional[Tuple[int, int]] = None,
+        filter: str = "box",
+    ) -> int:
         """
         Read the content of the framebuffer into a buffer.
 
+        The pixels are written in their final layout, there is no need
+        to flip or convert them afterwards::
+
+            # Read into the top left corner of a 1920 x 1080 RGB frame
+            frame = bytearray(1920 * 1080 * 3)
+            fbo.read_into(frame, (0, 0, 640, 480), row_stride=1920 * 3, flip_y=True)
+
         Args:
             buffer (bytearray): The buffer that will receive the pixels.
             viewport (tuple): The viewport.
@@ -2674,7 +2975,34 @@ class Framebuffer:
             attachment (int): The color attachment.
             alignment (int): The byte alignment of the pixels.
             dtype (str): Data type.
+            clamp (bool): Clamps floating point values to ``[0.0, 1.0]``
             write_offset (int): The write offset.
+            flip_y (bool): Write the rows top to bottom.
+            row_stride (int): The distance between rows in bytes.
+                ``0`` means tightly packed rows padded to ``alignment``.
+            channels (str): The channels to write, overrides ``components``.
+                Reordering not supported by the driver is not available for a :py:class:`Buffer`.
+            scale (tuple): The size of the written image, see :py:meth:`Framebuffer.read`.
+            filter (str): The filter used for ``scale``.
+
+        Returns:
+            int: The number of bytes the pixels span in the buffer.
+        """
+    def statistics(self, attachment: int = 0, buffer: Optional[Buffer] = None, offset: int = 0) -> Optional[Dict[str, Any]]:
+        """
+        Compute the min, max, mean and checksum of a color attachment on the GPU (OpenGL 4.3 required).
+
+        Renderbuffers and multisample attachments are resolved into a transient texture first.
+        The results are gathered on the GPU and read back once.
+        See :py:meth:`Texture.reduce` for details.
+
+        Args:
+            attachment (int): The color attachment.
+            buffer (Buffer): Receives min, max and mean as four floats each followed by the uint checksum.
+            offset (int): The write offset in the buffer.
+
+        Returns:
+            dict: ``min``, ``max`` and ``mean`` per component and an int ``checksum``, ``None`` with a ``buffer``.
         """
     def release(self) -> None:
         """Release the ModernGL object."""
@@ -2909,8 +3237,190 @@ class Query:
     extra: Any
     """Attribute for storing user defined objects"""
 
+    available: bool
+    """The results can be read without waiting for the GPU."""
+
     def __enter__(self): ...
     def __exit__(self, *args: Tuple[Any]): ...
+    def read_into(
+        self,
+        buffer: "Buffer",
+        offset: int = 0,
+        result: str = "samples",
+        wait: bool = True,
+        dtype: str = "u8",
+    ) -> None:
+        """
+        Write a result into a buffer on the GPU without waiting for it on the CPU.
+
+        Args:
+            buffer (Buffer): The buffer to write to.
+            offset (int): The byte offset in the buffer.
+            result (str): samples, any_samples, elapsed or primitives.
+            wait (bool): The GPU waits for the result, otherwise nothing is written when it is not available.
+            dtype (str): u8 for 64-bit or u4 for 32-bit results.
+        """
+    def release(self) -> None:
+        """Delete the OpenGL query objects."""
+
+class QueryResult(NamedTuple):
+    """The results of a query, None for the results not queried."""
+
+    samples: Optional[int]
+    any_samples: Optional[int]
+    elapsed: Optional[int]
+    primitives: Optional[int]
+
+class QueryPool:
+    """Recycles queries and collects their results without waiting for the GPU."""
+
+    ctx: "Context"
+    """The context this object belongs to"""
+
+    extra: Any
+    """Attribute for storing user defined objects"""
+
+    size: int
+    """The number of queries created by the pool."""
+
+    pending: int
+    """The number of queries not collected yet."""
+
+    def query(self, key: Any = None) -> AbstractContextManager[Query]:
+        """
+        Run a query of the pool, the key is returned with the results.
+        """
+    def collect(self, wait: bool = False) -> List[Tuple[Any, QueryResult]]:
+        """
+        The results of the finished queries in the order they ended,
+        up to the first query that is not available.
+
+        Args:
+            wait (bool): Wait for all the queries.
+        """
+    def release(self) -> None:
+        """Release the queries of the pool."""
+
+class ProfilerSection:
+    """The timings of a profiled section and its nested sections."""
+
+    name: str
+    """The name of the section."""
+
+    cpu_time: int
+    """The time spent recording the section on the CPU in nanoseconds."""
+
+    gpu_time: int
+    """The time spent executing the section on the GPU in nanoseconds."""
+
+    children: List["ProfilerSection"]
+    """The nested sections in the order they were recorded."""
+
+    def __getitem__(self, name: str) -> "ProfilerSection": ...
+    def __iter__(self) -> Iterator["ProfilerSection"]: ...
+    def report(self, depth: int = 0) -> str:
+        """Format the section tree as a table in milliseconds."""
+
+class Profiler:
+    """
+    Measures nested sections of a frame with timestamp queries.
+
+    The queries are read a few frames later so the measurement does not stall the pipeline.
+    """
+
+    ctx: "Context"
+    """The context this object belongs to"""
+
+    latency: int
+    """The number of frames that may be in flight before collecting waits for the GPU."""
+
+    debug_scopes: bool
+    """Sections also push a debug group with the same name."""
+
+    results: Optional[ProfilerSection]
+    """The most recent frame with resolved timings."""
+
+    frames: int
+    """The number of frames resolved so far."""
+
+    def begin_frame(self, name: str = "frame") -> None: ...
+    def end_frame(self) -> None: ...
+    def frame(self, name: str = "frame") -> AbstractContextManager["Profiler"]:
+        """Record a frame, the root section of the results."""
+    def section(self, name: str) -> AbstractContextManager[None]:
+        """Record a named section, sections can be nested."""
+    def collect(self, wait: bool = False) -> Optional[ProfilerSection]:
+        """
+        Read the timings of the finished frames.
+
+        Keyword Args:
+            wait (bool): Wait for every frame in flight.
+        """
+    def report(self) -> str:
+        """Format the most recent results."""
+    def release(self) -> None:
+        """Wait for the frames in flight and return their queries to the pool."""
+
+class Tracer:
+    """
+    Records moderngl calls and their GPU execution on a timeline.
+
+    The events are kept in a ring buffer in native memory.
+    """
+
+    ctx: "Context"
+    """The context this object belongs to"""
+
+    capacity: int
+    """The number of events kept, older events are overwritten."""
+
+    gpu: bool
+    """The GPU execution of every call is recorded."""
+
+    state: bool
+    """Bindings, uniform writes, scopes and state changes are recorded."""
+
+    active: bool
+    """The tracer has not been stopped yet."""
+
+    def __enter__(self) -> "Tracer": ...
+    def __exit__(self, *args: Tuple[Any]) -> None: ...
+    def section(self, name: str) -> AbstractContextManager[None]:
+        """Record a named section on the timeline."""
+    def stop(self) -> None:
+        """Stop tracing and keep the recorded events."""
+    def events(self) -> List[Dict[str, Any]]:
+        """The recorded events from the oldest, the times are in nanoseconds."""
+    def chrome_trace(self) -> Dict[str, Any]:
+        """The events in the Chrome trace event format."""
+    def perfetto_trace(self) -> bytes:
+        """The events as a Perfetto protobuf trace."""
+    def save(self, path: str, format: Optional[str] = None) -> None:
+        """
+        Write the trace to a file.
+
+        Args:
+            path (str): The path of the file.
+
+        Keyword Args:
+            format (str): ``'json'`` or ``'perfetto'``, by default ``'json'`` for ``.json`` files.
+        """
+
+class Capture:
+    """Records the OpenGL calls of a context to a file."""
+
+    ctx: "Context"
+    """The context this object belongs to"""
+
+    path: str
+    """The capture file."""
+
+    def __enter__(self) -> "Capture": ...
+    def __exit__(self, *args: Tuple[Any]) -> None: ...
+    def frame(self) -> AbstractContextManager[None]:
+        """Mark a frame, frames are repeated when replaying."""
+    def stop(self) -> None:
+        """Stop recording and close the file, raises if the file could not be written."""
 
 class Renderbuffer:
     """
@@ -4345,7 +4855,13 @@ class Texture:
     or kept within the Python object if not.
     """
 
-    def read(self, level: int = 0, alignment: int = 1) -> bytes:
+    def read(
+        self,
+        level: int = 0,
+        alignment: int = 1,
+        flip_y: bool = False,
+        channels: Optional[str] = None,
+    ) -> bytes:
         """
         Read the pixel data as bytes into system memory.
 
@@ -4357,6 +4873,8 @@ class Texture:
         Keyword Args:
             level (int): The mipmap level.
             alignment (int): The byte alignment of the pixels.
+            flip_y (bool): Return the rows top to bottom.
+            channels (str): The channels to return, for example ``"BGR"`` or ``"A"``.
 
         Returns:
             bytes
@@ -4367,6 +4885,9 @@ class Texture:
         level: int = 0,
         alignment: int = 1,
         write_offset: int = 0,
+        flip_y: bool = False,
+        row_stride: int = 0,
+        channels: Optional[str] = None,
     ) -> None:
         """
         Read the content of the texture into a bytearray or :py:class:`~moderngl.Buffer`.
@@ -4391,6 +4912,12 @@ class Texture:
             level (int): The mipmap level.
             alignment (int): The byte alignment of the pixels.
             write_offset (int): The write offset.
+            flip_y (bool): Write the rows top to bottom.
+                Not supported when reading into a :py:class:`Buffer`.
+            row_stride (int): The distance between rows in bytes.
+                ``0`` means tightly packed rows padded to ``alignment``.
+            channels (str): The channels to write, for example ``"BGR"`` or ``"A"``.
+                Reordering not supported by the driver is not available for a :py:class:`Buffer`.
         """
     def write(
         self,
@@ -4429,6 +4956,88 @@ class Texture:
             level (int): The mipmap level.
             alignment (int): The byte alignment of the pixels.
         """
+    def write_regions(
+        self,
+        data: Any,
+        regions: Any,
+        level: int = 0,
+        alignment: int = 1,
+    ) -> None:
+        """
+        Update many rectangles of the texture from a single source.
+
+        The texture is bound and the alignment is set once, then every region
+        is uploaded natively. This is much cheaper than calling :py:meth:`write`
+        for each glyph of an atlas or each tile of a map::
+
+            # Two 2 x 2 single component tiles stored one after the other
+            texture.write_regions(data, [(0, 0, 2, 2, 0), (6, 4, 2, 2, 4)])
+
+            # The same regions as a packed int32 array
+            texture.write_regions(data, np.array([[0, 0, 2, 2, 0], [6, 4, 2, 2, 4]], "i4"))
+
+        Args:
+            data (Union[bytes, Buffer]): The pixels of all regions.
+            regions: A sequence of ``(x, y, width, height, offset)`` tuples or a
+                packed buffer of int32 records with the same layout. The offset is
+                in bytes and every region is packed with rows padded to ``alignment``.
+
+        Keyword Args:
+            level (int): The mipmap level.
+            alignment (int): The byte alignment of the pixels.
+        """
+    def reduce(
+        self,
+        op: str = "sum",
+        level: int = 0,
+        buffer: Optional[Buffer] = None,
+        offset: int = 0,
+    ) -> Union[Tuple[float, ...], int, None]:
+        """
+        Reduce the texture to a handful of numbers on the GPU (OpenGL 4.3 required).
+
+        The image is reduced in 64 x 64 tiles by a compute shader followed by
+        a single workgroup combining the tiles, only the result is read back::
+
+            lo = texture.reduce("min")
+            hi = texture.reduce("max")
+            crc = texture.reduce("checksum")
+
+        When a ``buffer`` is passed the result is written into it and nothing is read back,
+        the reduction can then be consumed later without stalling.
+
+        Args:
+            op (str): ``"min"``, ``"max"``, ``"sum"``, ``"mean"`` or ``"checksum"``.
+
+        Keyword Args:
+            level (int): The mipmap level.
+            buffer (Buffer): Receives four floats, or a single uint for ``"checksum"``.
+            offset (int): The write offset in the buffer.
+
+        Returns:
+            tuple: One value per component, an int for ``"checksum"`` or ``None`` with a ``buffer``.
+        """
+    def histogram(
+        self,
+        bins: int = 256,
+        range: Tuple[float, float] = (0.0, 1.0),
+        level: int = 0,
+        buffer: Optional[Buffer] = None,
+        offset: int = 0,
+    ) -> Optional[Tuple[Tuple[int, ...], ...]]:
+        """
+        Count the texels per value range on the GPU (OpenGL 4.3 required).
+
+        Keyword Args:
+            bins (int): The number of bins, at most 256.
+            range (tuple): The values mapped to the first and the last bin, values outside are clamped.
+            level (int): The mipmap level.
+            buffer (Buffer): Receives ``components * bins`` uints, one histogram per component.
+            offset (int): The write offset in the buffer.
+
+        Returns:
+            tuple: One tuple of counts per component or ``None`` with a ``buffer``.
+        """
     def build_mipmaps(self, base: int = 0, max_level: int = 1000) -> None:
         """
         Generate mipmaps.
@@ -1,5 +1,15 @@
+import atexit
+import json
+import logging
+import os
+import struct
+import sys
+import threading
+import time
 import warnings
-from collections import deque
+import weakref
+from collections import deque, namedtuple
+from concurrent.futures import Future
 from contextlib import contextmanager
 
 from _moderngl import (
@@ -24,6 +34,81 @@ __version__ = "5.12.0"
 _GL_DEBUG_SOURCE_THIRD_PARTY = 0x8249
 _GL_DEBUG_SOURCE_APPLICATION = 0x824A
 
+# Same order as the name tables of the native debug output
+_DEBUG_SOURCES = ("api", "window_system", "shader_compiler", "third_party", "application", "other")
+_DEBUG_TYPES = (
+    "error",
+    "deprecated",
+    "undefined",
+    "portability",
+    "performance",
+    "marker",
+    "push_group",
+    "pop_group",
+    "other",
+)
+_DEBUG_SEVERITIES = ("high", "medium", "low", "notification")
+_DEBUG_LEVELS = {
+    "high": logging.ERROR,
+    "medium": logging.WARNING,
+    "low": logging.INFO,
+    "notification": logging.DEBUG,
+}
+
+_logger = logging.getLogger("moderngl")
+
+
+def _log_debug_message(source, type, id, severity, message):
+    _logger.log(_DEBUG_LEVELS[severity], "GL %s %s 0x%x: %s", source, type, id, message)
+
+
+def _log_memory_alarm(total, limit):
+    _logger.warning("estimated GPU memory of %d bytes is above the alarm of %d bytes", total, limit)
+
+
+# Contexts profiled by MODERNGL_PROFILE_STARTUP, reported when released or at exit
+_startup_contexts = weakref.WeakSet()
+
+
+def _profile_startup_from_env():
+    return os.environ.get("MODERNGL_PROFILE_STARTUP", "0") not in ("", "0")
+
+
+def _format_startup_profile(profile):
+    lines = ["%-16s %6s %10s %10s %10s" % ("phase", "count", "total ms", "first ms", "max ms")]
+    for phase, item in profile.items():
+        if item["count"]:
+            lines.append("%-16s %6d %10.3f %10.3f %10.3f" % (
+                phase, item["count"], item["total"] / 1e6, item["first"] / 1e6, item["max"] / 1e6,
+            ))
+    return "\n".join(lines)
+
+
+def _report_startup(ctx):
+    _startup_contexts.discard(ctx)
+    profile = ctx.startup_profile
+    if profile:
+        sys.stderr.write("moderngl startup profile\n%s\n" % _format_startup_profile(profile))
+
+
+@atexit.register
+def _report_startup_at_exit():
+    for ctx in list(_startup_contexts):
+        _report_startup(ctx)
+
+
+def _debug_mask(names, valid, kind):
+    if names is None:
+        return (1 << len(valid)) - 1
+    if isinstance(names, str):
+        names = (names,)
+    mask = 0
+    for name in names:
+        if name not in valid:
+            raise ValueError(f"invalid debug message {kind} '{name}', expected one of {', '.join(valid)}")
+        mask |= 1 << valid.index(name)
+    return mask
+
 
 def packager_imports():
     """some additional imports that code freezers (Pyinstaller,etc) should see."""
@@ -45,6 +130,9 @@ _VERTEX_ARRAY = 0x8074
 _FRAMEBUFFER = 0x8D40
 _RENDERBUFFER = 0x8D41
 
+_MEMORY_KINDS = ("buffer", "texture", "texture_3d", "texture_array", "texture_cube", "renderbuffer")
+_MEMORY_OBJECT_TYPES = (_BUFFER, _TEXTURE, _TEXTURE, _TEXTURE, _TEXTURE, _RENDERBUFFER)
+
 
 class Buffer:
     def __init__(self):
@@ -152,6 +240,10 @@ class ConditionalRender:
         self.mglo.end_render()
 
 
+# Same order as the query objects of the native Query
+_QUERY_RESULTS = ("samples", "any_samples", "elapsed", "primitives")
+
+
 class Query:
     def __init__(self):
         self.mglo = None
@@ -180,6 +272,381 @@ class Query:
     def elapsed(self):
         return self.mglo.elapsed
 
+    @property
+    def available(self):
+        return self.mglo.available
+
+    def read_into(self, buffer, offset=0, result="samples", wait=True, dtype="u8"):
+        if result not in _QUERY_RESULTS:
+            raise ValueError(f"invalid result '{result}', expected one of {', '.join(_QUERY_RESULTS)}")
+        if dtype not in ("u4", "u8"):
+            raise ValueError("dtype must be 'u4' or 'u8'")
+        self.mglo.read_into(buffer.mglo, offset, _QUERY_RESULTS.index(result), wait, dtype == "u8")
+
+    def release(self):
+        if not isinstance(self.mglo, InvalidObject):
+            self.mglo.release()
+            self.mglo = InvalidObject()
+
+
+QueryResult = namedtuple("QueryResult", _QUERY_RESULTS)
+
+
+class QueryPool:
+    def __init__(self, ctx, samples=False, any_samples=False, time=False, primitives=False):
+        self.ctx = ctx
+        self.extra = None
+        self._flags = (samples, any_samples, time, primitives)
+        self._free = deque()
+        self._pending = deque()
+        self._size = 0
+
+    @property
+    def size(self):
+        return self._size
+
+    @property
+    def pending(self):
+        return len(self._pending)
+
+    def _take(self):
+        if self._free:
+            return self._free.popleft()
+        self._size += 1
+        return self.ctx.query(*self._flags)
+
+    @contextmanager
+    def query(self, key=None):
+        query = self._take()
+        query.mglo.begin()
+        try:
+            yield query
+        finally:
+            query.mglo.end()
+            self._pending.append((key, query))
+
+    def collect(self, wait=False):
+        # The queries finish in the order they ended, the first one not available stops the collection
+        results = []
+        while self._pending:
+            key, query = self._pending[0]
+            result = query.mglo.result(wait)
+            if result is None:
+                break
+            self._pending.popleft()
+            self._free.append(query)
+            results.append((key, QueryResult(*result)))
+        return results
+
+    def release(self):
+        for query in self._free:
+            query.release()
+        for _, query in self._pending:
+            query.release()
+        self._free.clear()
+        self._pending.clear()
+        self._size = 0
+
+
+class ProfilerSection:
+    __slots__ = ["name", "cpu_time", "gpu_time", "children"]
+
+    def __init__(self, name, cpu_time, gpu_time, children):
+        self.name = name
+        self.cpu_time = cpu_time
+        self.gpu_time = gpu_time
+        self.children = children
+
+    def __getitem__(self, name):
+        for child in self.children:
+            if child.name == name:
+                return child
+        raise KeyError(name)
+
+    def __iter__(self):
+        yield from self.children
+
+    def __repr__(self):
+        return "<ProfilerSection %r cpu=%.3fms gpu=%.3fms>" % (self.name, self.cpu_time / 1e6, self.gpu_time / 1e6)
+
+    def report(self, depth=0):
+        lines = ["%-32s %10.3f ms %10.3f ms" % ("  " * depth + self.name, self.cpu_time / 1e6, self.gpu_time / 1e6)]
+        for child in self.children:
+            lines.append(child.report(depth + 1))
+        return "\n".join(lines)
+
+
+class Profiler:
+    def __init__(self, ctx, latency=3, debug_scopes=True):
+        if latency < 1:
+            raise ValueError("latency must be at least 1")
+
+        self.ctx = ctx
+        self.latency = latency
+        self.debug_scopes = debug_scopes and ctx.supports_debug_scopes
+        self.results = None
+        self.frames = 0
+        self._stack = []
+        self._pending = deque()
+        self._queries = None
+
+    # A section is recorded as [name, cpu_start, cpu_end, query_start, query_end, children]
+    def _begin(self, name):
+        record = [name, 0, 0, 0, 0, []]
+        if self._stack:
+            self._stack[-1][5].append(record)
+        self._stack.append(record)
+        if self.debug_scopes:
+            self.ctx.mglo.push_debug_scope(_GL_DEBUG_SOURCE_APPLICATION, hash(name) & 0xFFFFFFFF, name)
+        self.ctx.mglo.trace_begin(name)
+        record[3] = self.ctx.mglo.timestamp()
+        self._queries.append(record[3])
+        record[1] = time.perf_counter_ns()
+        return record
+
+    def _end(self):
+        record = self._stack.pop()
+        record[2] = time.perf_counter_ns()
+        record[4] = self.ctx.mglo.timestamp()
+        self._queries.append(record[4])
+        self.ctx.mglo.trace_end()
+        if self.debug_scopes:
+            self.ctx.mglo.pop_debug_scope()
+        return record
+
+    def begin_frame(self, name="frame"):
+        if self._stack:
+            raise RuntimeError("the previous frame has not ended")
+        self._queries = []
+        self._begin(name)
+
+    def end_frame(self):
+        if len(self._stack) != 1:
+            raise RuntimeError("begin_frame was not called or a section is still open")
+        frame = self._end()
+        self._pending.append((frame, self._queries))
+        self._queries = None
+        self.collect()
+
+    @contextmanager
+    def frame(self, name="frame"):
+        self.begin_frame(name)
+        try:
+            yield self
+        finally:
+            self.end_frame()
+
+    @contextmanager
+    def section(self, name):
+        if not self._stack:
+            raise RuntimeError("sections must be recorded inside a frame")
+        record = self._begin(name)
+        try:
+            yield
+        finally:
+            if self._stack and self._stack[-1] is record:
+                self._end()
+
+    def collect(self, wait=False):
+        # Frames older than the latency are waited for, newer ones are only read when ready
+        while self._pending:
+            frame, queries = self._pending[0]
+            block = wait or len(self._pending) > self.latency
+            timestamps = self.ctx.mglo.read_timestamps(queries, block)
+            if timestamps is None:
+                break
+            self._pending.popleft()
+            values = dict(zip(queries, timestamps))
+            self.results = self._resolve(frame, values)
+            self.frames += 1
+        return self.results
+
+    def _resolve(self, record, values):
+        name, cpu_start, cpu_end, query_start, query_end, children = record
+        children = [self._resolve(child, values) for child in children]
+        return ProfilerSection(name, cpu_end - cpu_start, values[query_end] - values[query_start], children)
+
+    def report(self):
+        if self.results is None:
+            return ""
+        return self.results.report()
+
+    def release(self):
+        # Returns the queries in flight to the pool
+        while self._pending:
+            frame, queries = self._pending.popleft()
+            self.ctx.mglo.read_timestamps(queries, True)
+
+
+def _varint(value):
+    res = bytearray()
+    while value > 0x7F:
+        res.append((value & 0x7F) | 0x80)
+        value >>= 7
+    res.append(value)
+    return bytes(res)
+
+
+def _proto_int(field, value):
+    return _varint(field << 3) + _varint(value)
+
+
+def _proto_bytes(field, value):
+    return _varint((field << 3) | 2) + _varint(len(value)) + value
+
+
+def _nested_slices(slices):
+    # Orders begin and end markers so overlapping ranges on one track stay nested
+    res = []
+    stack = []
+    for begin, end, name in sorted(slices, key=lambda item: (item[0], -item[1])):
+        while stack and stack[-1] <= begin:
+            res.append((stack.pop(), None))
+        if stack:
+            end = min(end, stack[-1])
+        stack.append(end)
+        res.append((begin, name))
+    while stack:
+        res.append((stack.pop(), None))
+    return res
+
+
+class Tracer:
+    def __init__(self, ctx, capacity=65536, gpu=True, state=False):
+        self.ctx = ctx
+        self.capacity = capacity
+        self.gpu = gpu
+        self.state = state
+        self._events = None
+        ctx.mglo.start_trace(capacity, gpu, state)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.stop()
+
+    @property
+    def active(self):
+        return self._events is None
+
+    @contextmanager
+    def section(self, name):
+        self.ctx.mglo.trace_begin(name)
+        try:
+            yield
+        finally:
+            self.ctx.mglo.trace_end()
+
+    def stop(self):
+        if self._events is None:
+            self._events = self.ctx.mglo.stop_trace()
+
+    def events(self):
+        raw = self._events if self._events is not None else self.ctx.mglo.trace_events()
+        labels = {}
+        res = []
+        for name, object_type, glo, cpu_begin, cpu_end, gpu_begin, gpu_end in raw:
+            label = None
+            if object_type and self.ctx.supports_labels:
+                key = (object_type, glo)
+                if key not in labels:
+                    labels[key] = self.ctx.mglo.get_label(object_type, glo)
+                label = labels[key]
+            res.append({
+                "name": name,
+                "label": label,
+                "glo": glo if object_type else None,
+                "cpu_begin": cpu_begin,
+                "cpu_end": cpu_end,
+                "gpu_begin": gpu_begin,
+                "gpu_end": gpu_end,
+            })
+        return res
+
+    def _slices(self):
+        cpu = []
+        gpu = []
+        for event in self.events():
+            name = event["name"]
+            if event["label"]:
+                name = "%s %s" % (name, event["label"])
+            cpu.append((event["cpu_begin"], event["cpu_end"], name))
+            if event["gpu_begin"] is not None:
+                gpu.append((event["gpu_begin"], event["gpu_end"], name))
+        return cpu, gpu
+
+    def chrome_trace(self):
+        cpu, gpu = self._slices()
+        origin = min([begin for begin, _, _ in cpu + gpu], default=0)
+        events = [
+            {"name": "thread_name", "ph": "M", "pid": 1, "tid": 1, "args": {"name": "CPU"}},
+            {"name": "thread_name", "ph": "M", "pid": 1, "tid": 2, "args": {"name": "GPU"}},
+        ]
+        for tid, slices in ((1, cpu), (2, gpu)):
+            for begin, end, name in slices:
+                events.append({
+                    "name": name,
+                    "ph": "X",
+                    "pid": 1,
+                    "tid": tid,
+                    "ts": (begin - origin) / 1000.0,
+                    "dur": (end - begin) / 1000.0,
+                })
+        return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+    def perfetto_trace(self):
+        res = bytearray()
+        cpu, gpu = self._slices()
+        for uuid, track_name, slices in ((1, "CPU", cpu), (2, "GPU", gpu)):
+            descriptor = _proto_int(1, uuid) + _proto_bytes(2, track_name.encode())
+            res += _proto_bytes(1, _proto_bytes(60, descriptor))
+            for timestamp, name in _nested_slices(slices):
+                if name is None:
+                    event = _proto_int(9, 2) + _proto_int(11, uuid)
+                else:
+                    event = _proto_int(9, 1) + _proto_int(11, uuid) + _proto_bytes(23, name.encode())
+                packet = _proto_int(8, timestamp) + _proto_int(10, 1) + _proto_bytes(11, event)
+                res += _proto_bytes(1, packet)
+        return bytes(res)
+
+    def save(self, path, format=None):
+        if format is None:
+            format = "json" if str(path).endswith(".json") else "perfetto"
+
+        if format == "json":
+            with open(path, "w") as f:
+                json.dump(self.chrome_trace(), f)
+        elif format == "perfetto":
+            with open(path, "wb") as f:
+                f.write(self.perfetto_trace())
+        else:
+            raise ValueError("format must be 'json' or 'perfetto', got '%s'" % format)
+
+
+class Capture:
+    def __init__(self, ctx, path):
+        self.ctx = ctx
+        self.path = os.fspath(path)
+        ctx.mglo.start_capture(self.path)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.stop()
+
+    @contextmanager
+    def frame(self):
+        self.ctx.mglo.capture_frame(True)
+        try:
+            yield
+        finally:
+            self.ctx.mglo.capture_frame(False)
+
+    def stop(self):
+        self.ctx.mglo.stop_capture()
+
 
 class ComputeShader:
     def __init__(self):
@@ -247,6 +714,338 @@ class ComputeShader:
             self._label = value
 
 
+_REDUCE_TILES = """
+#version 430
+
+layout (local_size_x = 16, local_size_y = 16) in;
+
+uniform SAMPLER Source;
+uniform int Level;
+uniform int Op;
+
+layout (std430, binding = PARTIALS) buffer Partials {
+    vec4 partials[];
+};
+
+shared vec4 values[256];
+
+vec4 combine(vec4 a, vec4 b) {
+    if (Op == 0) return min(a, b);
+    if (Op == 1) return max(a, b);
+    return a + b;
+}
+
+void main() {
+    ivec2 size = textureSize(Source, Level);
+    ivec2 base = ivec2(gl_WorkGroupID.xy) * 64 + ivec2(gl_LocalInvocationID.xy);
+    vec4 acc = vec4(Op == 0 ? 3.4e38 : (Op == 1 ? -3.4e38 : 0.0));
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            ivec2 at = base + ivec2(x, y) * 16;
+            if (at.x < size.x && at.y < size.y) {
+                acc = combine(acc, vec4(texelFetch(Source, at, Level)));
+            }
+        }
+    }
+    uint index = gl_LocalInvocationIndex;
+    values[index] = acc;
+    barrier();
+    for (uint stride = 128u; stride > 0u; stride >>= 1) {
+        if (index < stride) {
+            values[index] = combine(values[index], values[index + stride]);
+        }
+        barrier();
+    }
+    if (index == 0u) {
+        partials[gl_WorkGroupID.y * gl_NumWorkGroups.x + gl_WorkGroupID.x] = values[0];
+    }
+}
+"""
+
+_REDUCE_PARTIALS = """
+#version 430
+
+layout (local_size_x = 256) in;
+
+uniform int Op;
+uniform int Count;
+uniform float Scale;
+
+layout (std430, binding = PARTIALS) buffer Partials {
+    vec4 partials[];
+};
+
+layout (std430, binding = RESULT) buffer Result {
+    vec4 result;
+};
+
+shared vec4 values[256];
+
+vec4 combine(vec4 a, vec4 b) {
+    if (Op == 0) return min(a, b);
+    if (Op == 1) return max(a, b);
+    return a + b;
+}
+
+void main() {
+    uint index = gl_LocalInvocationIndex;
+    vec4 acc = vec4(Op == 0 ? 3.4e38 : (Op == 1 ? -3.4e38 : 0.0));
+    for (int i = int(index); i < Count; i += 256) {
+        acc = combine(acc, partials[i]);
+    }
+    values[index] = acc;
+    barrier();
+    for (uint stride = 128u; stride > 0u; stride >>= 1) {
+        if (index < stride) {
+            values[index] = combine(values[index], values[index + stride]);
+        }
+        barrier();
+    }
+    if (index == 0u) {
+        result = values[0] * Scale;
+    }
+}
+"""
+
+_CHECKSUM = """
+#version 430
+
+layout (local_size_x = 16, local_size_y = 16) in;
+
+uniform SAMPLER Source;
+uniform int Level;
+
+layout (std430, binding = RESULT) buffer Result {
+    uint checksum;
+};
+
+shared uint values[256];
+
+uint hash(uint x) {
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+void main() {
+    ivec2 size = textureSize(Source, Level);
+    ivec2 base = ivec2(gl_WorkGroupID.xy) * 64 + ivec2(gl_LocalInvocationID.xy);
+    uint acc = 0u;
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            ivec2 at = base + ivec2(x, y) * 16;
+            if (at.x < size.x && at.y < size.y) {
+                uvec4 bits = floatBitsToUint(vec4(texelFetch(Source, at, Level)));
+                uint h = hash(uint(at.x) ^ hash(uint(at.y)));
+                h = hash(h ^ bits.x);
+                h = hash(h ^ bits.y);
+                h = hash(h ^ bits.z);
+                acc += hash(h ^ bits.w);
+            }
+        }
+    }
+    uint index = gl_LocalInvocationIndex;
+    values[index] = acc;
+    barrier();
+    for (uint stride = 128u; stride > 0u; stride >>= 1) {
+        if (index < stride) {
+            values[index] += values[index + stride];
+        }
+        barrier();
+    }
+    if (index == 0u) {
+        atomicAdd(checksum, values[0]);
+    }
+}
+"""
+
+_HISTOGRAM = """
+#version 430
+
+layout (local_size_x = 16, local_size_y = 16) in;
+
+uniform SAMPLER Source;
+uniform int Level;
+uniform int Bins;
+uniform int Components;
+uniform vec2 Range;
+
+layout (std430, binding = PARTIALS) buffer Histogram {
+    uint counts[];
+};
+
+shared uint local_counts[1024];
+
+void main() {
+    uint index = gl_LocalInvocationIndex;
+    for (uint i = index; i < 1024u; i += 256u) {
+        local_counts[i] = 0u;
+    }
+    barrier();
+    ivec2 size = textureSize(Source, Level);
+    ivec2 base = ivec2(gl_WorkGroupID.xy) * 64 + ivec2(gl_LocalInvocationID.xy);
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            ivec2 at = base + ivec2(x, y) * 16;
+            if (at.x < size.x && at.y < size.y) {
+                vec4 t = clamp((vec4(texelFetch(Source, at, Level)) - Range.x) / (Range.y - Range.x), 0.0, 1.0);
+                ivec4 bin = min(ivec4(t * float(Bins)), ivec4(Bins - 1));
+                for (int c = 0; c < Components; ++c) {
+                    atomicAdd(local_counts[c * Bins + bin[c]], 1u);
+                }
+            }
+        }
+    }
+    barrier();
+    for (uint i = index; i < uint(Components * Bins); i += 256u) {
+        if (local_counts[i] != 0u) {
+            atomicAdd(counts[i], local_counts[i]);
+        }
+    }
+}
+"""
+
+_REDUCE_OPS = {"min": 0, "max": 1, "sum": 2, "mean": 3}
+
+
+class _Reduction:
+    """Compute shaders and scratch buffers behind Texture.reduce and Texture.histogram, one per context."""
+
+    def __init__(self, ctx):
+        self.ctx = ctx
+        self.programs = {}
+        self.partials = ctx.buffer(reserve=16)
+        self.result = ctx.buffer(reserve=16)
+        self.statistics_result = None
+        # The last two storage buffer bindings are reserved so user bindings survive a reduction
+        bindings = ctx.info["GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS"]
+        self.partials_binding = bindings - 2
+        self.result_binding = bindings - 1
+
+    @staticmethod
+    def get(ctx):
+        reduction = getattr(ctx, "_reduction", None)
+        if reduction is None:
+            if ctx.version_code < 430:
+                raise Error("texture reductions require OpenGL 4.3")
+            reduction = ctx._reduction = _Reduction(ctx)
+        return reduction
+
+    def program(self, source, texture=None):
+        sampler = "sampler2D"
+        if texture is not None:
+            if texture.samples:
+                raise Error("multisample textures cannot be reduced")
+            if texture.dtype[0] in "ui":
+                sampler = texture.dtype[0] + "sampler2D"
+
+        key = (id(source), sampler)
+        if key not in self.programs:
+            source = source.replace("SAMPLER", sampler)
+            source = source.replace("PARTIALS", str(self.partials_binding))
+            source = source.replace("RESULT", str(self.result_binding))
+            self.programs[key] = self.ctx.compute_shader(source)
+        return self.programs[key]
+
+    def bind_source(self, program, texture, level):
+        unit = self.ctx.default_texture_unit
+        texture.use(unit)
+        program["Source"] = unit
+        program["Level"] = level
+        width = max(texture.width >> level, 1)
+        height = max(texture.height >> level, 1)
+        return width, height, (width + 63) // 64, (height + 63) // 64
+
+    def reduce(self, texture, op, level):
+        if op not in _REDUCE_OPS:
+            raise Error("invalid op %s, expected one of %s" % (op, ", ".join(_REDUCE_OPS)))
+
+        op_code = _REDUCE_OPS[op]
+        tiles = self.program(_REDUCE_TILES, texture)
+        width, height, groups_x, groups_y = self.bind_source(tiles, texture, level)
+        count = groups_x * groups_y
+
+        if self.partials.size < count * 16:
+            self.partials.orphan(count * 16)
+
+        tiles["Op"] = op_code
+        self.partials.bind_to_storage_buffer(self.partials_binding)
+        tiles.run(groups_x, groups_y)
+        self.ctx.memory_barrier(Context.SHADER_STORAGE_BARRIER_BIT)
+
+        partials = self.program(_REDUCE_PARTIALS)
+        partials["Op"] = op_code
+        partials["Count"] = count
+        partials["Scale"] = 1.0 / (width * height) if op == "mean" else 1.0
+        self.result.bind_to_storage_buffer(self.result_binding)
+        partials.run()
+        self.ctx.memory_barrier(Context.BUFFER_UPDATE_BARRIER_BIT)
+
+    def checksum(self, texture, level):
+        program = self.program(_CHECKSUM, texture)
+        _, _, groups_x, groups_y = self.bind_source(program, texture, level)
+        self.result.clear()
+        self.result.bind_to_storage_buffer(self.result_binding)
+        program.run(groups_x, groups_y)
+        self.ctx.memory_barrier(Context.BUFFER_UPDATE_BARRIER_BIT)
+
+    def histogram(self, texture, bins, value_range, level, buffer, offset):
+        if not 1 <= bins <= 256:
+            raise Error("the number of bins must be between 1 and 256")
+
+        program = self.program(_HISTOGRAM, texture)
+        _, _, groups_x, groups_y = self.bind_source(program, texture, level)
+        size = texture.components * bins * 4
+
+        if self.partials.size < size:
+            self.partials.orphan(size)
+
+        self.partials.clear(size)
+        program["Bins"] = bins
+        program["Components"] = texture.components
+        program["Range"] = tuple(value_range)
+        self.partials.bind_to_storage_buffer(self.partials_binding)
+        program.run(groups_x, groups_y)
+        self.ctx.memory_barrier(Context.BUFFER_UPDATE_BARRIER_BIT)
+
+        if buffer is not None:
+            self.ctx.copy_buffer(buffer, self.partials, size, 0, offset)
+            return None
+
+        counts = struct.unpack("%dI" % (size // 4), self.partials.read(size))
+        return tuple(counts[i * bins:(i + 1) * bins] for i in range(texture.components))
+
+    def statistics(self, texture, buffer, offset):
+        # Every value is gathered on the GPU so there is at most one read back
+        if buffer is None:
+            if self.statistics_result is None:
+                self.statistics_result = self.ctx.buffer(reserve=52)
+            target, target_offset = self.statistics_result, 0
+        else:
+            target, target_offset = buffer, offset
+
+        for index, op in enumerate(("min", "max", "mean")):
+            self.reduce(texture, op, 0)
+            self.ctx.copy_buffer(target, self.result, 16, 0, target_offset + index * 16)
+        self.checksum(texture, 0)
+        self.ctx.copy_buffer(target, self.result, 4, 0, target_offset + 48)
+
+        if buffer is not None:
+            return None
+
+        values = struct.unpack("12fI", target.read(52))
+        components = texture.components
+        return {
+            "min": values[0:components],
+            "max": values[4:4 + components],
+            "mean": values[8:8 + components],
+            "checksum": values[12],
+        }
+
+
 class Framebuffer:
     def __init__(self):
         self.mglo = None
@@ -393,16 +1192,35 @@ class Framebuffer:
         alignment=1,
         dtype="f1",
         clamp=False,
+        flip_y=False,
+        channels=None,
+        scale=None,
+        filter="box",
     ):
         if viewport is None:
             viewport = (0, 0, self.width, self.height)
         if len(viewport) == 2:
             viewport = (0, 0, *viewport)
+        if channels:
+            components = len(channels)
+        width, height = viewport[2:] if scale is None else scale
         res, mem = mgl.writable_bytes(
-            mgl.expected_size(viewport[2], viewport[3], 1, components, alignment, dtype)
+            mgl.expected_size(width, height, 1, components, alignment, dtype)
         )
         self.mglo.read_into(
-            mem, viewport, components, attachment, alignment, clamp, dtype, 0
+            mem,
+            viewport,
+            components,
+            attachment,
+            alignment,
+            clamp,
+            dtype,
+            0,
+            flip_y,
+            0,
+            channels,
+            scale,
+            filter,
         )
         return res
 
@@ -416,6 +1234,11 @@ class Framebuffer:
         dtype="f1",
         clamp=False,
         write_offset=0,
+        flip_y=False,
+        row_stride=0,
+        channels=None,
+        scale=None,
+        filter="box",
     ):
         if type(buffer) is Buffer:
             buffer = buffer.mglo
@@ -429,8 +1252,69 @@ class Framebuffer:
             clamp,
             dtype,
             write_offset,
+            flip_y,
+            row_stride,
+            channels,
+            scale,
+            filter,
         )
 
+    def statistics(self, attachment=0, buffer=None, offset=0):
+        reduction = _Reduction.get(self.ctx)
+
+        if self._color_attachments is None:
+            # Detected and default framebuffers have no attachment objects, their pixels are copied
+            if attachment != 0:
+                raise Error("only the first color attachment of a detected framebuffer can be read")
+            texture = self.ctx.texture(self.size, 4, dtype=self.mglo.color_dtype(0))
+            dst = self.ctx.framebuffer([texture])
+            try:
+                self.ctx.copy_framebuffer(dst, self)
+                return reduction.statistics(texture, buffer, offset)
+            finally:
+                dst.release()
+                texture.release()
+
+        if not 0 <= attachment < len(self._color_attachments):
+            raise Error("invalid color attachment %d" % attachment)
+
+        source = self._color_attachments[attachment]
+
+        if isinstance(source, Texture) and not source.samples:
+            return reduction.statistics(source, buffer, offset)
+
+        # Renderbuffers and multisample textures cannot be fetched from, resolve them first
+        texture = self.ctx.texture(source.size, source.components, dtype=source.dtype)
+        src = self.ctx.framebuffer([source])
+        dst = self.ctx.framebuffer([texture])
+        try:
+            self.ctx.copy_framebuffer(dst, src)
+            return reduction.statistics(texture, buffer, offset)
+        finally:
+            dst.release()
+            src.release()
+            texture.release()
+
+        if not 0 <= attachment < len(self._color_attachments):
+            raise Error("invalid color attachment %d" % attachment)
+
+        source = self._color_attachments[attachment]
+
+        if isinstance(source, Texture) and not source.samples:
+            return reduction.statistics(source)
+
+        # Renderbuffers and multisample textures cannot be fetched from, resolve them first
+        texture = self.ctx.texture(source.size, source.components, dtype=source.dtype)
+        src = self.ctx.framebuffer([source])
+        dst = self.ctx.framebuffer([texture])
+        try:
+            self.ctx.copy_framebuffer(dst, src)
+            return reduction.statistics(texture)
+        finally:
+            dst.release()
+            src.release()
+            texture.release()
+
     def release(self):
         if not isinstance(self.mglo, InvalidObject):
             self._color_attachments = None
@@ -901,14 +1785,35 @@ class Texture:
         else:
             self._label = value
 
-    def read(self, level=0, alignment=1):
-        return self.mglo.read(level, alignment)
+    def read(self, level=0, alignment=1, flip_y=False, channels=None):
+        if not flip_y and not channels:
+            return self.mglo.read(level, alignment)
+
+        width = max(self.width >> level, 1)
+        height = max(self.height >> level, 1)
+        components = len(channels) if channels else self.components
+        res, mem = mgl.writable_bytes(
+            mgl.expected_size(width, height, 1, components, alignment, self.dtype)
+        )
+        self.mglo.read_into(mem, level, alignment, 0, flip_y, 0, channels)
+        return res
 
-    def read_into(self, buffer, level=0, alignment=1, write_offset=0):
+    def read_into(
+        self,
+        buffer,
+        level=0,
+        alignment=1,
+        write_offset=0,
+        flip_y=False,
+        row_stride=0,
+        channels=None,
+    ):
         if type(buffer) is Buffer:
             buffer = buffer.mglo
 
-        return self.mglo.read_into(buffer, level, alignment, write_offset)
+        return self.mglo.read_into(
+            buffer, level, alignment, write_offset, flip_y, row_stride, channels
+        )
 
     def write(self, data, viewport=None, level=0, alignment=1):
         if type(data) is Buffer:
@@ -916,6 +1821,32 @@ class Texture:
 
         self.mglo.write(data, viewport, level, alignment)
 
+    def write_regions(self, data, regions, level=0, alignment=1):
+        if type(data) is Buffer:
+            data = data.mglo
+
+        self.mglo.write_regions(data, regions, level, alignment)
+
+    def reduce(self, op="sum", level=0, buffer=None, offset=0):
+        reduction = _Reduction.get(self.ctx)
+
+        if op == "checksum":
+            reduction.checksum(self, level)
+            if buffer is not None:
+                self.ctx.copy_buffer(buffer, reduction.result, 4, 0, offset)
+                return None
+            return struct.unpack("I", reduction.result.read(4))[0]
+
+        reduction.reduce(self, op, level)
+        if buffer is not None:
+            self.ctx.copy_buffer(buffer, reduction.result, 16, 0, offset)
+            return None
+        return struct.unpack("4f", reduction.result.read(16))[: self.components]
+
+    def histogram(self, bins=256, range=(0.0, 1.0), level=0, buffer=None, offset=0):
+        reduction = _Reduction.get(self.ctx)
+        return reduction.histogram(self, bins, range, level, buffer, offset)
+
     def build_mipmaps(self, base=0, max_level=1000):
         self.mglo.build_mipmaps(base, max_level)
 
@@ -1582,17 +2513,18 @@ class Context:
     TRANSFORM_FEEDBACK_BARRIER_BIT = 0x00000800
     ATOMIC_COUNTER_BARRIER_BIT = 0x00001000
     SHADER_STORAGE_BARRIER_BIT = 0x00002000
+    QUERY_BUFFER_BARRIER_BIT = 0x00008000
     ALL_BARRIER_BITS = 0xFFFFFFFF
 
     def __init__(self):
         self.mglo = None
         self._screen = None
-        self._info = None
         self._extensions = None
         self.version_code = None
         self.fbo = None
         self.extra = None
         self._gc_mode = None
+        self._backend = None
         self._objects = deque()
         raise TypeError()
 
@@ -1615,17 +2547,96 @@ class Context:
     def objects(self):
         return self._objects
 
-    def gc(self):
+    def gc(self, defer=False):
         count = 0
         # Keep iterating until there are no more objects.
         # An object deletion can trigger new objects to be added
-        while self._objects:
-            # Remove the oldest objects first
-            obj = self._objects.popleft()
-            obj.release()
-            count += 1
+        while True:
+            # Remove the oldest objects first, the names are deleted in batches.
+            # An empty batch still deletes the deferred names whose fence was signaled
+            batch = [self._objects.popleft() for _ in range(len(self._objects))]
+            count += self.mglo.release_objects(batch, defer)
+            if not self._objects:
+                return count
+
+    @property
+    def release_stats(self):
+        return self.mglo.release_stats
+
+    @property
+    def stats(self):
+        return self.mglo.stats
+
+    def reset_stats(self):
+        return self.mglo.reset_stats()
+
+    def memory_report(self, labels=True):
+        total, peak, alarm, kinds, objects = self.mglo.memory_report(labels)
+        report = {
+            "total": total,
+            "peak": peak,
+            "alarm": alarm or None,
+            "types": {name: {"count": count, "bytes": size} for name, (count, size) in zip(_MEMORY_KINDS, kinds)},
+        }
+        if labels:
+            groups = {}
+            for kind, glo, size in objects:
+                label = None
+                if self.supports_labels:
+                    label = self.mglo.get_label(_MEMORY_OBJECT_TYPES[kind], glo) or None
+                group = groups.setdefault(label, {"count": 0, "bytes": 0})
+                group["count"] += 1
+                group["bytes"] += size
+            report["labels"] = groups
+        return report
+
+    @property
+    def startup_profile(self):
+        profile = self.mglo.startup_profile()
+        if profile is None:
+            return None
+        return {
+            phase: {"count": count, "total": total, "first": first, "max": longest}
+            for phase, (count, total, first, longest) in profile.items()
+        }
+
+    def set_memory_alarm(self, limit, callback=None):
+        if limit is not None and limit <= 0:
+            raise ValueError("limit must be positive")
+        self.mglo.set_memory_alarm(limit or 0, _log_memory_alarm if callback is None else callback)
+
+    def enable_debug_output(
+        self,
+        severity="medium",
+        types=None,
+        sources=None,
+        callback=None,
+        rate_limit=10,
+        synchronous=False,
+    ):
+        if severity not in _DEBUG_SEVERITIES:
+            raise ValueError(f"invalid severity '{severity}', expected one of {', '.join(_DEBUG_SEVERITIES)}")
+        if rate_limit < 0:
+            raise ValueError("rate_limit must not be negative")
+        severities = (1 << (_DEBUG_SEVERITIES.index(severity) + 1)) - 1
+        self.mglo.enable_debug_output(
+            severities,
+            _debug_mask(types, _DEBUG_TYPES, "type"),
+            _debug_mask(sources, _DEBUG_SOURCES, "source"),
+            rate_limit,
+            synchronous,
+            _log_debug_message if callback is None else callback,
+        )
 
-        return count
+    def disable_debug_output(self):
+        self.mglo.disable_debug_output()
+
+    def process_debug_output(self):
+        return self.mglo.process_debug_output()
+
+    @property
+    def debug_message_counts(self):
+        return self.mglo.debug_message_counts()
 
     @property
     def line_width(self):
@@ -1760,6 +2771,14 @@ class Context:
     def max_anisotropy(self):
         return self.mglo.max_anisotropy
 
+    @property
+    def dsa(self):
+        return self.mglo.dsa
+
+    @dsa.setter
+    def dsa(self, value):
+        self.mglo.dsa = value
+
     @property
     def screen(self):
         return self._screen
@@ -1807,15 +2826,18 @@ class Context:
 
         return self._extensions
 
+    def has_extension(self, name):
+        return self.mglo.has_extension(name)
+
     @property
     def supports_labels(self):
         if self.version_code >= 430:
             return True
 
-        if "GL_KHR_debug" in self.extensions:
+        if self.has_extension("GL_KHR_debug"):
             return True
 
-        if "GL_EXT_debug_label" in self.extensions:
+        if self.has_extension("GL_EXT_debug_label"):
             return True
 
         return False
@@ -1825,20 +2847,17 @@ class Context:
         if self.version_code >= 430:
             return True
 
-        if "GL_KHR_debug" in self.extensions:
+        if self.has_extension("GL_KHR_debug"):
             return True
 
-        if "GL_EXT_debug_marker" in self.extensions:
+        if self.has_extension("GL_EXT_debug_marker"):
             return True
 
         return False
 
     @property
     def info(self):
-        if self._info is None:
-            self._info = self.mglo.info
-
-        return self._info
+        return self.mglo.info
 
     @property
     def includes(self):
@@ -1877,6 +2896,9 @@ class Context:
     def finish(self):
         self.mglo.finish()
 
+    def create_loader(self, require=None, **settings):
+        return ResourceLoader(self, require, **settings)
+
     def copy_buffer(
         self, dst: Buffer, src: Buffer, size=-1, read_offset=0, write_offset=0
     ):
@@ -1906,6 +2928,19 @@ class Context:
         res.extra = None
         return res
 
+    def buffers(self, data, dynamic=False):
+        result = []
+        for mglo, size, glo in self.mglo.buffers(data, dynamic):
+            res = Buffer.__new__(Buffer)
+            res.mglo = mglo
+            res._size = size
+            res._glo = glo
+            res._dynamic = dynamic
+            res.ctx = self
+            res.extra = None
+            result.append(res)
+        return result
+
     def external_buffer(self, glo, size):
         res = Buffer.__new__(Buffer)
         res.mglo, res._size, res._glo = self.mglo.external_buffer(glo, size)
@@ -2176,6 +3211,23 @@ class Context:
         res.extra = None
         return res
 
+    def query_pool(self, samples=False, any_samples=False, time=False, primitives=False):
+        return QueryPool(self, samples, any_samples, time, primitives)
+
+    def profiler(self, latency=3, debug_scopes=True):
+        return Profiler(self, latency, debug_scopes)
+
+    def tracer(self, capacity=65536, gpu=True, state=False):
+        return Tracer(self, capacity, gpu, state)
+
+    def capture(self, path):
+        return Capture(self, path)
+
+    def replay(self, data, loops=1, finish=False):
+        if loops < 1:
+            raise ValueError("loops must be at least 1")
+        return self.mglo.replay(data, loops, finish)
+
     def scope(
         self,
         framebuffer=None,
@@ -2364,6 +3416,8 @@ class Context:
         if _store.default_context is self:
             _store.default_context = None
         if not isinstance(self.mglo, InvalidObject):
+            if self in _startup_contexts:
+                _report_startup(self)
             self.mglo.release()
             self.mglo = InvalidObject()
 
@@ -2413,35 +3467,22 @@ class Context:
                 self.mglo.pop_debug_scope()
 
 
-def create_context(require=None, standalone=False, share=False, **settings):
-    if require is None:
-        require = 330
-
-    if not standalone and not share and not settings and _store.default_context is None:
-        ctx = get_context()
-
-        if ctx.version_code < require:
-            raise ValueError(
-                "Requested OpenGL version {0}, got version {1}".format(
-                    require, ctx.version_code
-                )
-            )
-
-        return ctx
-
-    mode = "standalone" if standalone else "detect"
-    if share:
-        mode = "share"
+def _new_context(require, mode, standalone, settings):
+    report_startup = "profile_startup" not in settings and _profile_startup_from_env()
+    if report_startup:
+        settings = dict(settings, profile_startup=True)
 
     ctx = Context.__new__(Context)
     ctx.mglo, ctx.version_code = mgl.create_context(
         glversion=require, mode=mode, **settings
     )
-    ctx._info = None
     ctx._extensions = None
     ctx.extra = None
     ctx._gc_mode = None
+    ctx._backend = settings.get("backend")
     ctx._objects = deque()
+    if report_startup:
+        _startup_contexts.add(ctx)
 
     if ctx.version_code < require:
         raise ValueError(
@@ -2460,6 +3501,30 @@ def create_context(require=None, standalone=False, share=False, **settings):
         ctx.fbo = ctx.detect_framebuffer()
         ctx.mglo.fbo = ctx.fbo.mglo
 
+    return ctx
+
+
+def create_context(require=None, standalone=False, share=False, **settings):
+    if require is None:
+        require = 330
+
+    if not standalone and not share and not settings and _store.default_context is None:
+        ctx = get_context()
+
+        if ctx.version_code < require:
+            raise ValueError(
+                "Requested OpenGL version {0}, got version {1}".format(
+                    require, ctx.version_code
+                )
+            )
+
+        return ctx
+
+    mode = "standalone" if standalone else "detect"
+    if share:
+        mode = "share"
+
+    ctx = _new_context(require, mode, standalone, settings)
     _store.default_context = ctx
     return ctx
 
@@ -2470,13 +3535,16 @@ def init_context(loader=None):
 
         loader = DefaultLoader()
 
+    report_startup = _profile_startup_from_env()
     ctx = Context.__new__(Context)
-    ctx.mglo, ctx.version_code = mgl.create_context(context=loader)
-    ctx._info = None
+    ctx.mglo, ctx.version_code = mgl.create_context(context=loader, profile_startup=report_startup)
     ctx._extensions = None
     ctx.extra = None
     ctx._gc_mode = None
+    ctx._backend = None
     ctx._objects = deque()
+    if report_startup:
+        _startup_contexts.add(ctx)
 
     ctx._screen = ctx.detect_framebuffer(0)
     ctx.fbo = ctx.detect_framebuffer()
@@ -2494,6 +3562,230 @@ def create_standalone_context(**kwargs):
     return create_context(standalone=True, **kwargs)
 
 
+def egl_devices(libegl=None):
+    return mgl.egl_devices(libegl)
+
+
+class RenderPool:
+    def __init__(self, workers, require=None, **settings):
+        if workers < 1:
+            raise ValueError("workers must be at least 1")
+
+        if require is None:
+            require = 330
+
+        self._require = require
+        self._settings = settings
+        self._start(workers, "moderngl-render")
+
+    def _start(self, workers, name):
+        self._cond = threading.Condition()
+        self._queues = [deque() for _ in range(workers)]
+        self._next_queue = 0
+        self._shutdown = False
+        self._threads = []
+
+        ready = []
+        for index in range(workers):
+            future = Future()
+            thread = threading.Thread(
+                target=self._worker,
+                args=(index, future),
+                name="%s-%d" % (name, index),
+                daemon=True,
+            )
+            thread.start()
+            self._threads.append(thread)
+            ready.append(future)
+
+        try:
+            for future in ready:
+                future.result()
+        except BaseException:
+            self.shutdown()
+            raise
+
+    @property
+    def workers(self):
+        return len(self._threads)
+
+    def submit(self, fn, *args, **kwargs):
+        future = Future()
+        with self._cond:
+            if self._shutdown:
+                raise RuntimeError("cannot submit to a RenderPool after shutdown")
+            self._queues[self._next_queue].append((future, fn, args, kwargs))
+            self._next_queue = (self._next_queue + 1) % len(self._queues)
+            self._cond.notify()
+        return future
+
+    def map(self, fn, *iterables):
+        futures = [self.submit(fn, *args) for args in zip(*iterables)]
+
+        def results():
+            for future in futures:
+                yield future.result()
+
+        return results()
+
+    def shutdown(self, wait=True, cancel_futures=False):
+        with self._cond:
+            self._shutdown = True
+            if cancel_futures:
+                for queue in self._queues:
+                    while queue:
+                        queue.popleft()[0].cancel()
+            self._cond.notify_all()
+
+        if wait:
+            for thread in self._threads:
+                thread.join()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        self.shutdown()
+
+    def _next_job(self, index):
+        with self._cond:
+            while True:
+                if self._queues[index]:
+                    return self._queues[index].popleft()
+
+                # Steal the most recently queued job of a busy worker
+                count = len(self._queues)
+                for i in range(1, count):
+                    queue = self._queues[(index + i) % count]
+                    if queue:
+                        return queue.pop()
+
+                if self._shutdown:
+                    return None
+
+                self._cond.wait()
+
+    def _open_context(self, index):
+        return _new_context(self._require, "standalone", True, self._settings)
+
+    def _complete(self, ctx, future, result):
+        future.set_result(result)
+
+    def _worker(self, index, ready):
+        try:
+            ctx = self._open_context(index)
+            ctx.gc_mode = "context_gc"
+        except BaseException as exc:
+            ready.set_exception(exc)
+            return
+
+        ready.set_result(None)
+
+        try:
+            while True:
+                job = self._next_job(index)
+                if job is None:
+                    break
+
+                future, fn, args, kwargs = job
+                if not future.set_running_or_notify_cancel():
+                    continue
+
+                try:
+                    result = fn(ctx, *args, **kwargs)
+                except BaseException as exc:
+                    future.set_exception(exc)
+                else:
+                    self._complete(ctx, future, result)
+
+                # Drop the job before collecting what it left behind
+                del future, fn, args, kwargs, job
+                result = None
+                ctx.gc()
+        finally:
+            ctx.release()
+
+
+_SHARED_TYPES = (
+    Buffer,
+    ComputeShader,
+    Program,
+    Renderbuffer,
+    Sampler,
+    Texture,
+    Texture3D,
+    TextureArray,
+    TextureCube,
+)
+
+
+def _context_objects(value):
+    if isinstance(value, (list, tuple)):
+        for item in value:
+            yield from _context_objects(item)
+    elif isinstance(value, dict):
+        for item in value.values():
+            yield from _context_objects(item)
+    elif isinstance(getattr(value, "ctx", None), Context):
+        yield value
+
+
+def _adopt(ctx, value):
+    for obj in _context_objects(value):
+        ctx.mglo.adopt(obj.mglo)
+        obj.ctx = ctx
+        if isinstance(obj, (Program, ComputeShader)):
+            for member in obj._members.values():
+                if hasattr(member, "ctx"):
+                    member.ctx = ctx.mglo
+
+
+class ResourceLoader(RenderPool):
+    def __init__(self, ctx, require=None, **settings):
+        if require is None:
+            require = 330
+
+        self.ctx = ctx
+        if ctx._backend is not None:
+            settings.setdefault("backend", ctx._backend)
+
+        # The new context shares with ctx, creating it makes it current on this thread
+        # Entering a context that is already current nests, ctx is current again after the exit
+        ctx.__enter__()
+        try:
+            self._shared = _new_context(require, "share", True, settings)
+        finally:
+            ctx.__exit__(None, None, None)
+
+        try:
+            self._start(1, "moderngl-loader")
+        except BaseException:
+            self._shared.release()
+            raise
+
+    def _open_context(self, index):
+        self._shared.__enter__()
+        return self._shared
+
+    def _complete(self, ctx, future, result):
+        for obj in _context_objects(result):
+            if not isinstance(obj, _SHARED_TYPES):
+                future.set_exception(
+                    TypeError("%s objects are not shared between contexts" % type(obj).__name__)
+                )
+                return
+
+        # set_result wakes the threads waiting in result() before the done-callbacks run,
+        # the uploads complete and the objects change owner first
+        try:
+            ctx.finish()
+            _adopt(self.ctx, result)
+        except BaseException as exc:
+            future.set_exception(exc)
+        else:
+            future.set_result(result)
+
+
 def detect_format(program, attributes, mode="mgl"):
     def fmt(attr):
         # Translate shape format into attribute format
@@ -2577,6 +3869,7 @@ def _resolve_module_constants(scope):
         "TRANSFORM_FEEDBACK_BARRIER_BIT",
         "ATOMIC_COUNTER_BARRIER_BIT",
         "SHADER_STORAGE_BARRIER_BIT",
+        "QUERY_BUFFER_BARRIER_BIT",
         "ALL_BARRIER_BITS",
     ]
 
@@ -0,0 +1,61 @@
+"""Replay a capture written by Context.capture and report the timings.
+
+    python -m moderngl.replay capture.bin --loops 100
+"""
+
+import argparse
+import statistics
+
+import moderngl
+
+
+def report(stats, top=20):
+    lines = []
+    frames = stats["frames"]
+    lines.append("setup: %.3f ms" % (stats["setup"] / 1e6))
+    if frames:
+        lines.append(
+            "frames: %d, mean %.3f ms, median %.3f ms, min %.3f ms, max %.3f ms"
+            % (
+                len(frames),
+                statistics.mean(frames) / 1e6,
+                statistics.median(frames) / 1e6,
+                min(frames) / 1e6,
+                max(frames) / 1e6,
+            )
+        )
+    lines.append("")
+    lines.append("%-36s %10s %12s %10s" % ("call", "count", "total ms", "mean us"))
+    calls = sorted(stats["calls"].items(), key=lambda item: item[1][1], reverse=True)
+    for name, (count, total) in calls[:top]:
+        lines.append("%-36s %10d %12.3f %10.3f" % (name, count, total / 1e6, total / count / 1e3))
+    return "\n".join(lines)
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(prog="python -m moderngl.replay", description=__doc__.splitlines()[0])
+    parser.add_argument("capture", help="the capture file")
+    parser.add_argument("--loops", type=int, default=1, help="replay the frames this many times")
+    parser.add_argument("--finish", action="store_true", help="wait for the GPU at the end of every frame")
+    parser.add_argument("--backend", default=None, help="the context backend, for example native-egl")
+    parser.add_argument("--top", type=int, default=20, help="the number of calls listed")
+    args = parser.parse_args(argv)
+
+    with open(args.capture, "rb") as f:
+        data = f.read()
+
+    settings = {}
+    if args.backend:
+        settings["backend"] = args.backend
+
+    ctx = moderngl.create_context(standalone=True, **settings)
+    try:
+        stats = ctx.replay(data, loops=args.loops, finish=args.finish)
+    finally:
+        ctx.release()
+
+    print(report(stats, args.top))
+
+
+if __name__ == "__main__":
+    main()
@@ -21,7 +21,7 @@ if target not in PLATFORMS:
 
 libraries = {
     "windows": [],
-    "linux": [],
+    "linux": ["dl"],
     "cygwin": [],
     "darwin": [],
     "android": [],
@@ -53,6 +53,7 @@ mgl = Extension(
     extra_compile_args=extra_compile_args[target],
     extra_link_args=extra_linker_args[target],
     sources=["src/moderngl.cpp"],
+    depends=["src/gl_methods.hpp", "src/gl_capture.hpp", "src/native_egl.hpp"],
 )
 
 short_description = "ModernGL: High performance rendering for Python 3"
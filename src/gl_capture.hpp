@@ -0,0 +1,1135 @@
+#pragma once
+
+// Records the calls made through a GLMethods table to a file and replays them.
+// The thunks are generated from the call list below, every argument has one spec character:
+//   -  plain value
+//   b t v f r s u p h  buffer, texture, vertex array, framebuffer, renderbuffer, sampler, query, program and shader names
+//   1 2 3 4 5 6 7  names returned by Gen* and Create* in the same order as above
+//   B T V F R S U  names passed to Delete* in the same order as above
+//   a  an array of shader names
+//   *  client data, the size depends on the call
+//   i  client pixels or an offset into the bound pixel unpack buffer
+//   x  client memory written by the call or an offset into the bound pixel pack buffer
+//   w  client memory written by the call
+//   o  an offset passed as a pointer
+//   c  a null terminated string
+//   q  the shader sources of glShaderSource, z  the lengths of glShaderSource
+//   l  the varyings of glTransformFeedbackVaryings
+// The return value spec is p or h for created names, m for mapped memory and - otherwise.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#define MGL_CAPTURE_CALLS(X) \
+    X(Enable, "-", "-") \
+    X(Disable, "-", "-") \
+    X(BlendFunc, "--", "-") \
+    X(BlendFuncSeparate, "----", "-") \
+    X(BlendEquationSeparate, "--", "-") \
+    X(ColorMask, "----", "-") \
+    X(ColorMaski, "-----", "-") \
+    X(CullFace, "-", "-") \
+    X(FrontFace, "-", "-") \
+    X(DepthFunc, "-", "-") \
+    X(DepthMask, "-", "-") \
+    X(DepthRange, "--", "-") \
+    X(PolygonMode, "--", "-") \
+    X(PolygonOffset, "--", "-") \
+    X(PointSize, "-", "-") \
+    X(LineWidth, "-", "-") \
+    X(ProvokingVertex, "-", "-") \
+    X(PrimitiveRestartIndex, "-", "-") \
+    X(PatchParameteri, "--", "-") \
+    X(Viewport, "----", "-") \
+    X(Scissor, "----", "-") \
+    X(ClearColor, "----", "-") \
+    X(ClearDepth, "-", "-") \
+    X(Clear, "-", "-") \
+    X(DrawBuffer, "-", "-") \
+    X(DrawBuffers, "-*", "-") \
+    X(ReadBuffer, "-", "-") \
+    X(PixelStorei, "--", "-") \
+    X(ActiveTexture, "-", "-") \
+    X(ClampColor, "--", "-") \
+    X(MemoryBarrier, "-", "-") \
+    X(MemoryBarrierByRegion, "-", "-") \
+    X(Finish, "", "-") \
+    X(Flush, "", "-") \
+    X(GenBuffers, "-1", "-") \
+    X(GenTextures, "-2", "-") \
+    X(GenVertexArrays, "-3", "-") \
+    X(GenFramebuffers, "-4", "-") \
+    X(GenRenderbuffers, "-5", "-") \
+    X(GenSamplers, "-6", "-") \
+    X(CreateBuffers, "-1", "-") \
+    X(CreateTextures, "--2", "-") \
+    X(CreateFramebuffers, "-4", "-") \
+    X(CreateRenderbuffers, "-5", "-") \
+    X(DeleteBuffers, "-B", "-") \
+    X(DeleteTextures, "-T", "-") \
+    X(DeleteVertexArrays, "-V", "-") \
+    X(DeleteFramebuffers, "-F", "-") \
+    X(DeleteRenderbuffers, "-R", "-") \
+    X(DeleteSamplers, "-S", "-") \
+    X(GenQueries, "-7", "-") \
+    X(DeleteQueries, "-U", "-") \
+    X(BeginQuery, "-u", "-") \
+    X(EndQuery, "-", "-") \
+    X(BeginConditionalRender, "u-", "-") \
+    X(EndConditionalRender, "", "-") \
+    X(CreateProgram, "", "p") \
+    X(CreateShader, "-", "h") \
+    X(DeleteProgram, "p", "-") \
+    X(DeleteShader, "h", "-") \
+    X(AttachShader, "ph", "-") \
+    X(ShaderSource, "h-qz", "-") \
+    X(CompileShader, "h", "-") \
+    X(ShaderBinary, "-a-*-", "-") \
+    X(SpecializeShader, "hc-**", "-") \
+    X(LinkProgram, "p", "-") \
+    X(UseProgram, "p", "-") \
+    X(BindFragDataLocation, "p-c", "-") \
+    X(TransformFeedbackVaryings, "p-l-", "-") \
+    X(UniformBlockBinding, "p--", "-") \
+    X(ShaderStorageBlockBinding, "p--", "-") \
+    X(BindBuffer, "-b", "-") \
+    X(BindBufferBase, "--b", "-") \
+    X(BindBufferRange, "--b--", "-") \
+    X(BindTexture, "-t", "-") \
+    X(BindSampler, "-s", "-") \
+    X(BindVertexArray, "v", "-") \
+    X(BindFramebuffer, "-f", "-") \
+    X(BindRenderbuffer, "-r", "-") \
+    X(BindImageTexture, "-t-----", "-") \
+    X(BufferData, "--*-", "-") \
+    X(BufferSubData, "---*", "-") \
+    X(NamedBufferData, "b-*-", "-") \
+    X(NamedBufferSubData, "b--*", "-") \
+    X(CopyBufferSubData, "-----", "-") \
+    X(CopyNamedBufferSubData, "bb---", "-") \
+    X(ClearNamedBufferSubData, "b-----*", "-") \
+    X(MapBufferRange, "----", "m") \
+    X(MapNamedBufferRange, "b---", "m") \
+    X(UnmapBuffer, "-", "-") \
+    X(UnmapNamedBuffer, "b", "-") \
+    X(TexImage2D, "--------i", "-") \
+    X(TexImage3D, "---------i", "-") \
+    X(TexSubImage2D, "--------i", "-") \
+    X(TexSubImage3D, "----------i", "-") \
+    X(TextureSubImage2D, "t-------i", "-") \
+    X(TextureSubImage3D, "t---------i", "-") \
+    X(TexImage2DMultisample, "------", "-") \
+    X(CopyTexImage2D, "--------", "-") \
+    X(CopyTextureSubImage2D, "t-------", "-") \
+    X(TexParameteri, "---", "-") \
+    X(TexParameterf, "---", "-") \
+    X(TextureParameteri, "t--", "-") \
+    X(TextureParameterf, "t--", "-") \
+    X(GenerateMipmap, "-", "-") \
+    X(GenerateTextureMipmap, "t", "-") \
+    X(SamplerParameteri, "s--", "-") \
+    X(SamplerParameterf, "s--", "-") \
+    X(SamplerParameterfv, "s-*", "-") \
+    X(FramebufferTexture2D, "---t-", "-") \
+    X(FramebufferTexture, "--t-", "-") \
+    X(FramebufferRenderbuffer, "---r", "-") \
+    X(NamedFramebufferTexture, "f-t-", "-") \
+    X(NamedFramebufferRenderbuffer, "f--r", "-") \
+    X(NamedFramebufferDrawBuffer, "f-", "-") \
+    X(NamedFramebufferDrawBuffers, "f-*", "-") \
+    X(NamedFramebufferReadBuffer, "f-", "-") \
+    X(FramebufferParameteri, "---", "-") \
+    X(RenderbufferStorage, "----", "-") \
+    X(RenderbufferStorageMultisample, "-----", "-") \
+    X(NamedRenderbufferStorage, "r---", "-") \
+    X(NamedRenderbufferStorageMultisample, "r----", "-") \
+    X(BlitFramebuffer, "----------", "-") \
+    X(BlitNamedFramebuffer, "ff----------", "-") \
+    X(EnableVertexAttribArray, "-", "-") \
+    X(VertexAttribPointer, "-----o", "-") \
+    X(VertexAttribIPointer, "----o", "-") \
+    X(VertexAttribLPointer, "----o", "-") \
+    X(VertexAttribDivisor, "--", "-") \
+    X(DrawArraysInstanced, "----", "-") \
+    X(DrawElementsInstanced, "---o-", "-") \
+    X(MultiDrawArraysIndirect, "-o--", "-") \
+    X(MultiDrawElementsIndirect, "--o--", "-") \
+    X(DrawMeshTasksNV, "--", "-") \
+    X(DrawMeshTasksIndirectNV, "-", "-") \
+    X(MultiDrawMeshTasksIndirectNV, "---", "-") \
+    X(MultiDrawMeshTasksIndirectCountNV, "----", "-") \
+    X(DispatchCompute, "---", "-") \
+    X(DispatchComputeIndirect, "-", "-") \
+    X(BeginTransformFeedback, "-", "-") \
+    X(EndTransformFeedback, "", "-") \
+    X(Uniform1fv, "--*", "-") \
+    X(Uniform2fv, "--*", "-") \
+    X(Uniform3fv, "--*", "-") \
+    X(Uniform4fv, "--*", "-") \
+    X(Uniform1iv, "--*", "-") \
+    X(Uniform2iv, "--*", "-") \
+    X(Uniform3iv, "--*", "-") \
+    X(Uniform4iv, "--*", "-") \
+    X(Uniform1uiv, "--*", "-") \
+    X(Uniform2uiv, "--*", "-") \
+    X(Uniform3uiv, "--*", "-") \
+    X(Uniform4uiv, "--*", "-") \
+    X(Uniform1dv, "--*", "-") \
+    X(Uniform2dv, "--*", "-") \
+    X(Uniform3dv, "--*", "-") \
+    X(Uniform4dv, "--*", "-") \
+    X(UniformMatrix2fv, "---*", "-") \
+    X(UniformMatrix2x3fv, "---*", "-") \
+    X(UniformMatrix2x4fv, "---*", "-") \
+    X(UniformMatrix3x2fv, "---*", "-") \
+    X(UniformMatrix3fv, "---*", "-") \
+    X(UniformMatrix3x4fv, "---*", "-") \
+    X(UniformMatrix4x2fv, "---*", "-") \
+    X(UniformMatrix4x3fv, "---*", "-") \
+    X(UniformMatrix4fv, "---*", "-") \
+    X(UniformMatrix2dv, "---*", "-") \
+    X(UniformMatrix2x3dv, "---*", "-") \
+    X(UniformMatrix2x4dv, "---*", "-") \
+    X(UniformMatrix3x2dv, "---*", "-") \
+    X(UniformMatrix3dv, "---*", "-") \
+    X(UniformMatrix3x4dv, "---*", "-") \
+    X(UniformMatrix4x2dv, "---*", "-") \
+    X(UniformMatrix4x3dv, "---*", "-") \
+    X(UniformMatrix4dv, "---*", "-") \
+    X(ReadPixels, "------x", "-") \
+    X(GetTexImage, "----x", "-") \
+    X(GetTextureImage, "t----x", "-") \
+    X(GetNamedBufferSubData, "b--w", "-")
+
+enum {
+    #define MGL_CAPTURE_ID(name, args, ret) MGL_CAPTURE_ ## name,
+    MGL_CAPTURE_CALLS(MGL_CAPTURE_ID)
+    #undef MGL_CAPTURE_ID
+    MGL_CAPTURE_NUM_CALLS,
+    MGL_CAPTURE_FRAME_BEGIN = MGL_CAPTURE_NUM_CALLS,
+    MGL_CAPTURE_FRAME_END,
+};
+
+#define MGL_CAPTURE_MAX_ARGS 12
+#define MGL_CAPTURE_MAGIC "MGLCAPT"
+#define MGL_CAPTURE_VERSION 1
+
+static const char * capture_call_names[] = {
+    #define MGL_CAPTURE_NAME(name, args, ret) "gl" # name,
+    MGL_CAPTURE_CALLS(MGL_CAPTURE_NAME)
+    #undef MGL_CAPTURE_NAME
+};
+
+static const char * capture_arg_specs[] = {
+    #define MGL_CAPTURE_SPEC(name, args, ret) args,
+    MGL_CAPTURE_CALLS(MGL_CAPTURE_SPEC)
+    #undef MGL_CAPTURE_SPEC
+};
+
+static const char capture_ret_specs[] = {
+    #define MGL_CAPTURE_RET(name, args, ret) ret[0],
+    MGL_CAPTURE_CALLS(MGL_CAPTURE_RET)
+    #undef MGL_CAPTURE_RET
+};
+
+static int capture_name_kind(char spec) {
+    const char * kinds = "btvfrsuph";
+    const char * ptr = strchr(kinds, spec);
+    return spec && ptr ? (int)(ptr - kinds) : -1;
+}
+
+static int capture_pixel_size(uint64_t format, uint64_t type) {
+    int components = 4;
+    switch (format) {
+        case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX: components = 1; break;
+        case GL_RG: case GL_RG_INTEGER: components = 2; break;
+        case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: components = 3; break;
+        case GL_DEPTH_STENCIL: return type == GL_FLOAT_32_UNSIGNED_INT_24_8_REV ? 8 : 4;
+    }
+    switch (type) {
+        case GL_UNSIGNED_BYTE: case GL_BYTE: return components;
+        case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: return components * 2;
+        case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT: return components * 4;
+        case GL_UNSIGNED_BYTE_3_3_2: case GL_UNSIGNED_BYTE_2_3_3_REV: return 1;
+        case GL_UNSIGNED_SHORT_5_6_5: case GL_UNSIGNED_SHORT_4_4_4_4: case GL_UNSIGNED_SHORT_5_5_5_1: return 2;
+    }
+    return 4;
+}
+
+static uint64_t capture_image_size(uint64_t width, uint64_t height, uint64_t depth, uint64_t format, uint64_t type, int alignment, int row_length) {
+    if (!width || !height || !depth) {
+        return 0;
+    }
+    uint64_t pixel_size = capture_pixel_size(format, type);
+    uint64_t row_size = (row_length ? row_length : width) * pixel_size;
+    uint64_t row_stride = (row_size + alignment - 1) / alignment * alignment;
+    return (height * depth - 1) * row_stride + width * pixel_size;
+}
+
+// The arguments are stored as 64 bit values, floats keep their bit pattern
+
+template <typename T>
+static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, uint64_t>::type capture_value(T value) {
+    return std::is_signed<T>::value ? (uint64_t)(int64_t)value : (uint64_t)value;
+}
+
+static uint64_t capture_value(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static uint64_t capture_value(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+template <typename T>
+static uint64_t capture_value(T * value) {
+    return (uint64_t)(uintptr_t)value;
+}
+
+template <typename T>
+static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, T>::type replay_value(uint64_t value, T *) {
+    return (T)value;
+}
+
+static float replay_value(uint64_t value, float *) {
+    uint32_t bits = (uint32_t)value;
+    float res;
+    memcpy(&res, &bits, sizeof(res));
+    return res;
+}
+
+static double replay_value(uint64_t value, double *) {
+    double res;
+    memcpy(&res, &value, sizeof(res));
+    return res;
+}
+
+template <typename T>
+static T * replay_value(uint64_t value, T ** ) {
+    return (T *)(uintptr_t)value;
+}
+
+struct MGLCapture {
+    FILE * file;
+    void * real[MGL_CAPTURE_NUM_CALLS];
+    int unpack_alignment;
+    int pack_alignment;
+    int pack_row_length;
+    GLuint unpack_buffer;
+    GLuint pack_buffer;
+    void * mapped;
+    uint64_t mapped_size;
+    bool mapped_write;
+    bool write_error;
+    int slot;
+    PFNGLGETTEXLEVELPARAMETERIVPROC GetTexLevelParameteriv;
+};
+
+// The thunks have no user data, every capturing context owns a slot with its own thunks
+#define MGL_CAPTURE_SLOTS 4
+
+static MGLCapture * capture_slots[MGL_CAPTURE_SLOTS];
+static std::mutex capture_slots_lock;
+
+static bool acquire_capture_slot(MGLCapture * capture) {
+    std::lock_guard<std::mutex> guard(capture_slots_lock);
+    for (int i = 0; i < MGL_CAPTURE_SLOTS; ++i) {
+        if (!capture_slots[i]) {
+            capture_slots[i] = capture;
+            capture->slot = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void release_capture_slot(MGLCapture * capture) {
+    std::lock_guard<std::mutex> guard(capture_slots_lock);
+    capture_slots[capture->slot] = NULL;
+}
+
+static void capture_write(MGLCapture * capture, const void * data, size_t size) {
+    // The thunks cannot raise, a short write is reported when the capture stops
+    if (fwrite(data, 1, size, capture->file) != size) {
+        capture->write_error = true;
+    }
+}
+
+static void capture_varint(MGLCapture * capture, uint64_t value) {
+    unsigned char buffer[10];
+    int size = 0;
+    while (value > 0x7F) {
+        buffer[size++] = (unsigned char)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    buffer[size++] = (unsigned char)value;
+    capture_write(capture, buffer, size);
+}
+
+static void capture_signed(MGLCapture * capture, uint64_t value) {
+    int64_t signed_value = (int64_t)value;
+    capture_varint(capture, ((uint64_t)signed_value << 1) ^ (uint64_t)(signed_value >> 63));
+}
+
+static void capture_blob(MGLCapture * capture, const void * data, uint64_t size) {
+    // Zero marks a pointer kept as a value, the blob size is stored plus one
+    if (!data) {
+        capture_varint(capture, 0);
+        return;
+    }
+    capture_varint(capture, size + 1);
+    capture_write(capture, data, (size_t)size);
+}
+
+static uint64_t capture_data_size(int id, const uint64_t * values, int unpack_alignment) {
+    switch (id) {
+        case MGL_CAPTURE_DrawBuffers: return values[0] * sizeof(GLenum);
+        case MGL_CAPTURE_NamedFramebufferDrawBuffers: return values[1] * sizeof(GLenum);
+        case MGL_CAPTURE_ShaderBinary: return values[4];
+        case MGL_CAPTURE_SpecializeShader: return values[2] * sizeof(GLuint);
+        case MGL_CAPTURE_BufferData: return values[1];
+        case MGL_CAPTURE_BufferSubData: return values[2];
+        case MGL_CAPTURE_NamedBufferData: return values[1];
+        case MGL_CAPTURE_NamedBufferSubData: return values[2];
+        case MGL_CAPTURE_ClearNamedBufferSubData: return capture_pixel_size(values[4], values[5]);
+        case MGL_CAPTURE_SamplerParameterfv: return values[1] == GL_TEXTURE_BORDER_COLOR ? 4 * sizeof(GLfloat) : sizeof(GLfloat);
+        case MGL_CAPTURE_TexImage2D: return capture_image_size(values[3], values[4], 1, values[6], values[7], unpack_alignment, 0);
+        case MGL_CAPTURE_TexImage3D: return capture_image_size(values[3], values[4], values[5], values[7], values[8], unpack_alignment, 0);
+        case MGL_CAPTURE_TexSubImage2D: return capture_image_size(values[4], values[5], 1, values[6], values[7], unpack_alignment, 0);
+        case MGL_CAPTURE_TexSubImage3D: return capture_image_size(values[5], values[6], values[7], values[8], values[9], unpack_alignment, 0);
+        case MGL_CAPTURE_TextureSubImage2D: return capture_image_size(values[4], values[5], 1, values[6], values[7], unpack_alignment, 0);
+        case MGL_CAPTURE_TextureSubImage3D: return capture_image_size(values[5], values[6], values[7], values[8], values[9], unpack_alignment, 0);
+    }
+    if (id >= MGL_CAPTURE_Uniform1fv && id <= MGL_CAPTURE_Uniform4dv) {
+        int index = id - MGL_CAPTURE_Uniform1fv;
+        int scalar = index < 12 ? 4 : 8;
+        return values[1] * (index % 4 + 1) * scalar;
+    }
+    if (id >= MGL_CAPTURE_UniformMatrix2fv && id <= MGL_CAPTURE_UniformMatrix4dv) {
+        static const int sizes[] = {4, 6, 8, 6, 9, 12, 8, 12, 16};
+        int index = id - MGL_CAPTURE_UniformMatrix2fv;
+        return values[1] * sizes[index % 9] * (index < 9 ? 4 : 8);
+    }
+    return 0;
+}
+
+static uint64_t capture_output_size(int id, const uint64_t * values, int pack_alignment, int pack_row_length, PFNGLGETTEXLEVELPARAMETERIVPROC GetTexLevelParameteriv) {
+    switch (id) {
+        case MGL_CAPTURE_ReadPixels:
+            return capture_image_size(values[2], values[3], 1, values[4], values[5], pack_alignment, pack_row_length);
+        case MGL_CAPTURE_GetTexImage: {
+            GLint width = 0, height = 0, depth = 0;
+            GetTexLevelParameteriv((GLenum)values[0], (GLint)values[1], GL_TEXTURE_WIDTH, &width);
+            GetTexLevelParameteriv((GLenum)values[0], (GLint)values[1], GL_TEXTURE_HEIGHT, &height);
+            GetTexLevelParameteriv((GLenum)values[0], (GLint)values[1], GL_TEXTURE_DEPTH, &depth);
+            return capture_image_size(width, height, depth, values[2], values[3], pack_alignment, pack_row_length);
+        }
+        case MGL_CAPTURE_GetTextureImage: return values[4];
+        case MGL_CAPTURE_GetNamedBufferSubData: return values[2];
+    }
+    return 0;
+}
+
+static void capture_names(MGLCapture * capture, uint64_t count, const GLuint * names) {
+    capture_varint(capture, count);
+    for (uint64_t i = 0; i < count; ++i) {
+        capture_varint(capture, names[i]);
+    }
+}
+
+static void capture_record(MGLCapture * capture, int id, const uint64_t * values, int num_args, uint64_t result) {
+    const char * spec = capture_arg_specs[id];
+
+    capture_varint(capture, id);
+    for (int i = 0; i < num_args; ++i) {
+        // Pointers to client memory are replaced by the data that follows the arguments
+        bool client = strchr("1234567BTVFRSUa*xwclqz", spec[i]) != NULL;
+        if (spec[i] == 'i' && !capture->unpack_buffer) {
+            client = true;
+        }
+        if (spec[i] == 'x' && capture->pack_buffer) {
+            client = false;
+        }
+        capture_signed(capture, client ? 0 : values[i]);
+    }
+
+    for (int i = 0; i < num_args; ++i) {
+        const void * ptr = (const void *)(uintptr_t)values[i];
+        switch (spec[i]) {
+            case '*':
+                capture_blob(capture, ptr, capture_data_size(id, values, capture->unpack_alignment));
+                break;
+            case 'i':
+                capture_blob(capture, capture->unpack_buffer ? NULL : ptr, capture_data_size(id, values, capture->unpack_alignment));
+                break;
+            case 'x':
+            case 'w':
+                // Only the size is stored, the replay reads into scratch memory
+                if (spec[i] == 'x' && capture->pack_buffer) {
+                    capture_varint(capture, 0);
+                } else {
+                    capture_varint(capture, capture_output_size(id, values, capture->pack_alignment, capture->pack_row_length, capture->GetTexLevelParameteriv) + 1);
+                }
+                break;
+            case 'c':
+                capture_blob(capture, ptr, ptr ? strlen((const char *)ptr) + 1 : 0);
+                break;
+            case 'q': {
+                const GLchar * const * strings = (const GLchar * const *)ptr;
+                const GLint * lengths = (const GLint *)(uintptr_t)values[3];
+                std::string source;
+                for (uint64_t k = 0; k < values[1]; ++k) {
+                    if (lengths && lengths[k] >= 0) {
+                        source.append(strings[k], lengths[k]);
+                    } else {
+                        source.append(strings[k]);
+                    }
+                }
+                capture_blob(capture, source.c_str(), source.size() + 1);
+                break;
+            }
+            case 'l': {
+                const GLchar * const * strings = (const GLchar * const *)ptr;
+                std::string varyings;
+                for (uint64_t k = 0; k < values[1]; ++k) {
+                    varyings.append(strings[k]);
+                    varyings.push_back(0);
+                }
+                capture_blob(capture, varyings.data(), varyings.size());
+                break;
+            }
+            case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+            case 'B': case 'T': case 'V': case 'F': case 'R': case 'S': case 'U':
+            case 'a':
+                capture_names(capture, values[i - 1], (const GLuint *)ptr);
+                break;
+        }
+    }
+
+    if (capture_ret_specs[id] == 'p' || capture_ret_specs[id] == 'h') {
+        capture_varint(capture, result);
+    }
+
+    if (id == MGL_CAPTURE_UnmapBuffer || id == MGL_CAPTURE_UnmapNamedBuffer) {
+        capture_blob(capture, capture->mapped_write ? capture->mapped : NULL, capture->mapped_size);
+    }
+}
+
+static void capture_track_state(MGLCapture * capture, int id, const uint64_t * values, uint64_t result) {
+    // The size of pixel transfers depends on the pixel store state and the pixel buffer bindings
+    switch (id) {
+        case MGL_CAPTURE_PixelStorei:
+            if (values[0] == GL_UNPACK_ALIGNMENT) {
+                capture->unpack_alignment = (int)values[1];
+            } else if (values[0] == GL_PACK_ALIGNMENT) {
+                capture->pack_alignment = (int)values[1];
+            } else if (values[0] == GL_PACK_ROW_LENGTH) {
+                capture->pack_row_length = (int)values[1];
+            }
+            break;
+        case MGL_CAPTURE_BindBuffer:
+            if (values[0] == GL_PIXEL_UNPACK_BUFFER) {
+                capture->unpack_buffer = (GLuint)values[1];
+            } else if (values[0] == GL_PIXEL_PACK_BUFFER) {
+                capture->pack_buffer = (GLuint)values[1];
+            }
+            break;
+        case MGL_CAPTURE_MapBufferRange:
+        case MGL_CAPTURE_MapNamedBufferRange:
+            capture->mapped = (void *)(uintptr_t)result;
+            capture->mapped_size = values[2];
+            capture->mapped_write = (values[3] & GL_MAP_WRITE_BIT) != 0;
+            break;
+    }
+}
+
+template <int id, int slot, typename T>
+struct CaptureThunk;
+
+template <int id, int slot, typename R, typename... A>
+struct CaptureThunk<id, slot, R (APIENTRYP)(A...)> {
+    static R APIENTRY call(A... args) {
+        MGLCapture * capture = capture_slots[slot];
+        uint64_t values[sizeof...(A) + 1] = {capture_value(args)...};
+        if (id == MGL_CAPTURE_UnmapBuffer || id == MGL_CAPTURE_UnmapNamedBuffer) {
+            capture_record(capture, id, values, sizeof...(A), 0);
+        }
+        R result = ((R (APIENTRYP)(A...))capture->real[id])(args...);
+        capture_track_state(capture, id, values, capture_value(result));
+        if (id != MGL_CAPTURE_UnmapBuffer && id != MGL_CAPTURE_UnmapNamedBuffer) {
+            capture_record(capture, id, values, sizeof...(A), capture_value(result));
+        }
+        return result;
+    }
+};
+
+template <int id, int slot, typename... A>
+struct CaptureThunk<id, slot, void (APIENTRYP)(A...)> {
+    static void APIENTRY call(A... args) {
+        MGLCapture * capture = capture_slots[slot];
+        uint64_t values[sizeof...(A) + 1] = {capture_value(args)...};
+        ((void (APIENTRYP)(A...))capture->real[id])(args...);
+        capture_track_state(capture, id, values, 0);
+        capture_record(capture, id, values, sizeof...(A), 0);
+    }
+};
+
+template <typename T>
+struct CaptureArity;
+
+template <typename R, typename... A>
+struct CaptureArity<R (APIENTRYP)(A...)> {
+    static const int value = sizeof...(A);
+};
+
+template <int slot>
+static void install_capture_slot(GLMethods & gl, MGLCapture * capture) {
+    #define MGL_CAPTURE_INSTALL(name, args, ret) \
+        static_assert(CaptureArity<decltype(gl.name)>::value == sizeof(args) - 1, "capture spec of gl" # name); \
+        capture->real[MGL_CAPTURE_ ## name] = (void *)gl.name; \
+        if (gl.name) { \
+            gl.name = CaptureThunk<MGL_CAPTURE_ ## name, slot, decltype(gl.name)>::call; \
+        }
+    MGL_CAPTURE_CALLS(MGL_CAPTURE_INSTALL)
+    #undef MGL_CAPTURE_INSTALL
+}
+
+static void install_capture(GLMethods & gl, MGLCapture * capture) {
+    static void (* const installers[MGL_CAPTURE_SLOTS])(GLMethods & gl, MGLCapture * capture) = {
+        install_capture_slot<0>,
+        install_capture_slot<1>,
+        install_capture_slot<2>,
+        install_capture_slot<3>,
+    };
+
+    // The functions resolved on first use are resolved now, otherwise they would bypass the thunks
+    load_gl_mesh_shader_methods(gl);
+    installers[capture->slot](gl, capture);
+    capture->GetTexLevelParameteriv = gl.GetTexLevelParameteriv;
+}
+
+static void uninstall_capture(GLMethods & gl, MGLCapture * capture) {
+    #define MGL_CAPTURE_UNINSTALL(name, args, ret) \
+        gl.name = (decltype(gl.name))capture->real[MGL_CAPTURE_ ## name];
+    MGL_CAPTURE_CALLS(MGL_CAPTURE_UNINSTALL)
+    #undef MGL_CAPTURE_UNINSTALL
+}
+
+static void capture_header(MGLCapture * capture, int version_code) {
+    capture_write(capture, MGL_CAPTURE_MAGIC, 8);
+    capture_varint(capture, MGL_CAPTURE_VERSION);
+    capture_varint(capture, version_code);
+    capture_varint(capture, MGL_CAPTURE_NUM_CALLS);
+    for (int i = 0; i < MGL_CAPTURE_NUM_CALLS; ++i) {
+        capture_blob(capture, capture_call_names[i], strlen(capture_call_names[i]));
+    }
+}
+
+// Replay
+
+template <typename T>
+struct ReplayInvoker;
+
+template <typename R, typename... A>
+struct ReplayInvoker<R (APIENTRYP)(A...)> {
+    template <size_t... I>
+    static uint64_t call(void * proc, const uint64_t * values, std::index_sequence<I...>) {
+        return capture_value(((R (APIENTRYP)(A...))proc)(replay_value(values[I], (A *)NULL)...));
+    }
+
+    static uint64_t invoke(void * proc, const uint64_t * values) {
+        return call(proc, values, std::index_sequence_for<A...>());
+    }
+};
+
+template <typename... A>
+struct ReplayInvoker<void (APIENTRYP)(A...)> {
+    template <size_t... I>
+    static uint64_t call(void * proc, const uint64_t * values, std::index_sequence<I...>) {
+        ((void (APIENTRYP)(A...))proc)(replay_value(values[I], (A *)NULL)...);
+        return 0;
+    }
+
+    static uint64_t invoke(void * proc, const uint64_t * values) {
+        return call(proc, values, std::index_sequence_for<A...>());
+    }
+};
+
+typedef uint64_t (* ReplayInvoke)(void * proc, const uint64_t * values);
+
+static const ReplayInvoke replay_invokers[] = {
+    #define MGL_CAPTURE_INVOKER(name, args, ret) ReplayInvoker<decltype(GLMethods::name)>::invoke,
+    MGL_CAPTURE_CALLS(MGL_CAPTURE_INVOKER)
+    #undef MGL_CAPTURE_INVOKER
+};
+
+struct ReplayCall {
+    int id;
+    uint64_t values[MGL_CAPTURE_MAX_ARGS];
+    // Offsets into the blobs of the call for pointer arguments, names are stored separately
+    const char * data[MGL_CAPTURE_MAX_ARGS];
+    uint64_t size[MGL_CAPTURE_MAX_ARGS];
+    size_t names;
+    size_t num_names;
+    uint64_t result;
+};
+
+struct ReplayStats {
+    int version_code;
+    int num_frames;
+    long long setup;
+    std::vector<long long> frames;
+    long long calls[MGL_CAPTURE_NUM_CALLS];
+    long long time[MGL_CAPTURE_NUM_CALLS];
+};
+
+struct ReplayReader {
+    const unsigned char * ptr;
+    const unsigned char * end;
+    bool error;
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        int shift = 0;
+        while (ptr < end && shift < 64) {
+            unsigned char byte = *ptr++;
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (byte < 0x80) {
+                return value;
+            }
+            shift += 7;
+        }
+        error = true;
+        return 0;
+    }
+
+    uint64_t signed_varint() {
+        uint64_t value = varint();
+        return (value >> 1) ^ (uint64_t)(-(int64_t)(value & 1));
+    }
+
+    const char * blob(uint64_t * size) {
+        uint64_t stored = varint();
+        if (!stored) {
+            *size = 0;
+            return NULL;
+        }
+        *size = stored - 1;
+        if ((uint64_t)(end - ptr) < *size) {
+            error = true;
+            return NULL;
+        }
+        const char * res = (const char *)ptr;
+        ptr += *size;
+        return res;
+    }
+
+    uint64_t remaining() {
+        return (uint64_t)(end - ptr);
+    }
+};
+
+static bool replay_null_data(int id) {
+    // The calls that accept a null pointer for their data
+    switch (id) {
+        case MGL_CAPTURE_BufferData:
+        case MGL_CAPTURE_NamedBufferData:
+        case MGL_CAPTURE_ClearNamedBufferSubData:
+        case MGL_CAPTURE_TexImage2D:
+        case MGL_CAPTURE_TexImage3D:
+            return true;
+    }
+    return false;
+}
+
+static bool replay_terminated(const char * data, uint64_t size) {
+    return data && size && !data[size - 1];
+}
+
+static const char * replay_check(const ReplayCall & call, const char * spec, int num_args, uint64_t mapped_size) {
+    // The sizes that do not depend on the pixel store state are checked before replaying
+    for (int i = 0; i < num_args; ++i) {
+        switch (spec[i]) {
+            case '*': {
+                uint64_t expected = capture_data_size(call.id, call.values, 1);
+                if (call.data[i] ? call.size[i] != expected : expected && !replay_null_data(call.id)) {
+                    return "the capture data does not match the call";
+                }
+                break;
+            }
+            case 'w':
+                if (!call.data[i] || call.size[i] != capture_output_size(call.id, call.values, 1, 0, NULL)) {
+                    return "the capture data does not match the call";
+                }
+                break;
+            case 'c': case 'q':
+                if (!replay_terminated(call.data[i], call.size[i])) {
+                    return "the capture has a string that is not terminated";
+                }
+                break;
+            case 'l': {
+                uint64_t count = 0;
+                for (uint64_t k = 0; k < call.size[i]; ++k) {
+                    count += !call.data[i][k];
+                }
+                if (count != call.values[i - 1] || (call.size[i] && !replay_terminated(call.data[i], call.size[i]))) {
+                    return "the capture has a string that is not terminated";
+                }
+                break;
+            }
+            case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+            case 'B': case 'T': case 'V': case 'F': case 'R': case 'S': case 'U':
+            case 'a':
+                if (call.num_names != call.values[i - 1]) {
+                    return "the capture names do not match the call";
+                }
+                break;
+        }
+    }
+    if ((call.id == MGL_CAPTURE_UnmapBuffer || call.id == MGL_CAPTURE_UnmapNamedBuffer) && call.data[0] && call.size[0] != mapped_size) {
+        return "the capture data does not match the mapped range";
+    }
+    return NULL;
+}
+
+static const char * replay_parse(const char * data, size_t size, std::vector<ReplayCall> & calls, std::vector<GLuint> & names, int * version_code) {
+    ReplayReader reader = {(const unsigned char *)data, (const unsigned char *)data + size, false};
+    if (size < 8 || memcmp(data, MGL_CAPTURE_MAGIC, 8)) {
+        return "not a capture file";
+    }
+    reader.ptr += 8;
+    if (reader.varint() != MGL_CAPTURE_VERSION) {
+        return "unsupported capture version";
+    }
+    *version_code = (int)reader.varint();
+
+    // The calls are matched by name so captures survive changes to the call list
+    uint64_t num_ids = reader.varint();
+    if (num_ids > reader.remaining()) {
+        return "the capture file is truncated";
+    }
+    std::vector<int> ids((size_t)num_ids);
+    for (size_t i = 0; i < ids.size() && !reader.error; ++i) {
+        uint64_t length = 0;
+        const char * name = reader.blob(&length);
+        ids[i] = -1;
+        for (int k = 0; k < MGL_CAPTURE_NUM_CALLS; ++k) {
+            if (name && strlen(capture_call_names[k]) == length && !memcmp(capture_call_names[k], name, (size_t)length)) {
+                ids[i] = k;
+            }
+        }
+    }
+
+    uint64_t mapped_size = 0;
+    while (reader.ptr < reader.end && !reader.error) {
+        uint64_t file_id = reader.varint();
+        ReplayCall call = {};
+        if (file_id == ids.size()) {
+            call.id = MGL_CAPTURE_FRAME_BEGIN;
+            calls.push_back(call);
+            continue;
+        }
+        if (file_id == ids.size() + 1) {
+            call.id = MGL_CAPTURE_FRAME_END;
+            calls.push_back(call);
+            continue;
+        }
+        if (file_id > ids.size() || ids[(size_t)file_id] < 0) {
+            return "the capture uses an unknown call";
+        }
+
+        call.id = ids[(size_t)file_id];
+        const char * spec = capture_arg_specs[call.id];
+        int num_args = (int)strlen(spec);
+        for (int i = 0; i < num_args; ++i) {
+            call.values[i] = reader.signed_varint();
+        }
+
+        call.names = names.size();
+        for (int i = 0; i < num_args; ++i) {
+            if (strchr("*iclq", spec[i])) {
+                call.data[i] = reader.blob(&call.size[i]);
+            } else if (spec[i] == 'x' || spec[i] == 'w') {
+                uint64_t stored = reader.varint();
+                call.size[i] = stored ? stored - 1 : 0;
+                call.data[i] = stored ? "" : NULL;
+            } else if (strchr("1234567BTVFRSUa", spec[i])) {
+                uint64_t count = reader.varint();
+                if (count > reader.remaining()) {
+                    return "the capture file is truncated";
+                }
+                for (uint64_t k = 0; k < count && !reader.error; ++k) {
+                    names.push_back((GLuint)reader.varint());
+                }
+                call.num_names = (size_t)count;
+            }
+        }
+
+        if (capture_ret_specs[call.id] == 'p' || capture_ret_specs[call.id] == 'h') {
+            call.result = reader.varint();
+        }
+        if (call.id == MGL_CAPTURE_UnmapBuffer || call.id == MGL_CAPTURE_UnmapNamedBuffer) {
+            call.data[0] = reader.blob(&call.size[0]);
+        }
+        if (reader.error) {
+            break;
+        }
+
+        const char * error = replay_check(call, spec, num_args, mapped_size);
+        if (error) {
+            return error;
+        }
+        if (call.id == MGL_CAPTURE_MapBufferRange || call.id == MGL_CAPTURE_MapNamedBufferRange) {
+            mapped_size = call.values[2];
+        }
+        calls.push_back(call);
+    }
+
+    if (reader.error) {
+        return "the capture file is truncated";
+    }
+    return NULL;
+}
+
+struct Replayer {
+    const GLMethods & gl;
+    void * procs[MGL_CAPTURE_NUM_CALLS];
+    std::unordered_map<GLuint, GLuint> maps[9];
+    std::vector<GLuint> & names;
+    std::vector<char> scratch;
+    std::vector<GLuint> temp_names;
+    void * mapped;
+
+    Replayer(const GLMethods & gl, std::vector<GLuint> & names) : gl(gl), names(names), mapped(NULL) {
+        #define MGL_CAPTURE_PROC(name, args, ret) procs[MGL_CAPTURE_ ## name] = (void *)gl.name;
+        MGL_CAPTURE_CALLS(MGL_CAPTURE_PROC)
+        #undef MGL_CAPTURE_PROC
+    }
+
+    GLuint remap(int kind, uint64_t name) {
+        // Names created before the capture started are used as they are
+        std::unordered_map<GLuint, GLuint>::iterator it = maps[kind].find((GLuint)name);
+        return it != maps[kind].end() ? it->second : (GLuint)name;
+    }
+
+    GLint integer(GLenum pname) {
+        GLint value = 0;
+        gl.GetIntegerv(pname, &value);
+        return value;
+    }
+
+    const char * prepare(ReplayCall & call, uint64_t * values, const GLchar ** strings, std::vector<const GLchar *> & varyings) {
+        const char * spec = capture_arg_specs[call.id];
+        int num_args = (int)strlen(spec);
+        size_t name_index = call.names;
+        memcpy(values, call.values, sizeof(call.values));
+
+        for (int i = 0; i < num_args; ++i) {
+            int kind = capture_name_kind(spec[i]);
+            if (kind >= 0) {
+                values[i] = remap(kind, values[i]);
+                continue;
+            }
+            switch (spec[i]) {
+                case '*': case 'c':
+                    values[i] = (uint64_t)(uintptr_t)call.data[i];
+                    break;
+                case 'i': {
+                    // The pixels are read with the pixel store state of the replay
+                    bool unpack_buffer = integer(GL_PIXEL_UNPACK_BUFFER_BINDING) != 0;
+                    uint64_t expected = unpack_buffer ? 0 : capture_data_size(call.id, values, integer(GL_UNPACK_ALIGNMENT));
+                    if (call.data[i] && call.size[i] < expected) {
+                        return "the capture pixels do not match the call";
+                    }
+                    if (!call.data[i] && !unpack_buffer && (values[i] || (expected && !replay_null_data(call.id)))) {
+                        return "the capture reads pixels from a pixel buffer that is not bound";
+                    }
+                    if (call.data[i]) {
+                        values[i] = (uint64_t)(uintptr_t)call.data[i];
+                    }
+                    break;
+                }
+                case 'x': case 'w':
+                    if (call.data[i]) {
+                        uint64_t size = spec[i] == 'w' ? call.size[i] : capture_output_size(call.id, values, integer(GL_PACK_ALIGNMENT), integer(GL_PACK_ROW_LENGTH), gl.GetTexLevelParameteriv);
+                        if (scratch.size() < size) {
+                            scratch.resize((size_t)size);
+                        }
+                        values[i] = (uint64_t)(uintptr_t)scratch.data();
+                    } else if (!integer(GL_PIXEL_PACK_BUFFER_BINDING)) {
+                        return "the capture writes pixels to a pixel buffer that is not bound";
+                    }
+                    break;
+                case 'q':
+                    *strings = call.data[i];
+                    values[i - 1] = 1;
+                    values[i] = (uint64_t)(uintptr_t)strings;
+                    break;
+                case 'z':
+                    values[i] = 0;
+                    break;
+                case 'l':
+                    varyings.clear();
+                    for (uint64_t k = 0, offset = 0; k < values[i - 1] && offset < call.size[i]; ++k) {
+                        varyings.push_back(call.data[i] + offset);
+                        offset += strlen(call.data[i] + offset) + 1;
+                    }
+                    values[i] = (uint64_t)(uintptr_t)varyings.data();
+                    break;
+                case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+                    temp_names.resize(call.num_names + 1);
+                    values[i] = (uint64_t)(uintptr_t)temp_names.data();
+                    break;
+                case 'B': case 'T': case 'V': case 'F': case 'R': case 'S': case 'U': {
+                    int deleted = (int)(strchr("BTVFRSU", spec[i]) - "BTVFRSU");
+                    temp_names.resize(call.num_names + 1);
+                    for (size_t k = 0; k < call.num_names; ++k) {
+                        temp_names[k] = remap(deleted, names[name_index + k]);
+                        maps[deleted].erase(names[name_index + k]);
+                    }
+                    values[i] = (uint64_t)(uintptr_t)temp_names.data();
+                    break;
+                }
+                case 'a':
+                    temp_names.resize(call.num_names + 1);
+                    for (size_t k = 0; k < call.num_names; ++k) {
+                        temp_names[k] = remap(capture_name_kind('h'), names[name_index + k]);
+                    }
+                    values[i] = (uint64_t)(uintptr_t)temp_names.data();
+                    break;
+            }
+        }
+
+        if ((call.id == MGL_CAPTURE_UnmapBuffer || call.id == MGL_CAPTURE_UnmapNamedBuffer) && call.data[0] && mapped) {
+            memcpy(mapped, call.data[0], (size_t)call.size[0]);
+        }
+        return NULL;
+    }
+
+    void finish(ReplayCall & call, const uint64_t * values, uint64_t result) {
+        const char * spec = capture_arg_specs[call.id];
+        int num_args = (int)strlen(spec);
+        for (int i = 0; i < num_args; ++i) {
+            if (spec[i] >= '1' && spec[i] <= '7') {
+                int kind = spec[i] - '1';
+                for (size_t k = 0; k < call.num_names; ++k) {
+                    maps[kind][names[call.names + k]] = temp_names[k];
+                }
+            }
+        }
+        switch (capture_ret_specs[call.id]) {
+            case 'p': maps[capture_name_kind('p')][(GLuint)call.result] = (GLuint)result; break;
+            case 'h': maps[capture_name_kind('h')][(GLuint)call.result] = (GLuint)result; break;
+            case 'm': mapped = (void *)(uintptr_t)result; break;
+        }
+        if (call.id == MGL_CAPTURE_UnmapBuffer || call.id == MGL_CAPTURE_UnmapNamedBuffer) {
+            mapped = NULL;
+        }
+    }
+
+    const char * run(ReplayCall & call, ReplayStats * stats, long long * elapsed) {
+        uint64_t values[MGL_CAPTURE_MAX_ARGS];
+        const GLchar * strings = NULL;
+        std::vector<const GLchar *> varyings;
+        *elapsed = 0;
+
+        void * proc = procs[call.id];
+        if (!proc) {
+            return NULL;
+        }
+
+        const char * error = prepare(call, values, &strings, varyings);
+        if (error) {
+            return error;
+        }
+
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        uint64_t result = replay_invokers[call.id](proc, values);
+        *elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+
+        finish(call, values, result);
+        stats->calls[call.id] += 1;
+        stats->time[call.id] += *elapsed;
+        return NULL;
+    }
+};
+
+static const char * replay_capture(const GLMethods & gl, const char * data, size_t size, int loops, bool finish, ReplayStats * stats) {
+    std::vector<ReplayCall> calls;
+    std::vector<GLuint> names;
+    const char * error = replay_parse(data, size, calls, names, &stats->version_code);
+    if (error) {
+        return error;
+    }
+
+    Replayer replayer(gl, names);
+
+    // Everything up to the last frame is replayed once, then only the frames are repeated.
+    // The calls after the last frame run at the end, they usually release the objects.
+    size_t last_frame = 0;
+    for (size_t i = 0; i < calls.size(); ++i) {
+        if (calls[i].id == MGL_CAPTURE_FRAME_END) {
+            last_frame = i + 1;
+        }
+    }
+
+    for (int loop = 0; loop < loops; ++loop) {
+        bool in_frame = false;
+        std::chrono::steady_clock::time_point frame_begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < last_frame; ++i) {
+            ReplayCall & call = calls[i];
+            if (call.id == MGL_CAPTURE_FRAME_BEGIN) {
+                in_frame = true;
+                frame_begin = std::chrono::steady_clock::now();
+                continue;
+            }
+            if (call.id == MGL_CAPTURE_FRAME_END) {
+                if (finish) {
+                    gl.Finish();
+                }
+                stats->frames.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - frame_begin).count());
+                in_frame = false;
+                continue;
+            }
+            if (!in_frame && loop) {
+                continue;
+            }
+            long long elapsed = 0;
+            const char * error = replayer.run(call, stats, &elapsed);
+            if (error) {
+                return error;
+            }
+            if (!in_frame) {
+                stats->setup += elapsed;
+            }
+        }
+        if (!loop) {
+            stats->num_frames = (int)stats->frames.size();
+        }
+    }
+
+    for (size_t i = last_frame; i < calls.size(); ++i) {
+        if (calls[i].id < MGL_CAPTURE_NUM_CALLS) {
+            long long elapsed = 0;
+            const char * error = replayer.run(calls[i], stats, &elapsed);
+            if (error) {
+                return error;
+            }
+            stats->setup += elapsed;
+        }
+    }
+    return NULL;
+}
@@ -6,6 +6,8 @@
 #undef MemoryBarrier
 #endif
 
+typedef void * (* GLProcAddress)(const char * name);
+
 struct GLMethods {
     PFNGLCULLFACEPROC CullFace;
     PFNGLFRONTFACEPROC FrontFace;
@@ -1285,26 +1287,78 @@ struct GLMethods {
     // PFNGLGETINTEGERUI64I_VNVPROC GetIntegerui64i_vNV;
     // PFNGLVIEWPORTSWIZZLENVPROC ViewportSwizzleNV;
     // PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC FramebufferTextureMultiviewOVR;
+
+    // The loader is kept to resolve the rarely used groups on first use
+    PyObject * loader;
+    PyObject * load_function;
+    GLProcAddress proc_address;
+    bool mesh_shader_loaded;
+    bool bindless_texture_loaded;
 };
 
-void * load_opengl_function(PyObject * loader, const char * method, const char * name) {
-    if (PyErr_Occurred()) {
+void * load_opengl_function(const GLMethods & gl, const char * name) {
+    if (gl.proc_address) {
+        return gl.proc_address(name);
+    }
+
+    if (PyErr_Occurred() || !gl.load_function) {
         return NULL;
     }
 
-    PyObject * res = PyObject_CallMethod(loader, method, "s", name);
+    PyObject * name_str = PyUnicode_FromString(name);
+    PyObject * res = PyObject_CallFunctionObjArgs(gl.load_function, name_str, NULL);
+    Py_DECREF(name_str);
     if (!res) {
         return NULL;
     }
-    return PyLong_AsVoidPtr(res);
+    void * proc = PyLong_AsVoidPtr(res);
+    Py_DECREF(res);
+    return proc;
+}
+
+GLProcAddress native_proc_address(PyObject * loader) {
+    // Loaders may expose their getProcAddress as a capsule to skip a Python call per function
+    if (!PyObject_HasAttrString(loader, "proc_address")) {
+        return NULL;
+    }
+
+    PyObject * capsule = PyObject_GetAttrString(loader, "proc_address");
+    if (!capsule) {
+        PyErr_Clear();
+        return NULL;
+    }
+
+    // Only a capsule named "proc_address" is trusted to hold a getProcAddress function
+    GLProcAddress proc_address = NULL;
+    if (PyCapsule_IsValid(capsule, "proc_address")) {
+        proc_address = (GLProcAddress)PyCapsule_GetPointer(capsule, "proc_address");
+    }
+
+    Py_DECREF(capsule);
+    return proc_address;
+}
+
+void release_gl_methods(GLMethods & gl) {
+    // The lazily loaded groups cannot be resolved after this
+    Py_CLEAR(gl.load_function);
+    gl.proc_address = NULL;
 }
 
 GLMethods load_gl_methods(PyObject * loader) {
     GLMethods res = {};
 
-    const char * method = PyObject_HasAttrString(loader, "load_opengl_function") ? "load_opengl_function" : "load";
+    res.loader = loader;
+    res.proc_address = native_proc_address(loader);
+
+    if (!res.proc_address) {
+        const char * method = PyObject_HasAttrString(loader, "load_opengl_function") ? "load_opengl_function" : "load";
+        res.load_function = PyObject_GetAttrString(loader, method);
+        if (!res.load_function) {
+            return res;
+        }
+    }
 
-    #define load(name) res.name = (decltype(res.name))load_opengl_function(loader, method, "gl" # name);
+    #define load(name) res.name = (decltype(res.name))load_opengl_function(res, "gl" # name);
 
     load(CullFace);
     load(FrontFace);
@@ -1964,16 +2018,16 @@ GLMethods load_gl_methods(PyObject * loader) {
     load(MultiDrawElementsIndirectCount);
     load(PolygonOffsetClamp);
     // load(PrimitiveBoundingBoxARB);
-    load(GetTextureHandleARB);
+    // load(GetTextureHandleARB); resolved on first use
     // load(GetTextureSamplerHandleARB);
-    load(MakeTextureHandleResidentARB);
-    load(MakeTextureHandleNonResidentARB);
+    // load(MakeTextureHandleResidentARB); resolved on first use
+    // load(MakeTextureHandleNonResidentARB); resolved on first use
     // load(GetImageHandleARB);
     // load(MakeImageHandleResidentARB);
     // load(MakeImageHandleNonResidentARB);
     // load(UniformHandleui64ARB);
     // load(UniformHandleui64vARB);
-    load(ProgramUniformHandleui64ARB);
+    // load(ProgramUniformHandleui64ARB); resolved on first use
     // load(ProgramUniformHandleui64vARB);
     // load(IsTextureHandleResidentARB);
     // load(IsImageHandleResidentARB);
@@ -2463,10 +2517,10 @@ GLMethods load_gl_methods(PyObject * loader) {
     // load(TexPageCommitmentMemNV);
     // load(NamedBufferPageCommitmentMemNV);
     // load(TexturePageCommitmentMemNV);
-    load(DrawMeshTasksNV);
-    load(DrawMeshTasksIndirectNV);
-    load(MultiDrawMeshTasksIndirectNV);
-    load(MultiDrawMeshTasksIndirectCountNV);
+    // load(DrawMeshTasksNV); resolved on first use
+    // load(DrawMeshTasksIndirectNV); resolved on first use
+    // load(MultiDrawMeshTasksIndirectNV); resolved on first use
+    // load(MultiDrawMeshTasksIndirectCountNV); resolved on first use
     // load(GenPathsNV);
     // load(DeletePathsNV);
     // load(IsPathNV);
@@ -2589,3 +2643,25 @@ GLMethods load_gl_methods(PyObject * loader) {
 
     return res;
 };
+
+bool load_gl_mesh_shader_methods(GLMethods & gl) {
+    if (!gl.mesh_shader_loaded) {
+        gl.mesh_shader_loaded = true;
+        gl.DrawMeshTasksNV = (PFNGLDRAWMESHTASKSNVPROC)load_opengl_function(gl, "glDrawMeshTasksNV");
+        gl.DrawMeshTasksIndirectNV = (PFNGLDRAWMESHTASKSINDIRECTNVPROC)load_opengl_function(gl, "glDrawMeshTasksIndirectNV");
+        gl.MultiDrawMeshTasksIndirectNV = (PFNGLMULTIDRAWMESHTASKSINDIRECTNVPROC)load_opengl_function(gl, "glMultiDrawMeshTasksIndirectNV");
+        gl.MultiDrawMeshTasksIndirectCountNV = (PFNGLMULTIDRAWMESHTASKSINDIRECTCOUNTNVPROC)load_opengl_function(gl, "glMultiDrawMeshTasksIndirectCountNV");
+    }
+    return gl.DrawMeshTasksNV && gl.DrawMeshTasksIndirectNV && gl.MultiDrawMeshTasksIndirectNV && gl.MultiDrawMeshTasksIndirectCountNV;
+}
+
+bool load_gl_bindless_texture_methods(GLMethods & gl) {
+    if (!gl.bindless_texture_loaded) {
+        gl.bindless_texture_loaded = true;
+        gl.GetTextureHandleARB = (PFNGLGETTEXTUREHANDLEARBPROC)load_opengl_function(gl, "glGetTextureHandleARB");
+        gl.MakeTextureHandleResidentARB = (PFNGLMAKETEXTUREHANDLERESIDENTARBPROC)load_opengl_function(gl, "glMakeTextureHandleResidentARB");
+        gl.MakeTextureHandleNonResidentARB = (PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC)load_opengl_function(gl, "glMakeTextureHandleNonResidentARB");
+        gl.ProgramUniformHandleui64ARB = (PFNGLPROGRAMUNIFORMHANDLEUI64ARBPROC)load_opengl_function(gl, "glProgramUniformHandleui64ARB");
+    }
+    return gl.GetTextureHandleARB && gl.MakeTextureHandleResidentARB && gl.MakeTextureHandleNonResidentARB && gl.ProgramUniformHandleui64ARB;
+}
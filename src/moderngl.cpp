@@ -1,28 +1,54 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 
-#include "gl_methods.hpp"
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
 
-#define MGLError_Set(...) PyErr_Format(moderngl_error, __VA_ARGS__)
+#include "gl_methods.hpp"
+#include "gl_capture.hpp"
+#include "native_egl.hpp"
 
 #define MGL_MAX(a, b) (((a) > (b)) ? (a) : (b))
 #define MGL_MIN(a, b) (((a) < (b)) ? (a) : (b))
 
-static PyObject * helper;
-static PyObject * moderngl_error;
-static PyTypeObject * MGLBuffer_type;
-static PyTypeObject * MGLContext_type;
-static PyTypeObject * MGLFramebuffer_type;
-static PyTypeObject * MGLProgram_type;
-static PyTypeObject * MGLQuery_type;
-static PyTypeObject * MGLRenderbuffer_type;
-static PyTypeObject * MGLScope_type;
-static PyTypeObject * MGLTexture_type;
-static PyTypeObject * MGLTextureArray_type;
-static PyTypeObject * MGLTextureCube_type;
-static PyTypeObject * MGLTexture3D_type;
-static PyTypeObject * MGLVertexArray_type;
-static PyTypeObject * MGLSampler_type;
+struct ModuleState {
+    PyObject * helper;
+    PyTypeObject * MGLBuffer_type;
+    PyTypeObject * MGLContext_type;
+    PyTypeObject * MGLFramebuffer_type;
+    PyTypeObject * MGLProgram_type;
+    PyTypeObject * MGLQuery_type;
+    PyTypeObject * MGLRenderbuffer_type;
+    PyTypeObject * MGLScope_type;
+    PyTypeObject * MGLTexture_type;
+    PyTypeObject * MGLTextureArray_type;
+    PyTypeObject * MGLTextureCube_type;
+    PyTypeObject * MGLTexture3D_type;
+    PyTypeObject * MGLVertexArray_type;
+    PyTypeObject * MGLSampler_type;
+    PyTypeObject * MGLNativeEGL_type;
+};
+
+static void MGLError_Set(const char * format, ...) {
+    // The error type belongs to the helper module of the calling interpreter
+    PyObject * helper = PyImport_ImportModule("_moderngl");
+    if (!helper) {
+        return;
+    }
+
+    PyObject * error = PyObject_GetAttrString(helper, "Error");
+    Py_DECREF(helper);
+    if (!error) {
+        return;
+    }
+
+    va_list vargs;
+    va_start(vargs, format);
+    PyErr_FormatV(error, format, vargs);
+    va_end(vargs);
+    Py_DECREF(error);
+}
 
 enum MGLEnableFlag {
     MGL_NOTHING = 0,
@@ -77,9 +103,29 @@ struct MGLDataType {
     bool float_type;
 };
 
+enum MGLMemoryKind {
+    MGL_MEMORY_BUFFER,
+    MGL_MEMORY_TEXTURE,
+    MGL_MEMORY_TEXTURE_3D,
+    MGL_MEMORY_TEXTURE_ARRAY,
+    MGL_MEMORY_TEXTURE_CUBE,
+    MGL_MEMORY_RENDERBUFFER,
+    MGL_MEMORY_KINDS,
+};
+
+// Linked into MGLContext.memory while the object is alive
+struct MGLMemoryEntry {
+    MGLMemoryEntry * prev;
+    MGLMemoryEntry * next;
+    int kind;
+    GLuint name;
+    long long bytes;
+};
+
 struct MGLBuffer {
     PyObject_HEAD
     MGLContext * context;
+    MGLMemoryEntry memory;
     int buffer_obj;
     Py_ssize_t size;
     bool dynamic;
@@ -87,10 +133,172 @@ struct MGLBuffer {
     bool external;
 };
 
+enum MGLReleaseKind {
+    MGL_RELEASE_BUFFER,
+    MGL_RELEASE_TEXTURE,
+    MGL_RELEASE_VERTEX_ARRAY,
+    MGL_RELEASE_FRAMEBUFFER,
+    MGL_RELEASE_RENDERBUFFER,
+    MGL_RELEASE_SAMPLER,
+    MGL_RELEASE_PROGRAM,
+    MGL_RELEASE_KINDS,
+};
+
+struct MGLReleaseQueue {
+    GLuint * names[MGL_RELEASE_KINDS];
+    int count[MGL_RELEASE_KINDS];
+    int capacity[MGL_RELEASE_KINDS];
+};
+
+#define MGL_NAME_POOL_SIZE 64
+
+struct MGLNamePool {
+    GLuint names[MGL_NAME_POOL_SIZE];
+    int count;
+};
+
+// Timestamp queries are recycled, the profiler keeps several frames in flight
+struct MGLQueryPool {
+    GLuint * names;
+    int count;
+    int capacity;
+};
+
+// Counted in the entry points, the GL calls issued internally are not counted
+struct MGLStats {
+    long long draws;
+    long long dispatches;
+    long long program_binds;
+    long long vertex_array_binds;
+    long long texture_binds;
+    long long sampler_binds;
+    long long framebuffer_binds;
+    long long uniform_writes;
+    long long bytes_uploaded;
+    long long bytes_downloaded;
+    long long objects_created;
+    long long objects_released;
+};
+
+// The bytes are estimated from the sizes, formats, mipmap levels and samples of the live objects
+struct MGLMemory {
+    MGLMemoryEntry live;
+    long long count[MGL_MEMORY_KINDS];
+    long long bytes[MGL_MEMORY_KINDS];
+    long long total;
+    long long peak;
+    long long alarm;
+    bool alarm_raised;
+    PyObject * alarm_callback;
+};
+
+#define MGL_TRACE_MAX_DEPTH 64
+
+// Named sections use name_index into MGLTracer.names, API calls use a static name
+struct MGLTraceEvent {
+    const char * name;
+    int name_index;
+    GLenum object_type;
+    GLuint object;
+    GLuint query_begin;
+    GLuint query_end;
+    long long begin;
+    long long end;
+};
+
+struct MGLTracer {
+    MGLTraceEvent * events;
+    long long capacity;
+    long long count;
+    bool gpu;
+    bool state;
+    long long gpu_offset;
+    PyObject * names;
+    PyObject * name_indices;
+    MGLTraceEvent sections[MGL_TRACE_MAX_DEPTH];
+    int depth;
+};
+
+#define MGL_DEBUG_QUEUE_SIZE 256
+
+// Source, type and severity are indices into the name tables
+struct MGLDebugMessage {
+    int source;
+    int type;
+    GLuint id;
+    int severity;
+    char * text;
+};
+
+struct MGLDebugCounter {
+    long long count;
+    long long window;
+    int forwarded;
+};
+
+// Filled by the driver callback on any thread without the GIL, the queue is delivered to Python later
+struct MGLDebugOutput {
+    std::mutex lock;
+    int refs;
+    bool detached;
+    bool scheduled;
+    bool pending_calls;
+    bool was_enabled;
+    bool was_synchronous;
+    int severities;
+    int types;
+    int sources;
+    int rate_limit;
+    MGLDebugMessage queue[MGL_DEBUG_QUEUE_SIZE];
+    int queued;
+    std::unordered_map<GLuint, MGLDebugCounter> counters;
+    PyObject * callback;
+};
+
+enum MGLStartupPhase {
+    MGL_STARTUP_CONTEXT,
+    MGL_STARTUP_LOAD_GL_METHODS,
+    MGL_STARTUP_SETUP,
+    MGL_STARTUP_COMPILE,
+    MGL_STARTUP_LINK,
+    MGL_STARTUP_REFLECTION,
+    MGL_STARTUP_BUFFERS,
+    MGL_STARTUP_TEXTURES,
+    MGL_STARTUP_VERTEX_ARRAYS,
+    MGL_STARTUP_PHASES,
+};
+
+static const char * startup_phase_names[] = {
+    "context",
+    "load_gl_methods",
+    "setup",
+    "compile",
+    "link",
+    "reflection",
+    "buffers",
+    "textures",
+    "vertex_arrays",
+};
+
+// The first call of a phase is kept apart, it often pays for the lazy initialization of the driver
+struct MGLStartupProfile {
+    long long count[MGL_STARTUP_PHASES];
+    long long total[MGL_STARTUP_PHASES];
+    long long first[MGL_STARTUP_PHASES];
+    long long max[MGL_STARTUP_PHASES];
+};
+
 struct MGLContext {
     PyObject_HEAD
+    PyObject * module;
+    ModuleState * state;
     PyObject * ctx;
     PyObject * extensions;
+    PyObject * info;
+    const char ** extension_names;
+    int num_extensions;
+    MGLContext * previous_current;
+    int nested_enters;
     MGLFramebuffer * default_framebuffer;
     MGLFramebuffer * bound_framebuffer;
     PyObject * includes;
@@ -117,10 +325,552 @@ struct MGLContext {
     int provoking_vertex;
     float polygon_offset_factor;
     float polygon_offset_units;
+    bool dsa;
+    unsigned long owner_thread;
+    bool check_thread;
+    MGLReleaseQueue release_batch;
+    MGLReleaseQueue release_deferred;
+    GLsync release_fence;
+    long long released_objects;
+    long long released_bytes;
+    MGLNamePool buffer_names;
+    MGLNamePool texture_names;
+    MGLNamePool vertex_array_names;
+    MGLStats stats;
+    MGLMemory memory;
+    MGLQueryPool timestamp_queries;
+    MGLTracer * tracer;
+    MGLCapture * capture;
+    MGLDebugOutput * debug_output;
+    MGLStartupProfile * startup;
     GLMethods gl;
     bool released;
 };
 
+// The context moderngl made current on this thread, backends remember a single previous context
+static thread_local MGLContext * current_context = NULL;
+
+static bool context_enter(MGLContext * self) {
+    PyObject * res = PyObject_CallMethod(self->ctx, "__enter__", NULL);
+    if (!res) {
+        return false;
+    }
+    Py_DECREF(res);
+    self->previous_current = current_context;
+    current_context = self;
+    return true;
+}
+
+static bool context_exit(MGLContext * self) {
+    PyObject * res = PyObject_CallMethod(self->ctx, "__exit__", NULL);
+    if (!res) {
+        return false;
+    }
+    Py_DECREF(res);
+    current_context = self->previous_current;
+    self->previous_current = NULL;
+    return true;
+}
+
+struct MGLCurrentScope {
+    // Lazy queries may run while another context is current, the owning context is entered around them
+    // Entering a context that is already current would overwrite the context its backend restores on exit
+    MGLContext * context;
+    bool entered;
+
+    MGLCurrentScope(MGLContext * context) : context(context) {
+        entered = false;
+        if (current_context == context) {
+            return;
+        }
+        PyObject * type, * value, * traceback;
+        PyErr_Fetch(&type, &value, &traceback);
+        entered = context_enter(context);
+        PyErr_Clear();
+        PyErr_Restore(type, value, traceback);
+    }
+
+    ~MGLCurrentScope() {
+        if (!entered) {
+            return;
+        }
+        PyObject * type, * value, * traceback;
+        PyErr_Fetch(&type, &value, &traceback);
+        context_exit(context);
+        PyErr_Clear();
+        PyErr_Restore(type, value, traceback);
+    }
+};
+
+static int compare_extension_names(const void * a, const void * b) {
+    return strcmp(*(const char **)a, *(const char **)b);
+}
+
+static void load_extension_names(MGLContext * self) {
+    if (self->extension_names) {
+        return;
+    }
+
+    MGLCurrentScope current(self);
+    const GLMethods & gl = self->gl;
+
+    int num_extensions = 0;
+    gl.GetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
+
+    // The strings are owned by the driver and remain valid for the lifetime of the context
+    self->extension_names = new const char * [num_extensions + 1];
+    self->num_extensions = 0;
+
+    for (int i = 0; i < num_extensions; ++i) {
+        const char * name = (const char *)gl.GetStringi(GL_EXTENSIONS, i);
+        if (name) {
+            self->extension_names[self->num_extensions++] = name;
+        }
+    }
+
+    qsort(self->extension_names, self->num_extensions, sizeof(const char *), compare_extension_names);
+}
+
+static bool has_extension(MGLContext * self, const char * name) {
+    load_extension_names(self);
+    return bsearch(&name, self->extension_names, self->num_extensions, sizeof(const char *), compare_extension_names) != NULL;
+}
+
+static int context_limit(MGLContext * self, int * limit, int pname) {
+    // The limits are queried on first use, a negative value means not queried yet
+    if (*limit < 0) {
+        MGLCurrentScope current(self);
+        *limit = 0;
+        self->gl.GetIntegerv(pname, (GLint *)limit);
+    }
+    return *limit;
+}
+
+static float context_max_anisotropy(MGLContext * self) {
+    if (self->max_anisotropy < 0.0f) {
+        MGLCurrentScope current(self);
+        self->max_anisotropy = 0.0f;
+        self->gl.GetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, (GLfloat *)&self->max_anisotropy);
+    }
+    return self->max_anisotropy;
+}
+
+static void release_queue_push(MGLReleaseQueue * queue, int kind, int name) {
+    if (queue->count[kind] == queue->capacity[kind]) {
+        int capacity = queue->capacity[kind] ? queue->capacity[kind] * 2 : 64;
+        queue->names[kind] = (GLuint *)PyMem_Realloc(queue->names[kind], capacity * sizeof(GLuint));
+        queue->capacity[kind] = capacity;
+    }
+    queue->names[kind][queue->count[kind]++] = (GLuint)name;
+}
+
+static int release_queue_size(MGLReleaseQueue * queue) {
+    int size = 0;
+    for (int kind = 0; kind < MGL_RELEASE_KINDS; ++kind) {
+        size += queue->count[kind];
+    }
+    return size;
+}
+
+static void release_queue_delete(const GLMethods & gl, MGLReleaseQueue * queue) {
+    // One call per object type instead of one call per object
+    if (queue->count[MGL_RELEASE_BUFFER]) {
+        gl.DeleteBuffers(queue->count[MGL_RELEASE_BUFFER], queue->names[MGL_RELEASE_BUFFER]);
+    }
+    if (queue->count[MGL_RELEASE_TEXTURE]) {
+        gl.DeleteTextures(queue->count[MGL_RELEASE_TEXTURE], queue->names[MGL_RELEASE_TEXTURE]);
+    }
+    if (queue->count[MGL_RELEASE_VERTEX_ARRAY]) {
+        gl.DeleteVertexArrays(queue->count[MGL_RELEASE_VERTEX_ARRAY], queue->names[MGL_RELEASE_VERTEX_ARRAY]);
+    }
+    if (queue->count[MGL_RELEASE_FRAMEBUFFER]) {
+        gl.DeleteFramebuffers(queue->count[MGL_RELEASE_FRAMEBUFFER], queue->names[MGL_RELEASE_FRAMEBUFFER]);
+    }
+    if (queue->count[MGL_RELEASE_RENDERBUFFER]) {
+        gl.DeleteRenderbuffers(queue->count[MGL_RELEASE_RENDERBUFFER], queue->names[MGL_RELEASE_RENDERBUFFER]);
+    }
+    if (queue->count[MGL_RELEASE_SAMPLER]) {
+        gl.DeleteSamplers(queue->count[MGL_RELEASE_SAMPLER], queue->names[MGL_RELEASE_SAMPLER]);
+    }
+    for (int i = 0; i < queue->count[MGL_RELEASE_PROGRAM]; ++i) {
+        gl.DeleteProgram(queue->names[MGL_RELEASE_PROGRAM][i]);
+    }
+    for (int kind = 0; kind < MGL_RELEASE_KINDS; ++kind) {
+        queue->count[kind] = 0;
+    }
+}
+
+static int take_name(MGLNamePool * pool, PFNGLGENBUFFERSPROC gen) {
+    // The names are generated in batches, the Gen* functions share one signature
+    if (!pool->count) {
+        gen(MGL_NAME_POOL_SIZE, pool->names);
+        pool->count = MGL_NAME_POOL_SIZE;
+    }
+    return (int)pool->names[--pool->count];
+}
+
+static void free_name_pools(MGLContext * self) {
+    const GLMethods & gl = self->gl;
+    if (self->buffer_names.count) {
+        gl.DeleteBuffers(self->buffer_names.count, self->buffer_names.names);
+    }
+    if (self->texture_names.count) {
+        gl.DeleteTextures(self->texture_names.count, self->texture_names.names);
+    }
+    if (self->vertex_array_names.count) {
+        gl.DeleteVertexArrays(self->vertex_array_names.count, self->vertex_array_names.names);
+    }
+    self->buffer_names.count = 0;
+    self->texture_names.count = 0;
+    self->vertex_array_names.count = 0;
+}
+
+static bool query_pool_reserve(MGLQueryPool * pool, int size) {
+    if (size <= pool->capacity) {
+        return true;
+    }
+    int capacity = pool->capacity ? pool->capacity : MGL_NAME_POOL_SIZE;
+    while (capacity < size) {
+        capacity *= 2;
+    }
+    GLuint * names = (GLuint *)PyMem_Realloc(pool->names, capacity * sizeof(GLuint));
+    if (!names) {
+        PyErr_NoMemory();
+        return false;
+    }
+    pool->names = names;
+    pool->capacity = capacity;
+    return true;
+}
+
+static GLuint take_timestamp(MGLContext * self) {
+    // Writes a timestamp query, the names are recycled once their results are read
+    MGLQueryPool * pool = &self->timestamp_queries;
+    if (!pool->count) {
+        if (!query_pool_reserve(pool, MGL_NAME_POOL_SIZE)) {
+            return 0;
+        }
+        self->gl.GenQueries(MGL_NAME_POOL_SIZE, pool->names);
+        pool->count = MGL_NAME_POOL_SIZE;
+    }
+    GLuint query = pool->names[--pool->count];
+    self->gl.QueryCounter(query, GL_TIMESTAMP);
+    return query;
+}
+
+static bool give_timestamps(MGLContext * self, const GLuint * names, int count) {
+    MGLQueryPool * pool = &self->timestamp_queries;
+    if (!query_pool_reserve(pool, pool->count + count)) {
+        return false;
+    }
+    memcpy(pool->names + pool->count, names, count * sizeof(GLuint));
+    pool->count += count;
+    return true;
+}
+
+static bool check_context_thread(MGLContext * self) {
+    // The context is owned by the thread that created or last entered it
+    if (self->check_thread && self->owner_thread != PyThread_get_thread_ident()) {
+        MGLError_Set("the context is current on another thread, enter the context to use it on this thread");
+        return false;
+    }
+    return true;
+}
+
+static long long trace_clock() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void trace_begin_event(MGLContext * self, MGLTraceEvent * event, const char * name, GLenum object_type, GLuint object, bool gpu) {
+    event->name = name;
+    event->name_index = -1;
+    event->object_type = object_type;
+    event->object = object;
+    event->query_begin = gpu ? take_timestamp(self) : 0;
+    event->query_end = 0;
+    event->begin = trace_clock();
+}
+
+static void trace_end_event(MGLContext * self, MGLTraceEvent * event) {
+    MGLTracer * tracer = self->tracer;
+    event->end = trace_clock();
+    if (event->query_begin) {
+        event->query_end = take_timestamp(self);
+    }
+
+    // The ring keeps the most recent events, the queries of the overwritten ones are recycled
+    MGLTraceEvent * slot = &tracer->events[tracer->count % tracer->capacity];
+    if (tracer->count >= tracer->capacity && slot->query_begin) {
+        GLuint queries[2] = {slot->query_begin, slot->query_end};
+        give_timestamps(self, queries, slot->query_end ? 2 : 1);
+    }
+    *slot = *event;
+    tracer->count += 1;
+}
+
+// Disabled tracing costs a null check on entry and on exit
+// Bindings, uniform writes and state changes pass state, they are recorded only when the tracer
+// was started with state and never get timestamp queries
+struct MGLTraceScope {
+    MGLContext * context;
+    MGLTracer * tracer;
+    MGLTraceEvent event;
+
+    MGLTraceScope(MGLContext * context, const char * name, GLenum object_type, GLuint object, bool state = false) {
+        this->tracer = context->tracer;
+        if (this->tracer && state && !this->tracer->state) {
+            this->tracer = NULL;
+        }
+        if (this->tracer) {
+            this->context = context;
+            trace_begin_event(context, &event, name, object_type, object, tracer->gpu && !state);
+        }
+    }
+
+    ~MGLTraceScope() {
+        if (this->tracer && context->tracer == tracer) {
+            trace_end_event(context, &event);
+        }
+    }
+};
+
+static void startup_record(MGLStartupProfile * profile, int phase, long long elapsed) {
+    if (!profile->count[phase]) {
+        profile->first[phase] = elapsed;
+    }
+    if (elapsed > profile->max[phase]) {
+        profile->max[phase] = elapsed;
+    }
+    profile->count[phase] += 1;
+    profile->total[phase] += elapsed;
+}
+
+// Disabled profiling costs a null check on entry and on exit
+struct MGLStartupScope {
+    MGLStartupProfile * profile;
+    int phase;
+    long long begin;
+
+    MGLStartupScope(MGLContext * context, int phase) {
+        this->profile = context->startup;
+        if (this->profile) {
+            this->phase = phase;
+            this->begin = trace_clock();
+        }
+    }
+
+    ~MGLStartupScope() {
+        if (this->profile) {
+            startup_record(profile, phase, trace_clock() - begin);
+        }
+    }
+};
+
+static void free_tracer(MGLContext * self) {
+    MGLTracer * tracer = self->tracer;
+    if (!tracer) {
+        return;
+    }
+    self->tracer = NULL;
+    PyMem_Free(tracer->events);
+    Py_XDECREF(tracer->names);
+    Py_XDECREF(tracer->name_indices);
+    PyMem_Free(tracer);
+}
+
+static const GLenum debug_sources[] = {
+    GL_DEBUG_SOURCE_API,
+    GL_DEBUG_SOURCE_WINDOW_SYSTEM,
+    GL_DEBUG_SOURCE_SHADER_COMPILER,
+    GL_DEBUG_SOURCE_THIRD_PARTY,
+    GL_DEBUG_SOURCE_APPLICATION,
+    GL_DEBUG_SOURCE_OTHER,
+};
+
+static const GLenum debug_types[] = {
+    GL_DEBUG_TYPE_ERROR,
+    GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR,
+    GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR,
+    GL_DEBUG_TYPE_PORTABILITY,
+    GL_DEBUG_TYPE_PERFORMANCE,
+    GL_DEBUG_TYPE_MARKER,
+    GL_DEBUG_TYPE_PUSH_GROUP,
+    GL_DEBUG_TYPE_POP_GROUP,
+    GL_DEBUG_TYPE_OTHER,
+};
+
+static const GLenum debug_severities[] = {
+    GL_DEBUG_SEVERITY_HIGH,
+    GL_DEBUG_SEVERITY_MEDIUM,
+    GL_DEBUG_SEVERITY_LOW,
+    GL_DEBUG_SEVERITY_NOTIFICATION,
+};
+
+static const char * debug_source_names[] = {"api", "window_system", "shader_compiler", "third_party", "application", "other"};
+static const char * debug_type_names[] = {"error", "deprecated", "undefined", "portability", "performance", "marker", "push_group", "pop_group", "other"};
+static const char * debug_severity_names[] = {"high", "medium", "low", "notification"};
+
+// Unknown values fall into the last entry
+static int debug_index(const GLenum * values, int count, GLenum value) {
+    for (int i = 0; i < count - 1; ++i) {
+        if (values[i] == value) {
+            return i;
+        }
+    }
+    return count - 1;
+}
+
+static int debug_output_pending(void * arg);
+
+static void APIENTRY debug_output_callback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar * message, const void * user_param) {
+    MGLDebugOutput * output = (MGLDebugOutput *)user_param;
+    int source_index = debug_index(debug_sources, 6, source);
+    int type_index = debug_index(debug_types, 9, type);
+    int severity_index = debug_index(debug_severities, 4, severity);
+    if (!(output->sources >> source_index & 1) || !(output->types >> type_index & 1) || !(output->severities >> severity_index & 1)) {
+        return;
+    }
+
+    if (length < 0) {
+        length = (GLsizei)strlen(message);
+    }
+
+    std::lock_guard<std::mutex> guard(output->lock);
+    if (output->detached) {
+        return;
+    }
+
+    // Every message is counted, at most rate_limit messages per id and second are forwarded
+    MGLDebugCounter & counter = output->counters[id];
+    counter.count += 1;
+    if (output->rate_limit > 0) {
+        long long now = trace_clock();
+        if (now - counter.window >= 1000000000LL) {
+            counter.window = now;
+            counter.forwarded = 0;
+        }
+        if (counter.forwarded >= output->rate_limit) {
+            return;
+        }
+        counter.forwarded += 1;
+    }
+
+    if (output->queued == MGL_DEBUG_QUEUE_SIZE) {
+        return;
+    }
+
+    char * text = (char *)PyMem_RawMalloc(length + 1);
+    if (!text) {
+        return;
+    }
+    memcpy(text, message, length);
+    text[length] = 0;
+
+    MGLDebugMessage & slot = output->queue[output->queued++];
+    slot.source = source_index;
+    slot.type = type_index;
+    slot.id = id;
+    slot.severity = severity_index;
+    slot.text = text;
+
+    if (output->pending_calls && !output->scheduled && Py_AddPendingCall(debug_output_pending, output) == 0) {
+        output->scheduled = true;
+        output->refs += 1;
+    }
+}
+
+// Called with the GIL held, the messages are taken out of the queue before any Python code runs
+static int deliver_debug_output(MGLDebugOutput * output) {
+    MGLDebugMessage messages[MGL_DEBUG_QUEUE_SIZE];
+    int count = 0;
+    {
+        std::lock_guard<std::mutex> guard(output->lock);
+        count = output->queued;
+        memcpy(messages, output->queue, sizeof(MGLDebugMessage) * count);
+        output->queued = 0;
+    }
+
+    PyObject * callback = output->callback;
+    Py_XINCREF(callback);
+    for (int i = 0; i < count; ++i) {
+        MGLDebugMessage & message = messages[i];
+        if (callback) {
+            PyObject * res = PyObject_CallFunction(
+                callback,
+                "ssIsN",
+                debug_source_names[message.source],
+                debug_type_names[message.type],
+                message.id,
+                debug_severity_names[message.severity],
+                PyUnicode_DecodeUTF8(message.text, strlen(message.text), "replace")
+            );
+            if (res) {
+                Py_DECREF(res);
+            } else {
+                PyErr_WriteUnraisable(callback);
+            }
+        }
+        PyMem_RawFree(message.text);
+    }
+    Py_XDECREF(callback);
+    return count;
+}
+
+static void unref_debug_output(MGLDebugOutput * output) {
+    bool last = false;
+    {
+        std::lock_guard<std::mutex> guard(output->lock);
+        output->refs -= 1;
+        last = output->refs == 0;
+    }
+    if (last) {
+        for (int i = 0; i < output->queued; ++i) {
+            PyMem_RawFree(output->queue[i].text);
+        }
+        delete output;
+    }
+}
+
+static int debug_output_pending(void * arg) {
+    MGLDebugOutput * output = (MGLDebugOutput *)arg;
+    {
+        std::lock_guard<std::mutex> guard(output->lock);
+        output->scheduled = false;
+    }
+    deliver_debug_output(output);
+    unref_debug_output(output);
+    return 0;
+}
+
+static void stop_debug_output(MGLContext * self) {
+    MGLDebugOutput * output = self->debug_output;
+    if (!output) {
+        return;
+    }
+    self->debug_output = NULL;
+
+    const GLMethods & gl = self->gl;
+    gl.DebugMessageCallback(NULL, NULL);
+    // The message control state cannot be queried, enable_debug_output overwrote it
+    // so the default is restored: every message enabled except the low severity ones
+    gl.DebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, NULL, GL_TRUE);
+    gl.DebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_LOW, 0, NULL, GL_FALSE);
+    if (!output->was_synchronous) {
+        gl.Disable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    }
+    if (!output->was_enabled) {
+        gl.Disable(GL_DEBUG_OUTPUT);
+    }
+
+    deliver_debug_output(output);
+    {
+        std::lock_guard<std::mutex> guard(output->lock);
+        output->detached = true;
+    }
+    Py_CLEAR(output->callback);
+    unref_debug_output(output);
+}
+
 struct Rect {
     int x, y, width, height;
 };
@@ -212,6 +962,17 @@ static int parse_cube(PyObject * arg, Cube * cube) {
     return 1;
 }
 
+// Intermediate images of scaled reads, kept by the framebuffer and only reallocated when they grow
+struct ScaledRead {
+    int framebuffer_obj[2];
+    int renderbuffer_obj[2];
+    MGLMemoryEntry memory[2];
+    int num_targets;
+    int internal_format;
+    int width;
+    int height;
+};
+
 struct MGLFramebuffer {
     PyObject_HEAD
     MGLContext * context;
@@ -229,6 +990,7 @@ struct MGLFramebuffer {
     int height;
     int samples;
     bool depth_mask;
+    ScaledRead scaled;
     bool released;
 };
 
@@ -269,6 +1031,7 @@ struct MGLQuery {
 struct MGLRenderbuffer {
     PyObject_HEAD
     MGLContext * context;
+    MGLMemoryEntry memory;
     MGLDataType * data_type;
     int renderbuffer_obj;
     int width;
@@ -317,6 +1080,7 @@ struct MGLScope {
 struct MGLTexture {
     PyObject_HEAD
     MGLContext * context;
+    MGLMemoryEntry memory;
     MGLDataType * data_type;
     int texture_obj;
     int width;
@@ -338,6 +1102,7 @@ struct MGLTexture {
 struct MGLTexture3D {
     PyObject_HEAD
     MGLContext * context;
+    MGLMemoryEntry memory;
     MGLDataType * data_type;
     int texture_obj;
     int width;
@@ -356,6 +1121,7 @@ struct MGLTexture3D {
 struct MGLTextureArray {
     PyObject_HEAD
     MGLContext * context;
+    MGLMemoryEntry memory;
     MGLDataType * data_type;
     int texture_obj;
     int width;
@@ -374,6 +1140,7 @@ struct MGLTextureArray {
 struct MGLTextureCube {
     PyObject_HEAD
     MGLContext * context;
+    MGLMemoryEntry memory;
     MGLDataType * data_type;
     int texture_obj;
     int width;
@@ -396,7 +1163,7 @@ struct MGLVertexArray {
     int index_element_size;
     int index_element_type;
     int vertex_array_obj;
-    int num_vertices;
+    Py_ssize_t num_vertices;
     int num_instances;
     bool released;
 };
@@ -482,34 +1249,142 @@ static PyObject * compare_func_to_string(int func) {
     return PyUnicode_FromString("?");
 }
 
-struct FormatNode {
-    int size;
-    int count;
-    int type;
-    bool normalize;
-};
+static long long mipmap_texels(int width, int height, int depth, int max_level) {
+    long long texels = 0;
+    for (int level = 0; level <= max_level; ++level) {
+        texels += (long long)width * height * depth;
+        if (width == 1 && height == 1 && depth == 1) {
+            break;
+        }
+        width = MGL_MAX(width / 2, 1);
+        height = MGL_MAX(height / 2, 1);
+        depth = MGL_MAX(depth / 2, 1);
+    }
+    return texels;
+}
 
-struct FormatInfo {
-    int size;
-    int nodes;
-    int divisor;
-    bool valid;
+static long long memory_bytes(MGLBuffer * buffer) {
+    return buffer->size;
+}
 
-    static FormatInfo invalid() {
-        FormatInfo invalid;
-        invalid.size = 0;
-        invalid.nodes = 0;
-        invalid.divisor = 0;
-        invalid.valid = false;
-        return invalid;
-    }
-};
+static long long memory_bytes(MGLTexture * texture) {
+    long long texels = mipmap_texels(texture->width, texture->height, 1, texture->max_level);
+    return texels * texture->components * texture->data_type->size * MGL_MAX(texture->samples, 1);
+}
 
-struct FormatIterator {
-    const char * ptr;
-    FormatNode node;
+static long long memory_bytes(MGLTexture3D * texture) {
+    long long texels = mipmap_texels(texture->width, texture->height, texture->depth, texture->max_level);
+    return texels * texture->components * texture->data_type->size;
+}
 
-    FormatIterator(const char * str);
+static long long memory_bytes(MGLTextureArray * texture) {
+    long long texels = mipmap_texels(texture->width, texture->height, 1, texture->max_level) * texture->layers;
+    return texels * texture->components * texture->data_type->size;
+}
+
+static long long memory_bytes(MGLTextureCube * texture) {
+    long long texels = mipmap_texels(texture->width, texture->height, 1, texture->max_level) * 6;
+    return texels * texture->components * texture->data_type->size;
+}
+
+static long long memory_bytes(MGLRenderbuffer * renderbuffer) {
+    long long texels = (long long)renderbuffer->width * renderbuffer->height;
+    return texels * renderbuffer->components * renderbuffer->data_type->size * MGL_MAX(renderbuffer->samples, 1);
+}
+
+// The alarm is raised once when the total goes above it and rearmed when it drops below
+static void memory_check_alarm(MGLContext * self) {
+    MGLMemory & memory = self->memory;
+    if (!memory.alarm || memory.total <= memory.alarm) {
+        memory.alarm_raised = false;
+        return;
+    }
+    if (memory.alarm_raised || !memory.alarm_callback) {
+        return;
+    }
+
+    memory.alarm_raised = true;
+    PyObject * callback = memory.alarm_callback;
+    Py_INCREF(callback);
+    PyObject * res = PyObject_CallFunction(callback, "LL", memory.total, memory.alarm);
+    if (res) {
+        Py_DECREF(res);
+    } else {
+        PyErr_WriteUnraisable(callback);
+    }
+    Py_DECREF(callback);
+}
+
+static void memory_update(MGLContext * self, int kind, long long bytes) {
+    MGLMemory & memory = self->memory;
+    memory.bytes[kind] += bytes;
+    memory.total += bytes;
+    memory.peak = MGL_MAX(memory.peak, memory.total);
+    memory_check_alarm(self);
+}
+
+static void memory_track(MGLContext * self, MGLMemoryEntry * entry, int kind, GLuint name, long long bytes) {
+    MGLMemoryEntry * live = &self->memory.live;
+    entry->kind = kind;
+    entry->name = name;
+    entry->bytes = bytes;
+    entry->prev = live;
+    entry->next = live->next;
+    live->next->prev = entry;
+    live->next = entry;
+    self->memory.count[kind] += 1;
+    memory_update(self, kind, bytes);
+}
+
+static void memory_resize(MGLContext * self, MGLMemoryEntry * entry, long long bytes) {
+    if (!entry->next) {
+        return;
+    }
+    long long delta = bytes - entry->bytes;
+    entry->bytes = bytes;
+    memory_update(self, entry->kind, delta);
+}
+
+static void memory_untrack(MGLContext * self, MGLMemoryEntry * entry) {
+    if (!entry->next) {
+        return;
+    }
+    entry->prev->next = entry->next;
+    entry->next->prev = entry->prev;
+    entry->prev = NULL;
+    entry->next = NULL;
+    self->memory.count[entry->kind] -= 1;
+    memory_update(self, entry->kind, -entry->bytes);
+}
+
+struct FormatNode {
+    int size;
+    int count;
+    int type;
+    bool normalize;
+};
+
+struct FormatInfo {
+    int size;
+    int nodes;
+    int divisor;
+    bool valid;
+
+    static FormatInfo invalid() {
+        FormatInfo invalid;
+        invalid.size = 0;
+        invalid.nodes = 0;
+        invalid.divisor = 0;
+        invalid.valid = false;
+        return invalid;
+    }
+};
+
+struct FormatIterator {
+    const char * ptr;
+    FormatNode node;
+
+    FormatIterator(const char * str);
 
     FormatInfo info();
     FormatNode * next();
@@ -817,7 +1692,246 @@ static MGLDataType * from_dtype(const char * dtype) {
     return NULL;
 }
 
+struct ReadLayout {
+    int base_format;
+    int read_components;
+    int components;
+    int swizzle[4];
+    bool convert;
+    int element_size;
+    Py_ssize_t row_size;
+    Py_ssize_t row_stride;
+    Py_ssize_t required_size;
+};
+
+static bool parse_read_layout(ReadLayout * layout, const char * channels, int components, int width, int height, int alignment, Py_ssize_t row_stride, MGLDataType * data_type, bool depth) {
+    bool integer = data_type->base_format == int_base_format;
+
+    layout->base_format = depth ? GL_DEPTH_COMPONENT : data_type->base_format[components];
+    layout->read_components = components;
+    layout->components = components;
+    layout->convert = false;
+    layout->element_size = data_type->size;
+
+    if (channels && channels[0]) {
+        if (depth) {
+            MGLError_Set("channels cannot be selected when reading depth");
+            return false;
+        }
+
+        int num_channels = (int)strlen(channels);
+        if (num_channels > 4) {
+            MGLError_Set("channels must have at most 4 characters not %d", num_channels);
+            return false;
+        }
+
+        int max_channel = 0;
+        for (int i = 0; i < num_channels; ++i) {
+            switch (channels[i]) {
+                case 'R': case 'r': layout->swizzle[i] = 0; break;
+                case 'G': case 'g': layout->swizzle[i] = 1; break;
+                case 'B': case 'b': layout->swizzle[i] = 2; break;
+                case 'A': case 'a': layout->swizzle[i] = 3; break;
+                default:
+                    MGLError_Set("invalid channel '%c' in channels", channels[i]);
+                    return false;
+            }
+            max_channel = MGL_MAX(max_channel, layout->swizzle[i]);
+        }
+
+        layout->components = num_channels;
+
+        // Let the driver produce the final layout whenever a pixel transfer format exists for it.
+        // Anything else is read with the fewest components covering the selection and converted on the cpu.
+
+        bool prefix = true;
+        for (int i = 0; i < num_channels; ++i) {
+            prefix = prefix && layout->swizzle[i] == i;
+        }
+
+        if (prefix) {
+            layout->base_format = data_type->base_format[num_channels];
+            layout->read_components = num_channels;
+        } else if (num_channels >= 3 && layout->swizzle[0] == 2 && layout->swizzle[1] == 1 && layout->swizzle[2] == 0 && (num_channels == 3 || layout->swizzle[3] == 3)) {
+            if (num_channels == 3) {
+                layout->base_format = integer ? GL_BGR_INTEGER : GL_BGR;
+            } else {
+                layout->base_format = integer ? GL_BGRA_INTEGER : GL_BGRA;
+            }
+            layout->read_components = num_channels;
+        } else {
+            layout->base_format = data_type->base_format[max_channel + 1];
+            layout->read_components = max_channel + 1;
+            layout->convert = true;
+        }
+    }
+
+    layout->row_size = (Py_ssize_t)width * layout->components * layout->element_size;
+
+    if (row_stride < 0) {
+        MGLError_Set("the row_stride must not be negative");
+        return false;
+    }
+
+    if (!row_stride) {
+        layout->row_stride = (layout->row_size + alignment - 1) / alignment * alignment;
+        layout->required_size = layout->row_stride * height;
+    } else {
+        if (row_stride < layout->row_size) {
+            MGLError_Set("the row_stride must be at least %zd", layout->row_size);
+            return false;
+        }
+        layout->row_stride = row_stride;
+        layout->required_size = height ? row_stride * (height - 1) + layout->row_size : 0;
+    }
+
+    return true;
+}
+
+static bool set_pack_row_stride(const GLMethods & gl, Py_ssize_t row_stride, int pixel_size) {
+    // GL_PACK_ROW_LENGTH counts pixels, the padding is controlled by GL_PACK_ALIGNMENT.
+    // Find a pair that lands exactly on the requested stride.
+
+    static const int alignments[] = {8, 4, 2, 1};
+
+    for (int i = 0; i < 4; ++i) {
+        int alignment = alignments[i];
+        if (row_stride % alignment) {
+            continue;
+        }
+        Py_ssize_t row_length = row_stride / pixel_size;
+        if ((row_length * pixel_size + alignment - 1) / alignment * alignment == row_stride) {
+            gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
+            gl.PixelStorei(GL_PACK_ROW_LENGTH, (int)row_length);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void flip_rows(char * ptr, int height, Py_ssize_t row_size, Py_ssize_t row_stride) {
+    char * temp = new char[row_size];
+    for (int y = 0; y < height / 2; ++y) {
+        char * top = ptr + (Py_ssize_t)y * row_stride;
+        char * bottom = ptr + (Py_ssize_t)(height - 1 - y) * row_stride;
+        memcpy(temp, top, row_size);
+        memcpy(top, bottom, row_size);
+        memcpy(bottom, temp, row_size);
+    }
+    delete[] temp;
+}
+
+static void copy_rows(const char * src, char * dst, int height, Py_ssize_t row_size, Py_ssize_t src_stride, Py_ssize_t dst_stride, bool flip_y) {
+    for (int y = 0; y < height; ++y) {
+        int dst_y = flip_y ? height - 1 - y : y;
+        memcpy(dst + (Py_ssize_t)dst_y * dst_stride, src + (Py_ssize_t)y * src_stride, row_size);
+    }
+}
+
+// The loops below have a fixed trip count per pixel so the compiler can unroll and vectorize them.
+
+template <typename T, int N>
+static void swizzle_row(const T * src, T * dst, int width, int src_components, const int * swizzle) {
+    for (int x = 0; x < width; ++x) {
+        for (int c = 0; c < N; ++c) {
+            dst[x * N + c] = src[x * src_components + swizzle[c]];
+        }
+    }
+}
+
+template <typename T>
+static void swizzle_rows(const char * src, char * dst, int width, int height, const ReadLayout & layout, bool flip_y) {
+    Py_ssize_t src_stride = (Py_ssize_t)width * layout.read_components * sizeof(T);
+    for (int y = 0; y < height; ++y) {
+        const T * src_row = (const T *)(src + (Py_ssize_t)y * src_stride);
+        T * dst_row = (T *)(dst + (Py_ssize_t)(flip_y ? height - 1 - y : y) * layout.row_stride);
+        switch (layout.components) {
+            case 1: swizzle_row<T, 1>(src_row, dst_row, width, layout.read_components, layout.swizzle); break;
+            case 2: swizzle_row<T, 2>(src_row, dst_row, width, layout.read_components, layout.swizzle); break;
+            case 3: swizzle_row<T, 3>(src_row, dst_row, width, layout.read_components, layout.swizzle); break;
+            case 4: swizzle_row<T, 4>(src_row, dst_row, width, layout.read_components, layout.swizzle); break;
+        }
+    }
+}
+
+static void swizzle_pixels(const char * src, char * dst, int width, int height, const ReadLayout & layout, bool flip_y) {
+    switch (layout.element_size) {
+        case 1: swizzle_rows<unsigned char>(src, dst, width, height, layout, flip_y); break;
+        case 2: swizzle_rows<unsigned short>(src, dst, width, height, layout, flip_y); break;
+        case 4: swizzle_rows<unsigned int>(src, dst, width, height, layout, flip_y); break;
+    }
+}
+
+static void read_pixel_rows(const GLMethods & gl, Rect rect, int format, int type, char * ptr, Py_ssize_t row_stride, bool flip_y) {
+    gl.PixelStorei(GL_PACK_ALIGNMENT, 1);
+    gl.PixelStorei(GL_PACK_ROW_LENGTH, 0);
+    for (int y = 0; y < rect.height; ++y) {
+        int dst_y = flip_y ? rect.height - 1 - y : y;
+        gl.ReadPixels(rect.x, rect.y + y, rect.width, 1, format, type, ptr + (Py_ssize_t)dst_y * row_stride);
+    }
+}
+
+static void * map_buffer_range(MGLBuffer * self, Py_ssize_t offset, Py_ssize_t size, int access) {
+    const GLMethods & gl = self->context->gl;
+    if (self->context->dsa) {
+        return gl.MapNamedBufferRange(self->buffer_obj, offset, size, access);
+    }
+    gl.BindBuffer(GL_ARRAY_BUFFER, self->buffer_obj);
+    return gl.MapBufferRange(GL_ARRAY_BUFFER, offset, size, access);
+}
+
+static void unmap_buffer(MGLBuffer * self) {
+    const GLMethods & gl = self->context->gl;
+    if (self->context->dsa) {
+        gl.UnmapNamedBuffer(self->buffer_obj);
+    } else {
+        gl.BindBuffer(GL_ARRAY_BUFFER, self->buffer_obj);
+        gl.UnmapBuffer(GL_ARRAY_BUFFER);
+    }
+}
+
+static MGLBuffer * create_buffer(MGLContext * self, const void * data, Py_ssize_t size, bool dynamic) {
+    const GLMethods & gl = self->gl;
+
+    int buffer_obj = take_name(&self->buffer_names, self->dsa ? gl.CreateBuffers : gl.GenBuffers);
+    if (!buffer_obj) {
+        MGLError_Set("cannot create buffer");
+        return NULL;
+    }
+
+    if (self->dsa) {
+        gl.NamedBufferData(buffer_obj, size, data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    } else {
+        gl.BindBuffer(GL_ARRAY_BUFFER, buffer_obj);
+        gl.BufferData(GL_ARRAY_BUFFER, size, data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    }
+
+    if (data) {
+        self->stats.bytes_uploaded += size;
+    }
+
+    MGLBuffer * buffer = PyObject_New(MGLBuffer, self->state->MGLBuffer_type);
+    buffer->released = false;
+    buffer->external = false;
+    buffer->buffer_obj = buffer_obj;
+    buffer->size = size;
+    buffer->dynamic = dynamic;
+
+    Py_INCREF(self);
+    buffer->context = self;
+    self->stats.objects_created += 1;
+    memory_track(self, &buffer->memory, MGL_MEMORY_BUFFER, buffer_obj, memory_bytes(buffer));
+    return buffer;
+}
+
 static PyObject * MGLContext_buffer(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLStartupScope startup(self, MGL_STARTUP_BUFFERS);
+
     PyObject * data;
     Py_ssize_t reserve;
     int dynamic;
@@ -865,47 +1979,97 @@ static PyObject * MGLContext_buffer(MGLContext * self, PyObject * args) {
         return 0;
     }
 
-    MGLBuffer * buffer = PyObject_New(MGLBuffer, MGLBuffer_type);
-    buffer->released = false;
-    buffer->external = false;
+    MGLBuffer * buffer = create_buffer(self, buffer_view.buf, buffer_view.len, dynamic ? true : false);
+
+    if (data != Py_None) {
+        PyBuffer_Release(&buffer_view);
+    }
 
-    buffer->size = buffer_view.len;
-    buffer->dynamic = dynamic ? true : false;
+    if (!buffer) {
+        return 0;
+    }
 
-    const GLMethods & gl = self->gl;
+    return Py_BuildValue("(Oni)", buffer, buffer->size, buffer->buffer_obj);
+}
 
-    buffer->buffer_obj = 0;
-    gl.GenBuffers(1, (GLuint *)&buffer->buffer_obj);
+static PyObject * MGLBuffer_release(MGLBuffer * self, PyObject * args);
 
-    if (!buffer->buffer_obj) {
-        MGLError_Set("cannot create buffer");
-        Py_DECREF(buffer);
+static PyObject * MGLContext_buffers(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    PyObject * items;
+    int dynamic;
+
+    if (!PyArg_ParseTuple(args, "Op", &items, &dynamic)) {
         return 0;
     }
 
-    gl.BindBuffer(GL_ARRAY_BUFFER, buffer->buffer_obj);
-    gl.BufferData(GL_ARRAY_BUFFER, buffer->size, buffer_view.buf, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    items = PySequence_Fast(items, "data must be a sequence");
+    if (!items) {
+        return 0;
+    }
 
-    Py_INCREF(self);
-    buffer->context = self;
+    Py_ssize_t num_items = PySequence_Fast_GET_SIZE(items);
+    PyObject * res = PyList_New(num_items);
 
-    if (data != Py_None) {
-        PyBuffer_Release(&buffer_view);
+    for (Py_ssize_t i = 0; i < num_items; ++i) {
+        PyObject * item = PySequence_Fast_GET_ITEM(items, i);
+        MGLBuffer * buffer = NULL;
+
+        if (PyLong_Check(item)) {
+            Py_ssize_t reserve = PyLong_AsSsize_t(item);
+            if (reserve > 0) {
+                buffer = create_buffer(self, NULL, reserve, dynamic ? true : false);
+            } else if (!PyErr_Occurred()) {
+                MGLError_Set("the buffer cannot be empty");
+            }
+        } else {
+            Py_buffer buffer_view;
+            if (PyObject_GetBuffer(item, &buffer_view, PyBUF_SIMPLE) == 0) {
+                if (buffer_view.len) {
+                    buffer = create_buffer(self, buffer_view.buf, buffer_view.len, dynamic ? true : false);
+                } else {
+                    MGLError_Set("the buffer cannot be empty");
+                }
+                PyBuffer_Release(&buffer_view);
+            }
+        }
+
+        if (!buffer) {
+            // Release the buffers created so far
+            for (Py_ssize_t j = 0; j < i; ++j) {
+                PyObject * created = PyTuple_GET_ITEM(PyList_GET_ITEM(res, j), 0);
+                Py_XDECREF(MGLBuffer_release((MGLBuffer *)created, NULL));
+            }
+            PyList_SetSlice(res, 0, i, NULL);
+            Py_DECREF(res);
+            Py_DECREF(items);
+            return 0;
+        }
+
+        PyList_SET_ITEM(res, i, Py_BuildValue("(Oni)", buffer, buffer->size, buffer->buffer_obj));
     }
 
-    return Py_BuildValue("(Oni)", buffer, buffer->size, buffer->buffer_obj);
+    Py_DECREF(items);
+    return res;
 }
 
 static PyObject * MGLContext_external_buffer(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
     int glo;
-    int size;
+    Py_ssize_t size;
 
-    int args_ok = PyArg_ParseTuple(args, "II", &glo, &size);
+    int args_ok = PyArg_ParseTuple(args, "In", &glo, &size);
     if (!args_ok) {
         return NULL;
     }
 
-    MGLBuffer * buffer = PyObject_New(MGLBuffer, MGLBuffer_type);
+    MGLBuffer * buffer = PyObject_New(MGLBuffer, self->state->MGLBuffer_type);
     buffer->released = false;
     buffer->external = false;
 
@@ -915,11 +2079,18 @@ static PyObject * MGLContext_external_buffer(MGLContext * self, PyObject * args)
 
     Py_INCREF(self);
     buffer->context = self;
+    memory_track(self, &buffer->memory, MGL_MEMORY_BUFFER, glo, memory_bytes(buffer));
 
     return Py_BuildValue("(Oni)", buffer, buffer->size, buffer->buffer_obj);
 }
 
 static PyObject * MGLBuffer_write(MGLBuffer * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Buffer.write", GL_BUFFER, self->buffer_obj);
+
     PyObject * data;
     Py_ssize_t offset;
 
@@ -943,19 +2114,30 @@ static PyObject * MGLBuffer_write(MGLBuffer * self, PyObject * args) {
     }
 
     if (offset < 0 || buffer_view.len + offset > self->size) {
-        MGLError_Set("out of range offset = %d or size = %d", offset, buffer_view.len);
+        MGLError_Set("out of range offset = %zd or size = %zd", offset, buffer_view.len);
         PyBuffer_Release(&buffer_view);
         return 0;
     }
 
     const GLMethods & gl = self->context->gl;
-    gl.BindBuffer(GL_ARRAY_BUFFER, self->buffer_obj);
-    gl.BufferSubData(GL_ARRAY_BUFFER, (GLintptr)offset, buffer_view.len, buffer_view.buf);
+    if (self->context->dsa) {
+        gl.NamedBufferSubData(self->buffer_obj, (GLintptr)offset, buffer_view.len, buffer_view.buf);
+    } else {
+        gl.BindBuffer(GL_ARRAY_BUFFER, self->buffer_obj);
+        gl.BufferSubData(GL_ARRAY_BUFFER, (GLintptr)offset, buffer_view.len, buffer_view.buf);
+    }
+    self->context->stats.bytes_uploaded += buffer_view.len;
     PyBuffer_Release(&buffer_view);
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLBuffer_read(MGLBuffer * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Buffer.read", GL_BUFFER, self->buffer_obj);
+
     Py_ssize_t size;
     Py_ssize_t offset;
 
@@ -975,14 +2157,23 @@ static PyObject * MGLBuffer_read(MGLBuffer * self, PyObject * args) {
     }
 
     if (offset < 0 || offset + size > self->size) {
-        MGLError_Set("out of range offset = %d or size = %d", offset, size);
+        MGLError_Set("out of range offset = %zd or size = %zd", offset, size);
         return 0;
     }
 
     const GLMethods & gl = self->context->gl;
 
-    gl.BindBuffer(GL_ARRAY_BUFFER, self->buffer_obj);
-    void * map = gl.MapBufferRange(GL_ARRAY_BUFFER, offset, size, GL_MAP_READ_BIT);
+    if (self->context->dsa) {
+        PyObject * data = PyBytes_FromStringAndSize(NULL, size);
+        char * ptr = PyBytes_AS_STRING(data);
+        Py_BEGIN_ALLOW_THREADS
+        gl.GetNamedBufferSubData(self->buffer_obj, offset, size, ptr);
+        Py_END_ALLOW_THREADS
+        self->context->stats.bytes_downloaded += size;
+        return data;
+    }
+
+    void * map = map_buffer_range(self, offset, size, GL_MAP_READ_BIT);
 
     if (!map) {
         MGLError_Set("cannot map the buffer");
@@ -991,12 +2182,19 @@ static PyObject * MGLBuffer_read(MGLBuffer * self, PyObject * args) {
 
     PyObject * data = PyBytes_FromStringAndSize((const char *)map, size);
 
-    gl.UnmapBuffer(GL_ARRAY_BUFFER);
+    unmap_buffer(self);
 
+    self->context->stats.bytes_downloaded += size;
     return data;
 }
 
 static PyObject * MGLBuffer_read_into(MGLBuffer * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Buffer.read_into", GL_BUFFER, self->buffer_obj);
+
     PyObject * data;
     Py_ssize_t size;
     Py_ssize_t offset;
@@ -1040,19 +2238,41 @@ static PyObject * MGLBuffer_read_into(MGLBuffer * self, PyObject * args) {
 
     const GLMethods & gl = self->context->gl;
 
-    gl.BindBuffer(GL_ARRAY_BUFFER, self->buffer_obj);
-    void * map = gl.MapBufferRange(GL_ARRAY_BUFFER, offset, size, GL_MAP_READ_BIT);
-
     char * ptr = (char *)buffer_view.buf + write_offset;
+
+    if (self->context->dsa) {
+        Py_BEGIN_ALLOW_THREADS
+        gl.GetNamedBufferSubData(self->buffer_obj, offset, size, ptr);
+        Py_END_ALLOW_THREADS
+        self->context->stats.bytes_downloaded += size;
+        PyBuffer_Release(&buffer_view);
+        Py_RETURN_NONE;
+    }
+
+    void * map = map_buffer_range(self, offset, size, GL_MAP_READ_BIT);
+
+    if (!map) {
+        MGLError_Set("cannot map the buffer");
+        PyBuffer_Release(&buffer_view);
+        return 0;
+    }
+
     memcpy(ptr, map, size);
 
-    gl.UnmapBuffer(GL_ARRAY_BUFFER);
+    unmap_buffer(self);
 
+    self->context->stats.bytes_downloaded += size;
     PyBuffer_Release(&buffer_view);
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLBuffer_write_chunks(MGLBuffer * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Buffer.write_chunks", GL_BUFFER, self->buffer_obj);
+
     PyObject * data;
     Py_ssize_t start;
     Py_ssize_t step;
@@ -1081,13 +2301,10 @@ static PyObject * MGLBuffer_write_chunks(MGLBuffer * self, PyObject * args) {
         return 0;
     }
 
-    const GLMethods & gl = self->context->gl;
-    gl.BindBuffer(GL_ARRAY_BUFFER, self->buffer_obj);
-
     Py_ssize_t chunk_size = buffer_view.len / count;
 
     if (buffer_view.len != chunk_size * count) {
-        MGLError_Set("data (%d bytes) cannot be divided to %d equal chunks", buffer_view.len, count);
+        MGLError_Set("data (%zd bytes) cannot be divided to %zd equal chunks", buffer_view.len, count);
         PyBuffer_Release(&buffer_view);
         return 0;
     }
@@ -1102,7 +2319,7 @@ static PyObject * MGLBuffer_write_chunks(MGLBuffer * self, PyObject * args) {
         return 0;
     }
 
-    char * write_ptr = (char *)gl.MapBufferRange(GL_ARRAY_BUFFER, 0, self->size, GL_MAP_WRITE_BIT);
+    char * write_ptr = (char *)map_buffer_range(self, 0, self->size, GL_MAP_WRITE_BIT);
     char * read_ptr = (char *)buffer_view.buf;
 
     if (!write_ptr) {
@@ -1118,12 +2335,19 @@ static PyObject * MGLBuffer_write_chunks(MGLBuffer * self, PyObject * args) {
         write_ptr += step;
     }
 
-    gl.UnmapBuffer(GL_ARRAY_BUFFER);
+    unmap_buffer(self);
+    self->context->stats.bytes_uploaded += buffer_view.len;
     PyBuffer_Release(&buffer_view);
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLBuffer_read_chunks(MGLBuffer * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Buffer.read_chunks", GL_BUFFER, self->buffer_obj);
+
     Py_ssize_t chunk_size;
     Py_ssize_t start;
     Py_ssize_t step;
@@ -1153,11 +2377,7 @@ static PyObject * MGLBuffer_read_chunks(MGLBuffer * self, PyObject * args) {
         return 0;
     }
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.BindBuffer(GL_ARRAY_BUFFER, self->buffer_obj);
-
-    char * read_ptr = (char *)gl.MapBufferRange(GL_ARRAY_BUFFER, 0, self->size, GL_MAP_READ_BIT);
+    char * read_ptr = (char *)map_buffer_range(self, 0, self->size, GL_MAP_READ_BIT);
 
     if (!read_ptr) {
         MGLError_Set("cannot map the buffer");
@@ -1174,11 +2394,16 @@ static PyObject * MGLBuffer_read_chunks(MGLBuffer * self, PyObject * args) {
         read_ptr += step;
     }
 
-    gl.UnmapBuffer(GL_ARRAY_BUFFER);
+    unmap_buffer(self);
+    self->context->stats.bytes_downloaded += chunk_size * count;
     return data;
 }
 
 static PyObject * MGLBuffer_read_chunks_into(MGLBuffer * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     PyObject * data;
     Py_ssize_t chunk_size;
     Py_ssize_t start;
@@ -1201,6 +2426,17 @@ static PyObject * MGLBuffer_read_chunks_into(MGLBuffer * self, PyObject * args)
         return 0;
     }
 
+    Py_ssize_t abs_step = step > 0 ? step : -step;
+
+    if (start < 0) {
+        start = self->size + start;
+    }
+
+    if (start < 0 || chunk_size < 0 || count < 0 || write_offset < 0 || chunk_size > abs_step || start + chunk_size > self->size || start + count * step - step < 0 || start + count * step - step + chunk_size > self->size) {
+        MGLError_Set("size error");
+        return 0;
+    }
+
     Py_buffer buffer_view;
 
     int get_buffer = PyObject_GetBuffer(data, &buffer_view, PyBUF_WRITABLE);
@@ -1209,15 +2445,18 @@ static PyObject * MGLBuffer_read_chunks_into(MGLBuffer * self, PyObject * args)
         return 0;
     }
 
-    const GLMethods & gl = self->context->gl;
+    if (buffer_view.len < write_offset + chunk_size * count) {
+        MGLError_Set("the buffer is too small");
+        PyBuffer_Release(&buffer_view);
+        return 0;
+    }
 
-    gl.BindBuffer(GL_ARRAY_BUFFER, self->buffer_obj);
-
-    char * read_ptr = (char *)gl.MapBufferRange(GL_ARRAY_BUFFER, 0, self->size, GL_MAP_READ_BIT);
+    char * read_ptr = (char *)map_buffer_range(self, 0, self->size, GL_MAP_READ_BIT);
     char * write_ptr = (char *)buffer_view.buf + write_offset;
 
     if (!read_ptr) {
         MGLError_Set("cannot map the buffer");
+        PyBuffer_Release(&buffer_view);
         return 0;
     }
 
@@ -1228,12 +2467,19 @@ static PyObject * MGLBuffer_read_chunks_into(MGLBuffer * self, PyObject * args)
         read_ptr += step;
     }
 
-    gl.UnmapBuffer(GL_ARRAY_BUFFER);
+    unmap_buffer(self);
+    self->context->stats.bytes_downloaded += chunk_size * count;
     PyBuffer_Release(&buffer_view);
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLBuffer_clear(MGLBuffer * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Buffer.clear", GL_BUFFER, self->buffer_obj);
+
     Py_ssize_t size;
     Py_ssize_t offset;
     PyObject * chunk;
@@ -1274,12 +2520,19 @@ static PyObject * MGLBuffer_clear(MGLBuffer * self, PyObject * args) {
     }
 
     const GLMethods & gl = self->context->gl;
-    gl.BindBuffer(GL_ARRAY_BUFFER, self->buffer_obj);
 
-    char * map = (char *)gl.MapBufferRange(GL_ARRAY_BUFFER, offset, size, GL_MAP_WRITE_BIT);
+    if (self->context->dsa && !buffer_view.len) {
+        gl.ClearNamedBufferSubData(self->buffer_obj, GL_R8, offset, size, GL_RED, GL_UNSIGNED_BYTE, NULL);
+        Py_RETURN_NONE;
+    }
+
+    char * map = (char *)map_buffer_range(self, offset, size, GL_MAP_WRITE_BIT);
 
     if (!map) {
         MGLError_Set("cannot map the buffer");
+        if (chunk != Py_None) {
+            PyBuffer_Release(&buffer_view);
+        }
         return 0;
     }
 
@@ -1291,10 +2544,10 @@ static PyObject * MGLBuffer_clear(MGLBuffer * self, PyObject * args) {
             map[i] = src[i % divisor];
         }
     } else {
-        memset(map + offset, 0, size);
+        memset(map, 0, size);
     }
 
-    gl.UnmapBuffer(GL_ARRAY_BUFFER);
+    unmap_buffer(self);
 
     if (chunk != Py_None) {
         PyBuffer_Release(&buffer_view);
@@ -1304,6 +2557,10 @@ static PyObject * MGLBuffer_clear(MGLBuffer * self, PyObject * args) {
 }
 
 static PyObject * MGLBuffer_orphan(MGLBuffer * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     Py_ssize_t size;
 
     int args_ok = PyArg_ParseTuple(
@@ -1318,15 +2575,26 @@ static PyObject * MGLBuffer_orphan(MGLBuffer * self, PyObject * args) {
 
     if (size > 0) {
         self->size = size;
+        memory_resize(self->context, &self->memory, memory_bytes(self));
     }
 
     const GLMethods & gl = self->context->gl;
-    gl.BindBuffer(GL_ARRAY_BUFFER, self->buffer_obj);
-    gl.BufferData(GL_ARRAY_BUFFER, self->size, 0, self->dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    if (self->context->dsa) {
+        gl.NamedBufferData(self->buffer_obj, self->size, 0, self->dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    } else {
+        gl.BindBuffer(GL_ARRAY_BUFFER, self->buffer_obj);
+        gl.BufferData(GL_ARRAY_BUFFER, self->size, 0, self->dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    }
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLBuffer_bind_to_uniform_block(MGLBuffer * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Buffer.bind_to_uniform_block", GL_BUFFER, self->buffer_obj, true);
+
     int binding;
     Py_ssize_t offset;
     Py_ssize_t size;
@@ -1348,11 +2616,17 @@ static PyObject * MGLBuffer_bind_to_uniform_block(MGLBuffer * self, PyObject * a
     }
 
     const GLMethods & gl = self->context->gl;
-    gl.BindBufferRange(GL_UNIFORM_BUFFER, binding, self->buffer_obj, offset, size);
+    gl.BindBufferRange(GL_UNIFORM_BUFFER, binding, self->buffer_obj, (GLintptr)offset, (GLsizeiptr)size);
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLBuffer_bind_to_storage_buffer(MGLBuffer * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Buffer.bind_to_storage_buffer", GL_BUFFER, self->buffer_obj, true);
+
     int binding;
     Py_ssize_t offset;
     Py_ssize_t size;
@@ -1374,7 +2648,7 @@ static PyObject * MGLBuffer_bind_to_storage_buffer(MGLBuffer * self, PyObject *
     }
 
     const GLMethods & gl = self->context->gl;
-    gl.BindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, self->buffer_obj, offset, size);
+    gl.BindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, self->buffer_obj, (GLintptr)offset, (GLsizeiptr)size);
     Py_RETURN_NONE;
 }
 
@@ -1382,7 +2656,12 @@ static PyObject * MGLBuffer_release(MGLBuffer * self, PyObject * args) {
     if (self->released || self->external) {
         Py_RETURN_NONE;
     }
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     self->released = true;
+    self->context->stats.objects_released += 1;
+    memory_untrack(self->context, &self->memory);
 
     const GLMethods & gl = self->context->gl;
     gl.DeleteBuffers(1, (GLuint *)&self->buffer_obj);
@@ -1397,11 +2676,14 @@ static PyObject * MGLBuffer_size(MGLBuffer * self, PyObject * args) {
 }
 
 static int MGLBuffer_tp_as_buffer_get_view(MGLBuffer * self, Py_buffer * view, int flags) {
+    if (!check_context_thread(self->context)) {
+        view->obj = 0;
+        return -1;
+    }
+
     int access = (flags == PyBUF_SIMPLE) ? GL_MAP_READ_BIT : (GL_MAP_READ_BIT | GL_MAP_WRITE_BIT);
 
-    const GLMethods & gl = self->context->gl;
-    gl.BindBuffer(GL_ARRAY_BUFFER, self->buffer_obj);
-    void * map = gl.MapBufferRange(GL_ARRAY_BUFFER, 0, self->size, access);
+    void * map = map_buffer_range(self, 0, self->size, access);
 
     if (!map) {
         PyErr_Format(PyExc_BufferError, "Cannot map buffer");
@@ -1425,8 +2707,7 @@ static int MGLBuffer_tp_as_buffer_get_view(MGLBuffer * self, Py_buffer * view, i
 }
 
 static void MGLBuffer_tp_as_buffer_release_view(MGLBuffer * self, Py_buffer * view) {
-    const GLMethods & gl = self->context->gl;
-    gl.UnmapBuffer(GL_ARRAY_BUFFER);
+    unmap_buffer(self);
 }
 
 struct AttachmentParameters {
@@ -1439,10 +2720,10 @@ struct AttachmentParameters {
     int glo;
 };
 
-static int attachment_parameters(PyObject * attachment, AttachmentParameters * parameters, int must_be_depth) {
+static int attachment_parameters(ModuleState * state, PyObject * attachment, AttachmentParameters * parameters, int must_be_depth) {
     int width = 0, height = 0, samples = 0, renderbuffer = 0, layered = 0, glo = 0, depth = 0;
 
-    if (Py_TYPE(attachment) == MGLTexture_type) {
+    if (Py_TYPE(attachment) == state->MGLTexture_type) {
         MGLTexture * image = (MGLTexture *)attachment;
         depth = image->depth;
         width = image->width;
@@ -1453,7 +2734,7 @@ static int attachment_parameters(PyObject * attachment, AttachmentParameters * p
         layered = 0;
     }
 
-    if (Py_TYPE(attachment) == MGLTextureArray_type) {
+    if (Py_TYPE(attachment) == state->MGLTextureArray_type) {
         MGLTextureArray * image = (MGLTextureArray *)attachment;
         depth = 0;
         width = image->width;
@@ -1464,7 +2745,7 @@ static int attachment_parameters(PyObject * attachment, AttachmentParameters * p
         layered = 1;
     }
 
-    if (Py_TYPE(attachment) == MGLRenderbuffer_type) {
+    if (Py_TYPE(attachment) == state->MGLRenderbuffer_type) {
         MGLRenderbuffer * image = (MGLRenderbuffer *)attachment;
         depth = image->depth;
         width = image->width;
@@ -1494,6 +2775,10 @@ static int attachment_parameters(PyObject * attachment, AttachmentParameters * p
 }
 
 static PyObject * MGLContext_framebuffer(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
     PyObject * color_attachments_arg;
     PyObject * depth_attachment_arg;
 
@@ -1514,29 +2799,42 @@ static PyObject * MGLContext_framebuffer(MGLContext * self, PyObject * args) {
         return NULL;
     }
 
-    MGLFramebuffer * framebuffer = PyObject_New(MGLFramebuffer, MGLFramebuffer_type);
+    MGLFramebuffer * framebuffer = PyObject_New(MGLFramebuffer, self->state->MGLFramebuffer_type);
     framebuffer->released = false;
+    framebuffer->scaled = {};
 
     framebuffer->framebuffer_obj = 0;
-    gl.GenFramebuffers(1, (GLuint *)&framebuffer->framebuffer_obj);
+    if (self->dsa) {
+        gl.CreateFramebuffers(1, (GLuint *)&framebuffer->framebuffer_obj);
+    } else {
+        gl.GenFramebuffers(1, (GLuint *)&framebuffer->framebuffer_obj);
+    }
 
     if (!framebuffer->framebuffer_obj) {
         MGLError_Set("cannot create framebuffer");
         return NULL;
     }
 
-    gl.BindFramebuffer(GL_FRAMEBUFFER, framebuffer->framebuffer_obj);
+    if (!self->dsa) {
+        gl.BindFramebuffer(GL_FRAMEBUFFER, framebuffer->framebuffer_obj);
+    }
 
     AttachmentParameters params = {};
     int color_attachments_count = (int)PyTuple_Size(color_attachments_arg);
 
     for (int i = 0; i < color_attachments_count; ++i) {
         PyObject * attachment = PyTuple_GetItem(color_attachments_arg, i);
-        if (!attachment_parameters(attachment, &params, false)) {
+        if (!attachment_parameters(self->state, attachment, &params, false)) {
             MGLError_Set("invalid color attachment");
             return NULL;
         }
-        if (params.renderbuffer) {
+        if (self->dsa) {
+            if (params.renderbuffer) {
+                gl.NamedFramebufferRenderbuffer(framebuffer->framebuffer_obj, GL_COLOR_ATTACHMENT0 + i, GL_RENDERBUFFER, params.glo);
+            } else {
+                gl.NamedFramebufferTexture(framebuffer->framebuffer_obj, GL_COLOR_ATTACHMENT0 + i, params.glo, 0);
+            }
+        } else if (params.renderbuffer) {
             gl.FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_RENDERBUFFER, params.glo);
         } else if (!params.layered) {
             int target = params.samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
@@ -1547,11 +2845,17 @@ static PyObject * MGLContext_framebuffer(MGLContext * self, PyObject * args) {
     }
 
     if (depth_attachment_arg != Py_None) {
-        if (!attachment_parameters(depth_attachment_arg, &params, true)) {
+        if (!attachment_parameters(self->state, depth_attachment_arg, &params, true)) {
             MGLError_Set("invalid depth attachment");
             return NULL;
         }
-        if (params.renderbuffer) {
+        if (self->dsa) {
+            if (params.renderbuffer) {
+                gl.NamedFramebufferRenderbuffer(framebuffer->framebuffer_obj, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, params.glo);
+            } else {
+                gl.NamedFramebufferTexture(framebuffer->framebuffer_obj, GL_DEPTH_ATTACHMENT, params.glo, 0);
+            }
+        } else if (params.renderbuffer) {
             gl.FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, params.glo);
         } else {
             int target = params.samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
@@ -1564,13 +2868,20 @@ static PyObject * MGLContext_framebuffer(MGLContext * self, PyObject * args) {
         return NULL;
     }
 
-    if (!color_attachments_count) {
-        gl.DrawBuffer(GL_NONE);
-    }
-
-    int status = gl.CheckFramebufferStatus(GL_FRAMEBUFFER);
+    int status = 0;
 
-    gl.BindFramebuffer(GL_FRAMEBUFFER, self->bound_framebuffer->framebuffer_obj);
+    if (self->dsa) {
+        if (!color_attachments_count) {
+            gl.NamedFramebufferDrawBuffer(framebuffer->framebuffer_obj, GL_NONE);
+        }
+        status = gl.CheckNamedFramebufferStatus(framebuffer->framebuffer_obj, GL_FRAMEBUFFER);
+    } else {
+        if (!color_attachments_count) {
+            gl.DrawBuffer(GL_NONE);
+        }
+        status = gl.CheckFramebufferStatus(GL_FRAMEBUFFER);
+        gl.BindFramebuffer(GL_FRAMEBUFFER, self->bound_framebuffer->framebuffer_obj);
+    }
 
     switch (status) {
         case GL_FRAMEBUFFER_UNDEFINED:
@@ -1629,10 +2940,15 @@ static PyObject * MGLContext_framebuffer(MGLContext * self, PyObject * args) {
 
     Py_DECREF(color_attachments_arg);
 
+    self->stats.objects_created += 1;
     return Py_BuildValue("(O(ii)ii)", framebuffer, framebuffer->width, framebuffer->height, framebuffer->samples, framebuffer->framebuffer_obj);
 }
 
 static PyObject * MGLContext_empty_framebuffer(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
     int width;
     int height;
     int layers = 0;
@@ -1644,8 +2960,9 @@ static PyObject * MGLContext_empty_framebuffer(MGLContext * self, PyObject * arg
 
     const GLMethods & gl = self->gl;
 
-    MGLFramebuffer * framebuffer = PyObject_New(MGLFramebuffer, MGLFramebuffer_type);
+    MGLFramebuffer * framebuffer = PyObject_New(MGLFramebuffer, self->state->MGLFramebuffer_type);
     framebuffer->released = false;
+    framebuffer->scaled = {};
 
     framebuffer->framebuffer_obj = 0;
     gl.GenFramebuffers(1, (GLuint *)&framebuffer->framebuffer_obj);
@@ -1732,14 +3049,97 @@ static PyObject * MGLContext_empty_framebuffer(MGLContext * self, PyObject * arg
     Py_INCREF(self);
     framebuffer->context = self;
 
+    self->stats.objects_created += 1;
     return Py_BuildValue("(O(ii)ii)", framebuffer, framebuffer->width, framebuffer->height, framebuffer->samples, framebuffer->framebuffer_obj);
 }
 
+// Without a queue the names are deleted immediately
+static void release_scaled_read(MGLFramebuffer * self, MGLReleaseQueue * queue) {
+    ScaledRead * scaled = &self->scaled;
+    for (int i = 0; i < scaled->num_targets; ++i) {
+        memory_untrack(self->context, &scaled->memory[i]);
+        if (queue) {
+            release_queue_push(queue, MGL_RELEASE_FRAMEBUFFER, scaled->framebuffer_obj[i]);
+            release_queue_push(queue, MGL_RELEASE_RENDERBUFFER, scaled->renderbuffer_obj[i]);
+        }
+    }
+    if (scaled->num_targets && !queue) {
+        self->context->gl.DeleteFramebuffers(scaled->num_targets, (GLuint *)scaled->framebuffer_obj);
+        self->context->gl.DeleteRenderbuffers(scaled->num_targets, (GLuint *)scaled->renderbuffer_obj);
+    }
+    *scaled = {};
+}
+
+// Four channels with the component type and size of the source
+static int scaled_read_format(int component_type, int component_size, int * pixel_size) {
+    switch (component_type) {
+        case GL_INT:
+            *pixel_size = component_size <= 8 ? 4 : component_size <= 16 ? 8 : 16;
+            return component_size <= 8 ? GL_RGBA8I : component_size <= 16 ? GL_RGBA16I : GL_RGBA32I;
+        case GL_UNSIGNED_INT:
+            *pixel_size = component_size <= 8 ? 4 : component_size <= 16 ? 8 : 16;
+            return component_size <= 8 ? GL_RGBA8UI : component_size <= 16 ? GL_RGBA16UI : GL_RGBA32UI;
+        case GL_FLOAT:
+            *pixel_size = component_size <= 16 ? 8 : 16;
+            return component_size <= 16 ? GL_RGBA16F : GL_RGBA32F;
+        case GL_SIGNED_NORMALIZED:
+            // The signed normalized formats are not required to be renderable
+            *pixel_size = component_size <= 8 ? 8 : 16;
+            return component_size <= 8 ? GL_RGBA16F : GL_RGBA32F;
+    }
+    *pixel_size = component_size <= 8 ? 4 : 8;
+    return component_size <= 8 ? GL_RGBA8 : GL_RGBA16;
+}
+
+// The dtype of a texture that holds a color attachment without losing precision
+static PyObject * MGLFramebuffer_color_dtype(MGLFramebuffer * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    int attachment;
+
+    if (!PyArg_ParseTuple(args, "i", &attachment)) {
+        return NULL;
+    }
+
+    const GLMethods & gl = self->context->gl;
+    int point = self->framebuffer_obj ? GL_COLOR_ATTACHMENT0 + attachment : GL_BACK_LEFT;
+    int object_type = GL_NONE;
+    int component_type = GL_UNSIGNED_NORMALIZED;
+    int component_size = 8;
+
+    gl.BindFramebuffer(GL_READ_FRAMEBUFFER, self->framebuffer_obj);
+    gl.GetFramebufferAttachmentParameteriv(GL_READ_FRAMEBUFFER, point, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &object_type);
+    if (object_type != GL_NONE) {
+        gl.GetFramebufferAttachmentParameteriv(GL_READ_FRAMEBUFFER, point, GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE, &component_type);
+        gl.GetFramebufferAttachmentParameteriv(GL_READ_FRAMEBUFFER, point, GL_FRAMEBUFFER_ATTACHMENT_RED_SIZE, &component_size);
+    }
+    gl.BindFramebuffer(GL_READ_FRAMEBUFFER, self->context->bound_framebuffer->framebuffer_obj);
+
+    switch (component_type) {
+        case GL_INT:
+            return PyUnicode_FromString(component_size <= 8 ? "i1" : component_size <= 16 ? "i2" : "i4");
+        case GL_UNSIGNED_INT:
+            return PyUnicode_FromString(component_size <= 8 ? "u1" : component_size <= 16 ? "u2" : "u4");
+        case GL_FLOAT:
+        case GL_SIGNED_NORMALIZED:
+            return PyUnicode_FromString(component_size <= 16 ? "f2" : "f4");
+    }
+    return PyUnicode_FromString(component_size <= 8 ? "f1" : "nu2");
+}
+
 static PyObject * MGLFramebuffer_release(MGLFramebuffer * self, PyObject * args) {
     if (self->released) {
         Py_RETURN_NONE;
     }
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     self->released = true;
+    self->context->stats.objects_released += 1;
+
+    release_scaled_read(self, NULL);
 
     if (self->framebuffer_obj) {
         self->context->gl.DeleteFramebuffers(1, (GLuint *)&self->framebuffer_obj);
@@ -1751,6 +3151,12 @@ static PyObject * MGLFramebuffer_release(MGLFramebuffer * self, PyObject * args)
 }
 
 static PyObject * MGLFramebuffer_clear(MGLFramebuffer * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Framebuffer.clear", GL_FRAMEBUFFER, self->framebuffer_obj);
+
     float r, g, b, a, depth;
     PyObject * viewport_arg;
 
@@ -1820,6 +3226,12 @@ static PyObject * MGLFramebuffer_clear(MGLFramebuffer * self, PyObject * args) {
 }
 
 static PyObject * MGLFramebuffer_use(MGLFramebuffer * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Framebuffer.use", GL_FRAMEBUFFER, self->framebuffer_obj);
+
     const GLMethods & gl = self->context->gl;
 
     gl.BindFramebuffer(GL_FRAMEBUFFER, self->framebuffer_obj);
@@ -1857,10 +3269,164 @@ static PyObject * MGLFramebuffer_use(MGLFramebuffer * self, PyObject * args) {
     Py_DECREF(self->context->bound_framebuffer);
     self->context->bound_framebuffer = self;
 
+    self->context->stats.framebuffer_binds += 1;
     Py_RETURN_NONE;
 }
 
+static int blit_scaled(MGLFramebuffer * self, int attachment, Rect src, int width, int height, int filter, bool box) {
+    ScaledRead * scaled = &self->scaled;
+    const GLMethods & gl = self->context->gl;
+    bool dsa = self->context->dsa;
+
+    if (!dsa) {
+        gl.BindFramebuffer(GL_READ_FRAMEBUFFER, self->framebuffer_obj);
+    }
+
+    // The intermediate images keep the precision of the source, integer images cannot be filtered
+    // The attachments of the default framebuffer are not queried, 16 bits cover its usual formats
+    int component_type = GL_UNSIGNED_NORMALIZED;
+    int component_size = 16;
+    if (self->framebuffer_obj && dsa) {
+        gl.GetNamedFramebufferAttachmentParameteriv(self->framebuffer_obj, GL_COLOR_ATTACHMENT0 + attachment, GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE, &component_type);
+        gl.GetNamedFramebufferAttachmentParameteriv(self->framebuffer_obj, GL_COLOR_ATTACHMENT0 + attachment, GL_FRAMEBUFFER_ATTACHMENT_RED_SIZE, &component_size);
+    } else if (self->framebuffer_obj) {
+        gl.GetFramebufferAttachmentParameteriv(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + attachment, GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE, &component_type);
+        gl.GetFramebufferAttachmentParameteriv(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + attachment, GL_FRAMEBUFFER_ATTACHMENT_RED_SIZE, &component_size);
+    }
+
+    if (component_type == GL_INT || component_type == GL_UNSIGNED_INT) {
+        filter = GL_NEAREST;
+        box = false;
+    }
+
+    // The halving steps of a box filter would round an 8 bit image on every step
+    if (box) {
+        component_size = MGL_MAX(component_size, 16);
+    }
+
+    int pixel_size = 0;
+    int internal_format = scaled_read_format(component_type, component_size, &pixel_size);
+
+    // A multisample source is resolved first, a box filter halves the image with linear blits
+    // until it is within a factor of two of the requested size. A halving step is an exact 2x2
+    // average for even sizes only, an odd size is rounded down and the linear taps drift by up to
+    // half a source pixel, so the result approximates a box filter there.
+
+    Rect steps[66];
+    int num_steps = 0;
+    int step_width = src.width;
+    int step_height = src.height;
+
+    if (self->samples) {
+        steps[num_steps++] = rect(0, 0, step_width, step_height);
+    }
+
+    while (box && (step_width >= width * 2 || step_height >= height * 2)) {
+        step_width = MGL_MAX(step_width / 2, width);
+        step_height = MGL_MAX(step_height / 2, height);
+        steps[num_steps++] = rect(0, 0, step_width, step_height);
+    }
+
+    if (!num_steps || step_width != width || step_height != height) {
+        steps[num_steps++] = rect(0, 0, width, height);
+    }
+
+    int max_width = 0;
+    int max_height = 0;
+    for (int i = 0; i < num_steps; ++i) {
+        max_width = MGL_MAX(max_width, steps[i].width);
+        max_height = MGL_MAX(max_height, steps[i].height);
+    }
+
+    int num_targets = num_steps > 1 ? 2 : 1;
+    bool reuse = scaled->num_targets >= num_targets && scaled->internal_format == internal_format &&
+        scaled->width >= max_width && scaled->height >= max_height;
+
+    if (!reuse) {
+        // Grow to the largest read so far, alternating sizes do not reallocate every time
+        max_width = MGL_MAX(max_width, scaled->width);
+        max_height = MGL_MAX(max_height, scaled->height);
+        num_targets = MGL_MAX(num_targets, scaled->num_targets);
+        release_scaled_read(self, NULL);
+
+        if (dsa) {
+            gl.CreateFramebuffers(num_targets, (GLuint *)scaled->framebuffer_obj);
+            gl.CreateRenderbuffers(num_targets, (GLuint *)scaled->renderbuffer_obj);
+        } else {
+            gl.GenFramebuffers(num_targets, (GLuint *)scaled->framebuffer_obj);
+            gl.GenRenderbuffers(num_targets, (GLuint *)scaled->renderbuffer_obj);
+        }
+
+        for (int i = 0; i < num_targets && dsa; ++i) {
+            gl.NamedRenderbufferStorage(scaled->renderbuffer_obj[i], internal_format, max_width, max_height);
+            gl.NamedFramebufferRenderbuffer(scaled->framebuffer_obj[i], GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, scaled->renderbuffer_obj[i]);
+        }
+
+        for (int i = 0; i < num_targets && !dsa; ++i) {
+            gl.BindRenderbuffer(GL_RENDERBUFFER, scaled->renderbuffer_obj[i]);
+            gl.RenderbufferStorage(GL_RENDERBUFFER, internal_format, max_width, max_height);
+            gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, scaled->framebuffer_obj[i]);
+            gl.FramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, scaled->renderbuffer_obj[i]);
+        }
+
+        // Counted as renderbuffers of the context
+        for (int i = 0; i < num_targets; ++i) {
+            long long bytes = (long long)max_width * max_height * pixel_size;
+            memory_track(self->context, &scaled->memory[i], MGL_MEMORY_RENDERBUFFER, scaled->renderbuffer_obj[i], bytes);
+        }
+
+        scaled->num_targets = num_targets;
+        scaled->internal_format = internal_format;
+        scaled->width = max_width;
+        scaled->height = max_height;
+    }
+
+    gl.Disable(GL_SCISSOR_TEST);
+
+    int read_framebuffer = self->framebuffer_obj;
+    int read_buffer = GL_COLOR_ATTACHMENT0 + attachment;
+    Rect from = src;
+
+    for (int i = 0; i < num_steps; ++i) {
+        int target = i % num_targets;
+        int step_filter = (self->samples && !i) ? GL_NEAREST : filter;
+        if (dsa) {
+            gl.NamedFramebufferReadBuffer(read_framebuffer, read_buffer);
+            gl.BlitNamedFramebuffer(
+                read_framebuffer, scaled->framebuffer_obj[target],
+                from.x, from.y, from.x + from.width, from.y + from.height,
+                0, 0, steps[i].width, steps[i].height,
+                GL_COLOR_BUFFER_BIT, step_filter
+            );
+        } else {
+            gl.BindFramebuffer(GL_READ_FRAMEBUFFER, read_framebuffer);
+            gl.ReadBuffer(read_buffer);
+            gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, scaled->framebuffer_obj[target]);
+            gl.BlitFramebuffer(
+                from.x, from.y, from.x + from.width, from.y + from.height,
+                0, 0, steps[i].width, steps[i].height,
+                GL_COLOR_BUFFER_BIT, step_filter
+            );
+        }
+        read_framebuffer = scaled->framebuffer_obj[target];
+        read_buffer = GL_COLOR_ATTACHMENT0;
+        from = steps[i];
+    }
+
+    if (self->context->bound_framebuffer->scissor_enabled) {
+        gl.Enable(GL_SCISSOR_TEST);
+    }
+
+    return read_framebuffer;
+}
+
 static PyObject * MGLFramebuffer_read_into(MGLFramebuffer * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Framebuffer.read", GL_FRAMEBUFFER, self->framebuffer_obj);
+
     PyObject * data;
     PyObject * viewport_arg;
     int components;
@@ -1870,10 +3436,15 @@ static PyObject * MGLFramebuffer_read_into(MGLFramebuffer * self, PyObject * arg
 
     const char * dtype;
     Py_ssize_t write_offset;
+    int flip_y;
+    Py_ssize_t row_stride;
+    const char * channels;
+    PyObject * scale_arg;
+    const char * filter_arg;
 
     int args_ok = PyArg_ParseTuple(
         args,
-        "OOIIIpsn",
+        "OOIIIpsnpnzOs",
         &data,
         &viewport_arg,
         &components,
@@ -1881,7 +3452,12 @@ static PyObject * MGLFramebuffer_read_into(MGLFramebuffer * self, PyObject * arg
         &alignment,
         &clamp,
         &dtype,
-        &write_offset
+        &write_offset,
+        &flip_y,
+        &row_stride,
+        &channels,
+        &scale_arg,
+        &filter_arg
     );
 
     if (!args_ok) {
@@ -1915,38 +3491,69 @@ static PyObject * MGLFramebuffer_read_into(MGLFramebuffer * self, PyObject * arg
         read_depth = true;
     }
 
-    unsigned long long expected_size = (unsigned long long)viewport_rect.width * components * data_type->size;
-    expected_size = (expected_size + alignment - 1) / alignment * alignment;
-    expected_size = expected_size * viewport_rect.height;
+    bool scaled_read = scale_arg != Py_None;
+    int filter = GL_LINEAR;
+    bool box = false;
+    Rect read_rect = viewport_rect;
 
-    int pixel_type = data_type->gl_type;
-    int base_format = read_depth ? GL_DEPTH_COMPONENT : data_type->base_format[components];
+    if (scaled_read) {
+        int scale_width = 0;
+        int scale_height = 0;
 
-    if (Py_TYPE(data) == MGLBuffer_type) {
+        if (!PyArg_ParseTuple(scale_arg, "ii", &scale_width, &scale_height)) {
+            PyErr_Clear();
+            MGLError_Set("the scale must be a tuple of two integers");
+            return 0;
+        }
 
-        MGLBuffer * buffer = (MGLBuffer *)data;
+        if (scale_width <= 0 || scale_height <= 0) {
+            MGLError_Set("the scale must be positive");
+            return 0;
+        }
 
-        const GLMethods & gl = self->context->gl;
+        if (read_depth) {
+            MGLError_Set("the scale is only supported for color attachments");
+            return 0;
+        }
 
-        if (clamp) {
-            gl.ClampColor(GL_CLAMP_READ_COLOR, GL_TRUE);
+        if (!strcmp(filter_arg, "box")) {
+            box = true;
+        } else if (!strcmp(filter_arg, "linear")) {
+            filter = GL_LINEAR;
+        } else if (!strcmp(filter_arg, "nearest")) {
+            filter = GL_NEAREST;
         } else {
-            gl.ClampColor(GL_CLAMP_READ_COLOR, GL_FIXED_ONLY);
+            MGLError_Set("invalid filter %s, expected box, linear or nearest", filter_arg);
+            return 0;
         }
 
-        gl.BindBuffer(GL_PIXEL_PACK_BUFFER, buffer->buffer_obj);
-        gl.BindFramebuffer(GL_FRAMEBUFFER, self->framebuffer_obj);
-        gl.ReadBuffer(read_depth ? GL_NONE : (GL_COLOR_ATTACHMENT0 + attachment));
-        gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
-        gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.ReadPixels(viewport_rect.x, viewport_rect.y, viewport_rect.width, viewport_rect.height, base_format, pixel_type, (void *)write_offset);
-        gl.BindFramebuffer(GL_FRAMEBUFFER, self->context->bound_framebuffer->framebuffer_obj);
-        gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        read_rect = rect(0, 0, scale_width, scale_height);
+    }
 
-    } else {
+    ReadLayout layout;
+    if (!parse_read_layout(&layout, channels, components, read_rect.width, read_rect.height, alignment, row_stride, data_type, read_depth)) {
+        return 0;
+    }
 
-        Py_buffer buffer_view;
+    unsigned long long expected_size = layout.required_size;
+
+    int pixel_type = data_type->gl_type;
+    int base_format = layout.base_format;
+    int pixel_size = layout.components * layout.element_size;
+
+    bool pack_buffer = Py_TYPE(data) == self->context->state->MGLBuffer_type;
+
+    Py_buffer buffer_view;
+    char * ptr;
+
+    if (pack_buffer) {
+        if (layout.convert) {
+            MGLError_Set("the channels %s cannot be read into a Buffer", channels);
+            return 0;
+        }
 
+        ptr = (char *)write_offset;
+    } else {
         int get_buffer = PyObject_GetBuffer(data, &buffer_view, PyBUF_WRITABLE);
         if (get_buffer < 0) {
             // Propagate the default error
@@ -1959,27 +3566,75 @@ static PyObject * MGLFramebuffer_read_into(MGLFramebuffer * self, PyObject * arg
             return 0;
         }
 
-        char * ptr = (char *)buffer_view.buf + write_offset;
+        ptr = (char *)buffer_view.buf + write_offset;
+    }
 
-        const GLMethods & gl = self->context->gl;
+    const GLMethods & gl = self->context->gl;
 
-        if (clamp) {
-            gl.ClampColor(GL_CLAMP_READ_COLOR, GL_TRUE);
-        } else {
-            gl.ClampColor(GL_CLAMP_READ_COLOR, GL_FIXED_ONLY);
+    if (clamp) {
+        gl.ClampColor(GL_CLAMP_READ_COLOR, GL_TRUE);
+    } else {
+        gl.ClampColor(GL_CLAMP_READ_COLOR, GL_FIXED_ONLY);
+    }
+
+    int read_framebuffer = self->framebuffer_obj;
+    int read_buffer = read_depth ? GL_NONE : (GL_COLOR_ATTACHMENT0 + attachment);
+
+    if (scaled_read) {
+        // Only the small image is packed, the full resolution never leaves the gpu
+        read_framebuffer = blit_scaled(self, attachment, viewport_rect, read_rect.width, read_rect.height, filter, box);
+        read_buffer = GL_COLOR_ATTACHMENT0;
+    }
+
+    if (pack_buffer) {
+        gl.BindBuffer(GL_PIXEL_PACK_BUFFER, ((MGLBuffer *)data)->buffer_obj);
+    }
+
+    if (self->context->dsa) {
+        // Only the read bind point is used, the bound draw framebuffer stays untouched
+        gl.NamedFramebufferReadBuffer(read_framebuffer, read_buffer);
+        gl.BindFramebuffer(GL_READ_FRAMEBUFFER, read_framebuffer);
+    } else {
+        gl.BindFramebuffer(GL_FRAMEBUFFER, read_framebuffer);
+        gl.ReadBuffer(read_buffer);
+    }
+    gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+
+    if (layout.convert) {
+        char * temp = new char[(Py_ssize_t)read_rect.width * read_rect.height * layout.read_components * layout.element_size];
+        gl.PixelStorei(GL_PACK_ALIGNMENT, 1);
+        gl.PixelStorei(GL_PACK_ROW_LENGTH, 0);
+        Py_BEGIN_ALLOW_THREADS
+        gl.ReadPixels(read_rect.x, read_rect.y, read_rect.width, read_rect.height, base_format, pixel_type, temp);
+        Py_END_ALLOW_THREADS
+        swizzle_pixels(temp, ptr, read_rect.width, read_rect.height, layout, flip_y);
+        delete[] temp;
+    } else if (!(flip_y && pack_buffer) && set_pack_row_stride(gl, layout.row_stride, pixel_size)) {
+        Py_BEGIN_ALLOW_THREADS
+        gl.ReadPixels(read_rect.x, read_rect.y, read_rect.width, read_rect.height, base_format, pixel_type, ptr);
+        Py_END_ALLOW_THREADS
+        if (flip_y) {
+            flip_rows(ptr, read_rect.height, layout.row_size, layout.row_stride);
         }
+    } else {
+        // Rows packed into a Buffer are copied by the gpu, this does not stall the pipeline
+        read_pixel_rows(gl, read_rect, base_format, pixel_type, ptr, layout.row_stride, flip_y);
+    }
 
-        gl.BindFramebuffer(GL_FRAMEBUFFER, self->framebuffer_obj);
-        gl.ReadBuffer(read_depth ? GL_NONE : (GL_COLOR_ATTACHMENT0 + attachment));
-        gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
-        gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.ReadPixels(viewport_rect.x, viewport_rect.y, viewport_rect.width, viewport_rect.height, base_format, pixel_type, ptr);
-        gl.BindFramebuffer(GL_FRAMEBUFFER, self->context->bound_framebuffer->framebuffer_obj);
+    gl.PixelStorei(GL_PACK_ROW_LENGTH, 0);
+    gl.BindFramebuffer(self->context->dsa ? GL_READ_FRAMEBUFFER : GL_FRAMEBUFFER, self->context->bound_framebuffer->framebuffer_obj);
 
+    if (pack_buffer) {
+        gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    } else {
         PyBuffer_Release(&buffer_view);
     }
 
-    return PyLong_FromLong(expected_size);
+    if (!pack_buffer) {
+        self->context->stats.bytes_downloaded += expected_size;
+    }
+
+    return PyLong_FromUnsignedLongLong(expected_size);
 }
 
 static PyObject * MGLFramebuffer_get_viewport(MGLFramebuffer * self, void * closure) {
@@ -1987,6 +3642,9 @@ static PyObject * MGLFramebuffer_get_viewport(MGLFramebuffer * self, void * clos
 }
 
 static int MGLFramebuffer_set_viewport(MGLFramebuffer * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     Rect viewport_rect = {};
     if (!parse_rect(value, &viewport_rect)) {
         MGLError_Set("wrong values in the viewport");
@@ -2013,6 +3671,9 @@ static PyObject * MGLFramebuffer_get_scissor(MGLFramebuffer * self, void * closu
 }
 
 static int MGLFramebuffer_set_scissor(MGLFramebuffer * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     if (value == Py_None) {
         self->scissor = rect(0, 0, self->width, self->height);
         self->scissor_enabled = false;
@@ -2088,6 +3749,9 @@ static int parse_mask(PyObject * arg, char * value) {
 }
 
 static int MGLFramebuffer_set_color_mask(MGLFramebuffer * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     if (self->draw_buffers_len == 1) {
         if (!parse_mask(value, &self->color_mask[0])) {
             MGLError_Set("invalid color mask");
@@ -2127,6 +3791,9 @@ static PyObject * MGLFramebuffer_get_depth_mask(MGLFramebuffer * self, void * cl
 }
 
 static int MGLFramebuffer_set_depth_mask(MGLFramebuffer * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     if (value == Py_True) {
         self->depth_mask = true;
     } else if (value == Py_False) {
@@ -2145,6 +3812,9 @@ static int MGLFramebuffer_set_depth_mask(MGLFramebuffer * self, PyObject * value
 }
 
 static PyObject * MGLFramebuffer_get_bits(MGLFramebuffer * self, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     if (self->framebuffer_obj) {
         MGLError_Set("only the default_framebuffer have bits");
         return 0;
@@ -2195,6 +3865,10 @@ static PyObject * MGLFramebuffer_get_bits(MGLFramebuffer * self, void * closure)
 }
 
 static PyObject * MGLContext_program(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
     PyObject * shaders[8];
     PyObject * varyings_arg;
     PyObject * fragment_outputs;
@@ -2229,7 +3903,7 @@ static PyObject * MGLContext_program(MGLContext * self, PyObject * args) {
 
     int varyings_count = (int)PyTuple_Size(varyings_arg);
 
-    MGLProgram * program = PyObject_New(MGLProgram, MGLProgram_type);
+    MGLProgram * program = PyObject_New(MGLProgram, self->state->MGLProgram_type);
     program->released = false;
 
     Py_INCREF(self);
@@ -2251,6 +3925,8 @@ static PyObject * MGLContext_program(MGLContext * self, PyObject * args) {
             continue;
         }
 
+        MGLStartupScope startup(self, MGL_STARTUP_COMPILE);
+
         int shader_obj = gl.CreateShader(SHADER_TYPE[i]);
         if (!shader_obj) {
             MGLError_Set("cannot create shader");
@@ -2267,7 +3943,7 @@ static PyObject * MGLContext_program(MGLContext * self, PyObject * args) {
         }
 
         if (PyUnicode_Check(shaders[i])) {
-            shaders[i] = PyObject_CallMethod(helper, "resolve_includes", "(ON)", self, shaders[i]);
+            shaders[i] = PyObject_CallMethod(self->state->helper, "resolve_includes", "(ON)", self, shaders[i]);
             if (!shaders[i]) {
                 return NULL;
             }
@@ -2365,7 +4041,13 @@ static PyObject * MGLContext_program(MGLContext * self, PyObject * args) {
         }
     }
 
-    gl.LinkProgram(program_obj);
+    int linked = GL_FALSE;
+
+    {
+        MGLStartupScope startup(self, MGL_STARTUP_LINK);
+        gl.LinkProgram(program_obj);
+        gl.GetProgramiv(program_obj, GL_LINK_STATUS, &linked);
+    }
 
     // Delete the shader objects after the program is linked
     for (int i = 0; i < NUM_SHADER_SLOTS; ++i) {
@@ -2374,9 +4056,6 @@ static PyObject * MGLContext_program(MGLContext * self, PyObject * args) {
         }
     }
 
-    int linked = GL_FALSE;
-    gl.GetProgramiv(program_obj, GL_LINK_STATUS, &linked);
-
     if (!linked) {
         const char * message = "GLSL Linker failed";
         const char * title = "Program";
@@ -2521,6 +4200,9 @@ static PyObject * MGLContext_program(MGLContext * self, PyObject * args) {
 
     Py_INCREF(program);
 
+    // The members are built by calling back into Python
+    MGLStartupScope startup(self, MGL_STARTUP_REFLECTION);
+
     int num_attributes = 0;
     int num_varyings = 0;
     int num_uniforms = 0;
@@ -2554,7 +4236,7 @@ static PyObject * MGLContext_program(MGLContext * self, PyObject * args) {
         clean_glsl_name(name, name_len);
 
         PyObject * item = PyObject_CallMethod(
-            helper, "make_attribute", "(siiOi)",
+            self->state->helper, "make_attribute", "(siiOi)",
             name, type, program->program_obj, location, array_length
         );
 
@@ -2574,7 +4256,7 @@ static PyObject * MGLContext_program(MGLContext * self, PyObject * args) {
 
         gl.GetTransformFeedbackVarying(program->program_obj, i, 256, &name_len, &array_length, (GLenum *)&type, name);
 
-        PyObject * item = PyObject_CallMethod(helper, "make_varying", "(siii)", name, i, array_length, dimension);
+        PyObject * item = PyObject_CallMethod(self->state->helper, "make_varying", "(siii)", name, i, array_length, dimension);
         PyDict_SetItemString(members_dict, name, item);
         Py_DECREF(item);
     }
@@ -2595,7 +4277,7 @@ static PyObject * MGLContext_program(MGLContext * self, PyObject * args) {
         }
 
         PyObject * item = PyObject_CallMethod(
-            helper, "make_uniform", "(siiiiO)",
+            self->state->helper, "make_uniform", "(siiiiO)",
             name, type, program->program_obj, location, array_length, self
         );
 
@@ -2615,7 +4297,7 @@ static PyObject * MGLContext_program(MGLContext * self, PyObject * args) {
         clean_glsl_name(name, name_len);
 
         PyObject * item = PyObject_CallMethod(
-            helper, "make_uniform_block", "(siiiO)",
+            self->state->helper, "make_uniform_block", "(siiiO)",
             name, program->program_obj, index, size, self
         );
 
@@ -2631,7 +4313,7 @@ static PyObject * MGLContext_program(MGLContext * self, PyObject * args) {
         clean_glsl_name(name, name_len);
 
         PyObject * item = PyObject_CallMethod(
-            helper, "make_storage_block", "(siiO)",
+            self->state->helper, "make_storage_block", "(siiO)",
             name, program_obj, i, self
         );
 
@@ -2646,10 +4328,17 @@ static PyObject * MGLContext_program(MGLContext * self, PyObject * args) {
         geom_info = Py_BuildValue("(OOi)", Py_None, Py_None, 0);
     }
     PyObject * members_and_attributes = Py_BuildValue("(NNN)", members_dict, attribute_locations, attribute_types);
+    self->stats.objects_created += 1;
     return Py_BuildValue("(ONNNi)", program, members_and_attributes, PyTuple_New(0), geom_info, program->program_obj);
 }
 
 static PyObject * MGLProgram_run(MGLProgram * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "ComputeShader.run", GL_PROGRAM, self->program_obj);
+
     unsigned x;
     unsigned y;
     unsigned z;
@@ -2661,27 +4350,45 @@ static PyObject * MGLProgram_run(MGLProgram * self, PyObject * args) {
     const GLMethods & gl = self->context->gl;
 
     gl.UseProgram(self->program_obj);
+    self->context->stats.dispatches += 1;
+    self->context->stats.program_binds += 1;
+    Py_BEGIN_ALLOW_THREADS
     gl.DispatchCompute(x, y, z);
+    Py_END_ALLOW_THREADS
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLProgram_run_indirect(MGLProgram * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "ComputeShader.run_indirect", GL_PROGRAM, self->program_obj);
+
     MGLBuffer * buffer;
     Py_ssize_t offset = 0;
 
-    if (!PyArg_ParseTuple(args, "O!|n", MGLBuffer_type, &buffer, &offset)) {
+    if (!PyArg_ParseTuple(args, "O!|n", self->context->state->MGLBuffer_type, &buffer, &offset)) {
         return 0;
     }
 
     const GLMethods & gl = self->context->gl;
 
     gl.UseProgram(self->program_obj);
+    self->context->stats.dispatches += 1;
+    self->context->stats.program_binds += 1;
     gl.BindBuffer(GL_DISPATCH_INDIRECT_BUFFER, buffer->buffer_obj);
     gl.DispatchComputeIndirect((GLintptr)offset);
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLProgram_draw_mesh_tasks(MGLProgram * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Program.draw_mesh_tasks", GL_PROGRAM, self->program_obj);
+
     unsigned first;
     unsigned count;
 
@@ -2689,45 +4396,74 @@ static PyObject * MGLProgram_draw_mesh_tasks(MGLProgram * self, PyObject * args)
         return 0;
     }
 
+    if (!load_gl_mesh_shader_methods(self->context->gl)) {
+        MGLError_Set("mesh shaders are not supported");
+        return 0;
+    }
+
     const GLMethods & gl = self->context->gl;
 
     gl.UseProgram(self->program_obj);
+    self->context->stats.draws += 1;
+    self->context->stats.program_binds += 1;
     gl.DrawMeshTasksNV(first, count);
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLProgram_draw_mesh_tasks_indirect(MGLProgram * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     MGLBuffer * buffer;
     Py_ssize_t offset = 0;
     Py_ssize_t drawcount = 1;
     Py_ssize_t stride = 0;
 
-    if (!PyArg_ParseTuple(args, "O!|nnn", MGLBuffer_type, &buffer, &offset, &drawcount, &stride)) {
+    if (!PyArg_ParseTuple(args, "O!|nnn", self->context->state->MGLBuffer_type, &buffer, &offset, &drawcount, &stride)) {
+        return 0;
+    }
+
+    if (!load_gl_mesh_shader_methods(self->context->gl)) {
+        MGLError_Set("mesh shaders are not supported");
         return 0;
     }
 
     const GLMethods & gl = self->context->gl;
 
     gl.UseProgram(self->program_obj);
+    self->context->stats.draws += 1;
+    self->context->stats.program_binds += 1;
     gl.BindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer->buffer_obj);
     gl.MultiDrawMeshTasksIndirectNV((GLintptr)offset, (GLsizei)drawcount, (GLsizei)stride);
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLProgram_draw_mesh_tasks_indirect_count(MGLProgram * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     MGLBuffer * buffer;
     Py_ssize_t offset = 0;
     Py_ssize_t drawcount_offset = 0;
     Py_ssize_t maxdrawcount = 1;
     Py_ssize_t stride = 0;
 
-    if (!PyArg_ParseTuple(args, "O!nnn|n", MGLBuffer_type, &buffer, &offset, &drawcount_offset, &maxdrawcount, &stride)) {
+    if (!PyArg_ParseTuple(args, "O!nnn|n", self->context->state->MGLBuffer_type, &buffer, &offset, &drawcount_offset, &maxdrawcount, &stride)) {
+        return 0;
+    }
+
+    if (!load_gl_mesh_shader_methods(self->context->gl)) {
+        MGLError_Set("mesh shaders are not supported");
         return 0;
     }
 
     const GLMethods & gl = self->context->gl;
 
     gl.UseProgram(self->program_obj);
+    self->context->stats.draws += 1;
+    self->context->stats.program_binds += 1;
     gl.BindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer->buffer_obj);
     gl.MultiDrawMeshTasksIndirectCountNV((GLintptr)offset, (GLintptr)drawcount_offset, (GLsizei)maxdrawcount, (GLsizei)stride);
     Py_RETURN_NONE;
@@ -2737,7 +4473,11 @@ static PyObject * MGLProgram_release(MGLProgram * self, PyObject * args) {
     if (self->released) {
         Py_RETURN_NONE;
     }
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     self->released = true;
+    self->context->stats.objects_released += 1;
 
     const GLMethods & gl = self->context->gl;
     gl.DeleteProgram(self->program_obj);
@@ -2747,8 +4487,12 @@ static PyObject * MGLProgram_release(MGLProgram * self, PyObject * args) {
 }
 
 static PyObject * MGLContext_query(MGLContext * self, PyObject * args) {
-    int samples_passed;
-    int any_samples_passed;
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    int samples_passed;
+    int any_samples_passed;
     int time_elapsed;
     int primitives_generated;
 
@@ -2773,7 +4517,7 @@ static PyObject * MGLContext_query(MGLContext * self, PyObject * args) {
         primitives_generated = 1;
     }
 
-    MGLQuery * query = PyObject_New(MGLQuery, MGLQuery_type);
+    MGLQuery * query = PyObject_New(MGLQuery, self->state->MGLQuery_type);
     query->query_obj[SAMPLES_PASSED] = 0;
     query->query_obj[ANY_SAMPLES_PASSED] = 0;
     query->query_obj[TIME_ELAPSED] = 0;
@@ -2801,10 +4545,15 @@ static PyObject * MGLContext_query(MGLContext * self, PyObject * args) {
         gl.GenQueries(1, (GLuint *)&query->query_obj[PRIMITIVES_GENERATED]);
     }
 
+    self->stats.objects_created += 1;
     return (PyObject *)query;
 }
 
 static PyObject * MGLQuery_begin(MGLQuery * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     if (self->state != QUERY_INACTIVE) {
         MGLError_Set(self->state == QUERY_ACTIVE ? "this query is already running" : "this query is in conditional render mode");
         return NULL;
@@ -2833,6 +4582,10 @@ static PyObject * MGLQuery_begin(MGLQuery * self, PyObject * args) {
 }
 
 static PyObject * MGLQuery_end(MGLQuery * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     if (self->state != QUERY_ACTIVE) {
         MGLError_Set(self->state == QUERY_INACTIVE ? "this query was not started" : "this query is in conditional render mode");
         return NULL;
@@ -2862,6 +4615,10 @@ static PyObject * MGLQuery_end(MGLQuery * self, PyObject * args) {
 }
 
 static PyObject * MGLQuery_begin_render(MGLQuery * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     if (self->state != QUERY_INACTIVE) {
         MGLError_Set(self->state == QUERY_ACTIVE ? "this query was not stopped" : "this query is already in conditional render mode");
         return NULL;
@@ -2883,6 +4640,10 @@ static PyObject * MGLQuery_begin_render(MGLQuery * self, PyObject * args) {
 }
 
 static PyObject * MGLQuery_end_render(MGLQuery * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     if (self->state != QUERY_CONDITIONAL_RENDER) {
         MGLError_Set("this query is not in conditional render mode");
         return NULL;
@@ -2894,7 +4655,38 @@ static PyObject * MGLQuery_end_render(MGLQuery * self, PyObject * args) {
     Py_RETURN_NONE;
 }
 
+static bool query_available(MGLQuery * self) {
+    if (self->state == QUERY_ACTIVE || !self->ended) {
+        return false;
+    }
+
+    const GLMethods & gl = self->context->gl;
+
+    for (int i = 0; i < 4; ++i) {
+        if (self->query_obj[i]) {
+            GLuint available = GL_FALSE;
+            gl.GetQueryObjectuiv(self->query_obj[i], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static GLuint64 query_result(MGLQuery * self, int index) {
+    // Elapsed times above 4.29 seconds do not fit in 32 bits
+    GLuint64 result = 0;
+    if (self->ended) {
+        self->context->gl.GetQueryObjectui64v(self->query_obj[index], GL_QUERY_RESULT, &result);
+    }
+    return result;
+}
+
 static PyObject * MGLQuery_get_samples(MGLQuery * self, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     if (!self->query_obj[SAMPLES_PASSED]) {
         MGLError_Set("query created without the samples_passed flag");
         return NULL;
@@ -2905,17 +4697,13 @@ static PyObject * MGLQuery_get_samples(MGLQuery * self, void * closure) {
         return NULL;
     }
 
-    const GLMethods & gl = self->context->gl;
-
-    unsigned samples = 0;
-    if (self->ended) {
-        gl.GetQueryObjectuiv(self->query_obj[SAMPLES_PASSED], GL_QUERY_RESULT, &samples);
-    }
-
-    return PyLong_FromUnsignedLong(samples);
+    return PyLong_FromUnsignedLongLong(query_result(self, SAMPLES_PASSED));
 }
 
 static PyObject * MGLQuery_get_primitives(MGLQuery * self, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     if (!self->query_obj[PRIMITIVES_GENERATED]) {
         MGLError_Set("query created without the primitives_generated flag");
         return NULL;
@@ -2926,17 +4714,13 @@ static PyObject * MGLQuery_get_primitives(MGLQuery * self, void * closure) {
         return NULL;
     }
 
-    const GLMethods & gl = self->context->gl;
-
-    unsigned primitives = 0;
-    if (self->ended) {
-        gl.GetQueryObjectuiv(self->query_obj[PRIMITIVES_GENERATED], GL_QUERY_RESULT, &primitives);
-    }
-
-    return PyLong_FromUnsignedLong(primitives);
+    return PyLong_FromUnsignedLongLong(query_result(self, PRIMITIVES_GENERATED));
 }
 
 static PyObject * MGLQuery_get_elapsed(MGLQuery * self, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     if (!self->query_obj[TIME_ELAPSED]) {
         MGLError_Set("query created without the time_elapsed flag");
         return NULL;
@@ -2947,14 +4731,144 @@ static PyObject * MGLQuery_get_elapsed(MGLQuery * self, void * closure) {
         return NULL;
     }
 
+    return PyLong_FromUnsignedLongLong(query_result(self, TIME_ELAPSED));
+}
+
+static PyObject * MGLQuery_get_available(MGLQuery * self, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+    return PyBool_FromLong(query_available(self));
+}
+
+static PyObject * MGLQuery_result(MGLQuery * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+    int wait;
+
+    int args_ok = PyArg_ParseTuple(
+        args,
+        "p",
+        &wait
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
+    if (self->state == QUERY_ACTIVE) {
+        MGLError_Set("this query was not stopped");
+        return NULL;
+    }
+
+    // Without waiting the results are read only when all of them are available
+    if (!self->ended || (!wait && !query_available(self))) {
+        Py_RETURN_NONE;
+    }
+
+    PyObject * res = PyTuple_New(4);
+    for (int i = 0; i < 4; ++i) {
+        PyObject * item = Py_None;
+        if (self->query_obj[i]) {
+            item = PyLong_FromUnsignedLongLong(query_result(self, i));
+        } else {
+            Py_INCREF(item);
+        }
+        PyTuple_SET_ITEM(res, i, item);
+    }
+    return res;
+}
+
+static PyObject * MGLQuery_read_into(MGLQuery * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLBuffer * buffer;
+    Py_ssize_t offset;
+    int index;
+    int wait;
+    int wide;
+
+    int args_ok = PyArg_ParseTuple(
+        args,
+        "O!nipp",
+        self->context->state->MGLBuffer_type,
+        &buffer,
+        &offset,
+        &index,
+        &wait,
+        &wide
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
+    if (index < 0 || index >= 4 || !self->query_obj[index]) {
+        MGLError_Set("query created without this result");
+        return NULL;
+    }
+
+    if (self->state == QUERY_ACTIVE) {
+        MGLError_Set("this query was not stopped");
+        return NULL;
+    }
+
+    if (!self->ended) {
+        MGLError_Set("this query has no result");
+        return NULL;
+    }
+
+    MGLContext * ctx = self->context;
+    if (ctx->version_code < 440 && !has_extension(ctx, "GL_ARB_query_buffer_object")) {
+        MGLError_Set("query buffers require OpenGL 4.4 or GL_ARB_query_buffer_object");
+        return NULL;
+    }
+
+    Py_ssize_t size = wide ? 8 : 4;
+    if (offset < 0 || offset + size > buffer->size) {
+        MGLError_Set("out of range offset = %zd or size = %zd", offset, size);
+        return NULL;
+    }
+
+    // The GPU writes the result when it is available, the CPU does not wait for it
+    const GLMethods & gl = ctx->gl;
+    GLenum pname = wait ? GL_QUERY_RESULT : GL_QUERY_RESULT_NO_WAIT;
+    gl.BindBuffer(GL_QUERY_BUFFER, buffer->buffer_obj);
+    if (wide) {
+        gl.GetQueryObjectui64v(self->query_obj[index], pname, (GLuint64 *)offset);
+    } else {
+        gl.GetQueryObjectuiv(self->query_obj[index], pname, (GLuint *)offset);
+    }
+    gl.BindBuffer(GL_QUERY_BUFFER, 0);
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLQuery_release(MGLQuery * self, PyObject * args) {
+    if (self->released) {
+        Py_RETURN_NONE;
+    }
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+    self->released = true;
+    self->context->stats.objects_released += 1;
+
     const GLMethods & gl = self->context->gl;
+    if (self->state == QUERY_CONDITIONAL_RENDER) {
+        gl.EndConditionalRender();
+    }
 
-    unsigned elapsed = 0;
-    if (self->ended) {
-        gl.GetQueryObjectuiv(self->query_obj[TIME_ELAPSED], GL_QUERY_RESULT, &elapsed);
+    for (int i = 0; i < 4; ++i) {
+        if (self->query_obj[i]) {
+            gl.DeleteQueries(1, (GLuint *)&self->query_obj[i]);
+        }
     }
 
-    return PyLong_FromUnsignedLong(elapsed);
+    Py_DECREF(self->context);
+    Py_RETURN_NONE;
 }
 
 // TODO: Add label support for MGLQuery (it contains multiple OpenGL query objects)
@@ -2963,7 +4877,12 @@ static PyObject * MGLRenderbuffer_release(MGLRenderbuffer * self, PyObject * arg
     if (self->released) {
         Py_RETURN_NONE;
     }
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     self->released = true;
+    self->context->stats.objects_released += 1;
+    memory_untrack(self->context, &self->memory);
 
     const GLMethods & gl = self->context->gl;
     gl.DeleteRenderbuffers(1, (GLuint *)&self->renderbuffer_obj);
@@ -2973,6 +4892,10 @@ static PyObject * MGLRenderbuffer_release(MGLRenderbuffer * self, PyObject * arg
 }
 
 static PyObject * MGLContext_sampler(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
     int args_ok = PyArg_ParseTuple(
         args,
         ""
@@ -2984,7 +4907,7 @@ static PyObject * MGLContext_sampler(MGLContext * self, PyObject * args) {
 
     const GLMethods & gl = self->gl;
 
-    MGLSampler * sampler = PyObject_New(MGLSampler, MGLSampler_type);
+    MGLSampler * sampler = PyObject_New(MGLSampler, self->state->MGLSampler_type);
     sampler->released = false;
 
     gl.GenSamplers(1, (GLuint *)&sampler->sampler_obj);
@@ -3006,10 +4929,17 @@ static PyObject * MGLContext_sampler(MGLContext * self, PyObject * args) {
     Py_INCREF(self);
     sampler->context = self;
 
+    self->stats.objects_created += 1;
     return Py_BuildValue("(Oi)", sampler, sampler->sampler_obj);
 }
 
 static PyObject * MGLContext_memory_barrier(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self, "Context.memory_barrier", 0, 0, true);
+
     unsigned barriers = GL_ALL_BARRIER_BITS;
     int by_region = false;
 
@@ -3031,6 +4961,12 @@ static PyObject * MGLContext_memory_barrier(MGLContext * self, PyObject * args)
 }
 
 static PyObject * MGLSampler_use(MGLSampler * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Sampler.use", GL_SAMPLER, self->sampler_obj, true);
+
     int index;
 
     if (!PyArg_ParseTuple(args, "I", &index)) {
@@ -3039,10 +4975,15 @@ static PyObject * MGLSampler_use(MGLSampler * self, PyObject * args) {
 
     const GLMethods & gl = self->context->gl;
     gl.BindSampler(index, self->sampler_obj);
+    self->context->stats.sampler_binds += 1;
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLSampler_clear(MGLSampler * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     int index;
 
     int args_ok = PyArg_ParseTuple(
@@ -3065,7 +5006,11 @@ static PyObject * MGLSampler_release(MGLSampler * self, PyObject * args) {
     if (self->released) {
         Py_RETURN_NONE;
     }
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     self->released = true;
+    self->context->stats.objects_released += 1;
 
     const GLMethods & gl = self->context->gl;
     gl.DeleteSamplers(1, (GLuint *)&self->sampler_obj);
@@ -3080,6 +5025,9 @@ static PyObject * MGLSampler_get_repeat_x(MGLSampler * self, void * closure) {
 }
 
 static int MGLSampler_set_repeat_x(MGLSampler * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     const GLMethods & gl = self->context->gl;
 
     if (value == Py_True) {
@@ -3101,6 +5049,9 @@ static PyObject * MGLSampler_get_repeat_y(MGLSampler * self, void * closure) {
 }
 
 static int MGLSampler_set_repeat_y(MGLSampler * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     const GLMethods & gl = self->context->gl;
 
     if (value == Py_True) {
@@ -3122,6 +5073,9 @@ static PyObject * MGLSampler_get_repeat_z(MGLSampler * self, void * closure) {
 }
 
 static int MGLSampler_set_repeat_z(MGLSampler * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     const GLMethods & gl = self->context->gl;
 
     if (value == Py_True) {
@@ -3162,6 +5116,9 @@ static int parse_filter(PyObject * arg, int * min_filter_value, int * mag_filter
 }
 
 static int MGLSampler_set_filter(MGLSampler * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     if (!parse_filter(value, &self->min_filter, &self->mag_filter)) {
         MGLError_Set("invalid filter");
         return -1;
@@ -3178,6 +5135,9 @@ static PyObject * MGLSampler_get_compare_func(MGLSampler * self, void * closure)
 }
 
 static int MGLSampler_set_compare_func(MGLSampler * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     const char * func = PyUnicode_AsUTF8(value);
     if (!func) {
         MGLError_Set("invalid compare function");
@@ -3202,8 +5162,12 @@ static PyObject * MGLSampler_get_anisotropy(MGLSampler * self, void * closure) {
 }
 
 static int MGLSampler_set_anisotropy(MGLSampler * self, PyObject * value, void * closure) {
-    if (self->context->max_anisotropy == 0) return 0;
-    self->anisotropy = (float)MGL_MIN(MGL_MAX(PyFloat_AsDouble(value), 1.0), self->context->max_anisotropy);
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
+    float max_anisotropy = context_max_anisotropy(self->context);
+    if (max_anisotropy == 0) return 0;
+    self->anisotropy = (float)MGL_MIN(MGL_MAX(PyFloat_AsDouble(value), 1.0), max_anisotropy);
 
     const GLMethods & gl = self->context->gl;
     gl.SamplerParameterf(self->sampler_obj, GL_TEXTURE_MAX_ANISOTROPY, self->anisotropy);
@@ -3239,6 +5203,9 @@ static int parse_color(PyObject * arg, float * value) {
 }
 
 static int MGLSampler_set_border_color(MGLSampler * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     if (!parse_color(value, self->border_color)) {
         MGLError_Set("invalid border color");
         return -1;
@@ -3258,6 +5225,9 @@ static PyObject * MGLSampler_get_min_lod(MGLSampler * self, void * closure) {
 }
 
 static int MGLSampler_set_min_lod(MGLSampler * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     self->min_lod = (float)PyFloat_AsDouble(value);
 
     const GLMethods & gl = self->context->gl;
@@ -3271,6 +5241,9 @@ static PyObject * MGLSampler_get_max_lod(MGLSampler * self, void * closure) {
 }
 
 static int MGLSampler_set_max_lod(MGLSampler * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     self->max_lod = (float)PyFloat_AsDouble(value);
 
     const GLMethods & gl = self->context->gl;
@@ -3279,7 +5252,7 @@ static int MGLSampler_set_max_lod(MGLSampler * self, PyObject * value, void * cl
     return 0;
 }
 
-static int parse_texture_binding(PyObject * arg, TextureBinding * value) {
+static int parse_texture_binding(ModuleState * state, PyObject * arg, TextureBinding * value) {
     arg = PySequence_Tuple(arg);
     if (!arg || PyTuple_Size(arg) != 2) {
         PyErr_Clear();
@@ -3290,19 +5263,19 @@ static int parse_texture_binding(PyObject * arg, TextureBinding * value) {
     int texture_type = 0;
     int texture_obj = 0;
 
-    if (Py_TYPE(item) == MGLTexture_type) {
+    if (Py_TYPE(item) == state->MGLTexture_type) {
         MGLTexture * texture = (MGLTexture *)item;
         texture_type = texture->samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
         texture_obj = texture->texture_obj;
     }
 
-    if (Py_TYPE(item) == MGLTexture3D_type) {
+    if (Py_TYPE(item) == state->MGLTexture3D_type) {
         MGLTexture3D * texture = (MGLTexture3D *)item;
         texture_type = GL_TEXTURE_3D;
         texture_obj = texture->texture_obj;
     }
 
-    if (Py_TYPE(item) == MGLTextureCube_type) {
+    if (Py_TYPE(item) == state->MGLTextureCube_type) {
         MGLTextureCube * texture = (MGLTextureCube *)item;
         texture_type = GL_TEXTURE_CUBE_MAP;
         texture_obj = texture->texture_obj;
@@ -3325,7 +5298,7 @@ static int parse_texture_binding(PyObject * arg, TextureBinding * value) {
     return 1;
 }
 
-static int parse_buffer_binding(PyObject * arg, BufferBinding * value) {
+static int parse_buffer_binding(ModuleState * state, PyObject * arg, BufferBinding * value) {
     arg = PySequence_Tuple(arg);
     if (!arg || PyTuple_Size(arg) != 2) {
         PyErr_Clear();
@@ -3335,7 +5308,7 @@ static int parse_buffer_binding(PyObject * arg, BufferBinding * value) {
     PyObject * item = PyTuple_GetItem(arg, 0);
     int buffer_obj = 0;
 
-    if (Py_TYPE(item) == MGLBuffer_type) {
+    if (Py_TYPE(item) == state->MGLBuffer_type) {
         MGLBuffer * buffer = (MGLBuffer *)item;
         buffer_obj = buffer->buffer_obj;
     }
@@ -3389,6 +5362,10 @@ static int parse_sampler_binding(PyObject * arg, SamplerBinding * value) {
 }
 
 static PyObject * MGLContext_scope(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
     MGLFramebuffer * framebuffer;
     PyObject * enable_flags;
     PyObject * textures_arg;
@@ -3399,7 +5376,7 @@ static PyObject * MGLContext_scope(MGLContext * self, PyObject * args) {
     int args_ok = PyArg_ParseTuple(
         args,
         "O!OOOOO",
-        MGLFramebuffer_type,
+        self->state->MGLFramebuffer_type,
         &framebuffer,
         &enable_flags,
         &textures_arg,
@@ -3449,7 +5426,7 @@ static PyObject * MGLContext_scope(MGLContext * self, PyObject * args) {
         }
     }
 
-    MGLScope * scope = PyObject_New(MGLScope, MGLScope_type);
+    MGLScope * scope = PyObject_New(MGLScope, self->state->MGLScope_type);
     scope->released = false;
 
     Py_INCREF(self);
@@ -3474,21 +5451,21 @@ static PyObject * MGLContext_scope(MGLContext * self, PyObject * args) {
     scope->samplers = (SamplerBinding *)PyMem_Malloc(scope->num_samplers * sizeof(SamplerBinding));
 
     for (int i = 0; i < scope->num_textures; ++i) {
-        if (!parse_texture_binding(PyTuple_GetItem(textures_arg, i), &scope->textures[i])) {
+        if (!parse_texture_binding(self->state, PyTuple_GetItem(textures_arg, i), &scope->textures[i])) {
             MGLError_Set("invalid textures");
             return NULL;
         }
     }
 
     for (int i = 0; i < scope->num_uniform_buffers; ++i) {
-        if (!parse_buffer_binding(PyTuple_GetItem(uniform_buffers_arg, i), &scope->uniform_buffers[i])) {
+        if (!parse_buffer_binding(self->state, PyTuple_GetItem(uniform_buffers_arg, i), &scope->uniform_buffers[i])) {
             MGLError_Set("invalid uniform buffers");
             return NULL;
         }
     }
 
     for (int i = 0; i < scope->num_storage_buffers; ++i) {
-        if (!parse_buffer_binding(PyTuple_GetItem(storage_buffers_arg, i), &scope->storage_buffers[i])) {
+        if (!parse_buffer_binding(self->state, PyTuple_GetItem(storage_buffers_arg, i), &scope->storage_buffers[i])) {
             MGLError_Set("invalid storage buffers");
             return NULL;
         }
@@ -3507,10 +5484,17 @@ static PyObject * MGLContext_scope(MGLContext * self, PyObject * args) {
     Py_DECREF(samplers_arg);
 
     Py_INCREF(scope);
+    self->stats.objects_created += 1;
     return (PyObject *)scope;
 }
 
 static PyObject * MGLScope_begin(MGLScope * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Scope.begin", 0, 0, true);
+
     const GLMethods & gl = self->context->gl;
     const int & flags = self->enable_flags;
 
@@ -3523,6 +5507,7 @@ static PyObject * MGLScope_begin(MGLScope * self, PyObject * args) {
         gl.ActiveTexture(self->textures[i].location);
         gl.BindTexture(self->textures[i].type, self->textures[i].glo);
     }
+    self->context->stats.texture_binds += self->num_textures;
 
     for (int i = 0; i < self->num_uniform_buffers; ++i) {
         gl.BindBufferBase(GL_UNIFORM_BUFFER, self->uniform_buffers[i].location, self->uniform_buffers[i].glo);
@@ -3574,6 +5559,12 @@ static PyObject * MGLScope_begin(MGLScope * self, PyObject * args) {
 }
 
 static PyObject * MGLScope_end(MGLScope * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Scope.end", 0, 0, true);
+
     const GLMethods & gl = self->context->gl;
     const int & flags = self->old_enable_flags;
 
@@ -3619,6 +5610,7 @@ static PyObject * MGLScope_release(MGLScope * self, PyObject * args) {
         Py_RETURN_NONE;
     }
     self->released = true;
+    self->context->stats.objects_released += 1;
 
     Py_DECREF(self->framebuffer);
     Py_DECREF(self->old_framebuffer);
@@ -3629,6 +5621,12 @@ static PyObject * MGLScope_release(MGLScope * self, PyObject * args) {
 }
 
 static PyObject * MGLContext_texture(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLStartupScope startup(self, MGL_STARTUP_TEXTURES);
+
     int width;
     int height;
 
@@ -3666,7 +5664,7 @@ static PyObject * MGLContext_texture(MGLContext * self, PyObject * args) {
         return 0;
     }
 
-    if ((samples & (samples - 1)) || samples > self->max_samples) {
+    if ((samples & (samples - 1)) || samples > context_limit(self, &self->max_samples, GL_MAX_SAMPLES)) {
         MGLError_Set("the number of samples is invalid");
         return 0;
     }
@@ -3696,13 +5694,17 @@ static PyObject * MGLContext_texture(MGLContext * self, PyObject * args) {
     if (use_renderbuffer) {
         const GLMethods & gl = self->gl;
 
-        MGLRenderbuffer * renderbuffer = PyObject_New(MGLRenderbuffer, MGLRenderbuffer_type);
+        MGLRenderbuffer * renderbuffer = PyObject_New(MGLRenderbuffer, self->state->MGLRenderbuffer_type);
         renderbuffer->released = false;
 
         int format = data_type->internal_format[components];
 
         renderbuffer->renderbuffer_obj = 0;
-        gl.GenRenderbuffers(1, (GLuint *)&renderbuffer->renderbuffer_obj);
+        if (self->dsa) {
+            gl.CreateRenderbuffers(1, (GLuint *)&renderbuffer->renderbuffer_obj);
+        } else {
+            gl.GenRenderbuffers(1, (GLuint *)&renderbuffer->renderbuffer_obj);
+        }
 
         if (!renderbuffer->renderbuffer_obj) {
             MGLError_Set("cannot create renderbuffer");
@@ -3710,12 +5712,20 @@ static PyObject * MGLContext_texture(MGLContext * self, PyObject * args) {
             return 0;
         }
 
-        gl.BindRenderbuffer(GL_RENDERBUFFER, renderbuffer->renderbuffer_obj);
-
-        if (samples == 0) {
-            gl.RenderbufferStorage(GL_RENDERBUFFER, format, width, height);
+        if (self->dsa) {
+            if (samples == 0) {
+                gl.NamedRenderbufferStorage(renderbuffer->renderbuffer_obj, format, width, height);
+            } else {
+                gl.NamedRenderbufferStorageMultisample(renderbuffer->renderbuffer_obj, samples, format, width, height);
+            }
         } else {
-            gl.RenderbufferStorageMultisample(GL_RENDERBUFFER, samples, format, width, height);
+            gl.BindRenderbuffer(GL_RENDERBUFFER, renderbuffer->renderbuffer_obj);
+
+            if (samples == 0) {
+                gl.RenderbufferStorage(GL_RENDERBUFFER, format, width, height);
+            } else {
+                gl.RenderbufferStorageMultisample(GL_RENDERBUFFER, samples, format, width, height);
+            }
         }
 
         renderbuffer->width = width;
@@ -3728,6 +5738,8 @@ static PyObject * MGLContext_texture(MGLContext * self, PyObject * args) {
         Py_INCREF(self);
         renderbuffer->context = self;
 
+        self->stats.objects_created += 1;
+        memory_track(self, &renderbuffer->memory, MGL_MEMORY_RENDERBUFFER, renderbuffer->renderbuffer_obj, memory_bytes(renderbuffer));
         return Py_BuildValue("(Oi)", renderbuffer, renderbuffer->renderbuffer_obj);
     }
 
@@ -3749,7 +5761,7 @@ static PyObject * MGLContext_texture(MGLContext * self, PyObject * args) {
     }
 
     if (buffer_view.len != expected_size) {
-        MGLError_Set("data size mismatch %d != %d", buffer_view.len, expected_size);
+        MGLError_Set("data size mismatch %zd != %llu", buffer_view.len, expected_size);
         if (data != Py_None) {
             PyBuffer_Release(&buffer_view);
         }
@@ -3765,12 +5777,12 @@ static PyObject * MGLContext_texture(MGLContext * self, PyObject * args) {
 
     gl.ActiveTexture(GL_TEXTURE0 + self->default_texture_unit);
 
-    MGLTexture * texture = PyObject_New(MGLTexture, MGLTexture_type);
+    MGLTexture * texture = PyObject_New(MGLTexture, self->state->MGLTexture_type);
     texture->released = false;
     texture->external = false;
 
     texture->texture_obj = 0;
-    gl.GenTextures(1, (GLuint *)&texture->texture_obj);
+    texture->texture_obj = take_name(&self->texture_names, gl.GenTextures);
 
     if (!texture->texture_obj) {
         MGLError_Set("cannot create texture");
@@ -3796,6 +5808,7 @@ static PyObject * MGLContext_texture(MGLContext * self, PyObject * args) {
     }
 
     if (data != Py_None) {
+        self->stats.bytes_uploaded += buffer_view.len;
         PyBuffer_Release(&buffer_view);
     }
 
@@ -3819,10 +5832,18 @@ static PyObject * MGLContext_texture(MGLContext * self, PyObject * args) {
     Py_INCREF(self);
     texture->context = self;
 
+    self->stats.objects_created += 1;
+    memory_track(self, &texture->memory, MGL_MEMORY_TEXTURE, texture->texture_obj, memory_bytes(texture));
     return Py_BuildValue("(Oi)", texture, texture->texture_obj);
 }
 
 static PyObject * MGLContext_depth_texture(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLStartupScope startup(self, MGL_STARTUP_TEXTURES);
+
     int width;
     int height;
 
@@ -3847,7 +5868,7 @@ static PyObject * MGLContext_depth_texture(MGLContext * self, PyObject * args) {
         return 0;
     }
 
-    if ((samples & (samples - 1)) || samples > self->max_samples) {
+    if ((samples & (samples - 1)) || samples > context_limit(self, &self->max_samples, GL_MAX_SAMPLES)) {
         MGLError_Set("the number of samples is invalid");
         return 0;
     }
@@ -3865,11 +5886,15 @@ static PyObject * MGLContext_depth_texture(MGLContext * self, PyObject * args) {
     if (use_renderbuffer) {
         const GLMethods & gl = self->gl;
 
-        MGLRenderbuffer * renderbuffer = PyObject_New(MGLRenderbuffer, MGLRenderbuffer_type);
+        MGLRenderbuffer * renderbuffer = PyObject_New(MGLRenderbuffer, self->state->MGLRenderbuffer_type);
         renderbuffer->released = false;
 
         renderbuffer->renderbuffer_obj = 0;
-        gl.GenRenderbuffers(1, (GLuint *)&renderbuffer->renderbuffer_obj);
+        if (self->dsa) {
+            gl.CreateRenderbuffers(1, (GLuint *)&renderbuffer->renderbuffer_obj);
+        } else {
+            gl.GenRenderbuffers(1, (GLuint *)&renderbuffer->renderbuffer_obj);
+        }
 
         if (!renderbuffer->renderbuffer_obj) {
             MGLError_Set("cannot create renderbuffer");
@@ -3877,12 +5902,20 @@ static PyObject * MGLContext_depth_texture(MGLContext * self, PyObject * args) {
             return 0;
         }
 
-        gl.BindRenderbuffer(GL_RENDERBUFFER, renderbuffer->renderbuffer_obj);
-
-        if (samples == 0) {
-            gl.RenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        if (self->dsa) {
+            if (samples == 0) {
+                gl.NamedRenderbufferStorage(renderbuffer->renderbuffer_obj, GL_DEPTH_COMPONENT24, width, height);
+            } else {
+                gl.NamedRenderbufferStorageMultisample(renderbuffer->renderbuffer_obj, samples, GL_DEPTH_COMPONENT24, width, height);
+            }
         } else {
-            gl.RenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_DEPTH_COMPONENT24, width, height);
+            gl.BindRenderbuffer(GL_RENDERBUFFER, renderbuffer->renderbuffer_obj);
+
+            if (samples == 0) {
+                gl.RenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+            } else {
+                gl.RenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_DEPTH_COMPONENT24, width, height);
+            }
         }
 
         renderbuffer->width = width;
@@ -3895,6 +5928,8 @@ static PyObject * MGLContext_depth_texture(MGLContext * self, PyObject * args) {
         Py_INCREF(self);
         renderbuffer->context = self;
 
+        self->stats.objects_created += 1;
+        memory_track(self, &renderbuffer->memory, MGL_MEMORY_RENDERBUFFER, renderbuffer->renderbuffer_obj, memory_bytes(renderbuffer));
         return Py_BuildValue("(Oi)", renderbuffer, renderbuffer->renderbuffer_obj);
     }
 
@@ -3916,7 +5951,7 @@ static PyObject * MGLContext_depth_texture(MGLContext * self, PyObject * args) {
     }
 
     if (buffer_view.len != expected_size) {
-        MGLError_Set("data size mismatch %d != %d", buffer_view.len, expected_size);
+        MGLError_Set("data size mismatch %zd != %llu", buffer_view.len, expected_size);
         if (data != Py_None) {
             PyBuffer_Release(&buffer_view);
         }
@@ -3930,12 +5965,12 @@ static PyObject * MGLContext_depth_texture(MGLContext * self, PyObject * args) {
 
     gl.ActiveTexture(GL_TEXTURE0 + self->default_texture_unit);
 
-    MGLTexture * texture = PyObject_New(MGLTexture, MGLTexture_type);
+    MGLTexture * texture = PyObject_New(MGLTexture, self->state->MGLTexture_type);
     texture->released = false;
     texture->external = false;
 
     texture->texture_obj = 0;
-    gl.GenTextures(1, (GLuint *)&texture->texture_obj);
+    texture->texture_obj = take_name(&self->texture_names, gl.GenTextures);
 
     if (!texture->texture_obj) {
         MGLError_Set("cannot create texture");
@@ -3958,6 +5993,7 @@ static PyObject * MGLContext_depth_texture(MGLContext * self, PyObject * args) {
     }
 
     if (data != Py_None) {
+        self->stats.bytes_uploaded += buffer_view.len;
         PyBuffer_Release(&buffer_view);
     }
 
@@ -3980,10 +6016,16 @@ static PyObject * MGLContext_depth_texture(MGLContext * self, PyObject * args) {
     Py_INCREF(self);
     texture->context = self;
 
+    self->stats.objects_created += 1;
+    memory_track(self, &texture->memory, MGL_MEMORY_TEXTURE, texture->texture_obj, memory_bytes(texture));
     return Py_BuildValue("(Oi)", texture, texture->texture_obj);
 }
 
 static PyObject * MGLContext_external_texture(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
     int glo;
     int width;
     int height;
@@ -4013,9 +6055,11 @@ static PyObject * MGLContext_external_texture(MGLContext * self, PyObject * args
         return 0;
     }
 
-    MGLTexture * texture = PyObject_New(MGLTexture, MGLTexture_type);
+    MGLTexture * texture = PyObject_New(MGLTexture, self->state->MGLTexture_type);
     texture->released = false;
     texture->external = true;
+    texture->memory.prev = NULL;
+    texture->memory.next = NULL;
 
     texture->texture_obj = glo;
     texture->width = width;
@@ -4041,7 +6085,39 @@ static PyObject * MGLContext_external_texture(MGLContext * self, PyObject * args
     return Py_BuildValue("(Oi)", texture, texture->texture_obj);
 }
 
+static void get_texture_image(MGLTexture * self, int level, int format, int type, Py_ssize_t buf_size, void * pixels) {
+    const GLMethods & gl = self->context->gl;
+    if (self->context->dsa) {
+        Py_BEGIN_ALLOW_THREADS
+        gl.GetTextureImage(self->texture_obj, level, format, type, (int)MGL_MIN(buf_size, (Py_ssize_t)0x7fffffff), pixels);
+        Py_END_ALLOW_THREADS
+        return;
+    }
+    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
+    gl.BindTexture(GL_TEXTURE_2D, self->texture_obj);
+    Py_BEGIN_ALLOW_THREADS
+    gl.GetTexImage(GL_TEXTURE_2D, level, format, type, pixels);
+    Py_END_ALLOW_THREADS
+}
+
+static void texture_sub_image(MGLTexture * self, int level, Rect rect, int format, int type, const void * pixels) {
+    const GLMethods & gl = self->context->gl;
+    if (self->context->dsa) {
+        gl.TextureSubImage2D(self->texture_obj, level, rect.x, rect.y, rect.width, rect.height, format, type, pixels);
+        return;
+    }
+    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
+    gl.BindTexture(GL_TEXTURE_2D, self->texture_obj);
+    gl.TexSubImage2D(GL_TEXTURE_2D, level, rect.x, rect.y, rect.width, rect.height, format, type, pixels);
+}
+
 static PyObject * MGLTexture_read(MGLTexture * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Texture.read", GL_TEXTURE, self->texture_obj);
+
     int level;
     int alignment;
 
@@ -4089,9 +6165,6 @@ static PyObject * MGLTexture_read(MGLTexture * self, PyObject * args) {
 
     const GLMethods & gl = self->context->gl;
 
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_2D, self->texture_obj);
-
     gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
     gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
 
@@ -4115,24 +6188,37 @@ static PyObject * MGLTexture_read(MGLTexture * self, PyObject * args) {
     // printf("level_width: %d\n", level_width);
     // printf("level_height: %d\n", level_height);
 
-    gl.GetTexImage(GL_TEXTURE_2D, level, base_format, pixel_type, data);
+    get_texture_image(self, level, base_format, pixel_type, expected_size, data);
 
+    self->context->stats.bytes_downloaded += expected_size;
     return result;
 }
 
 static PyObject * MGLTexture_read_into(MGLTexture * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Texture.read_into", GL_TEXTURE, self->texture_obj);
+
     PyObject * data;
     int level;
     int alignment;
     Py_ssize_t write_offset;
+    int flip_y;
+    Py_ssize_t row_stride;
+    const char * channels;
 
     int args_ok = PyArg_ParseTuple(
         args,
-        "OIIn",
+        "OIInpnz",
         &data,
         &level,
         &alignment,
-        &write_offset
+        &write_offset,
+        &flip_y,
+        &row_stride,
+        &channels
     );
 
     if (!args_ok) {
@@ -4160,25 +6246,42 @@ static PyObject * MGLTexture_read_into(MGLTexture * self, PyObject * args) {
     width = width > 1 ? width : 1;
     height = height > 1 ? height : 1;
 
-    unsigned long long expected_size = (unsigned long long)width * self->components * self->data_type->size;
-    expected_size = (expected_size + alignment - 1) / alignment * alignment;
-    expected_size = expected_size * height;
+    ReadLayout layout;
+    if (!parse_read_layout(&layout, channels, self->components, width, height, alignment, row_stride, self->data_type, self->depth)) {
+        return 0;
+    }
+
+    unsigned long long expected_size = layout.required_size;
 
     int pixel_type = self->data_type->gl_type;
-    int base_format = self->depth ? GL_DEPTH_COMPONENT : self->data_type->base_format[self->components];
+    int base_format = layout.base_format;
+    int pixel_size = layout.components * layout.element_size;
 
-    if (Py_TYPE(data) == MGLBuffer_type) {
+    if (Py_TYPE(data) == self->context->state->MGLBuffer_type) {
 
         MGLBuffer * buffer = (MGLBuffer *)data;
 
+        if (layout.convert) {
+            MGLError_Set("the channels %s cannot be read into a Buffer", channels);
+            return 0;
+        }
+
+        if (flip_y) {
+            MGLError_Set("flip_y is not supported when reading a texture into a Buffer");
+            return 0;
+        }
+
         const GLMethods & gl = self->context->gl;
 
+        if (!set_pack_row_stride(gl, layout.row_stride, pixel_size)) {
+            MGLError_Set("the row_stride %zd cannot be used with %d byte pixels", layout.row_stride, pixel_size);
+            return 0;
+        }
+
         gl.BindBuffer(GL_PIXEL_PACK_BUFFER, buffer->buffer_obj);
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_2D, self->texture_obj);
-        gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.GetTexImage(GL_TEXTURE_2D, level, base_format, pixel_type, (void *)write_offset);
+        get_texture_image(self, level, base_format, pixel_type, buffer->size - write_offset, (void *)write_offset);
+        gl.PixelStorei(GL_PACK_ROW_LENGTH, 0);
         gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
     } else {
@@ -4201,12 +6304,33 @@ static PyObject * MGLTexture_read_into(MGLTexture * self, PyObject * args) {
 
         const GLMethods & gl = self->context->gl;
 
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_2D, self->texture_obj);
-        gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.GetTexImage(GL_TEXTURE_2D, level, base_format, pixel_type, ptr);
 
+        if (layout.convert) {
+            Py_ssize_t temp_size = (Py_ssize_t)width * height * layout.read_components * layout.element_size;
+            char * temp = new char[temp_size];
+            gl.PixelStorei(GL_PACK_ALIGNMENT, 1);
+            gl.PixelStorei(GL_PACK_ROW_LENGTH, 0);
+            get_texture_image(self, level, base_format, pixel_type, temp_size, temp);
+            swizzle_pixels(temp, ptr, width, height, layout, flip_y);
+            delete[] temp;
+        } else if (set_pack_row_stride(gl, layout.row_stride, pixel_size)) {
+            get_texture_image(self, level, base_format, pixel_type, buffer_view.len - write_offset, ptr);
+            if (flip_y) {
+                flip_rows(ptr, height, layout.row_size, layout.row_stride);
+            }
+        } else {
+            char * temp = new char[layout.row_size * height];
+            gl.PixelStorei(GL_PACK_ALIGNMENT, 1);
+            gl.PixelStorei(GL_PACK_ROW_LENGTH, 0);
+            get_texture_image(self, level, base_format, pixel_type, layout.row_size * height, temp);
+            copy_rows(temp, ptr, height, layout.row_size, layout.row_size, layout.row_stride, flip_y);
+            delete[] temp;
+        }
+
+        gl.PixelStorei(GL_PACK_ROW_LENGTH, 0);
+
+        self->context->stats.bytes_downloaded += expected_size;
         PyBuffer_Release(&buffer_view);
 
     }
@@ -4215,7 +6339,13 @@ static PyObject * MGLTexture_read_into(MGLTexture * self, PyObject * args) {
 }
 
 static PyObject * MGLTexture_write(MGLTexture * self, PyObject * args) {
-    PyObject * data;
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Texture.write", GL_TEXTURE, self->texture_obj);
+
+    PyObject * data;
     PyObject * viewport_arg;
     int level;
     int alignment;
@@ -4268,18 +6398,16 @@ static PyObject * MGLTexture_write(MGLTexture * self, PyObject * args) {
     int pixel_type = self->data_type->gl_type;
     int format = self->depth ? GL_DEPTH_COMPONENT : self->data_type->base_format[self->components];
 
-    if (Py_TYPE(data) == MGLBuffer_type) {
+    if (Py_TYPE(data) == self->context->state->MGLBuffer_type) {
 
         MGLBuffer * buffer = (MGLBuffer *)data;
 
         const GLMethods & gl = self->context->gl;
 
         gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->buffer_obj);
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_2D, self->texture_obj);
         gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.TexSubImage2D(GL_TEXTURE_2D, level, viewport_rect.x, viewport_rect.y, viewport_rect.width, viewport_rect.height, format, pixel_type, 0);
+        texture_sub_image(self, level, viewport_rect, format, pixel_type, 0);
         gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
     } else {
@@ -4291,7 +6419,7 @@ static PyObject * MGLTexture_write(MGLTexture * self, PyObject * args) {
         }
 
         if (buffer_view.len != expected_size) {
-            MGLError_Set("data size mismatch %d != %d", buffer_view.len, expected_size);
+            MGLError_Set("data size mismatch %zd != %llu", buffer_view.len, expected_size);
             if (data != Py_None) {
                 PyBuffer_Release(&buffer_view);
             }
@@ -4300,12 +6428,11 @@ static PyObject * MGLTexture_write(MGLTexture * self, PyObject * args) {
 
         const GLMethods & gl = self->context->gl;
 
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_2D, self->texture_obj);
         gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.TexSubImage2D(GL_TEXTURE_2D, level, viewport_rect.x, viewport_rect.y, viewport_rect.width, viewport_rect.height, format, pixel_type, buffer_view.buf);
+        texture_sub_image(self, level, viewport_rect, format, pixel_type, buffer_view.buf);
 
+        self->context->stats.bytes_uploaded += buffer_view.len;
         PyBuffer_Release(&buffer_view);
 
     }
@@ -4313,7 +6440,242 @@ static PyObject * MGLTexture_write(MGLTexture * self, PyObject * args) {
     Py_RETURN_NONE;
 }
 
+struct TextureRegion {
+    int x;
+    int y;
+    int width;
+    int height;
+    Py_ssize_t offset;
+};
+
+static TextureRegion * parse_texture_regions(PyObject * regions_arg, Py_ssize_t * num_regions) {
+    if (!PyList_Check(regions_arg) && !PyTuple_Check(regions_arg) && PyObject_CheckBuffer(regions_arg)) {
+        // Packed int32 (x, y, width, height, offset) records, for example a numpy array of shape (n, 5)
+        Py_buffer regions_view;
+        if (PyObject_GetBuffer(regions_arg, &regions_view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+            return NULL;
+        }
+
+        const char * item_format = regions_view.format ? regions_view.format : "B";
+        if (item_format[0] == '@' || item_format[0] == '=') {
+            item_format += 1;
+        }
+
+        if (regions_view.itemsize != 4 || (strcmp(item_format, "i") && strcmp(item_format, "l"))) {
+            MGLError_Set("the packed regions must be int32, got format '%s' with itemsize %zd", regions_view.format ? regions_view.format : "B", regions_view.itemsize);
+            PyBuffer_Release(&regions_view);
+            return NULL;
+        }
+
+        if (regions_view.len % (5 * sizeof(int))) {
+            MGLError_Set("the packed regions must be int32 records of (x, y, width, height, offset)");
+            PyBuffer_Release(&regions_view);
+            return NULL;
+        }
+
+        *num_regions = regions_view.len / (5 * sizeof(int));
+        TextureRegion * regions = new TextureRegion[*num_regions + 1];
+        const int * packed = (const int *)regions_view.buf;
+
+        for (Py_ssize_t i = 0; i < *num_regions; ++i) {
+            regions[i].x = packed[i * 5 + 0];
+            regions[i].y = packed[i * 5 + 1];
+            regions[i].width = packed[i * 5 + 2];
+            regions[i].height = packed[i * 5 + 3];
+            regions[i].offset = packed[i * 5 + 4];
+        }
+
+        PyBuffer_Release(&regions_view);
+        return regions;
+    }
+
+    PyObject * regions_seq = PySequence_Fast(regions_arg, "the regions must be a sequence or a packed int32 array");
+    if (!regions_seq) {
+        return NULL;
+    }
+
+    *num_regions = PySequence_Fast_GET_SIZE(regions_seq);
+    TextureRegion * regions = new TextureRegion[*num_regions + 1];
+
+    for (Py_ssize_t i = 0; i < *num_regions; ++i) {
+        PyObject * region = PySequence_Fast_GET_ITEM(regions_seq, i);
+        PyObject * region_seq = PySequence_Fast(region, "");
+
+        if (!region_seq || PySequence_Fast_GET_SIZE(region_seq) != 5) {
+            PyErr_Clear();
+            MGLError_Set("regions[%zd] must be a tuple of (x, y, width, height, offset)", i);
+            Py_XDECREF(region_seq);
+            Py_DECREF(regions_seq);
+            delete[] regions;
+            return NULL;
+        }
+
+        PyObject ** items = PySequence_Fast_ITEMS(region_seq);
+        regions[i].x = PyLong_AsLong(items[0]);
+        regions[i].y = PyLong_AsLong(items[1]);
+        regions[i].width = PyLong_AsLong(items[2]);
+        regions[i].height = PyLong_AsLong(items[3]);
+        regions[i].offset = PyLong_AsSsize_t(items[4]);
+        Py_DECREF(region_seq);
+
+        if (PyErr_Occurred()) {
+            PyErr_Clear();
+            MGLError_Set("regions[%zd] must contain integers", i);
+            Py_DECREF(regions_seq);
+            delete[] regions;
+            return NULL;
+        }
+    }
+
+    Py_DECREF(regions_seq);
+    return regions;
+}
+
+static PyObject * MGLTexture_write_regions(MGLTexture * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Texture.write_regions", GL_TEXTURE, self->texture_obj);
+
+    PyObject * data;
+    PyObject * regions_arg;
+    int level;
+    int alignment;
+
+    int args_ok = PyArg_ParseTuple(
+        args,
+        "OOII",
+        &data,
+        &regions_arg,
+        &level,
+        &alignment
+    );
+
+    if (!args_ok) {
+        return 0;
+    }
+
+    if (alignment != 1 && alignment != 2 && alignment != 4 && alignment != 8) {
+        MGLError_Set("the alignment must be 1, 2, 4 or 8");
+        return 0;
+    }
+
+    if (level > self->max_level) {
+        MGLError_Set("invalid level");
+        return 0;
+    }
+
+    if (self->samples) {
+        MGLError_Set("multisample textures cannot be written directly");
+        return 0;
+    }
+
+    Py_ssize_t num_regions = 0;
+    TextureRegion * regions = parse_texture_regions(regions_arg, &num_regions);
+    if (!regions) {
+        return 0;
+    }
+
+    bool unpack_buffer = Py_TYPE(data) == self->context->state->MGLBuffer_type;
+
+    Py_buffer buffer_view;
+    const char * base;
+    Py_ssize_t data_size;
+
+    if (unpack_buffer) {
+        base = NULL;
+        data_size = ((MGLBuffer *)data)->size;
+    } else {
+        if (PyObject_GetBuffer(data, &buffer_view, PyBUF_SIMPLE) < 0) {
+            delete[] regions;
+            return 0;
+        }
+        base = (const char *)buffer_view.buf;
+        data_size = buffer_view.len;
+    }
+
+    int pixel_size = self->components * self->data_type->size;
+    int level_width = MGL_MAX(self->width >> level, 1);
+    int level_height = MGL_MAX(self->height >> level, 1);
+    Py_ssize_t uploaded_size = 0;
+
+    for (Py_ssize_t i = 0; i < num_regions; ++i) {
+        const TextureRegion & region = regions[i];
+
+        if (region.width < 0 || region.height < 0 || region.offset < 0) {
+            MGLError_Set("regions[%zd] has a negative size or offset", i);
+            break;
+        }
+
+        if (region.x < 0 || region.y < 0 || region.x > level_width - region.width || region.y > level_height - region.height) {
+            MGLError_Set("regions[%zd] is outside of the %dx%d level %d", i, level_width, level_height, level);
+            break;
+        }
+
+        Py_ssize_t row_size = (Py_ssize_t)region.width * pixel_size;
+        Py_ssize_t row_stride = (row_size + alignment - 1) / alignment * alignment;
+        Py_ssize_t required_size = region.height ? row_stride * (region.height - 1) + row_size : 0;
+
+        if (region.offset + required_size > data_size) {
+            MGLError_Set("regions[%zd] reads past the end of the data", i);
+            break;
+        }
+
+        uploaded_size += required_size;
+    }
+
+    if (PyErr_Occurred()) {
+        if (!unpack_buffer) {
+            PyBuffer_Release(&buffer_view);
+        }
+        delete[] regions;
+        return 0;
+    }
+
+    int pixel_type = self->data_type->gl_type;
+    int format = self->depth ? GL_DEPTH_COMPONENT : self->data_type->base_format[self->components];
+
+    const GLMethods & gl = self->context->gl;
+
+    if (unpack_buffer) {
+        gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, ((MGLBuffer *)data)->buffer_obj);
+    }
+
+    if (!self->context->dsa) {
+        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
+        gl.BindTexture(GL_TEXTURE_2D, self->texture_obj);
+    }
+    gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
+    gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+
+    for (Py_ssize_t i = 0; i < num_regions; ++i) {
+        const TextureRegion & region = regions[i];
+        if (self->context->dsa) {
+            gl.TextureSubImage2D(self->texture_obj, level, region.x, region.y, region.width, region.height, format, pixel_type, base + region.offset);
+        } else {
+            gl.TexSubImage2D(GL_TEXTURE_2D, level, region.x, region.y, region.width, region.height, format, pixel_type, base + region.offset);
+        }
+    }
+
+    if (unpack_buffer) {
+        gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    } else {
+        self->context->stats.bytes_uploaded += uploaded_size;
+        PyBuffer_Release(&buffer_view);
+    }
+
+    delete[] regions;
+    Py_RETURN_NONE;
+}
+
 static PyObject * MGLTexture_meth_bind(MGLTexture * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Texture.bind_to_image", GL_TEXTURE, self->texture_obj, true);
+
     int unit;
     int read;
     int write;
@@ -4350,6 +6712,12 @@ static PyObject * MGLTexture_meth_bind(MGLTexture * self, PyObject * args) {
 }
 
 static PyObject * MGLTexture_use(MGLTexture * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Texture.use", GL_TEXTURE, self->texture_obj, true);
+
     int index;
 
     int args_ok = PyArg_ParseTuple(
@@ -4368,10 +6736,44 @@ static PyObject * MGLTexture_use(MGLTexture * self, PyObject * args) {
     gl.ActiveTexture(GL_TEXTURE0 + index);
     gl.BindTexture(texture_target, self->texture_obj);
 
+    self->context->stats.texture_binds += 1;
     Py_RETURN_NONE;
 }
 
+static void texture_parameteri(MGLTexture * self, int pname, int param) {
+    const GLMethods & gl = self->context->gl;
+    if (self->context->dsa) {
+        gl.TextureParameteri(self->texture_obj, pname, param);
+    } else {
+        gl.TexParameteri(self->samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D, pname, param);
+    }
+}
+
+static void texture_parameterf(MGLTexture * self, int pname, float param) {
+    const GLMethods & gl = self->context->gl;
+    if (self->context->dsa) {
+        gl.TextureParameterf(self->texture_obj, pname, param);
+    } else {
+        gl.TexParameterf(self->samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D, pname, param);
+    }
+}
+
+static void get_texture_parameteriv(MGLTexture * self, int pname, int * params) {
+    const GLMethods & gl = self->context->gl;
+    if (self->context->dsa) {
+        gl.GetTextureParameteriv(self->texture_obj, pname, params);
+    } else {
+        gl.GetTexParameteriv(self->samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D, pname, params);
+    }
+}
+
 static PyObject * MGLTexture_build_mipmaps(MGLTexture * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Texture.build_mipmaps", GL_TEXTURE, self->texture_obj);
+
     int base = 0;
     int max = 1000;
 
@@ -4395,31 +6797,46 @@ static PyObject * MGLTexture_build_mipmaps(MGLTexture * self, PyObject * args) {
 
     const GLMethods & gl = self->context->gl;
 
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(texture_target, self->texture_obj);
+    if (!self->context->dsa) {
+        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
+        gl.BindTexture(texture_target, self->texture_obj);
+    }
 
-    gl.TexParameteri(texture_target, GL_TEXTURE_BASE_LEVEL, base);
-    gl.TexParameteri(texture_target, GL_TEXTURE_MAX_LEVEL, max);
+    texture_parameteri(self, GL_TEXTURE_BASE_LEVEL, base);
+    texture_parameteri(self, GL_TEXTURE_MAX_LEVEL, max);
 
-    gl.GenerateMipmap(texture_target);
+    if (self->context->dsa) {
+        gl.GenerateTextureMipmap(self->texture_obj);
+    } else {
+        gl.GenerateMipmap(texture_target);
+    }
 
-    gl.TexParameteri(texture_target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    gl.TexParameteri(texture_target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    texture_parameteri(self, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    texture_parameteri(self, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     self->min_filter = GL_LINEAR_MIPMAP_LINEAR;
     self->mag_filter = GL_LINEAR;
     self->max_level = max;
+    memory_resize(self->context, &self->memory, memory_bytes(self));
 
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLTexture_get_handle(MGLTexture * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     int resident = true;
 
     if(!PyArg_ParseTuple(args, "|p", &resident)) {
         return NULL;
     }
 
+    if (!load_gl_bindless_texture_methods(self->context->gl)) {
+        MGLError_Set("bindless textures are not supported");
+        return 0;
+    }
+
     const GLMethods & gl = self->context->gl;
 
     unsigned long long handle = gl.GetTextureHandleARB(self->texture_obj);
@@ -4436,7 +6853,12 @@ static PyObject * MGLTexture_release(MGLTexture * self, PyObject * args) {
     if (self->released || self->external) {
         Py_RETURN_NONE;
     }
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     self->released = true;
+    self->context->stats.objects_released += 1;
+    memory_untrack(self->context, &self->memory);
 
     const GLMethods & gl = self->context->gl;
     gl.DeleteTextures(1, (GLuint *)&self->texture_obj);
@@ -4451,19 +6873,24 @@ static PyObject * MGLTexture_get_repeat_x(MGLTexture * self, void * closure) {
 }
 
 static int MGLTexture_set_repeat_x(MGLTexture * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     int texture_target = self->samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
 
     const GLMethods & gl = self->context->gl;
 
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(texture_target, self->texture_obj);
+    if (!self->context->dsa) {
+        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
+        gl.BindTexture(texture_target, self->texture_obj);
+    }
 
     if (value == Py_True) {
-        gl.TexParameteri(texture_target, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        texture_parameteri(self, GL_TEXTURE_WRAP_S, GL_REPEAT);
         self->repeat_x = true;
         return 0;
     } else if (value == Py_False) {
-        gl.TexParameteri(texture_target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        texture_parameteri(self, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         self->repeat_x = false;
         return 0;
     } else {
@@ -4477,19 +6904,24 @@ static PyObject * MGLTexture_get_repeat_y(MGLTexture * self, void * closure) {
 }
 
 static int MGLTexture_set_repeat_y(MGLTexture * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     int texture_target = self->samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
 
     const GLMethods & gl = self->context->gl;
 
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(texture_target, self->texture_obj);
+    if (!self->context->dsa) {
+        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
+        gl.BindTexture(texture_target, self->texture_obj);
+    }
 
     if (value == Py_True) {
-        gl.TexParameteri(texture_target, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        texture_parameteri(self, GL_TEXTURE_WRAP_T, GL_REPEAT);
         self->repeat_y = true;
         return 0;
     } else if (value == Py_False) {
-        gl.TexParameteri(texture_target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        texture_parameteri(self, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         self->repeat_y = false;
         return 0;
     } else {
@@ -4503,6 +6935,9 @@ static PyObject * MGLTexture_get_filter(MGLTexture * self, void * closure) {
 }
 
 static int MGLTexture_set_filter(MGLTexture * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     if (!parse_filter(value, &self->min_filter, &self->mag_filter)) {
         MGLError_Set("invalid filter");
         return -1;
@@ -4512,15 +6947,20 @@ static int MGLTexture_set_filter(MGLTexture * self, PyObject * value, void * clo
 
     const GLMethods & gl = self->context->gl;
 
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(texture_target, self->texture_obj);
-    gl.TexParameteri(texture_target, GL_TEXTURE_MIN_FILTER, self->min_filter);
-    gl.TexParameteri(texture_target, GL_TEXTURE_MAG_FILTER, self->mag_filter);
+    if (!self->context->dsa) {
+        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
+        gl.BindTexture(texture_target, self->texture_obj);
+    }
+    texture_parameteri(self, GL_TEXTURE_MIN_FILTER, self->min_filter);
+    texture_parameteri(self, GL_TEXTURE_MAG_FILTER, self->mag_filter);
 
     return 0;
 }
 
 static PyObject * MGLTexture_get_swizzle(MGLTexture * self, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
 
     if (self->depth) {
         MGLError_Set("cannot get swizzle of depth textures");
@@ -4531,18 +6971,20 @@ static PyObject * MGLTexture_get_swizzle(MGLTexture * self, void * closure) {
 
     const GLMethods & gl = self->context->gl;
 
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(texture_target, self->texture_obj);
+    if (!self->context->dsa) {
+        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
+        gl.BindTexture(texture_target, self->texture_obj);
+    }
 
     int swizzle_r = 0;
     int swizzle_g = 0;
     int swizzle_b = 0;
     int swizzle_a = 0;
 
-    gl.GetTexParameteriv(texture_target, GL_TEXTURE_SWIZZLE_R, &swizzle_r);
-    gl.GetTexParameteriv(texture_target, GL_TEXTURE_SWIZZLE_G, &swizzle_g);
-    gl.GetTexParameteriv(texture_target, GL_TEXTURE_SWIZZLE_B, &swizzle_b);
-    gl.GetTexParameteriv(texture_target, GL_TEXTURE_SWIZZLE_A, &swizzle_a);
+    get_texture_parameteriv(self, GL_TEXTURE_SWIZZLE_R, &swizzle_r);
+    get_texture_parameteriv(self, GL_TEXTURE_SWIZZLE_G, &swizzle_g);
+    get_texture_parameteriv(self, GL_TEXTURE_SWIZZLE_B, &swizzle_b);
+    get_texture_parameteriv(self, GL_TEXTURE_SWIZZLE_A, &swizzle_a);
 
     char swizzle[5] = {
         char_from_swizzle(swizzle_r),
@@ -4556,6 +6998,9 @@ static PyObject * MGLTexture_get_swizzle(MGLTexture * self, void * closure) {
 }
 
 static int MGLTexture_set_swizzle(MGLTexture * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     const char * swizzle = PyUnicode_AsUTF8(value);
 
     if (self->depth) {
@@ -4588,16 +7033,18 @@ static int MGLTexture_set_swizzle(MGLTexture * self, PyObject * value, void * cl
 
     const GLMethods & gl = self->context->gl;
 
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(texture_target, self->texture_obj);
+    if (!self->context->dsa) {
+        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
+        gl.BindTexture(texture_target, self->texture_obj);
+    }
 
-    gl.TexParameteri(texture_target, GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
+    texture_parameteri(self, GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
     if (tex_swizzle[1] != -1) {
-        gl.TexParameteri(texture_target, GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
+        texture_parameteri(self, GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
         if (tex_swizzle[2] != -1) {
-            gl.TexParameteri(texture_target, GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
+            texture_parameteri(self, GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
             if (tex_swizzle[3] != -1) {
-                gl.TexParameteri(texture_target, GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
+                texture_parameteri(self, GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
             }
         }
     }
@@ -4615,6 +7062,9 @@ static PyObject * MGLTexture_get_compare_func(MGLTexture * self, void * closure)
 }
 
 static int MGLTexture_set_compare_func(MGLTexture * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     if (!self->depth) {
         MGLError_Set("only depth textures have compare_func");
         return -1;
@@ -4630,13 +7080,15 @@ static int MGLTexture_set_compare_func(MGLTexture * self, PyObject * value, void
     self->compare_func = compare_func_from_string(func);
 
     const GLMethods & gl = self->context->gl;
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(texture_target, self->texture_obj);
+    if (!self->context->dsa) {
+        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
+        gl.BindTexture(texture_target, self->texture_obj);
+    }
     if (self->compare_func == 0) {
-        gl.TexParameteri(texture_target, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+        texture_parameteri(self, GL_TEXTURE_COMPARE_MODE, GL_NONE);
     } else {
-        gl.TexParameteri(texture_target, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
-        gl.TexParameteri(texture_target, GL_TEXTURE_COMPARE_FUNC, self->compare_func);
+        texture_parameteri(self, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+        texture_parameteri(self, GL_TEXTURE_COMPARE_FUNC, self->compare_func);
     }
 
     return 0;
@@ -4647,20 +7099,97 @@ static PyObject * MGLTexture_get_anisotropy(MGLTexture * self, void * closure) {
 }
 
 static int MGLTexture_set_anisotropy(MGLTexture * self, PyObject * value, void * closure) {
-    if (self->context->max_anisotropy == 0) return 0;
-    self->anisotropy = (float)MGL_MIN(MGL_MAX(PyFloat_AsDouble(value), 1.0), self->context->max_anisotropy);
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
+    float max_anisotropy = context_max_anisotropy(self->context);
+    if (max_anisotropy == 0) return 0;
+    self->anisotropy = (float)MGL_MIN(MGL_MAX(PyFloat_AsDouble(value), 1.0), max_anisotropy);
     int texture_target = self->samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
 
     const GLMethods & gl = self->context->gl;
 
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(texture_target, self->texture_obj);
-    gl.TexParameterf(texture_target, GL_TEXTURE_MAX_ANISOTROPY, self->anisotropy);
+    if (!self->context->dsa) {
+        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
+        gl.BindTexture(texture_target, self->texture_obj);
+    }
+    texture_parameterf(self, GL_TEXTURE_MAX_ANISOTROPY, self->anisotropy);
 
     return 0;
 }
 
+// The 3D, array and cube textures share these, with direct state access the bind points stay untouched
+
+static void bind_texture_target(MGLContext * ctx, int target, int texture_obj) {
+    if (!ctx->dsa) {
+        ctx->gl.ActiveTexture(GL_TEXTURE0 + ctx->default_texture_unit);
+        ctx->gl.BindTexture(target, texture_obj);
+    }
+}
+
+static void texture_target_parameteri(MGLContext * ctx, int target, int texture_obj, int pname, int param) {
+    if (ctx->dsa) {
+        ctx->gl.TextureParameteri(texture_obj, pname, param);
+    } else {
+        ctx->gl.TexParameteri(target, pname, param);
+    }
+}
+
+static void texture_target_parameterf(MGLContext * ctx, int target, int texture_obj, int pname, float param) {
+    if (ctx->dsa) {
+        ctx->gl.TextureParameterf(texture_obj, pname, param);
+    } else {
+        ctx->gl.TexParameterf(target, pname, param);
+    }
+}
+
+static void get_texture_target_parameteriv(MGLContext * ctx, int target, int texture_obj, int pname, int * params) {
+    if (ctx->dsa) {
+        ctx->gl.GetTextureParameteriv(texture_obj, pname, params);
+    } else {
+        ctx->gl.GetTexParameteriv(target, pname, params);
+    }
+}
+
+static void generate_texture_target_mipmap(MGLContext * ctx, int target, int texture_obj) {
+    if (ctx->dsa) {
+        ctx->gl.GenerateTextureMipmap(texture_obj);
+    } else {
+        ctx->gl.GenerateMipmap(target);
+    }
+}
+
+// The layer is the z offset of 3D and array textures or the face of a cube texture
+static void get_texture_layers(MGLContext * ctx, int target, int texture_obj, Cube box, int format, int type, Py_ssize_t buf_size, void * pixels) {
+    const GLMethods & gl = ctx->gl;
+    int buf_limit = (int)MGL_MIN(buf_size, (Py_ssize_t)0x7fffffff);
+    if (ctx->dsa) {
+        gl.GetTextureSubImage(texture_obj, 0, box.x, box.y, box.z, box.width, box.height, box.depth, format, type, buf_limit, pixels);
+    } else if (target == GL_TEXTURE_CUBE_MAP) {
+        gl.GetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + box.z, 0, format, type, pixels);
+    } else {
+        gl.GetTexImage(target, 0, format, type, pixels);
+    }
+}
+
+static void texture_layers_sub_image(MGLContext * ctx, int target, int texture_obj, Cube box, int format, int type, const void * pixels) {
+    const GLMethods & gl = ctx->gl;
+    if (ctx->dsa) {
+        gl.TextureSubImage3D(texture_obj, 0, box.x, box.y, box.z, box.width, box.height, box.depth, format, type, pixels);
+    } else if (target == GL_TEXTURE_CUBE_MAP) {
+        gl.TexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + box.z, 0, box.x, box.y, box.width, box.height, format, type, pixels);
+    } else {
+        gl.TexSubImage3D(target, 0, box.x, box.y, box.z, box.width, box.height, box.depth, format, type, pixels);
+    }
+}
+
 static PyObject * MGLContext_texture3d(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLStartupScope startup(self, MGL_STARTUP_TEXTURES);
+
     int width;
     int height;
     int depth;
@@ -4724,7 +7253,7 @@ static PyObject * MGLContext_texture3d(MGLContext * self, PyObject * args) {
     }
 
     if (buffer_view.len != expected_size) {
-        MGLError_Set("data size mismatch %d != %d", buffer_view.len, expected_size);
+        MGLError_Set("data size mismatch %zd != %llu", buffer_view.len, expected_size);
         if (data != Py_None) {
             PyBuffer_Release(&buffer_view);
         }
@@ -4737,11 +7266,11 @@ static PyObject * MGLContext_texture3d(MGLContext * self, PyObject * args) {
 
     const GLMethods & gl = self->gl;
 
-    MGLTexture3D * texture = PyObject_New(MGLTexture3D, MGLTexture3D_type);
+    MGLTexture3D * texture = PyObject_New(MGLTexture3D, self->state->MGLTexture3D_type);
     texture->released = false;
 
     texture->texture_obj = 0;
-    gl.GenTextures(1, (GLuint *)&texture->texture_obj);
+    texture->texture_obj = take_name(&self->texture_names, gl.GenTextures);
 
     if (!texture->texture_obj) {
         MGLError_Set("cannot create texture");
@@ -4764,6 +7293,7 @@ static PyObject * MGLContext_texture3d(MGLContext * self, PyObject * args) {
     }
 
     if (data != Py_None) {
+        self->stats.bytes_uploaded += buffer_view.len;
         PyBuffer_Release(&buffer_view);
     }
 
@@ -4784,10 +7314,18 @@ static PyObject * MGLContext_texture3d(MGLContext * self, PyObject * args) {
     Py_INCREF(self);
     texture->context = self;
 
+    self->stats.objects_created += 1;
+    memory_track(self, &texture->memory, MGL_MEMORY_TEXTURE_3D, texture->texture_obj, memory_bytes(texture));
     return Py_BuildValue("(Oi)", texture, texture->texture_obj);
 }
 
 static PyObject * MGLTexture3D_read(MGLTexture3D * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Texture3D.read", GL_TEXTURE, self->texture_obj);
+
     int alignment;
 
     int args_ok = PyArg_ParseTuple(
@@ -4817,17 +7355,21 @@ static PyObject * MGLTexture3D_read(MGLTexture3D * self, PyObject * args) {
 
     const GLMethods & gl = self->context->gl;
 
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_3D, self->texture_obj);
+    bind_texture_target(self->context, GL_TEXTURE_3D, self->texture_obj);
 
     gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
     gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-    gl.GetTexImage(GL_TEXTURE_3D, 0, base_format, pixel_type, data);
+    get_texture_layers(self->context, GL_TEXTURE_3D, self->texture_obj, cube(0, 0, 0, self->width, self->height, self->depth), base_format, pixel_type, expected_size, data);
 
+    self->context->stats.bytes_downloaded += expected_size;
     return result;
 }
 
 static PyObject * MGLTexture3D_read_into(MGLTexture3D * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     PyObject * data;
     int alignment;
     Py_ssize_t write_offset;
@@ -4856,18 +7398,17 @@ static PyObject * MGLTexture3D_read_into(MGLTexture3D * self, PyObject * args) {
     int pixel_type = self->data_type->gl_type;
     int format = self->data_type->base_format[self->components];
 
-    if (Py_TYPE(data) == MGLBuffer_type) {
+    if (Py_TYPE(data) == self->context->state->MGLBuffer_type) {
 
         MGLBuffer * buffer = (MGLBuffer *)data;
 
         const GLMethods & gl = self->context->gl;
 
         gl.BindBuffer(GL_PIXEL_PACK_BUFFER, buffer->buffer_obj);
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_3D, self->texture_obj);
+        bind_texture_target(self->context, GL_TEXTURE_3D, self->texture_obj);
         gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.GetTexImage(GL_TEXTURE_3D, 0, format, pixel_type, (void *)write_offset);
+        get_texture_layers(self->context, GL_TEXTURE_3D, self->texture_obj, cube(0, 0, 0, self->width, self->height, self->depth), format, pixel_type, buffer->size - write_offset, (void *)write_offset);
         gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
     } else {
@@ -4889,12 +7430,12 @@ static PyObject * MGLTexture3D_read_into(MGLTexture3D * self, PyObject * args) {
         char * ptr = (char *)buffer_view.buf + write_offset;
 
         const GLMethods & gl = self->context->gl;
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_3D, self->texture_obj);
+        bind_texture_target(self->context, GL_TEXTURE_3D, self->texture_obj);
         gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.GetTexImage(GL_TEXTURE_3D, 0, format, pixel_type, ptr);
+        get_texture_layers(self->context, GL_TEXTURE_3D, self->texture_obj, cube(0, 0, 0, self->width, self->height, self->depth), format, pixel_type, expected_size, ptr);
 
+        self->context->stats.bytes_downloaded += expected_size;
         PyBuffer_Release(&buffer_view);
 
     }
@@ -4903,6 +7444,12 @@ static PyObject * MGLTexture3D_read_into(MGLTexture3D * self, PyObject * args) {
 }
 
 static PyObject * MGLTexture3D_write(MGLTexture3D * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Texture3D.write", GL_TEXTURE, self->texture_obj);
+
     PyObject * data;
     PyObject * viewport_arg;
     int alignment;
@@ -4941,18 +7488,17 @@ static PyObject * MGLTexture3D_write(MGLTexture3D * self, PyObject * args) {
     int pixel_type = self->data_type->gl_type;
     int format = self->data_type->base_format[self->components];
 
-    if (Py_TYPE(data) == MGLBuffer_type) {
+    if (Py_TYPE(data) == self->context->state->MGLBuffer_type) {
 
         MGLBuffer * buffer = (MGLBuffer *)data;
 
         const GLMethods & gl = self->context->gl;
 
         gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->buffer_obj);
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_3D, self->texture_obj);
+        bind_texture_target(self->context, GL_TEXTURE_3D, self->texture_obj);
         gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.TexSubImage3D(GL_TEXTURE_3D, 0, viewport_cube.x, viewport_cube.y, viewport_cube.z, viewport_cube.width, viewport_cube.height, viewport_cube.depth, format, pixel_type, 0);
+        texture_layers_sub_image(self->context, GL_TEXTURE_3D, self->texture_obj, viewport_cube, format, pixel_type, 0);
         gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
     } else {
@@ -4964,7 +7510,7 @@ static PyObject * MGLTexture3D_write(MGLTexture3D * self, PyObject * args) {
         }
 
         if (buffer_view.len != expected_size) {
-            MGLError_Set("data size mismatch %d != %d", buffer_view.len, expected_size);
+            MGLError_Set("data size mismatch %zd != %llu", buffer_view.len, expected_size);
             if (data != Py_None) {
                 PyBuffer_Release(&buffer_view);
             }
@@ -4973,13 +7519,13 @@ static PyObject * MGLTexture3D_write(MGLTexture3D * self, PyObject * args) {
 
         const GLMethods & gl = self->context->gl;
 
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_3D, self->texture_obj);
+        bind_texture_target(self->context, GL_TEXTURE_3D, self->texture_obj);
 
         gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.TexSubImage3D(GL_TEXTURE_3D, 0, viewport_cube.x, viewport_cube.y, viewport_cube.z, viewport_cube.width, viewport_cube.height, viewport_cube.depth, format, pixel_type, buffer_view.buf);
+        texture_layers_sub_image(self->context, GL_TEXTURE_3D, self->texture_obj, viewport_cube, format, pixel_type, buffer_view.buf);
 
+        self->context->stats.bytes_uploaded += buffer_view.len;
         PyBuffer_Release(&buffer_view);
     }
 
@@ -4987,6 +7533,12 @@ static PyObject * MGLTexture3D_write(MGLTexture3D * self, PyObject * args) {
 }
 
 static PyObject * MGLTexture3D_meth_bind(MGLTexture3D * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Texture3D.bind_to_image", GL_TEXTURE, self->texture_obj, true);
+
     int unit;
     int read;
     int write;
@@ -5024,6 +7576,12 @@ static PyObject * MGLTexture3D_meth_bind(MGLTexture3D * self, PyObject * args) {
 }
 
 static PyObject * MGLTexture3D_use(MGLTexture3D * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "Texture3D.use", GL_TEXTURE, self->texture_obj, true);
+
     int index;
 
     int args_ok = PyArg_ParseTuple(
@@ -5040,10 +7598,15 @@ static PyObject * MGLTexture3D_use(MGLTexture3D * self, PyObject * args) {
     gl.ActiveTexture(GL_TEXTURE0 + index);
     gl.BindTexture(GL_TEXTURE_3D, self->texture_obj);
 
+    self->context->stats.texture_binds += 1;
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLTexture3D_build_mipmaps(MGLTexture3D * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     int base = 0;
     int max = 1000;
 
@@ -5065,33 +7628,39 @@ static PyObject * MGLTexture3D_build_mipmaps(MGLTexture3D * self, PyObject * arg
 
     int texture_target = GL_TEXTURE_3D;
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(texture_target, self->texture_obj);
+    bind_texture_target(self->context, texture_target, self->texture_obj);
 
-    gl.TexParameteri(texture_target, GL_TEXTURE_BASE_LEVEL, base);
-    gl.TexParameteri(texture_target, GL_TEXTURE_MAX_LEVEL, max);
+    texture_target_parameteri(self->context, texture_target, self->texture_obj, GL_TEXTURE_BASE_LEVEL, base);
+    texture_target_parameteri(self->context, texture_target, self->texture_obj, GL_TEXTURE_MAX_LEVEL, max);
 
-    gl.GenerateMipmap(texture_target);
+    generate_texture_target_mipmap(self->context, texture_target, self->texture_obj);
 
-    gl.TexParameteri(texture_target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    gl.TexParameteri(texture_target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    texture_target_parameteri(self->context, texture_target, self->texture_obj, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    texture_target_parameteri(self->context, texture_target, self->texture_obj, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     self->min_filter = GL_LINEAR_MIPMAP_LINEAR;
     self->mag_filter = GL_LINEAR;
     self->max_level = max;
+    memory_resize(self->context, &self->memory, memory_bytes(self));
 
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLTexture3D_get_handle(MGLTexture3D * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     int resident = true;
 
     if(!PyArg_ParseTuple(args, "|p", &resident)) {
         return NULL;
     }
 
+    if (!load_gl_bindless_texture_methods(self->context->gl)) {
+        MGLError_Set("bindless textures are not supported");
+        return 0;
+    }
+
     const GLMethods & gl = self->context->gl;
 
     unsigned long long handle = gl.GetTextureHandleARB(self->texture_obj);
@@ -5108,7 +7677,12 @@ static PyObject * MGLTexture3D_release(MGLTexture3D * self, PyObject * args) {
     if (self->released) {
         Py_RETURN_NONE;
     }
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     self->released = true;
+    self->context->stats.objects_released += 1;
+    memory_untrack(self->context, &self->memory);
 
     const GLMethods & gl = self->context->gl;
     gl.DeleteTextures(1, (GLuint *)&self->texture_obj);
@@ -5123,18 +7697,18 @@ static PyObject * MGLTexture3D_get_repeat_x(MGLTexture3D * self, void * closure)
 }
 
 static int MGLTexture3D_set_repeat_x(MGLTexture3D * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_3D, self->texture_obj);
+    bind_texture_target(self->context, GL_TEXTURE_3D, self->texture_obj);
 
     if (value == Py_True) {
-        gl.TexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        texture_target_parameteri(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_WRAP_S, GL_REPEAT);
         self->repeat_x = true;
         return 0;
     } else if (value == Py_False) {
-        gl.TexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        texture_target_parameteri(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         self->repeat_x = false;
         return 0;
     } else {
@@ -5148,18 +7722,18 @@ static PyObject * MGLTexture3D_get_repeat_y(MGLTexture3D * self, void * closure)
 }
 
 static int MGLTexture3D_set_repeat_y(MGLTexture3D * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_3D, self->texture_obj);
+    bind_texture_target(self->context, GL_TEXTURE_3D, self->texture_obj);
 
     if (value == Py_True) {
-        gl.TexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        texture_target_parameteri(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_WRAP_T, GL_REPEAT);
         self->repeat_y = true;
         return 0;
     } else if (value == Py_False) {
-        gl.TexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        texture_target_parameteri(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         self->repeat_y = false;
         return 0;
     } else {
@@ -5173,18 +7747,18 @@ static PyObject * MGLTexture3D_get_repeat_z(MGLTexture3D * self, void * closure)
 }
 
 static int MGLTexture3D_set_repeat_z(MGLTexture3D * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_3D, self->texture_obj);
+    bind_texture_target(self->context, GL_TEXTURE_3D, self->texture_obj);
 
     if (value == Py_True) {
-        gl.TexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_REPEAT);
+        texture_target_parameteri(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_WRAP_R, GL_REPEAT);
         self->repeat_z = true;
         return 0;
     } else if (value == Py_False) {
-        gl.TexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        texture_target_parameteri(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
         self->repeat_z = false;
         return 0;
     } else {
@@ -5198,37 +7772,37 @@ static PyObject * MGLTexture3D_get_filter(MGLTexture3D * self, void * closure) {
 }
 
 static int MGLTexture3D_set_filter(MGLTexture3D * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     if (!parse_filter(value, &self->min_filter, &self->mag_filter)) {
         MGLError_Set("invalid filter");
         return -1;
     }
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_3D, self->texture_obj);
-    gl.TexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, self->min_filter);
-    gl.TexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, self->mag_filter);
+    bind_texture_target(self->context, GL_TEXTURE_3D, self->texture_obj);
+    texture_target_parameteri(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_MIN_FILTER, self->min_filter);
+    texture_target_parameteri(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_MAG_FILTER, self->mag_filter);
 
     return 0;
 }
 
 static PyObject * MGLTexture3D_get_swizzle(MGLTexture3D * self, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_3D, self->texture_obj);
+    bind_texture_target(self->context, GL_TEXTURE_3D, self->texture_obj);
 
     int swizzle_r = 0;
     int swizzle_g = 0;
     int swizzle_b = 0;
     int swizzle_a = 0;
 
-    gl.GetTexParameteriv(GL_TEXTURE_3D, GL_TEXTURE_SWIZZLE_R, &swizzle_r);
-    gl.GetTexParameteriv(GL_TEXTURE_3D, GL_TEXTURE_SWIZZLE_G, &swizzle_g);
-    gl.GetTexParameteriv(GL_TEXTURE_3D, GL_TEXTURE_SWIZZLE_B, &swizzle_b);
-    gl.GetTexParameteriv(GL_TEXTURE_3D, GL_TEXTURE_SWIZZLE_A, &swizzle_a);
+    get_texture_target_parameteriv(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_SWIZZLE_R, &swizzle_r);
+    get_texture_target_parameteriv(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_SWIZZLE_G, &swizzle_g);
+    get_texture_target_parameteriv(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_SWIZZLE_B, &swizzle_b);
+    get_texture_target_parameteriv(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_SWIZZLE_A, &swizzle_a);
 
     char swizzle[5] = {
         char_from_swizzle(swizzle_r),
@@ -5242,6 +7816,9 @@ static PyObject * MGLTexture3D_get_swizzle(MGLTexture3D * self, void * closure)
 }
 
 static int MGLTexture3D_set_swizzle(MGLTexture3D * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     const char * swizzle = PyUnicode_AsUTF8(value);
 
     if (!swizzle[0]) {
@@ -5266,18 +7843,15 @@ static int MGLTexture3D_set_swizzle(MGLTexture3D * self, PyObject * value, void
     }
 
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_3D, self->texture_obj);
+    bind_texture_target(self->context, GL_TEXTURE_3D, self->texture_obj);
 
-    gl.TexParameteri(GL_TEXTURE_3D, GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
+    texture_target_parameteri(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
     if (tex_swizzle[1] != -1) {
-        gl.TexParameteri(GL_TEXTURE_3D, GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
+        texture_target_parameteri(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
         if (tex_swizzle[2] != -1) {
-            gl.TexParameteri(GL_TEXTURE_3D, GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
+            texture_target_parameteri(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
             if (tex_swizzle[3] != -1) {
-                gl.TexParameteri(GL_TEXTURE_3D, GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
+                texture_target_parameteri(self->context, GL_TEXTURE_3D, self->texture_obj, GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
             }
         }
     }
@@ -5286,6 +7860,12 @@ static int MGLTexture3D_set_swizzle(MGLTexture3D * self, PyObject * value, void
 }
 
 static PyObject * MGLContext_texture_array(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLStartupScope startup(self, MGL_STARTUP_TEXTURES);
+
     int width;
     int height;
     int layers;
@@ -5349,7 +7929,7 @@ static PyObject * MGLContext_texture_array(MGLContext * self, PyObject * args) {
     }
 
     if (buffer_view.len != expected_size) {
-        MGLError_Set("data size mismatch %d != %d", buffer_view.len, expected_size);
+        MGLError_Set("data size mismatch %zd != %llu", buffer_view.len, expected_size);
         if (data != Py_None) {
             PyBuffer_Release(&buffer_view);
         }
@@ -5364,11 +7944,11 @@ static PyObject * MGLContext_texture_array(MGLContext * self, PyObject * args) {
 
     gl.ActiveTexture(GL_TEXTURE0 + self->default_texture_unit);
 
-    MGLTextureArray * texture = PyObject_New(MGLTextureArray, MGLTextureArray_type);
+    MGLTextureArray * texture = PyObject_New(MGLTextureArray, self->state->MGLTextureArray_type);
     texture->released = false;
 
     texture->texture_obj = 0;
-    gl.GenTextures(1, (GLuint *)&texture->texture_obj);
+    texture->texture_obj = take_name(&self->texture_names, gl.GenTextures);
 
     if (!texture->texture_obj) {
         MGLError_Set("cannot create texture");
@@ -5390,6 +7970,7 @@ static PyObject * MGLContext_texture_array(MGLContext * self, PyObject * args) {
     }
 
     if (data != Py_None) {
+        self->stats.bytes_uploaded += buffer_view.len;
         PyBuffer_Release(&buffer_view);
     }
 
@@ -5410,10 +7991,18 @@ static PyObject * MGLContext_texture_array(MGLContext * self, PyObject * args) {
     Py_INCREF(self);
     texture->context = self;
 
+    self->stats.objects_created += 1;
+    memory_track(self, &texture->memory, MGL_MEMORY_TEXTURE_ARRAY, texture->texture_obj, memory_bytes(texture));
     return Py_BuildValue("(Oi)", texture, texture->texture_obj);
 }
 
 static PyObject * MGLTextureArray_read(MGLTextureArray * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "TextureArray.read", GL_TEXTURE, self->texture_obj);
+
     int alignment;
 
     int args_ok = PyArg_ParseTuple(
@@ -5443,8 +8032,7 @@ static PyObject * MGLTextureArray_read(MGLTextureArray * self, PyObject * args)
 
     const GLMethods & gl = self->context->gl;
 
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_2D_ARRAY, self->texture_obj);
+    bind_texture_target(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj);
 
     gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
     gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
@@ -5469,12 +8057,17 @@ static PyObject * MGLTextureArray_read(MGLTextureArray * self, PyObject * args)
     // printf("level_width: %d\n", level_width);
     // printf("level_height: %d\n", level_height);
 
-    gl.GetTexImage(GL_TEXTURE_2D_ARRAY, 0, base_format, pixel_type, data);
+    get_texture_layers(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, cube(0, 0, 0, self->width, self->height, self->layers), base_format, pixel_type, expected_size, data);
 
+    self->context->stats.bytes_downloaded += expected_size;
     return result;
 }
 
 static PyObject * MGLTextureArray_read_into(MGLTextureArray * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     PyObject * data;
     int alignment;
     Py_ssize_t write_offset;
@@ -5503,18 +8096,17 @@ static PyObject * MGLTextureArray_read_into(MGLTextureArray * self, PyObject * a
     int pixel_type = self->data_type->gl_type;
     int format = self->data_type->base_format[self->components];
 
-    if (Py_TYPE(data) == MGLBuffer_type) {
+    if (Py_TYPE(data) == self->context->state->MGLBuffer_type) {
 
         MGLBuffer * buffer = (MGLBuffer *)data;
 
         const GLMethods & gl = self->context->gl;
 
         gl.BindBuffer(GL_PIXEL_PACK_BUFFER, buffer->buffer_obj);
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_2D_ARRAY, self->texture_obj);
+        bind_texture_target(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj);
         gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.GetTexImage(GL_TEXTURE_2D_ARRAY, 0, format, pixel_type, (void *)write_offset);
+        get_texture_layers(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, cube(0, 0, 0, self->width, self->height, self->layers), format, pixel_type, buffer->size - write_offset, (void *)write_offset);
         gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
     } else {
@@ -5537,12 +8129,12 @@ static PyObject * MGLTextureArray_read_into(MGLTextureArray * self, PyObject * a
 
         const GLMethods & gl = self->context->gl;
 
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_2D_ARRAY, self->texture_obj);
+        bind_texture_target(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj);
         gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.GetTexImage(GL_TEXTURE_2D_ARRAY, 0, format, pixel_type, ptr);
+        get_texture_layers(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, cube(0, 0, 0, self->width, self->height, self->layers), format, pixel_type, expected_size, ptr);
 
+        self->context->stats.bytes_downloaded += expected_size;
         PyBuffer_Release(&buffer_view);
 
     }
@@ -5551,6 +8143,12 @@ static PyObject * MGLTextureArray_read_into(MGLTextureArray * self, PyObject * a
 }
 
 static PyObject * MGLTextureArray_write(MGLTextureArray * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "TextureArray.write", GL_TEXTURE, self->texture_obj);
+
     PyObject * data;
     PyObject * viewport_arg;
     int alignment;
@@ -5589,18 +8187,17 @@ static PyObject * MGLTextureArray_write(MGLTextureArray * self, PyObject * args)
     int pixel_type = self->data_type->gl_type;
     int format = self->data_type->base_format[self->components];
 
-    if (Py_TYPE(data) == MGLBuffer_type) {
+    if (Py_TYPE(data) == self->context->state->MGLBuffer_type) {
 
         MGLBuffer * buffer = (MGLBuffer *)data;
 
         const GLMethods & gl = self->context->gl;
 
         gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->buffer_obj);
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_2D_ARRAY, self->texture_obj);
+        bind_texture_target(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj);
         gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.TexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, viewport_cube.x, viewport_cube.y, viewport_cube.z, viewport_cube.width, viewport_cube.height, viewport_cube.depth, format, pixel_type, 0);
+        texture_layers_sub_image(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, viewport_cube, format, pixel_type, 0);
         gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
     } else {
@@ -5612,7 +8209,7 @@ static PyObject * MGLTextureArray_write(MGLTextureArray * self, PyObject * args)
         }
 
         if (buffer_view.len != expected_size) {
-            MGLError_Set("data size mismatch %d != %d", buffer_view.len, expected_size);
+            MGLError_Set("data size mismatch %zd != %llu", buffer_view.len, expected_size);
             if (data != Py_None) {
                 PyBuffer_Release(&buffer_view);
             }
@@ -5621,12 +8218,12 @@ static PyObject * MGLTextureArray_write(MGLTextureArray * self, PyObject * args)
 
         const GLMethods & gl = self->context->gl;
 
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_2D_ARRAY, self->texture_obj);
+        bind_texture_target(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj);
         gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.TexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, viewport_cube.x, viewport_cube.y, viewport_cube.z, viewport_cube.width, viewport_cube.height, viewport_cube.depth, format, pixel_type, buffer_view.buf);
+        texture_layers_sub_image(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, viewport_cube, format, pixel_type, buffer_view.buf);
 
+        self->context->stats.bytes_uploaded += buffer_view.len;
         PyBuffer_Release(&buffer_view);
 
     }
@@ -5635,6 +8232,12 @@ static PyObject * MGLTextureArray_write(MGLTextureArray * self, PyObject * args)
 }
 
 static PyObject * MGLTextureArray_meth_bind(MGLTextureArray * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "TextureArray.bind_to_image", GL_TEXTURE, self->texture_obj, true);
+
     int unit;
     int read;
     int write;
@@ -5672,6 +8275,12 @@ static PyObject * MGLTextureArray_meth_bind(MGLTextureArray * self, PyObject * a
 }
 
 static PyObject * MGLTextureArray_use(MGLTextureArray * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "TextureArray.use", GL_TEXTURE, self->texture_obj, true);
+
     int index;
 
     int args_ok = PyArg_ParseTuple(
@@ -5689,10 +8298,15 @@ static PyObject * MGLTextureArray_use(MGLTextureArray * self, PyObject * args) {
     gl.ActiveTexture(GL_TEXTURE0 + index);
     gl.BindTexture(GL_TEXTURE_2D_ARRAY, self->texture_obj);
 
+    self->context->stats.texture_binds += 1;
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLTextureArray_build_mipmaps(MGLTextureArray * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     int base = 0;
     int max = 1000;
 
@@ -5714,33 +8328,39 @@ static PyObject * MGLTextureArray_build_mipmaps(MGLTextureArray * self, PyObject
 
     int texture_target = GL_TEXTURE_2D_ARRAY;
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(texture_target, self->texture_obj);
+    bind_texture_target(self->context, texture_target, self->texture_obj);
 
-    gl.TexParameteri(texture_target, GL_TEXTURE_BASE_LEVEL, base);
-    gl.TexParameteri(texture_target, GL_TEXTURE_MAX_LEVEL, max);
+    texture_target_parameteri(self->context, texture_target, self->texture_obj, GL_TEXTURE_BASE_LEVEL, base);
+    texture_target_parameteri(self->context, texture_target, self->texture_obj, GL_TEXTURE_MAX_LEVEL, max);
 
-    gl.GenerateMipmap(texture_target);
+    generate_texture_target_mipmap(self->context, texture_target, self->texture_obj);
 
-    gl.TexParameteri(texture_target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    gl.TexParameteri(texture_target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    texture_target_parameteri(self->context, texture_target, self->texture_obj, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    texture_target_parameteri(self->context, texture_target, self->texture_obj, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     self->min_filter = GL_LINEAR_MIPMAP_LINEAR;
     self->mag_filter = GL_LINEAR;
     self->max_level = max;
+    memory_resize(self->context, &self->memory, memory_bytes(self));
 
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLTextureArray_get_handle(MGLTextureArray * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     int resident = true;
 
     if(!PyArg_ParseTuple(args, "|p", &resident)) {
         return NULL;
     }
 
+    if (!load_gl_bindless_texture_methods(self->context->gl)) {
+        MGLError_Set("bindless textures are not supported");
+        return 0;
+    }
+
     const GLMethods & gl = self->context->gl;
 
     unsigned long long handle = gl.GetTextureHandleARB(self->texture_obj);
@@ -5757,7 +8377,12 @@ static PyObject * MGLTextureArray_release(MGLTextureArray * self, PyObject * arg
     if (self->released) {
         Py_RETURN_NONE;
     }
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     self->released = true;
+    self->context->stats.objects_released += 1;
+    memory_untrack(self->context, &self->memory);
 
     const GLMethods & gl = self->context->gl;
     gl.DeleteTextures(1, (GLuint *)&self->texture_obj);
@@ -5772,18 +8397,18 @@ static PyObject * MGLTextureArray_get_repeat_x(MGLTextureArray * self, void * cl
 }
 
 static int MGLTextureArray_set_repeat_x(MGLTextureArray * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_2D_ARRAY, self->texture_obj);
+    bind_texture_target(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj);
 
     if (value == Py_True) {
-        gl.TexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        texture_target_parameteri(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, GL_TEXTURE_WRAP_S, GL_REPEAT);
         self->repeat_x = true;
         return 0;
     } else if (value == Py_False) {
-        gl.TexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        texture_target_parameteri(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         self->repeat_x = false;
         return 0;
     } else {
@@ -5797,18 +8422,18 @@ static PyObject * MGLTextureArray_get_repeat_y(MGLTextureArray * self, void * cl
 }
 
 static int MGLTextureArray_set_repeat_y(MGLTextureArray * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_2D_ARRAY, self->texture_obj);
+    bind_texture_target(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj);
 
     if (value == Py_True) {
-        gl.TexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        texture_target_parameteri(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, GL_TEXTURE_WRAP_T, GL_REPEAT);
         self->repeat_y = true;
         return 0;
     } else if (value == Py_False) {
-        gl.TexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        texture_target_parameteri(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         self->repeat_y = false;
         return 0;
     } else {
@@ -5822,37 +8447,37 @@ static PyObject * MGLTextureArray_get_filter(MGLTextureArray * self, void * clos
 }
 
 static int MGLTextureArray_set_filter(MGLTextureArray * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     if (!parse_filter(value, &self->min_filter, &self->mag_filter)) {
         MGLError_Set("invalid filter");
         return -1;
     }
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_2D_ARRAY, self->texture_obj);
-    gl.TexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, self->min_filter);
-    gl.TexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, self->mag_filter);
+    bind_texture_target(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj);
+    texture_target_parameteri(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, GL_TEXTURE_MIN_FILTER, self->min_filter);
+    texture_target_parameteri(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, GL_TEXTURE_MAG_FILTER, self->mag_filter);
 
     return 0;
 }
 
 static PyObject * MGLTextureArray_get_swizzle(MGLTextureArray * self, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_2D_ARRAY, self->texture_obj);
+    bind_texture_target(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj);
 
     int swizzle_r = 0;
     int swizzle_g = 0;
     int swizzle_b = 0;
     int swizzle_a = 0;
 
-    gl.GetTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_R, &swizzle_r);
-    gl.GetTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_G, &swizzle_g);
-    gl.GetTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_B, &swizzle_b);
-    gl.GetTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_A, &swizzle_a);
+    get_texture_target_parameteriv(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, GL_TEXTURE_SWIZZLE_R, &swizzle_r);
+    get_texture_target_parameteriv(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, GL_TEXTURE_SWIZZLE_G, &swizzle_g);
+    get_texture_target_parameteriv(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, GL_TEXTURE_SWIZZLE_B, &swizzle_b);
+    get_texture_target_parameteriv(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, GL_TEXTURE_SWIZZLE_A, &swizzle_a);
 
     char swizzle[5] = {
         char_from_swizzle(swizzle_r),
@@ -5866,6 +8491,9 @@ static PyObject * MGLTextureArray_get_swizzle(MGLTextureArray * self, void * clo
 }
 
 static int MGLTextureArray_set_swizzle(MGLTextureArray * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     const char * swizzle = PyUnicode_AsUTF8(value);
 
     if (!swizzle[0]) {
@@ -5890,18 +8518,15 @@ static int MGLTextureArray_set_swizzle(MGLTextureArray * self, PyObject * value,
     }
 
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_2D_ARRAY, self->texture_obj);
+    bind_texture_target(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj);
 
-    gl.TexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
+    texture_target_parameteri(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
     if (tex_swizzle[1] != -1) {
-        gl.TexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
+        texture_target_parameteri(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
         if (tex_swizzle[2] != -1) {
-            gl.TexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
+            texture_target_parameteri(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
             if (tex_swizzle[3] != -1) {
-                gl.TexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
+                texture_target_parameteri(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
             }
         }
     }
@@ -5914,19 +8539,26 @@ static PyObject * MGLTextureArray_get_anisotropy(MGLTextureArray * self, void *
 }
 
 static int MGLTextureArray_set_anisotropy(MGLTextureArray * self, PyObject * value, void * closure) {
-    if (self->context->max_anisotropy == 0) return 0;
-    self->anisotropy = (float)MGL_MIN(MGL_MAX(PyFloat_AsDouble(value), 1.0), self->context->max_anisotropy);
-
-    const GLMethods & gl = self->context->gl;
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
+    float max_anisotropy = context_max_anisotropy(self->context);
+    if (max_anisotropy == 0) return 0;
+    self->anisotropy = (float)MGL_MIN(MGL_MAX(PyFloat_AsDouble(value), 1.0), max_anisotropy);
 
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_2D_ARRAY, self->texture_obj);
-    gl.TexParameterf(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_ANISOTROPY, self->anisotropy);
+    bind_texture_target(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj);
+    texture_target_parameterf(self->context, GL_TEXTURE_2D_ARRAY, self->texture_obj, GL_TEXTURE_MAX_ANISOTROPY, self->anisotropy);
 
     return 0;
 }
 
 static PyObject * MGLContext_texture_cube(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLStartupScope startup(self, MGL_STARTUP_TEXTURES);
+
     int width;
     int height;
 
@@ -5990,7 +8622,7 @@ static PyObject * MGLContext_texture_cube(MGLContext * self, PyObject * args) {
     }
 
     if (buffer_view.len != expected_size) {
-        MGLError_Set("data size mismatch %d != %d", buffer_view.len, expected_size);
+        MGLError_Set("data size mismatch %zd != %llu", buffer_view.len, expected_size);
         if (data != Py_None) {
             PyBuffer_Release(&buffer_view);
         }
@@ -6003,11 +8635,11 @@ static PyObject * MGLContext_texture_cube(MGLContext * self, PyObject * args) {
 
     const GLMethods & gl = self->gl;
 
-    MGLTextureCube * texture = PyObject_New(MGLTextureCube, MGLTextureCube_type);
+    MGLTextureCube * texture = PyObject_New(MGLTextureCube, self->state->MGLTextureCube_type);
     texture->released = false;
 
     texture->texture_obj = 0;
-    gl.GenTextures(1, (GLuint *)&texture->texture_obj);
+    texture->texture_obj = take_name(&self->texture_names, gl.GenTextures);
 
     if (!texture->texture_obj) {
         MGLError_Set("cannot create texture");
@@ -6048,6 +8680,7 @@ static PyObject * MGLContext_texture_cube(MGLContext * self, PyObject * args) {
     }
 
     if (data != Py_None) {
+        self->stats.bytes_uploaded += buffer_view.len;
         PyBuffer_Release(&buffer_view);
     }
 
@@ -6066,10 +8699,16 @@ static PyObject * MGLContext_texture_cube(MGLContext * self, PyObject * args) {
     Py_INCREF(self);
     texture->context = self;
 
+    self->stats.objects_created += 1;
+    memory_track(self, &texture->memory, MGL_MEMORY_TEXTURE_CUBE, texture->texture_obj, memory_bytes(texture));
     return Py_BuildValue("(Oi)", texture, texture->texture_obj);
 }
 
 static PyObject * MGLContext_depth_texture_cube(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
     int width;
     int height;
 
@@ -6113,7 +8752,7 @@ static PyObject * MGLContext_depth_texture_cube(MGLContext * self, PyObject * ar
     }
 
     if (buffer_view.len != expected_size) {
-        MGLError_Set("data size mismatch %d != %d", buffer_view.len, expected_size);
+        MGLError_Set("data size mismatch %zd != %llu", buffer_view.len, expected_size);
         if (data != Py_None) {
             PyBuffer_Release(&buffer_view);
         }
@@ -6126,11 +8765,11 @@ static PyObject * MGLContext_depth_texture_cube(MGLContext * self, PyObject * ar
 
     const GLMethods & gl = self->gl;
 
-    MGLTextureCube * texture = PyObject_New(MGLTextureCube, MGLTextureCube_type);
+    MGLTextureCube * texture = PyObject_New(MGLTextureCube, self->state->MGLTextureCube_type);
     texture->released = false;
 
     texture->texture_obj = 0;
-    gl.GenTextures(1, (GLuint *)&texture->texture_obj);
+    texture->texture_obj = take_name(&self->texture_names, gl.GenTextures);
 
     if (!texture->texture_obj) {
         MGLError_Set("cannot create texture");
@@ -6166,6 +8805,7 @@ static PyObject * MGLContext_depth_texture_cube(MGLContext * self, PyObject * ar
     gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     if (data != Py_None) {
+        self->stats.bytes_uploaded += buffer_view.len;
         PyBuffer_Release(&buffer_view);
     }
 
@@ -6186,10 +8826,18 @@ static PyObject * MGLContext_depth_texture_cube(MGLContext * self, PyObject * ar
     Py_INCREF(self);
     texture->context = self;
 
+    self->stats.objects_created += 1;
+    memory_track(self, &texture->memory, MGL_MEMORY_TEXTURE_CUBE, texture->texture_obj, memory_bytes(texture));
     return Py_BuildValue("(Oi)", texture, texture->texture_obj);
 }
 
 static PyObject * MGLTextureCube_read(MGLTextureCube * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "TextureCube.read", GL_TEXTURE, self->texture_obj);
+
     int face;
     int alignment;
 
@@ -6226,17 +8874,21 @@ static PyObject * MGLTextureCube_read(MGLTextureCube * self, PyObject * args) {
 
     const GLMethods & gl = self->context->gl;
 
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_CUBE_MAP, self->texture_obj);
+    bind_texture_target(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj);
 
     gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
     gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-    gl.GetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, format, pixel_type, data);
+    get_texture_layers(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, cube(0, 0, face, self->width, self->height, 1), format, pixel_type, expected_size, data);
 
+    self->context->stats.bytes_downloaded += expected_size;
     return result;
 }
 
 static PyObject * MGLTextureCube_read_into(MGLTextureCube * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     PyObject * data;
     int face;
     int alignment;
@@ -6272,18 +8924,17 @@ static PyObject * MGLTextureCube_read_into(MGLTextureCube * self, PyObject * arg
     int pixel_type = self->data_type->gl_type;
     int format = self->depth ? GL_DEPTH_COMPONENT : self->data_type->base_format[self->components];
 
-    if (Py_TYPE(data) == MGLBuffer_type) {
+    if (Py_TYPE(data) == self->context->state->MGLBuffer_type) {
 
         MGLBuffer * buffer = (MGLBuffer *)data;
 
         const GLMethods & gl = self->context->gl;
 
         gl.BindBuffer(GL_PIXEL_PACK_BUFFER, buffer->buffer_obj);
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_CUBE_MAP, self->texture_obj);
+        bind_texture_target(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj);
         gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.GetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, format, pixel_type, (char *)write_offset);
+        get_texture_layers(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, cube(0, 0, face, self->width, self->height, 1), format, pixel_type, buffer->size - write_offset, (char *)write_offset);
         gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
     } else {
@@ -6305,12 +8956,12 @@ static PyObject * MGLTextureCube_read_into(MGLTextureCube * self, PyObject * arg
         char * ptr = (char *)buffer_view.buf + write_offset;
 
         const GLMethods & gl = self->context->gl;
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_CUBE_MAP, self->texture_obj);
+        bind_texture_target(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj);
         gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.GetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, format, pixel_type, ptr);
+        get_texture_layers(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, cube(0, 0, face, self->width, self->height, 1), format, pixel_type, expected_size, ptr);
 
+        self->context->stats.bytes_downloaded += expected_size;
         PyBuffer_Release(&buffer_view);
 
     }
@@ -6319,6 +8970,12 @@ static PyObject * MGLTextureCube_read_into(MGLTextureCube * self, PyObject * arg
 }
 
 static PyObject * MGLTextureCube_write(MGLTextureCube * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "TextureCube.write", GL_TEXTURE, self->texture_obj);
+
     int face;
     PyObject * data;
     PyObject * viewport_arg;
@@ -6371,18 +9028,17 @@ static PyObject * MGLTextureCube_write(MGLTextureCube * self, PyObject * args) {
     int pixel_type = self->data_type->gl_type;
     int format = self->depth ? GL_DEPTH_COMPONENT : self->data_type->base_format[self->components];
 
-    if (Py_TYPE(data) == MGLBuffer_type) {
+    if (Py_TYPE(data) == self->context->state->MGLBuffer_type) {
 
         MGLBuffer * buffer = (MGLBuffer *)data;
 
         const GLMethods & gl = self->context->gl;
 
         gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->buffer_obj);
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_CUBE_MAP, self->texture_obj);
+        bind_texture_target(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj);
         gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.TexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, viewport_rect.x, viewport_rect.y, viewport_rect.width, viewport_rect.height, format, pixel_type, 0);
+        texture_layers_sub_image(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, cube(viewport_rect.x, viewport_rect.y, face, viewport_rect.width, viewport_rect.height, 1), format, pixel_type, 0);
         gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
     } else {
@@ -6394,20 +9050,20 @@ static PyObject * MGLTextureCube_write(MGLTextureCube * self, PyObject * args) {
         }
 
         if (buffer_view.len != expected_size) {
-            MGLError_Set("data size mismatch %d != %d", buffer_view.len, expected_size);
+            MGLError_Set("data size mismatch %zd != %llu", buffer_view.len, expected_size);
             PyBuffer_Release(&buffer_view);
             return 0;
         }
 
         const GLMethods & gl = self->context->gl;
 
-        gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-        gl.BindTexture(GL_TEXTURE_CUBE_MAP, self->texture_obj);
+        bind_texture_target(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj);
 
         gl.PixelStorei(GL_PACK_ALIGNMENT, alignment);
         gl.PixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-        gl.TexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, viewport_rect.x, viewport_rect.y, viewport_rect.width, viewport_rect.height, format, pixel_type, buffer_view.buf);
+        texture_layers_sub_image(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, cube(viewport_rect.x, viewport_rect.y, face, viewport_rect.width, viewport_rect.height, 1), format, pixel_type, buffer_view.buf);
 
+        self->context->stats.bytes_uploaded += buffer_view.len;
         PyBuffer_Release(&buffer_view);
     }
 
@@ -6415,6 +9071,12 @@ static PyObject * MGLTextureCube_write(MGLTextureCube * self, PyObject * args) {
 }
 
 static PyObject * MGLTextureCube_meth_bind(MGLTextureCube * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "TextureCube.bind_to_image", GL_TEXTURE, self->texture_obj, true);
+
     int unit;
     int read;
     int write;
@@ -6452,6 +9114,12 @@ static PyObject * MGLTextureCube_meth_bind(MGLTextureCube * self, PyObject * arg
 }
 
 static PyObject * MGLTextureCube_use(MGLTextureCube * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "TextureCube.use", GL_TEXTURE, self->texture_obj, true);
+
     int index;
 
     int args_ok = PyArg_ParseTuple(
@@ -6468,16 +9136,25 @@ static PyObject * MGLTextureCube_use(MGLTextureCube * self, PyObject * args) {
     gl.ActiveTexture(GL_TEXTURE0 + index);
     gl.BindTexture(GL_TEXTURE_CUBE_MAP, self->texture_obj);
 
+    self->context->stats.texture_binds += 1;
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLTextureCube_get_handle(MGLTextureCube * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     int resident = true;
 
     if(!PyArg_ParseTuple(args, "|p", &resident)) {
         return NULL;
     }
 
+    if (!load_gl_bindless_texture_methods(self->context->gl)) {
+        MGLError_Set("bindless textures are not supported");
+        return 0;
+    }
+
     const GLMethods & gl = self->context->gl;
 
     unsigned long long handle = gl.GetTextureHandleARB(self->texture_obj);
@@ -6491,6 +9168,10 @@ static PyObject * MGLTextureCube_get_handle(MGLTextureCube * self, PyObject * ar
 }
 
 static PyObject * MGLTextureCube_build_mipmaps(MGLTextureCube * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     int base = 0;
     int max = 1000;
 
@@ -6512,22 +9193,20 @@ static PyObject * MGLTextureCube_build_mipmaps(MGLTextureCube * self, PyObject *
 
     int texture_target = GL_TEXTURE_CUBE_MAP;
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(texture_target, self->texture_obj);
+    bind_texture_target(self->context, texture_target, self->texture_obj);
 
-    gl.TexParameteri(texture_target, GL_TEXTURE_BASE_LEVEL, base);
-    gl.TexParameteri(texture_target, GL_TEXTURE_MAX_LEVEL, max);
+    texture_target_parameteri(self->context, texture_target, self->texture_obj, GL_TEXTURE_BASE_LEVEL, base);
+    texture_target_parameteri(self->context, texture_target, self->texture_obj, GL_TEXTURE_MAX_LEVEL, max);
 
-    gl.GenerateMipmap(texture_target);
+    generate_texture_target_mipmap(self->context, texture_target, self->texture_obj);
 
-    gl.TexParameteri(texture_target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    gl.TexParameteri(texture_target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    texture_target_parameteri(self->context, texture_target, self->texture_obj, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    texture_target_parameteri(self->context, texture_target, self->texture_obj, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     self->min_filter = GL_LINEAR_MIPMAP_LINEAR;
     self->mag_filter = GL_LINEAR;
     self->max_level = max;
+    memory_resize(self->context, &self->memory, memory_bytes(self));
 
     Py_RETURN_NONE;
 }
@@ -6536,7 +9215,12 @@ static PyObject * MGLTextureCube_release(MGLTextureCube * self, PyObject * args)
     if (self->released) {
         Py_RETURN_NONE;
     }
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     self->released = true;
+    self->context->stats.objects_released += 1;
+    memory_untrack(self->context, &self->memory);
 
     // TODO: decref
 
@@ -6552,41 +9236,41 @@ static PyObject * MGLTextureCube_get_filter(MGLTextureCube * self, void * closur
 }
 
 static int MGLTextureCube_set_filter(MGLTextureCube * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     if (!parse_filter(value, &self->min_filter, &self->mag_filter)) {
         MGLError_Set("invalid filter");
         return -1;
     }
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_CUBE_MAP, self->texture_obj);
-    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, self->min_filter);
-    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, self->mag_filter);
+    bind_texture_target(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj);
+    texture_target_parameteri(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, GL_TEXTURE_MIN_FILTER, self->min_filter);
+    texture_target_parameteri(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, GL_TEXTURE_MAG_FILTER, self->mag_filter);
 
     return 0;
 }
 
 static PyObject * MGLTextureCube_get_swizzle(MGLTextureCube * self, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     if (self->depth) {
         MGLError_Set("cannot get swizzle of depth textures");
         return 0;
     }
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_CUBE_MAP, self->texture_obj);
+    bind_texture_target(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj);
 
     int swizzle_r = 0;
     int swizzle_g = 0;
     int swizzle_b = 0;
     int swizzle_a = 0;
 
-    gl.GetTexParameteriv(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_R, &swizzle_r);
-    gl.GetTexParameteriv(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_G, &swizzle_g);
-    gl.GetTexParameteriv(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_B, &swizzle_b);
-    gl.GetTexParameteriv(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_A, &swizzle_a);
+    get_texture_target_parameteriv(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, GL_TEXTURE_SWIZZLE_R, &swizzle_r);
+    get_texture_target_parameteriv(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, GL_TEXTURE_SWIZZLE_G, &swizzle_g);
+    get_texture_target_parameteriv(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, GL_TEXTURE_SWIZZLE_B, &swizzle_b);
+    get_texture_target_parameteriv(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, GL_TEXTURE_SWIZZLE_A, &swizzle_a);
 
     char swizzle[5] = {
         char_from_swizzle(swizzle_r),
@@ -6600,6 +9284,9 @@ static PyObject * MGLTextureCube_get_swizzle(MGLTextureCube * self, void * closu
 }
 
 static int MGLTextureCube_set_swizzle(MGLTextureCube * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     const char * swizzle = PyUnicode_AsUTF8(value);
 
     if (self->depth) {
@@ -6629,18 +9316,15 @@ static int MGLTextureCube_set_swizzle(MGLTextureCube * self, PyObject * value, v
     }
 
 
-    const GLMethods & gl = self->context->gl;
-
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_CUBE_MAP, self->texture_obj);
+    bind_texture_target(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj);
 
-    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
+    texture_target_parameteri(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
     if (tex_swizzle[1] != -1) {
-        gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
+        texture_target_parameteri(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
         if (tex_swizzle[2] != -1) {
-            gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
+            texture_target_parameteri(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
             if (tex_swizzle[3] != -1) {
-                gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
+                texture_target_parameteri(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
             }
         }
     }
@@ -6658,6 +9342,9 @@ static PyObject * MGLTextureCube_get_compare_func(MGLTextureCube * self, void *
 }
 
 static int MGLTextureCube_set_compare_func(MGLTextureCube * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
     if (!self->depth) {
         MGLError_Set("only depth textures have compare_func");
         return -1;
@@ -6671,14 +9358,12 @@ static int MGLTextureCube_set_compare_func(MGLTextureCube * self, PyObject * val
 
     self->compare_func = compare_func_from_string(func);
 
-    const GLMethods & gl = self->context->gl;
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_CUBE_MAP, self->texture_obj);
+    bind_texture_target(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj);
     if (self->compare_func == 0) {
-        gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+        texture_target_parameteri(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, GL_TEXTURE_COMPARE_MODE, GL_NONE);
     } else {
-        gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
-        gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_COMPARE_FUNC, self->compare_func);
+        texture_target_parameteri(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+        texture_target_parameteri(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, GL_TEXTURE_COMPARE_FUNC, self->compare_func);
     }
 
     return 0;
@@ -6689,19 +9374,26 @@ static PyObject * MGLTextureCube_get_anisotropy(MGLTextureCube * self, void * cl
 }
 
 static int MGLTextureCube_set_anisotropy(MGLTextureCube * self, PyObject * value, void * closure) {
-    if (self->context->max_anisotropy == 0) return 0;
-    self->anisotropy = (float)MGL_MIN(MGL_MAX(PyFloat_AsDouble(value), 1.0), self->context->max_anisotropy);
-
-    const GLMethods & gl = self->context->gl;
+    if (!check_context_thread(self->context)) {
+        return -1;
+    }
+    float max_anisotropy = context_max_anisotropy(self->context);
+    if (max_anisotropy == 0) return 0;
+    self->anisotropy = (float)MGL_MIN(MGL_MAX(PyFloat_AsDouble(value), 1.0), max_anisotropy);
 
-    gl.ActiveTexture(GL_TEXTURE0 + self->context->default_texture_unit);
-    gl.BindTexture(GL_TEXTURE_CUBE_MAP, self->texture_obj);
-    gl.TexParameterf(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_ANISOTROPY, self->anisotropy);
+    bind_texture_target(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj);
+    texture_target_parameterf(self->context, GL_TEXTURE_CUBE_MAP, self->texture_obj, GL_TEXTURE_MAX_ANISOTROPY, self->anisotropy);
 
     return 0;
 }
 
 static PyObject * MGLContext_vertex_array(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLStartupScope startup(self, MGL_STARTUP_VERTEX_ARRAYS);
+
     MGLProgram * program;
     PyObject * content;
     MGLBuffer * index_buffer;
@@ -6710,7 +9402,7 @@ static PyObject * MGLContext_vertex_array(MGLContext * self, PyObject * args) {
     int args_ok = PyArg_ParseTuple(
         args,
         "O!OOI",
-        MGLProgram_type,
+        self->state->MGLProgram_type,
         &program,
         &content,
         &index_buffer,
@@ -6744,7 +9436,7 @@ static PyObject * MGLContext_vertex_array(MGLContext * self, PyObject * args) {
         PyObject * buffer = PyTuple_GET_ITEM(tuple, 0);
         PyObject * format = PyTuple_GET_ITEM(tuple, 1);
 
-        if (Py_TYPE(buffer) != MGLBuffer_type) {
+        if (Py_TYPE(buffer) != self->state->MGLBuffer_type) {
             MGLError_Set("content[%d][0] must be a Buffer not %s", i, Py_TYPE(buffer)->tp_name);
             return 0;
         }
@@ -6780,7 +9472,7 @@ static PyObject * MGLContext_vertex_array(MGLContext * self, PyObject * args) {
         }
     }
 
-    if (index_buffer != (MGLBuffer *)Py_None && Py_TYPE(index_buffer) != MGLBuffer_type) {
+    if (index_buffer != (MGLBuffer *)Py_None && Py_TYPE(index_buffer) != self->state->MGLBuffer_type) {
         MGLError_Set("the index_buffer must be a Buffer not %s", Py_TYPE(index_buffer)->tp_name);
         return 0;
     }
@@ -6792,7 +9484,7 @@ static PyObject * MGLContext_vertex_array(MGLContext * self, PyObject * args) {
 
     const GLMethods & gl = self->gl;
 
-    MGLVertexArray * array = PyObject_New(MGLVertexArray, MGLVertexArray_type);
+    MGLVertexArray * array = PyObject_New(MGLVertexArray, self->state->MGLVertexArray_type);
     array->released = false;
 
     array->num_vertices = 0;
@@ -6802,7 +9494,7 @@ static PyObject * MGLContext_vertex_array(MGLContext * self, PyObject * args) {
     array->program = program;
 
     array->vertex_array_obj = 0;
-    gl.GenVertexArrays(1, (GLuint *)&array->vertex_array_obj);
+    array->vertex_array_obj = take_name(&self->vertex_array_names, gl.GenVertexArrays);
 
     if (!array->vertex_array_obj) {
         MGLError_Set("cannot create vertex array");
@@ -6820,7 +9512,7 @@ static PyObject * MGLContext_vertex_array(MGLContext * self, PyObject * args) {
     array->index_element_type = element_types[index_element_size];
 
     if (index_buffer != (MGLBuffer *)Py_None) {
-        array->num_vertices = (int)(index_buffer->size / index_element_size);
+        array->num_vertices = index_buffer->size / index_element_size;
         gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer->buffer_obj);
     } else {
         array->num_vertices = -1;
@@ -6835,7 +9527,7 @@ static PyObject * MGLContext_vertex_array(MGLContext * self, PyObject * args) {
         FormatIterator it = FormatIterator(format);
         FormatInfo format_info = it.info();
 
-        int buf_vertices = (int)(buffer->size / format_info.size);
+        Py_ssize_t buf_vertices = buffer->size / format_info.size;
 
         if (!format_info.divisor && array->index_buffer == (MGLBuffer *)Py_None && (!i || array->num_vertices > buf_vertices)) {
             array->num_vertices = buf_vertices;
@@ -6896,18 +9588,46 @@ static PyObject * MGLContext_vertex_array(MGLContext * self, PyObject * args) {
     Py_INCREF(self);
     array->context = self;
 
+    self->stats.objects_created += 1;
     return Py_BuildValue("(Oi)", array, array->vertex_array_obj);
 }
 
+static bool check_draw_range(MGLVertexArray * self, Py_ssize_t vertices, Py_ssize_t first, Py_ssize_t instances) {
+    // OpenGL takes the counts of a single draw call as GLsizei and the first vertex as GLint.
+    // The first index of an indexed draw is a byte offset and is not limited.
+    if (vertices > INT_MAX || instances > INT_MAX) {
+        MGLError_Set("a single draw call is limited to %d vertices and instances, split the draw using first", INT_MAX);
+        return false;
+    }
+
+    if (first < 0) {
+        MGLError_Set("first must not be negative");
+        return false;
+    }
+
+    if (self->index_buffer == (MGLBuffer *)Py_None && first > INT_MAX) {
+        MGLError_Set("first is limited to %d without an index buffer", INT_MAX);
+        return false;
+    }
+
+    return true;
+}
+
 static PyObject * MGLVertexArray_render(MGLVertexArray * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "VertexArray.render", GL_VERTEX_ARRAY, self->vertex_array_obj);
+
     int mode;
-    int vertices;
-    int first;
-    int instances;
+    Py_ssize_t vertices;
+    Py_ssize_t first;
+    Py_ssize_t instances;
 
     int args_ok = PyArg_ParseTuple(
         args,
-        "IIII",
+        "Innn",
         &mode,
         &vertices,
         &first,
@@ -6931,31 +9651,46 @@ static PyObject * MGLVertexArray_render(MGLVertexArray * self, PyObject * args)
         instances = self->num_instances;
     }
 
+    if (!check_draw_range(self, vertices, first, instances)) {
+        return 0;
+    }
+
     const GLMethods & gl = self->context->gl;
 
     gl.UseProgram(self->program->program_obj);
     gl.BindVertexArray(self->vertex_array_obj);
+    self->context->stats.draws += 1;
+    self->context->stats.program_binds += 1;
+    self->context->stats.vertex_array_binds += 1;
 
+    Py_BEGIN_ALLOW_THREADS
     if (self->index_buffer != (MGLBuffer *)Py_None) {
         const void * ptr = (const void *)((GLintptr)first * self->index_element_size);
-        gl.DrawElementsInstanced(mode, vertices, self->index_element_type, ptr, instances);
+        gl.DrawElementsInstanced(mode, (GLsizei)vertices, self->index_element_type, ptr, (GLsizei)instances);
     } else {
-        gl.DrawArraysInstanced(mode, first, vertices, instances);
+        gl.DrawArraysInstanced(mode, (GLint)first, (GLsizei)vertices, (GLsizei)instances);
     }
+    Py_END_ALLOW_THREADS
 
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLVertexArray_render_indirect(MGLVertexArray * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "VertexArray.render_indirect", GL_VERTEX_ARRAY, self->vertex_array_obj);
+
     MGLBuffer * buffer;
     int mode;
-    int count;
-    int first;
+    Py_ssize_t count;
+    Py_ssize_t first;
 
     int args_ok = PyArg_ParseTuple(
         args,
-        "O!III",
-        MGLBuffer_type,
+        "O!Inn",
+        self->context->state->MGLBuffer_type,
         &buffer,
         &mode,
         &count,
@@ -6966,38 +9701,57 @@ static PyObject * MGLVertexArray_render_indirect(MGLVertexArray * self, PyObject
         return 0;
     }
 
-    if (count < 0) {
-        count = (int)(buffer->size / 20 - first);
+    if (first < 0) {
+        MGLError_Set("first must not be negative");
+        return 0;
+    }
+
+    if (count < 0) {
+        count = buffer->size / 20 - first;
+    }
+
+    if (count > INT_MAX) {
+        MGLError_Set("a single indirect draw is limited to %d commands", INT_MAX);
+        return 0;
     }
 
     const GLMethods & gl = self->context->gl;
 
     gl.UseProgram(self->program->program_obj);
     gl.BindVertexArray(self->vertex_array_obj);
+    self->context->stats.draws += 1;
+    self->context->stats.program_binds += 1;
+    self->context->stats.vertex_array_binds += 1;
     gl.BindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer->buffer_obj);
 
     const void * ptr = (const void *)((GLintptr)first * 20);
 
     if (self->index_buffer != (MGLBuffer *)Py_None) {
-        gl.MultiDrawElementsIndirect(mode, self->index_element_type, ptr, count, 20);
+        gl.MultiDrawElementsIndirect(mode, self->index_element_type, ptr, (GLsizei)count, 20);
     } else {
-        gl.MultiDrawArraysIndirect(mode, ptr, count, 20);
+        gl.MultiDrawArraysIndirect(mode, ptr, (GLsizei)count, 20);
     }
 
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLVertexArray_transform(MGLVertexArray * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self->context, "VertexArray.transform", GL_VERTEX_ARRAY, self->vertex_array_obj);
+
     PyObject * outputs;
     int mode;
-    int vertices;
-    int first;
-    int instances;
-    int buffer_offset;
+    Py_ssize_t vertices;
+    Py_ssize_t first;
+    Py_ssize_t instances;
+    Py_ssize_t buffer_offset;
 
     int args_ok = PyArg_ParseTuple(
         args,
-        "O!IIIII",
+        "O!Innnn",
         &PyList_Type,
         &outputs,
         &mode,
@@ -7029,6 +9783,10 @@ static PyObject * MGLVertexArray_transform(MGLVertexArray * self, PyObject * arg
         instances = self->num_instances;
     }
 
+    if (!check_draw_range(self, vertices, first, instances)) {
+        return 0;
+    }
+
     int output_mode = -1;
 
     // If a geo shader is present we need to sanity check the the rendering mode
@@ -7106,11 +9864,14 @@ static PyObject * MGLVertexArray_transform(MGLVertexArray * self, PyObject * arg
 
     gl.UseProgram(self->program->program_obj);
     gl.BindVertexArray(self->vertex_array_obj);
+    self->context->stats.draws += 1;
+    self->context->stats.program_binds += 1;
+    self->context->stats.vertex_array_binds += 1;
 
     int num_outputs = (int)PyList_Size(outputs);
     for (int i = 0; i < num_outputs; ++i) {
         MGLBuffer * output = (MGLBuffer *)PyList_GET_ITEM(outputs, i);
-        gl.BindBufferRange(GL_TRANSFORM_FEEDBACK_BUFFER, i, output->buffer_obj, buffer_offset, output->size - buffer_offset);
+        gl.BindBufferRange(GL_TRANSFORM_FEEDBACK_BUFFER, i, output->buffer_obj, (GLintptr)buffer_offset, (GLsizeiptr)(output->size - buffer_offset));
     }
 
     gl.Enable(GL_RASTERIZER_DISCARD);
@@ -7118,9 +9879,9 @@ static PyObject * MGLVertexArray_transform(MGLVertexArray * self, PyObject * arg
 
     if (self->index_buffer != (MGLBuffer *)Py_None) {
         const void * ptr = (const void *)((GLintptr)first * self->index_element_size);
-        gl.DrawElementsInstanced(mode, vertices, self->index_element_type, ptr, instances);
+        gl.DrawElementsInstanced(mode, (GLsizei)vertices, self->index_element_type, ptr, (GLsizei)instances);
     } else {
-        gl.DrawArraysInstanced(mode, first, vertices, instances);
+        gl.DrawArraysInstanced(mode, (GLint)first, (GLsizei)vertices, (GLsizei)instances);
     }
 
     gl.EndTransformFeedback();
@@ -7133,6 +9894,10 @@ static PyObject * MGLVertexArray_transform(MGLVertexArray * self, PyObject * arg
 }
 
 static PyObject * MGLVertexArray_bind(MGLVertexArray * self, PyObject * args) {
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
+
     int location;
     const char * type;
     MGLBuffer * buffer;
@@ -7147,7 +9912,7 @@ static PyObject * MGLVertexArray_bind(MGLVertexArray * self, PyObject * args) {
         "IsO!snIIp",
         &location,
         &type,
-        MGLBuffer_type,
+        self->context->state->MGLBuffer_type,
         &buffer,
         &format,
         &offset,
@@ -7213,7 +9978,11 @@ static PyObject * MGLVertexArray_release(MGLVertexArray * self, PyObject * args)
     if (self->released) {
         Py_RETURN_NONE;
     }
+    if (!check_context_thread(self->context)) {
+        return NULL;
+    }
     self->released = true;
+    self->context->stats.objects_released += 1;
 
     const GLMethods & gl = self->context->gl;
     gl.DeleteVertexArrays(1, (GLuint *)&self->vertex_array_obj);
@@ -7225,7 +9994,7 @@ static PyObject * MGLVertexArray_release(MGLVertexArray * self, PyObject * args)
 }
 
 static int MGLVertexArray_set_index_buffer(MGLVertexArray * self, PyObject * value, void * closure) {
-    if (Py_TYPE(value) != MGLBuffer_type) {
+    if (Py_TYPE(value) != self->context->state->MGLBuffer_type) {
         MGLError_Set("the index_buffer must be a Buffer not %s", Py_TYPE(value)->tp_name);
         return -1;
     }
@@ -7233,19 +10002,19 @@ static int MGLVertexArray_set_index_buffer(MGLVertexArray * self, PyObject * val
     Py_INCREF(value);
     Py_DECREF(self->index_buffer);
     self->index_buffer = (MGLBuffer *)value;
-    self->num_vertices = (int)(self->index_buffer->size / 4);
+    self->num_vertices = self->index_buffer->size / 4;
 
     return 0;
 }
 
 static PyObject * MGLVertexArray_get_vertices(MGLVertexArray * self, void * closure) {
-    return PyLong_FromLong(self->num_vertices);
+    return PyLong_FromSsize_t(self->num_vertices);
 }
 
 static int MGLVertexArray_set_vertices(MGLVertexArray * self, PyObject * value, void * closure) {
-    int vertices = PyLong_AsUnsignedLong(value);
+    Py_ssize_t vertices = PyLong_AsSsize_t(value);
 
-    if (PyErr_Occurred()) {
+    if (PyErr_Occurred() || vertices < 0) {
         MGLError_Set("invalid value for vertices");
         return -1;
     }
@@ -7273,6 +10042,9 @@ static int MGLVertexArray_set_instances(MGLVertexArray * self, PyObject * value,
 }
 
 static PyObject * MGLContext_set_label(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
     const GLMethods & gl = self->gl;
 
     GLenum type = 0;
@@ -7288,8 +10060,9 @@ static PyObject * MGLContext_set_label(MGLContext * self, PyObject * args) {
     if (gl.ObjectLabel) {
         // OpenGL core 4.3
 
-        if (label_length > self->max_label_length) {
-            MGLError_Set("Context's max label length is %d, got one of length %d", self->max_label_length, label_length);
+        int max_label_length = context_limit(self, &self->max_label_length, GL_MAX_LABEL_LENGTH);
+        if (label_length > max_label_length) {
+            MGLError_Set("Context's max label length is %d, got one of length %d", max_label_length, label_length);
             return NULL;
         }
 
@@ -7336,6 +10109,9 @@ static PyObject * MGLContext_set_label(MGLContext * self, PyObject * args) {
 }
 
 static PyObject * MGLContext_get_label(MGLContext * ctx, PyObject * args) {
+    if (!check_context_thread(ctx)) {
+        return NULL;
+    }
     const GLMethods & gl = ctx->gl;
 
     GLenum type = 0;
@@ -7346,7 +10122,7 @@ static PyObject * MGLContext_get_label(MGLContext * ctx, PyObject * args) {
         return NULL;
     }
 
-    int label_buffer_length = ctx->max_label_length + 1;
+    int label_buffer_length = context_limit(ctx, &ctx->max_label_length, GL_MAX_LABEL_LENGTH) + 1;
     char * label = new char[label_buffer_length];
     GLsizei label_length = 0;
     if (gl.GetObjectLabel) {
@@ -7390,6 +10166,9 @@ static PyObject * MGLContext_get_label(MGLContext * ctx, PyObject * args) {
 }
 
 static PyObject * MGLContext_push_debug_scope(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
     const GLMethods& gl = self->gl;
 
     GLenum source = 0;
@@ -7405,16 +10184,18 @@ static PyObject * MGLContext_push_debug_scope(MGLContext * self, PyObject * args
     if (gl.PushDebugGroup) {
         // OpenGL core 4.3
 
-        if (message_length >= self->max_debug_message_length) {
-            MGLError_Set("Context's max debug message length is %d, got one of length %d", self->max_debug_message_length, message_length);
+        int max_debug_message_length = context_limit(self, &self->max_debug_message_length, GL_MAX_DEBUG_MESSAGE_LENGTH);
+        if (message_length >= max_debug_message_length) {
+            MGLError_Set("Context's max debug message length is %d, got one of length %d", max_debug_message_length, message_length);
             return NULL;
         }
 
         int scope_stack_depth = 0;
         gl.GetIntegerv(GL_DEBUG_GROUP_STACK_DEPTH, &scope_stack_depth);
 
-        if (scope_stack_depth >= self->max_debug_group_stack_depth) {
-            MGLError_Set("Context's max debug group stack depth is %d, cannot push more scopes", self->max_debug_group_stack_depth);
+        int max_debug_group_stack_depth = context_limit(self, &self->max_debug_group_stack_depth, GL_MAX_DEBUG_GROUP_STACK_DEPTH);
+        if (scope_stack_depth >= max_debug_group_stack_depth) {
+            MGLError_Set("Context's max debug group stack depth is %d, cannot push more scopes", max_debug_group_stack_depth);
             return NULL;
         }
 
@@ -7441,6 +10222,9 @@ static PyObject * MGLContext_push_debug_scope(MGLContext * self, PyObject * args
 }
 
 static PyObject * MGLContext_pop_debug_scope(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
 
     const GLMethods& gl = self->gl;
 
@@ -7464,7 +10248,142 @@ static PyObject * MGLContext_pop_debug_scope(MGLContext * self, PyObject * args)
     Py_RETURN_NONE;
 }
 
+static PyObject * MGLContext_enable_debug_output(MGLContext * self, PyObject * args) {
+    int severities;
+    int types;
+    int sources;
+    int rate_limit;
+    int synchronous;
+    PyObject * callback;
+
+    int args_ok = PyArg_ParseTuple(
+        args,
+        "iiiipO",
+        &severities,
+        &types,
+        &sources,
+        &rate_limit,
+        &synchronous,
+        &callback
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    const GLMethods & gl = self->gl;
+
+    if (!gl.DebugMessageCallback || !gl.DebugMessageControl) {
+        MGLError_Set("debug output requires OpenGL 4.3 or GL_KHR_debug");
+        return NULL;
+    }
+
+    stop_debug_output(self);
+
+    MGLDebugOutput * output = new (std::nothrow) MGLDebugOutput();
+    if (!output) {
+        return PyErr_NoMemory();
+    }
+
+    output->refs = 1;
+    output->severities = severities;
+    output->types = types;
+    output->sources = sources;
+    output->rate_limit = rate_limit;
+    output->callback = callback;
+    Py_INCREF(callback);
+
+    // Pending calls run on the main thread of the main interpreter
+    #if PY_VERSION_HEX >= 0x03090000
+    output->pending_calls = PyInterpreterState_Get() == PyInterpreterState_Main();
+    #else
+    output->pending_calls = true;
+    #endif
+
+    output->was_enabled = gl.IsEnabled(GL_DEBUG_OUTPUT);
+    output->was_synchronous = gl.IsEnabled(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    gl.Enable(GL_DEBUG_OUTPUT);
+    if (synchronous) {
+        gl.Enable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    } else {
+        gl.Disable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    }
+
+    // The driver skips the disabled severities, sources and types are filtered in the callback
+    gl.DebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, NULL, GL_FALSE);
+    for (int i = 0; i < 4; ++i) {
+        if (severities >> i & 1) {
+            gl.DebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, debug_severities[i], 0, NULL, GL_TRUE);
+        }
+    }
+
+    // Messages logged before the callback was installed are not lost
+    if (gl.GetDebugMessageLog) {
+        int max_debug_message_length = context_limit(self, &self->max_debug_message_length, GL_MAX_DEBUG_MESSAGE_LENGTH);
+        char * text = (char *)PyMem_Malloc(max_debug_message_length + 1);
+        if (text) {
+            GLenum source, type, severity;
+            GLuint id;
+            GLsizei length;
+            while (gl.GetDebugMessageLog(1, max_debug_message_length, &source, &type, &id, &severity, &length, text)) {
+                debug_output_callback(source, type, id, severity, -1, text, output);
+            }
+            PyMem_Free(text);
+        }
+    }
+
+    gl.DebugMessageCallback(debug_output_callback, output);
+    self->debug_output = output;
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLContext_disable_debug_output(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    stop_debug_output(self);
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLContext_process_debug_output(MGLContext * self, PyObject * args) {
+    if (!self->debug_output) {
+        return PyLong_FromLong(0);
+    }
+    return PyLong_FromLong(deliver_debug_output(self->debug_output));
+}
+
+static PyObject * MGLContext_debug_message_counts(MGLContext * self, PyObject * args) {
+    PyObject * res = PyDict_New();
+    MGLDebugOutput * output = self->debug_output;
+    if (!output || !res) {
+        return res;
+    }
+    std::lock_guard<std::mutex> guard(output->lock);
+    for (const auto & item : output->counters) {
+        PyObject * key = PyLong_FromUnsignedLong(item.first);
+        PyObject * value = PyLong_FromLongLong(item.second.count);
+        int error = !key || !value || PyDict_SetItem(res, key, value) < 0;
+        Py_XDECREF(key);
+        Py_XDECREF(value);
+        if (error) {
+            Py_DECREF(res);
+            return NULL;
+        }
+    }
+    return res;
+}
+
 static PyObject * MGLContext_enable_only(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self, "Context.enable_only", 0, 0, true);
+
     int flags;
 
     int args_ok = PyArg_ParseTuple(
@@ -7508,126 +10427,991 @@ static PyObject * MGLContext_enable_only(MGLContext * self, PyObject * args) {
     } else {
         self->gl.Disable(GL_PROGRAM_POINT_SIZE);
     }
-
+
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLContext_enable(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self, "Context.enable", 0, 0, true);
+
+    int flags;
+
+    int args_ok = PyArg_ParseTuple(
+        args,
+        "i",
+        &flags
+    );
+
+    if (!args_ok) {
+        return 0;
+    }
+
+    self->enable_flags |= flags;
+
+    if (flags & MGL_BLEND) {
+        self->gl.Enable(GL_BLEND);
+    }
+
+    if (flags & MGL_DEPTH_TEST) {
+        self->gl.Enable(GL_DEPTH_TEST);
+    }
+
+    if (flags & MGL_CULL_FACE) {
+        self->gl.Enable(GL_CULL_FACE);
+    }
+
+    if (flags & MGL_RASTERIZER_DISCARD) {
+        self->gl.Enable(GL_RASTERIZER_DISCARD);
+    }
+
+    if (flags & MGL_PROGRAM_POINT_SIZE) {
+        self->gl.Enable(GL_PROGRAM_POINT_SIZE);
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLContext_disable(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self, "Context.disable", 0, 0, true);
+
+    int flags;
+
+    int args_ok = PyArg_ParseTuple(
+        args,
+        "i",
+        &flags
+    );
+
+    if (!args_ok) {
+        return 0;
+    }
+
+    self->enable_flags &= ~flags;
+
+    if (flags & MGL_BLEND) {
+        self->gl.Disable(GL_BLEND);
+    }
+
+    if (flags & MGL_DEPTH_TEST) {
+        self->gl.Disable(GL_DEPTH_TEST);
+    }
+
+    if (flags & MGL_CULL_FACE) {
+        self->gl.Disable(GL_CULL_FACE);
+    }
+
+    if (flags & MGL_RASTERIZER_DISCARD) {
+        self->gl.Disable(GL_RASTERIZER_DISCARD);
+    }
+
+    if (flags & MGL_PROGRAM_POINT_SIZE) {
+        self->gl.Disable(GL_PROGRAM_POINT_SIZE);
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLContext_enable_direct(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    int value;
+
+    int args_ok = PyArg_ParseTuple(
+        args,
+        "i",
+        &value
+    );
+
+    if (!args_ok) {
+        return 0;
+    }
+
+    self->gl.Enable(value);
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLContext_disable_direct(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    int value;
+
+    int args_ok = PyArg_ParseTuple(
+        args,
+        "i",
+        &value
+    );
+
+    if (!args_ok) {
+        return 0;
+    }
+
+    self->gl.Disable(value);
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLContext_finish(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self, "Context.finish", 0, 0);
+
+    Py_BEGIN_ALLOW_THREADS
+    self->gl.Finish();
+    Py_END_ALLOW_THREADS
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLContext_adopt(MGLContext * self, PyObject * args) {
+    PyObject * obj;
+
+    if (!PyArg_ParseTuple(args, "O", &obj)) {
+        return NULL;
+    }
+
+    MGLContext ** owner = NULL;
+    MGLMemoryEntry * memory = NULL;
+
+    if (Py_TYPE(obj) == self->state->MGLBuffer_type) {
+        owner = &((MGLBuffer *)obj)->context;
+        memory = &((MGLBuffer *)obj)->memory;
+    } else if (Py_TYPE(obj) == self->state->MGLTexture_type) {
+        owner = &((MGLTexture *)obj)->context;
+        memory = &((MGLTexture *)obj)->memory;
+    } else if (Py_TYPE(obj) == self->state->MGLTexture3D_type) {
+        owner = &((MGLTexture3D *)obj)->context;
+        memory = &((MGLTexture3D *)obj)->memory;
+    } else if (Py_TYPE(obj) == self->state->MGLTextureArray_type) {
+        owner = &((MGLTextureArray *)obj)->context;
+        memory = &((MGLTextureArray *)obj)->memory;
+    } else if (Py_TYPE(obj) == self->state->MGLTextureCube_type) {
+        owner = &((MGLTextureCube *)obj)->context;
+        memory = &((MGLTextureCube *)obj)->memory;
+    } else if (Py_TYPE(obj) == self->state->MGLRenderbuffer_type) {
+        owner = &((MGLRenderbuffer *)obj)->context;
+        memory = &((MGLRenderbuffer *)obj)->memory;
+    } else if (Py_TYPE(obj) == self->state->MGLProgram_type) {
+        owner = &((MGLProgram *)obj)->context;
+    } else if (Py_TYPE(obj) == self->state->MGLSampler_type) {
+        owner = &((MGLSampler *)obj)->context;
+    } else {
+        MGLError_Set("%s objects are not shared between contexts", Py_TYPE(obj)->tp_name);
+        return NULL;
+    }
+
+    MGLContext * previous = *owner;
+    if (memory && memory->next) {
+        MGLMemoryEntry entry = *memory;
+        memory_untrack(previous, memory);
+        memory_track(self, memory, entry.kind, entry.name, entry.bytes);
+    }
+    Py_INCREF(self);
+    *owner = self;
+    Py_DECREF(previous);
+    Py_RETURN_NONE;
+}
+
+static bool release_object(MGLContext * self, PyObject * obj, MGLReleaseQueue * queue) {
+    // Mirrors the release methods of the objects, the names are deleted in batches
+    ModuleState * state = self->state;
+    PyTypeObject * type = Py_TYPE(obj);
+
+    if (type == state->MGLBuffer_type && ((MGLBuffer *)obj)->context == self) {
+        MGLBuffer * buffer = (MGLBuffer *)obj;
+        if (buffer->released || buffer->external) {
+            return true;
+        }
+        buffer->released = true;
+        release_queue_push(queue, MGL_RELEASE_BUFFER, buffer->buffer_obj);
+        self->released_bytes += buffer->memory.bytes;
+        memory_untrack(self, &buffer->memory);
+        Py_DECREF(buffer->context);
+        Py_DECREF(buffer);
+    } else if (type == state->MGLTexture_type && ((MGLTexture *)obj)->context == self) {
+        MGLTexture * texture = (MGLTexture *)obj;
+        if (texture->released || texture->external) {
+            return true;
+        }
+        texture->released = true;
+        release_queue_push(queue, MGL_RELEASE_TEXTURE, texture->texture_obj);
+        self->released_bytes += texture->memory.bytes;
+        memory_untrack(self, &texture->memory);
+        Py_DECREF(texture->context);
+        Py_DECREF(texture);
+    } else if (type == state->MGLTexture3D_type && ((MGLTexture3D *)obj)->context == self) {
+        MGLTexture3D * texture = (MGLTexture3D *)obj;
+        if (texture->released) {
+            return true;
+        }
+        texture->released = true;
+        release_queue_push(queue, MGL_RELEASE_TEXTURE, texture->texture_obj);
+        self->released_bytes += texture->memory.bytes;
+        memory_untrack(self, &texture->memory);
+        Py_DECREF(texture->context);
+        Py_DECREF(texture);
+    } else if (type == state->MGLTextureArray_type && ((MGLTextureArray *)obj)->context == self) {
+        MGLTextureArray * texture = (MGLTextureArray *)obj;
+        if (texture->released) {
+            return true;
+        }
+        texture->released = true;
+        release_queue_push(queue, MGL_RELEASE_TEXTURE, texture->texture_obj);
+        self->released_bytes += texture->memory.bytes;
+        memory_untrack(self, &texture->memory);
+        Py_DECREF(texture->context);
+        Py_DECREF(texture);
+    } else if (type == state->MGLTextureCube_type && ((MGLTextureCube *)obj)->context == self) {
+        MGLTextureCube * texture = (MGLTextureCube *)obj;
+        if (texture->released) {
+            return true;
+        }
+        texture->released = true;
+        release_queue_push(queue, MGL_RELEASE_TEXTURE, texture->texture_obj);
+        self->released_bytes += texture->memory.bytes;
+        memory_untrack(self, &texture->memory);
+        Py_DECREF(texture);
+    } else if (type == state->MGLVertexArray_type && ((MGLVertexArray *)obj)->context == self) {
+        MGLVertexArray * array = (MGLVertexArray *)obj;
+        if (array->released) {
+            return true;
+        }
+        array->released = true;
+        release_queue_push(queue, MGL_RELEASE_VERTEX_ARRAY, array->vertex_array_obj);
+        Py_DECREF(array->program);
+        Py_XDECREF(array->index_buffer);
+        Py_DECREF(array);
+    } else if (type == state->MGLFramebuffer_type && ((MGLFramebuffer *)obj)->context == self) {
+        MGLFramebuffer * framebuffer = (MGLFramebuffer *)obj;
+        if (framebuffer->released) {
+            return true;
+        }
+        framebuffer->released = true;
+        release_scaled_read(framebuffer, queue);
+        if (framebuffer->framebuffer_obj) {
+            release_queue_push(queue, MGL_RELEASE_FRAMEBUFFER, framebuffer->framebuffer_obj);
+            Py_DECREF(framebuffer->context);
+        }
+        Py_DECREF(framebuffer);
+    } else if (type == state->MGLRenderbuffer_type && ((MGLRenderbuffer *)obj)->context == self) {
+        MGLRenderbuffer * renderbuffer = (MGLRenderbuffer *)obj;
+        if (renderbuffer->released) {
+            return true;
+        }
+        renderbuffer->released = true;
+        release_queue_push(queue, MGL_RELEASE_RENDERBUFFER, renderbuffer->renderbuffer_obj);
+        self->released_bytes += renderbuffer->memory.bytes;
+        memory_untrack(self, &renderbuffer->memory);
+        Py_DECREF(renderbuffer);
+    } else if (type == state->MGLSampler_type && ((MGLSampler *)obj)->context == self) {
+        MGLSampler * sampler = (MGLSampler *)obj;
+        if (sampler->released) {
+            return true;
+        }
+        sampler->released = true;
+        release_queue_push(queue, MGL_RELEASE_SAMPLER, sampler->sampler_obj);
+        Py_DECREF(sampler->context);
+        Py_DECREF(sampler);
+    } else if (type == state->MGLProgram_type && ((MGLProgram *)obj)->context == self) {
+        MGLProgram * program = (MGLProgram *)obj;
+        if (program->released) {
+            return true;
+        }
+        program->released = true;
+        release_queue_push(queue, MGL_RELEASE_PROGRAM, program->program_obj);
+        Py_DECREF(program);
+    } else {
+        // Scopes, queries and objects of other contexts count themselves in the release method
+        PyObject * res = PyObject_CallMethod(obj, "release", NULL);
+        if (!res) {
+            return false;
+        }
+        Py_DECREF(res);
+        self->released_objects += 1;
+        return true;
+    }
+
+    self->released_objects += 1;
+    self->stats.objects_released += 1;
+    return true;
+}
+
+static void release_deferred_objects(MGLContext * self, bool wait) {
+    if (!self->release_fence) {
+        return;
+    }
+
+    const GLMethods & gl = self->gl;
+    GLenum status = gl.ClientWaitSync(self->release_fence, 0, wait ? GL_TIMEOUT_IGNORED : 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+        return;
+    }
+
+    gl.DeleteSync(self->release_fence);
+    self->release_fence = NULL;
+    release_queue_delete(gl, &self->release_deferred);
+}
+
+static PyObject * MGLContext_release_objects(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    PyObject * objects;
+    int defer;
+
+    if (!PyArg_ParseTuple(args, "Op", &objects, &defer)) {
+        return NULL;
+    }
+
+    objects = PySequence_Fast(objects, "objects must be a sequence");
+    if (!objects) {
+        return NULL;
+    }
+
+    const GLMethods & gl = self->gl;
+
+    // The names released earlier are deleted once their fence is signaled
+    release_deferred_objects(self, false);
+
+    MGLReleaseQueue * queue = defer ? &self->release_deferred : &self->release_batch;
+    Py_ssize_t num_objects = PySequence_Fast_GET_SIZE(objects);
+    PyObject ** items = PySequence_Fast_ITEMS(objects);
+    bool ok = true;
+
+    for (Py_ssize_t i = 0; i < num_objects && ok; ++i) {
+        ok = release_object(self, items[i], queue);
+    }
+
+    if (defer) {
+        if (release_queue_size(queue)) {
+            // A newer fence also covers the commands issued before the previous one
+            if (self->release_fence) {
+                gl.DeleteSync(self->release_fence);
+            }
+            self->release_fence = gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            gl.Flush();
+        }
+    } else {
+        release_queue_delete(gl, queue);
+    }
+
+    Py_DECREF(objects);
+    if (!ok) {
+        return NULL;
+    }
+    return PyLong_FromSsize_t(num_objects);
+}
+
+static PyObject * stats_dict(const MGLStats & stats) {
+    return Py_BuildValue(
+        "{sLsLsLsLsLsLsLsLsLsLsLsL}",
+        "draws", stats.draws,
+        "dispatches", stats.dispatches,
+        "program_binds", stats.program_binds,
+        "vertex_array_binds", stats.vertex_array_binds,
+        "texture_binds", stats.texture_binds,
+        "sampler_binds", stats.sampler_binds,
+        "framebuffer_binds", stats.framebuffer_binds,
+        "uniform_writes", stats.uniform_writes,
+        "bytes_uploaded", stats.bytes_uploaded,
+        "bytes_downloaded", stats.bytes_downloaded,
+        "objects_created", stats.objects_created,
+        "objects_released", stats.objects_released
+    );
+}
+
+static PyObject * MGLContext_get_stats(MGLContext * self, void * closure) {
+    return stats_dict(self->stats);
+}
+
+static PyObject * MGLContext_reset_stats(MGLContext * self, PyObject * args) {
+    PyObject * res = stats_dict(self->stats);
+    memset(&self->stats, 0, sizeof(MGLStats));
+    return res;
+}
+
+static PyObject * MGLContext_memory_report(MGLContext * self, PyObject * args) {
+    int objects;
+
+    int args_ok = PyArg_ParseTuple(
+        args,
+        "p",
+        &objects
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
+    const MGLMemory & memory = self->memory;
+    PyObject * kinds = PyTuple_New(MGL_MEMORY_KINDS);
+    if (!kinds) {
+        return NULL;
+    }
+    for (int kind = 0; kind < MGL_MEMORY_KINDS; ++kind) {
+        PyTuple_SET_ITEM(kinds, kind, Py_BuildValue("(LL)", memory.count[kind], memory.bytes[kind]));
+    }
+
+    PyObject * live = Py_None;
+    Py_INCREF(live);
+    if (objects) {
+        Py_DECREF(live);
+        live = PyList_New(0);
+        for (MGLMemoryEntry * entry = memory.live.next; live && entry != &memory.live; entry = entry->next) {
+            PyObject * item = Py_BuildValue("(iIL)", entry->kind, entry->name, entry->bytes);
+            if (!item || PyList_Append(live, item) < 0) {
+                Py_XDECREF(item);
+                Py_CLEAR(live);
+                break;
+            }
+            Py_DECREF(item);
+        }
+        if (!live) {
+            Py_DECREF(kinds);
+            return NULL;
+        }
+    }
+
+    return Py_BuildValue("(LLLNN)", memory.total, memory.peak, memory.alarm, kinds, live);
+}
+
+static PyObject * MGLContext_startup_profile(MGLContext * self, PyObject * args) {
+    const MGLStartupProfile * profile = self->startup;
+    if (!profile) {
+        Py_RETURN_NONE;
+    }
+
+    PyObject * res = PyDict_New();
+    for (int phase = 0; res && phase < MGL_STARTUP_PHASES; ++phase) {
+        PyObject * item = Py_BuildValue("(LLLL)", profile->count[phase], profile->total[phase], profile->first[phase], profile->max[phase]);
+        if (!item || PyDict_SetItemString(res, startup_phase_names[phase], item) < 0) {
+            Py_XDECREF(item);
+            Py_CLEAR(res);
+            break;
+        }
+        Py_DECREF(item);
+    }
+    return res;
+}
+
+static PyObject * MGLContext_set_memory_alarm(MGLContext * self, PyObject * args) {
+    long long alarm;
+    PyObject * callback;
+
+    int args_ok = PyArg_ParseTuple(
+        args,
+        "LO",
+        &alarm,
+        &callback
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
+    PyObject * previous = self->memory.alarm_callback;
+    Py_INCREF(callback);
+    self->memory.alarm_callback = callback;
+    self->memory.alarm = alarm;
+    self->memory.alarm_raised = false;
+    Py_XDECREF(previous);
+
+    // An alarm below the current total is raised right away
+    memory_check_alarm(self);
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLContext_timestamp(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    if (!self->gl.QueryCounter) {
+        MGLError_Set("timestamp queries are not supported");
+        return NULL;
+    }
+
+    GLuint query = take_timestamp(self);
+    if (!query) {
+        return NULL;
+    }
+    return PyLong_FromUnsignedLong(query);
+}
+
+static PyObject * MGLContext_read_timestamps(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    PyObject * queries;
+    int wait;
+
+    int args_ok = PyArg_ParseTuple(
+        args,
+        "Op",
+        &queries,
+        &wait
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
+    PyObject * seq = PySequence_Fast(queries, "queries must be a sequence");
+    if (!seq) {
+        return NULL;
+    }
+
+    const GLMethods & gl = self->gl;
+    Py_ssize_t num_queries = PySequence_Fast_GET_SIZE(seq);
+    PyObject ** items = PySequence_Fast_ITEMS(seq);
+
+    GLuint * names = (GLuint *)PyMem_Malloc((num_queries + 1) * sizeof(GLuint));
+    if (!names) {
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+
+    for (Py_ssize_t i = 0; i < num_queries; ++i) {
+        names[i] = (GLuint)PyLong_AsUnsignedLong(items[i]);
+    }
+    Py_DECREF(seq);
+
+    if (PyErr_Occurred()) {
+        PyMem_Free(names);
+        return NULL;
+    }
+
+    // Timestamps complete in submission order, the last one being ready means all of them are
+    if (num_queries && !wait) {
+        GLuint available = 0;
+        gl.GetQueryObjectuiv(names[num_queries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            PyMem_Free(names);
+            Py_RETURN_NONE;
+        }
+    }
+
+    PyObject * res = PyTuple_New(num_queries);
+    for (Py_ssize_t i = 0; i < num_queries; ++i) {
+        GLuint64 timestamp = 0;
+        gl.GetQueryObjectui64v(names[i], GL_QUERY_RESULT, &timestamp);
+        PyTuple_SET_ITEM(res, i, PyLong_FromUnsignedLongLong(timestamp));
+    }
+
+    if (!give_timestamps(self, names, (int)num_queries)) {
+        Py_DECREF(res);
+        PyMem_Free(names);
+        return NULL;
+    }
+
+    PyMem_Free(names);
+    return res;
+}
+
+static PyObject * MGLContext_start_trace(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    Py_ssize_t capacity;
+    int gpu;
+    int state;
+
+    int args_ok = PyArg_ParseTuple(
+        args,
+        "npp",
+        &capacity,
+        &gpu,
+        &state
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
+    if (self->tracer) {
+        MGLError_Set("the context is already tracing");
+        return NULL;
+    }
+
+    if (capacity < 1) {
+        MGLError_Set("the trace capacity must be positive");
+        return NULL;
+    }
+
+    if (gpu && !self->gl.QueryCounter) {
+        MGLError_Set("timestamp queries are not supported");
+        return NULL;
+    }
+
+    MGLTracer * tracer = (MGLTracer *)PyMem_Calloc(1, sizeof(MGLTracer));
+    MGLTraceEvent * events = (MGLTraceEvent *)PyMem_Calloc(capacity, sizeof(MGLTraceEvent));
+    if (!tracer || !events) {
+        PyMem_Free(tracer);
+        PyMem_Free(events);
+        return PyErr_NoMemory();
+    }
+
+    tracer->events = events;
+    tracer->capacity = capacity;
+    tracer->gpu = gpu ? true : false;
+    tracer->state = state ? true : false;
+    tracer->names = PyList_New(0);
+    tracer->name_indices = PyDict_New();
+
+    if (tracer->gpu) {
+        // Maps the GPU clock to the trace clock
+        GLint64 timestamp = 0;
+        self->gl.GetInteger64v(GL_TIMESTAMP, &timestamp);
+        tracer->gpu_offset = trace_clock() - timestamp;
+    }
+
+    self->tracer = tracer;
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLContext_trace_begin(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    PyObject * name;
+
+    int args_ok = PyArg_ParseTuple(
+        args,
+        "U",
+        &name
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
+    MGLTracer * tracer = self->tracer;
+    if (!tracer) {
+        Py_RETURN_NONE;
+    }
+
+    if (tracer->depth == MGL_TRACE_MAX_DEPTH) {
+        MGLError_Set("trace sections cannot be nested deeper than %d", MGL_TRACE_MAX_DEPTH);
+        return NULL;
+    }
+
+    PyObject * index = PyDict_GetItemWithError(tracer->name_indices, name);
+    if (!index) {
+        if (PyErr_Occurred()) {
+            return NULL;
+        }
+        index = PyLong_FromSsize_t(PyList_GET_SIZE(tracer->names));
+        if (PyList_Append(tracer->names, name) < 0 || PyDict_SetItem(tracer->name_indices, name, index) < 0) {
+            Py_DECREF(index);
+            return NULL;
+        }
+        Py_DECREF(index);
+    }
+
+    MGLTraceEvent * event = &tracer->sections[tracer->depth++];
+    trace_begin_event(self, event, NULL, 0, 0, tracer->gpu);
+    event->name_index = (int)PyLong_AsLong(index);
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLContext_trace_end(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    MGLTracer * tracer = self->tracer;
+    if (!tracer || !tracer->depth) {
+        Py_RETURN_NONE;
+    }
+    trace_end_event(self, &tracer->sections[--tracer->depth]);
     Py_RETURN_NONE;
 }
 
-static PyObject * MGLContext_enable(MGLContext * self, PyObject * args) {
-    int flags;
-
-    int args_ok = PyArg_ParseTuple(
-        args,
-        "i",
-        &flags
-    );
+static PyObject * trace_events(MGLContext * self, bool recycle) {
+    const GLMethods & gl = self->gl;
+    MGLTracer * tracer = self->tracer;
 
-    if (!args_ok) {
-        return 0;
+    long long first = MGL_MAX(tracer->count - tracer->capacity, 0);
+    PyObject * res = PyList_New((Py_ssize_t)(tracer->count - first));
+    if (!res) {
+        return NULL;
     }
 
-    self->enable_flags |= flags;
+    for (long long i = first; i < tracer->count; ++i) {
+        MGLTraceEvent * event = &tracer->events[i % tracer->capacity];
 
-    if (flags & MGL_BLEND) {
-        self->gl.Enable(GL_BLEND);
-    }
+        PyObject * name;
+        if (event->name) {
+            name = PyUnicode_FromString(event->name);
+        } else {
+            name = PyList_GET_ITEM(tracer->names, event->name_index);
+            Py_INCREF(name);
+        }
+
+        PyObject * gpu_begin = Py_None;
+        PyObject * gpu_end = Py_None;
+        if (event->query_begin && event->query_end) {
+            GLuint64 begin = 0;
+            GLuint64 end = 0;
+            gl.GetQueryObjectui64v(event->query_begin, GL_QUERY_RESULT, &begin);
+            gl.GetQueryObjectui64v(event->query_end, GL_QUERY_RESULT, &end);
+            gpu_begin = PyLong_FromLongLong((long long)begin + tracer->gpu_offset);
+            gpu_end = PyLong_FromLongLong((long long)end + tracer->gpu_offset);
+        } else {
+            Py_INCREF(Py_None);
+            Py_INCREF(Py_None);
+        }
 
-    if (flags & MGL_DEPTH_TEST) {
-        self->gl.Enable(GL_DEPTH_TEST);
-    }
+        if (recycle && event->query_begin) {
+            GLuint queries[2] = {event->query_begin, event->query_end};
+            give_timestamps(self, queries, event->query_end ? 2 : 1);
+        }
 
-    if (flags & MGL_CULL_FACE) {
-        self->gl.Enable(GL_CULL_FACE);
+        PyObject * item = Py_BuildValue(
+            "(NIILLNN)",
+            name,
+            event->object_type,
+            event->object,
+            event->begin,
+            event->end,
+            gpu_begin,
+            gpu_end
+        );
+
+        if (!item) {
+            Py_DECREF(res);
+            return NULL;
+        }
+        PyList_SET_ITEM(res, (Py_ssize_t)(i - first), item);
     }
 
-    if (flags & MGL_RASTERIZER_DISCARD) {
-        self->gl.Enable(GL_RASTERIZER_DISCARD);
+    return res;
+}
+
+static PyObject * MGLContext_trace_events(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
     }
+    if (!self->tracer) {
+        return PyList_New(0);
+    }
+    return trace_events(self, false);
+}
 
-    if (flags & MGL_PROGRAM_POINT_SIZE) {
-        self->gl.Enable(GL_PROGRAM_POINT_SIZE);
+static PyObject * MGLContext_stop_trace(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    if (!self->tracer) {
+        return PyList_New(0);
     }
+    PyObject * res = trace_events(self, true);
+    free_tracer(self);
+    return res;
+}
 
-    Py_RETURN_NONE;
+static bool stop_capture(MGLContext * self) {
+    MGLCapture * capture = self->capture;
+    if (!capture) {
+        return true;
+    }
+    uninstall_capture(self->gl, capture);
+    release_capture_slot(capture);
+    bool written = !capture->write_error;
+    if (fclose(capture->file)) {
+        written = false;
+    }
+    PyMem_Free(capture);
+    self->capture = NULL;
+    return written;
 }
 
-static PyObject * MGLContext_disable(MGLContext * self, PyObject * args) {
-    int flags;
+static PyObject * MGLContext_start_capture(MGLContext * self, PyObject * args) {
+    const char * path;
 
     int args_ok = PyArg_ParseTuple(
         args,
-        "i",
-        &flags
+        "s",
+        &path
     );
 
     if (!args_ok) {
-        return 0;
+        return NULL;
     }
 
-    self->enable_flags &= ~flags;
-
-    if (flags & MGL_BLEND) {
-        self->gl.Disable(GL_BLEND);
+    if (!check_context_thread(self)) {
+        return NULL;
     }
 
-    if (flags & MGL_DEPTH_TEST) {
-        self->gl.Disable(GL_DEPTH_TEST);
+    if (self->capture) {
+        MGLError_Set("the context is already capturing");
+        return NULL;
     }
 
-    if (flags & MGL_CULL_FACE) {
-        self->gl.Disable(GL_CULL_FACE);
+    FILE * file = fopen(path, "wb");
+    if (!file) {
+        MGLError_Set("cannot open %s", path);
+        return NULL;
     }
 
-    if (flags & MGL_RASTERIZER_DISCARD) {
-        self->gl.Disable(GL_RASTERIZER_DISCARD);
+    MGLCapture * capture = (MGLCapture *)PyMem_Calloc(1, sizeof(MGLCapture));
+    if (!capture) {
+        fclose(file);
+        return PyErr_NoMemory();
     }
 
-    if (flags & MGL_PROGRAM_POINT_SIZE) {
-        self->gl.Disable(GL_PROGRAM_POINT_SIZE);
+    const GLMethods & gl = self->gl;
+    if (!acquire_capture_slot(capture)) {
+        fclose(file);
+        PyMem_Free(capture);
+        MGLError_Set("at most %d contexts can capture at the same time", MGL_CAPTURE_SLOTS);
+        return NULL;
     }
 
+    capture->file = file;
+    gl.GetIntegerv(GL_UNPACK_ALIGNMENT, &capture->unpack_alignment);
+    gl.GetIntegerv(GL_PACK_ALIGNMENT, &capture->pack_alignment);
+    gl.GetIntegerv(GL_PACK_ROW_LENGTH, &capture->pack_row_length);
+    gl.GetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, (GLint *)&capture->unpack_buffer);
+    gl.GetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, (GLint *)&capture->pack_buffer);
+    capture_header(capture, self->version_code);
+
+    // Pooled names were generated before the capture, the replay would not know them
+    free_name_pools(self);
+
+    self->capture = capture;
+    install_capture(self->gl, capture);
+
+    // The pixel store state is recorded so the replay computes the same transfer sizes
+    self->gl.PixelStorei(GL_UNPACK_ALIGNMENT, capture->unpack_alignment);
+    self->gl.PixelStorei(GL_PACK_ALIGNMENT, capture->pack_alignment);
+    self->gl.PixelStorei(GL_PACK_ROW_LENGTH, capture->pack_row_length);
     Py_RETURN_NONE;
 }
 
-static PyObject * MGLContext_enable_direct(MGLContext * self, PyObject * args) {
-    int value;
+static PyObject * MGLContext_stop_capture(MGLContext * self, PyObject * args) {
+    if (!stop_capture(self)) {
+        MGLError_Set("cannot write the capture file");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLContext_capture_frame(MGLContext * self, PyObject * args) {
+    int begin;
 
     int args_ok = PyArg_ParseTuple(
         args,
-        "i",
-        &value
+        "p",
+        &begin
     );
 
     if (!args_ok) {
-        return 0;
+        return NULL;
     }
 
-    self->gl.Enable(value);
+    if (self->capture) {
+        capture_varint(self->capture, begin ? MGL_CAPTURE_FRAME_BEGIN : MGL_CAPTURE_FRAME_END);
+        if (self->capture->write_error) {
+            MGLError_Set("cannot write the capture file");
+            return NULL;
+        }
+    }
     Py_RETURN_NONE;
 }
 
-static PyObject * MGLContext_disable_direct(MGLContext * self, PyObject * args) {
-    int value;
+static PyObject * MGLContext_replay(MGLContext * self, PyObject * args) {
+    Py_buffer data;
+    int loops;
+    int finish;
 
     int args_ok = PyArg_ParseTuple(
         args,
-        "i",
-        &value
+        "y*Ip",
+        &data,
+        &loops,
+        &finish
     );
 
     if (!args_ok) {
-        return 0;
+        return NULL;
     }
 
-    self->gl.Disable(value);
-    Py_RETURN_NONE;
+    if (!check_context_thread(self)) {
+        PyBuffer_Release(&data);
+        return NULL;
+    }
+
+    if (self->capture) {
+        PyBuffer_Release(&data);
+        MGLError_Set("cannot replay while capturing");
+        return NULL;
+    }
+
+    ReplayStats stats = ReplayStats();
+    const char * error;
+
+    Py_BEGIN_ALLOW_THREADS
+    error = replay_capture(self->gl, (const char *)data.buf, (size_t)data.len, loops, finish ? true : false, &stats);
+    Py_END_ALLOW_THREADS
+
+    PyBuffer_Release(&data);
+
+    if (error) {
+        MGLError_Set("%s", error);
+        return NULL;
+    }
+
+    PyObject * frames = PyList_New(stats.frames.size());
+    for (size_t i = 0; i < stats.frames.size(); ++i) {
+        PyList_SET_ITEM(frames, i, PyLong_FromLongLong(stats.frames[i]));
+    }
+
+    PyObject * calls = PyDict_New();
+    for (int i = 0; i < MGL_CAPTURE_NUM_CALLS; ++i) {
+        if (stats.calls[i]) {
+            PyObject * item = Py_BuildValue("(LL)", stats.calls[i], stats.time[i]);
+            PyDict_SetItemString(calls, capture_call_names[i], item);
+            Py_DECREF(item);
+        }
+    }
+
+    return Py_BuildValue(
+        "{sisisLsNsN}",
+        "version_code", stats.version_code,
+        "frames_per_loop", stats.num_frames,
+        "setup", stats.setup,
+        "frames", frames,
+        "calls", calls
+    );
 }
 
-static PyObject * MGLContext_finish(MGLContext * self, PyObject * args) {
-    self->gl.Finish();
-    Py_RETURN_NONE;
+static PyObject * MGLContext_get_release_stats(MGLContext * self, void * closure) {
+    return Py_BuildValue(
+        "{sLsLsi}",
+        "objects", self->released_objects,
+        "bytes", self->released_bytes,
+        "pending", release_queue_size(&self->release_deferred)
+    );
 }
 
 static PyObject * MGLContext_copy_buffer(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self, "Context.copy_buffer", 0, 0);
+
     MGLBuffer * dst;
     MGLBuffer * src;
 
@@ -7638,9 +11422,9 @@ static PyObject * MGLContext_copy_buffer(MGLContext * self, PyObject * args) {
     int args_ok = PyArg_ParseTuple(
         args,
         "O!O!nnn",
-        MGLBuffer_type,
+        self->state->MGLBuffer_type,
         &dst,
-        MGLBuffer_type,
+        self->state->MGLBuffer_type,
         &src,
         &size,
         &read_offset,
@@ -7667,6 +11451,11 @@ static PyObject * MGLContext_copy_buffer(MGLContext * self, PyObject * args) {
 
     const GLMethods & gl = self->gl;
 
+    if (self->dsa) {
+        gl.CopyNamedBufferSubData(src->buffer_obj, dst->buffer_obj, read_offset, write_offset, size);
+        Py_RETURN_NONE;
+    }
+
     gl.BindBuffer(GL_COPY_READ_BUFFER, src->buffer_obj);
     gl.BindBuffer(GL_COPY_WRITE_BUFFER, dst->buffer_obj);
     gl.CopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, read_offset, write_offset, size);
@@ -7675,6 +11464,12 @@ static PyObject * MGLContext_copy_buffer(MGLContext * self, PyObject * args) {
 }
 
 static PyObject * MGLContext_copy_framebuffer(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self, "Context.copy_framebuffer", 0, 0);
+
     PyObject * dst;
     MGLFramebuffer * src;
 
@@ -7682,7 +11477,7 @@ static PyObject * MGLContext_copy_framebuffer(MGLContext * self, PyObject * args
         args,
         "OO!",
         &dst,
-        MGLFramebuffer_type,
+        self->state->MGLFramebuffer_type,
         &src
     );
 
@@ -7699,7 +11494,7 @@ static PyObject * MGLContext_copy_framebuffer(MGLContext * self, PyObject * args
     // GL_DEPTH_BUFFER_BIT or GL_STENCIL_BUFFER_BIT, no data is transferred and a
     // GL_INVALID_OPERATION error is generated.
 
-    if (Py_TYPE(dst) == MGLFramebuffer_type) {
+    if (Py_TYPE(dst) == self->state->MGLFramebuffer_type) {
 
         MGLFramebuffer * dst_framebuffer = (MGLFramebuffer *)dst;
 
@@ -7724,9 +11519,28 @@ static PyObject * MGLContext_copy_framebuffer(MGLContext * self, PyObject * args
         }
 
 
+        int color_attachment_len = dst_framebuffer->draw_buffers_len;
+
+        if (self->dsa) {
+            // The read and draw buffers are set on the framebuffer objects, no bind point is touched
+            for (int i = 0; i < color_attachment_len; ++i) {
+                gl.NamedFramebufferReadBuffer(src->framebuffer_obj, src->draw_buffers[i]);
+                gl.NamedFramebufferDrawBuffer(dst_framebuffer->framebuffer_obj, dst_framebuffer->draw_buffers[i]);
+                gl.BlitNamedFramebuffer(
+                    src->framebuffer_obj, dst_framebuffer->framebuffer_obj,
+                    0, 0, width, height,
+                    0, 0, width, height,
+                    GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT,
+                    GL_NEAREST
+                );
+            }
+            gl.NamedFramebufferReadBuffer(src->framebuffer_obj, src->draw_buffers[0]);
+            gl.NamedFramebufferDrawBuffers(dst_framebuffer->framebuffer_obj, dst_framebuffer->draw_buffers_len, dst_framebuffer->draw_buffers);
+            Py_RETURN_NONE;
+        }
+
         int prev_read_buffer = -1;
         int prev_draw_buffer = -1;
-        int color_attachment_len = dst_framebuffer->draw_buffers_len;
         gl.GetIntegerv(GL_READ_BUFFER, &prev_read_buffer);
         gl.GetIntegerv(GL_DRAW_BUFFER, &prev_draw_buffer);
         gl.BindFramebuffer(GL_READ_FRAMEBUFFER, src->framebuffer_obj);
@@ -7749,7 +11563,7 @@ static PyObject * MGLContext_copy_framebuffer(MGLContext * self, PyObject * args
         gl.DrawBuffer(prev_draw_buffer);
         gl.DrawBuffers(self->bound_framebuffer->draw_buffers_len, self->bound_framebuffer->draw_buffers);
 
-    } else if (Py_TYPE(dst) == MGLTexture_type) {
+    } else if (Py_TYPE(dst) == self->state->MGLTexture_type) {
 
         MGLTexture * dst_texture = (MGLTexture *)dst;
 
@@ -7778,6 +11592,14 @@ static PyObject * MGLContext_copy_framebuffer(MGLContext * self, PyObject * args
         int texture_target = dst_texture->samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
         int format = formats[dst_texture->components];
 
+        if (self->dsa) {
+            // Only the read bind point is used, the texture keeps its internal format
+            gl.BindFramebuffer(GL_READ_FRAMEBUFFER, src->framebuffer_obj);
+            gl.CopyTextureSubImage2D(dst_texture->texture_obj, 0, 0, 0, 0, 0, width, height);
+            gl.BindFramebuffer(GL_READ_FRAMEBUFFER, self->bound_framebuffer->framebuffer_obj);
+            Py_RETURN_NONE;
+        }
+
         gl.BindFramebuffer(GL_READ_FRAMEBUFFER, src->framebuffer_obj);
         gl.ActiveTexture(GL_TEXTURE0 + self->default_texture_unit);
         gl.BindTexture(GL_TEXTURE_2D, dst_texture->texture_obj);
@@ -7795,6 +11617,9 @@ static PyObject * MGLContext_copy_framebuffer(MGLContext * self, PyObject * args
 }
 
 static PyObject * MGLContext_detect_framebuffer(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
     PyObject * glo;
 
     int args_ok = PyArg_ParseTuple(
@@ -7826,13 +11651,21 @@ static PyObject * MGLContext_detect_framebuffer(MGLContext * self, PyObject * ar
         return Py_BuildValue("(O(ii)ii)", framebuffer, framebuffer->width, framebuffer->height, framebuffer->samples, framebuffer->framebuffer_obj);
     }
 
-    gl.BindFramebuffer(GL_FRAMEBUFFER, framebuffer_obj);
+    bool dsa = self->dsa;
+    if (!dsa) {
+        gl.BindFramebuffer(GL_FRAMEBUFFER, framebuffer_obj);
+    }
 
-    int num_color_attachments = self->max_color_attachments;
+    int max_color_attachments = context_limit(self, &self->max_color_attachments, GL_MAX_COLOR_ATTACHMENTS);
+    int num_color_attachments = max_color_attachments;
 
-    for (int i = 0; i < self->max_color_attachments; ++i) {
+    for (int i = 0; i < max_color_attachments; ++i) {
         int color_attachment_type = 0;
-        gl.GetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &color_attachment_type);
+        if (dsa) {
+            gl.GetNamedFramebufferAttachmentParameteriv(framebuffer_obj, GL_COLOR_ATTACHMENT0 + i, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &color_attachment_type);
+        } else {
+            gl.GetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &color_attachment_type);
+        }
 
         if (!color_attachment_type) {
             num_color_attachments = i;
@@ -7841,22 +11674,40 @@ static PyObject * MGLContext_detect_framebuffer(MGLContext * self, PyObject * ar
     }
 
     int color_attachment_type = 0;
-    gl.GetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &color_attachment_type);
-
     int color_attachment_name = 0;
-    gl.GetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &color_attachment_name);
+    int samples = 0;
+
+    if (dsa) {
+        gl.GetNamedFramebufferAttachmentParameteriv(framebuffer_obj, GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &color_attachment_type);
+        gl.GetNamedFramebufferAttachmentParameteriv(framebuffer_obj, GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &color_attachment_name);
+        gl.GetNamedFramebufferParameteriv(framebuffer_obj, GL_SAMPLES, &samples);
+    } else {
+        gl.GetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &color_attachment_type);
+        gl.GetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &color_attachment_name);
+        gl.GetIntegerv(GL_SAMPLES, &samples);
+    }
 
     int width = 0;
     int height = 0;
 
     switch (color_attachment_type) {
         case GL_RENDERBUFFER: {
+            if (dsa) {
+                gl.GetNamedRenderbufferParameteriv(color_attachment_name, GL_RENDERBUFFER_WIDTH, &width);
+                gl.GetNamedRenderbufferParameteriv(color_attachment_name, GL_RENDERBUFFER_HEIGHT, &height);
+                break;
+            }
             gl.BindRenderbuffer(GL_RENDERBUFFER, color_attachment_name);
             gl.GetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_WIDTH, &width);
             gl.GetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_HEIGHT, &height);
             break;
         }
         case GL_TEXTURE: {
+            if (dsa) {
+                gl.GetTextureLevelParameteriv(color_attachment_name, 0, GL_TEXTURE_WIDTH, &width);
+                gl.GetTextureLevelParameteriv(color_attachment_name, 0, GL_TEXTURE_HEIGHT, &height);
+                break;
+            }
             gl.ActiveTexture(GL_TEXTURE0 + self->default_texture_unit);
             gl.BindTexture(GL_TEXTURE_2D, color_attachment_name);
             gl.GetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
@@ -7865,8 +11716,9 @@ static PyObject * MGLContext_detect_framebuffer(MGLContext * self, PyObject * ar
         }
     }
 
-    MGLFramebuffer * framebuffer = PyObject_New(MGLFramebuffer, MGLFramebuffer_type);
+    MGLFramebuffer * framebuffer = PyObject_New(MGLFramebuffer, self->state->MGLFramebuffer_type);
     framebuffer->released = false;
+    framebuffer->scaled = {};
 
     framebuffer->framebuffer_obj = framebuffer_obj;
 
@@ -7888,14 +11740,21 @@ static PyObject * MGLContext_detect_framebuffer(MGLContext * self, PyObject * ar
 
     framebuffer->width = width;
     framebuffer->height = height;
+    framebuffer->samples = samples;
     framebuffer->dynamic = true;
 
-    gl.BindFramebuffer(GL_FRAMEBUFFER, bound_framebuffer);
+    if (!dsa) {
+        gl.BindFramebuffer(GL_FRAMEBUFFER, bound_framebuffer);
+    }
 
     return Py_BuildValue("(O(ii)ii)", framebuffer, framebuffer->width, framebuffer->height, framebuffer->samples, framebuffer->framebuffer_obj);
 }
 
 static PyObject * MGLContext_clear_samplers(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
     int start;
     int end;
 
@@ -7927,19 +11786,81 @@ static PyObject * MGLContext_clear_samplers(MGLContext * self, PyObject * args)
 }
 
 static PyObject * MGLContext_enter(MGLContext * self, PyObject * args) {
-    return PyObject_CallMethod(self->ctx, "__enter__", NULL);
+    // Entering the current context again nests, the backend keeps the context of the outer enter
+    if (current_context == self) {
+        self->nested_enters += 1;
+    } else {
+        if (!context_enter(self)) {
+            return NULL;
+        }
+        // Enters that were never exited while the context was current are not nested in this one
+        self->nested_enters = 0;
+    }
+    self->owner_thread = PyThread_get_thread_ident();
+    Py_RETURN_NONE;
 }
 
 static PyObject * MGLContext_exit(MGLContext * self, PyObject * args) {
-    return PyObject_CallMethod(self->ctx, "__exit__", NULL);
+    if (self->nested_enters) {
+        self->nested_enters -= 1;
+        // Another context was made current inside the nested enter, an exit and an enter
+        // of the backend make this context current and keep the context it restores
+        if (current_context != self && (!context_exit(self) || !context_enter(self))) {
+            return NULL;
+        }
+        Py_RETURN_NONE;
+    }
+    if (!context_exit(self)) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
 }
 
 static PyObject * MGLContext_release(MGLContext * self, PyObject * args) {
     if (self->released) {
         Py_RETURN_NONE;
     }
+
+    // The names and queries can only be deleted on the thread the context is current on
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
     self->released = true;
 
+    // A capture left open is closed with the context, only Capture.stop reports write errors
+    stop_capture(self);
+    stop_debug_output(self);
+    Py_CLEAR(self->memory.alarm_callback);
+    self->memory.alarm = 0;
+
+    // Names shared with other contexts must not outlive the deferred queue
+    release_deferred_objects(self, true);
+    free_name_pools(self);
+    if (self->timestamp_queries.count) {
+        self->gl.DeleteQueries(self->timestamp_queries.count, self->timestamp_queries.names);
+    }
+    free_tracer(self);
+    PyMem_Free(self->startup);
+    self->startup = NULL;
+    PyMem_Free(self->timestamp_queries.names);
+    memset(&self->timestamp_queries, 0, sizeof(MGLQueryPool));
+    for (int kind = 0; kind < MGL_RELEASE_KINDS; ++kind) {
+        PyMem_Free(self->release_batch.names[kind]);
+        PyMem_Free(self->release_deferred.names[kind]);
+    }
+    memset(&self->release_batch, 0, sizeof(MGLReleaseQueue));
+    memset(&self->release_deferred, 0, sizeof(MGLReleaseQueue));
+
+    delete[] self->extension_names;
+    self->extension_names = NULL;
+    self->num_extensions = 0;
+    // Releasing the backend leaves no context current
+    if (current_context == self) {
+        current_context = NULL;
+    }
+
+    release_gl_methods(self->gl);
+
     PyObject * temp = PyObject_CallMethod(self->ctx, "release", NULL);
     if (!temp) {
         return NULL;
@@ -7951,6 +11872,9 @@ static PyObject * MGLContext_release(MGLContext * self, PyObject * args) {
 }
 
 static PyObject * MGLContext_clear_errors(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
     // According to the OpenGL wiki, OpenGL can hold multiple error flags.
     // (Contrast with something like the C stdlib's errno, which is a single global variable.)
     // Calling glGetError returns one of these error codes and clears it,
@@ -7964,6 +11888,9 @@ static PyObject * MGLContext_clear_errors(MGLContext * self, PyObject * args) {
 }
 
 static PyObject * MGLContext_get_ubo_binding(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
     int program_obj;
     int index;
     if (!PyArg_ParseTuple(args, "II", &program_obj, &index)) {
@@ -7975,6 +11902,9 @@ static PyObject * MGLContext_get_ubo_binding(MGLContext * self, PyObject * args)
 }
 
 static PyObject * MGLContext_set_ubo_binding(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
     int program_obj;
     int index;
     int binding;
@@ -7986,6 +11916,9 @@ static PyObject * MGLContext_set_ubo_binding(MGLContext * self, PyObject * args)
 }
 
 static PyObject * MGLContext_get_storage_block_binding(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
     int program_obj;
     int index;
     if (!PyArg_ParseTuple(args, "II", &program_obj, &index)) {
@@ -7998,6 +11931,9 @@ static PyObject * MGLContext_get_storage_block_binding(MGLContext * self, PyObje
 }
 
 static PyObject * MGLContext_set_storage_block_binding(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
     int program_obj;
     int index;
     int binding;
@@ -8009,6 +11945,9 @@ static PyObject * MGLContext_set_storage_block_binding(MGLContext * self, PyObje
 }
 
 static PyObject * MGLContext_read_uniform(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
     int program_obj;
     int location;
     int gl_type;
@@ -8096,6 +12035,12 @@ static PyObject * MGLContext_read_uniform(MGLContext * self, PyObject * args) {
 }
 
 static PyObject * MGLContext_write_uniform(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self, "Uniform.write", 0, 0, true);
+
     int program_obj;
     int location;
     int gl_type;
@@ -8116,6 +12061,8 @@ static PyObject * MGLContext_write_uniform(MGLContext * self, PyObject * args) {
     char * ptr = (char *)view.buf;
 
     gl.UseProgram(program_obj);
+    self->stats.uniform_writes += 1;
+    self->stats.program_binds += 1;
 
     switch (gl_type) {
         case GL_BOOL: gl.Uniform1iv(location, array_length, (int *)ptr); break;
@@ -8187,6 +12134,12 @@ static PyObject * MGLContext_write_uniform(MGLContext * self, PyObject * args) {
 }
 
 static PyObject * MGLContext_set_uniform_handle(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+
+    MGLTraceScope trace(self, "Uniform.handle", 0, 0, true);
+
     int program_obj;
     int location;
     unsigned long long handle;
@@ -8195,11 +12148,20 @@ static PyObject * MGLContext_set_uniform_handle(MGLContext * self, PyObject * ar
         return NULL;
     }
 
+    if (!load_gl_bindless_texture_methods(self->gl)) {
+        MGLError_Set("bindless textures are not supported");
+        return NULL;
+    }
+
     self->gl.ProgramUniformHandleui64ARB(program_obj, location, handle);
+    self->stats.uniform_writes += 1;
     Py_RETURN_NONE;
 }
 
 static PyObject * MGLContext_get_line_width(MGLContext * self, void * closure) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
     float line_width = 0.0f;
 
     self->gl.GetFloatv(GL_LINE_WIDTH, &line_width);
@@ -8208,6 +12170,9 @@ static PyObject * MGLContext_get_line_width(MGLContext * self, void * closure) {
 }
 
 static int MGLContext_set_line_width(MGLContext * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self)) {
+        return -1;
+    }
     float line_width = (float)PyFloat_AsDouble(value);
 
     if (PyErr_Occurred()) {
@@ -8220,6 +12185,9 @@ static int MGLContext_set_line_width(MGLContext * self, PyObject * value, void *
 }
 
 static PyObject * MGLContext_get_point_size(MGLContext * self, void * closure) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
     float point_size = 0.0f;
 
     self->gl.GetFloatv(GL_POINT_SIZE, &point_size);
@@ -8228,6 +12196,9 @@ static PyObject * MGLContext_get_point_size(MGLContext * self, void * closure) {
 }
 
 static int MGLContext_set_point_size(MGLContext * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self)) {
+        return -1;
+    }
     float point_size = (float)PyFloat_AsDouble(value);
 
     if (PyErr_Occurred()) {
@@ -8277,6 +12248,12 @@ static PyObject * MGLContext_get_blend_func(MGLContext * self, void * closure) {
 }
 
 static int MGLContext_set_blend_func(MGLContext * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self)) {
+        return -1;
+    }
+
+    MGLTraceScope trace(self, "Context.blend_func", 0, 0, true);
+
     int func[4] = {};
     if (!parse_blend_func(value, func)) {
         MGLError_Set("invalid blend func");
@@ -8330,6 +12307,12 @@ static PyObject * MGLContext_get_blend_equation(MGLContext * self, void * closur
 }
 
 static int MGLContext_set_blend_equation(MGLContext * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self)) {
+        return -1;
+    }
+
+    MGLTraceScope trace(self, "Context.blend_equation", 0, 0, true);
+
     int equation[2] = {};
     if (!parse_blend_equation(value, equation)) {
         MGLError_Set("invalid blend equation");
@@ -8345,6 +12328,9 @@ static PyObject * MGLContext_get_depth_func(MGLContext * self, void * closure) {
 }
 
 static int MGLContext_set_depth_func(MGLContext * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self)) {
+        return -1;
+    }
     const char * func = PyUnicode_AsUTF8(value);
 
     if (PyErr_Occurred()) {
@@ -8371,6 +12357,9 @@ static PyObject * MGLContext_get_depth_clamp_range(MGLContext * self, void * clo
 }
 
 static int MGLContext_set_depth_clamp_range(MGLContext * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self)) {
+        return -1;
+    }
     if (value == Py_None) {
         self->depth_clamp = false;
         self->depth_range[0] = 0.0;
@@ -8396,6 +12385,9 @@ static PyObject * MGLContext_get_multisample(MGLContext * self, void * closure)
 }
 
 static int MGLContext_set_multisample(MGLContext * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self)) {
+        return -1;
+    }
     if (value == Py_True) {
         self->gl.Enable(GL_MULTISAMPLE);
         self->multisample = true;
@@ -8413,6 +12405,9 @@ static PyObject * MGLContext_get_provoking_vertex(MGLContext * self, void * clos
 }
 
 static int MGLContext_set_provoking_vertex(MGLContext * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self)) {
+        return -1;
+    }
     int provoking_vertex_value = PyLong_AsLong(value);
     const GLMethods & gl = self->gl;
 
@@ -8429,6 +12424,9 @@ static PyObject * MGLContext_get_polygon_offset(MGLContext * self, void * closur
 }
 
 static int MGLContext_set_polygon_offset(MGLContext * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self)) {
+        return -1;
+    }
     if (!PyTuple_CheckExact(value) || PyTuple_Size(value) != 2) {
         return -1;
     }
@@ -8473,11 +12471,17 @@ static int MGLContext_set_default_texture_unit(MGLContext * self, PyObject * val
 }
 
 static PyObject * MGLContext_get_max_samples(MGLContext * self, void * closure) {
-    return PyLong_FromLong(self->max_samples);
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    return PyLong_FromLong(context_limit(self, &self->max_samples, GL_MAX_SAMPLES));
 }
 
 static PyObject * MGLContext_get_max_integer_samples(MGLContext * self, void * closure) {
-    return PyLong_FromLong(self->max_integer_samples);
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    return PyLong_FromLong(context_limit(self, &self->max_integer_samples, GL_MAX_INTEGER_SAMPLES));
 }
 
 static PyObject * MGLContext_get_max_texture_units(MGLContext * self, void * closure) {
@@ -8485,11 +12489,17 @@ static PyObject * MGLContext_get_max_texture_units(MGLContext * self, void * clo
 }
 
 static PyObject * MGLContext_get_max_anisotropy(MGLContext * self, void * closure) {
-    return PyFloat_FromDouble(self->max_anisotropy);
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    return PyFloat_FromDouble(context_max_anisotropy(self));
 }
 
 static PyObject * MGLContext_get_max_label_length(MGLContext * self, void * closure) {
-    if (self->max_label_length > 0) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    if (context_limit(self, &self->max_label_length, GL_MAX_LABEL_LENGTH) > 0) {
         return PyLong_FromLong(self->max_label_length);
     }
     else {
@@ -8498,7 +12508,10 @@ static PyObject * MGLContext_get_max_label_length(MGLContext * self, void * clos
 }
 
 static PyObject * MGLContext_get_max_debug_message_length(MGLContext * self, void * closure) {
-    if (self->max_debug_message_length > 0) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    if (context_limit(self, &self->max_debug_message_length, GL_MAX_DEBUG_MESSAGE_LENGTH) > 0) {
         return PyLong_FromLong(self->max_debug_message_length);
     }
     else {
@@ -8507,13 +12520,50 @@ static PyObject * MGLContext_get_max_debug_message_length(MGLContext * self, voi
 }
 
 
-static PyObject * MGLContext_get_max_debug_group_stack_depth(MGLContext * self, void * closure) {
-    if (self->max_debug_group_stack_depth > 0) {
-        return PyLong_FromLong(self->max_debug_group_stack_depth);
+static PyObject * MGLContext_get_max_debug_group_stack_depth(MGLContext * self, void * closure) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    if (context_limit(self, &self->max_debug_group_stack_depth, GL_MAX_DEBUG_GROUP_STACK_DEPTH) > 0) {
+        return PyLong_FromLong(self->max_debug_group_stack_depth);
+    }
+    else {
+        Py_RETURN_NONE;
+    }
+}
+
+static bool dsa_supported(MGLContext * self) {
+    // OpenGL 4.5 direct state access lets objects be created and updated without touching the bind points
+    const GLMethods & gl = self->gl;
+    return self->version_code >= 450 && gl.CreateBuffers && gl.NamedBufferSubData && gl.CreateTextures && gl.TextureSubImage2D &&
+        gl.TextureSubImage3D && gl.GetTextureSubImage && gl.CreateFramebuffers && gl.CreateRenderbuffers;
+}
+
+static PyObject * MGLContext_get_dsa(MGLContext * self, void * closure) {
+    return PyBool_FromLong(self->dsa);
+}
+
+static int MGLContext_set_dsa(MGLContext * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self)) {
+        return -1;
     }
-    else {
-        Py_RETURN_NONE;
+    int dsa = PyObject_IsTrue(value);
+    if (dsa < 0) {
+        return -1;
+    }
+
+    if (dsa && !dsa_supported(self)) {
+        MGLError_Set("direct state access requires OpenGL 4.5");
+        return -1;
+    }
+
+    if (self->dsa != (dsa ? true : false)) {
+        // Pooled buffer names are created with CreateBuffers only in dsa mode
+        free_name_pools(self);
     }
+
+    self->dsa = dsa ? true : false;
+    return 0;
 }
 
 static MGLFramebuffer * MGLContext_get_fbo(MGLContext * self, void * closure) {
@@ -8522,7 +12572,7 @@ static MGLFramebuffer * MGLContext_get_fbo(MGLContext * self, void * closure) {
 }
 
 static int MGLContext_set_fbo(MGLContext * self, PyObject * value, void * closure) {
-    if (Py_TYPE(value) != MGLFramebuffer_type) {
+    if (Py_TYPE(value) != self->state->MGLFramebuffer_type) {
         return -1;
     }
     Py_INCREF(value);
@@ -8536,6 +12586,9 @@ static PyObject * MGLContext_get_wireframe(MGLContext * self, void * closure) {
 }
 
 static int MGLContext_set_wireframe(MGLContext * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self)) {
+        return -1;
+    }
     if (value == Py_True) {
         self->gl.PolygonMode(GL_FRONT_AND_BACK, GL_LINE);
         self->wireframe = true;
@@ -8561,6 +12614,9 @@ static PyObject * MGLContext_get_front_face(MGLContext * self, void * closure) {
 }
 
 static int MGLContext_set_front_face(MGLContext * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self)) {
+        return -1;
+    }
     const char * str = PyUnicode_AsUTF8(value);
 
     if (!strcmp(str, "cw")) {
@@ -8593,6 +12649,9 @@ static PyObject * MGLContext_get_cull_face(MGLContext * self, void * closure) {
 }
 
 static int MGLContext_set_cull_face(MGLContext * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self)) {
+        return -1;
+    }
     const char * str = PyUnicode_AsUTF8(value);
 
     if (!strcmp(str, "front")) {
@@ -8611,6 +12670,9 @@ static int MGLContext_set_cull_face(MGLContext * self, PyObject * value, void *
 }
 
 static PyObject * MGLContext_get_patch_vertices(MGLContext * self, void * closure) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
     int patch_vertices = 0;
 
     self->gl.GetIntegerv(GL_PATCH_VERTICES, &patch_vertices);
@@ -8619,6 +12681,9 @@ static PyObject * MGLContext_get_patch_vertices(MGLContext * self, void * closur
 }
 
 static int MGLContext_set_patch_vertices(MGLContext * self, PyObject * value, void * closure) {
+    if (!check_context_thread(self)) {
+        return -1;
+    }
     int patch_vertices = PyLong_AsLong(value);
 
     if (PyErr_Occurred()) {
@@ -8635,6 +12700,9 @@ static int MGLContext_set_patch_vertices(MGLContext * self, PyObject * value, vo
 }
 
 static PyObject * MGLContext_get_error(MGLContext * self, void * closure) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
     switch (self->gl.GetError()) {
         case GL_NO_ERROR:
             return PyUnicode_FromFormat("GL_NO_ERROR");
@@ -8658,7 +12726,33 @@ static PyObject * MGLContext_get_error(MGLContext * self, void * closure) {
     return PyUnicode_FromFormat("GL_UNKNOWN_ERROR");
 }
 
+static PyObject * MGLContext_has_extension(MGLContext * self, PyObject * args) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    const char * name;
+
+    if (!PyArg_ParseTuple(args, "s", &name)) {
+        return NULL;
+    }
+
+    return PyBool_FromLong(has_extension(self, name));
+}
+
 static PyObject * MGLContext_get_extensions(MGLContext * self, void * closure) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    if (!self->extensions) {
+        load_extension_names(self);
+        self->extensions = PySet_New(NULL);
+        for (int i = 0; i < self->num_extensions; ++i) {
+            PyObject * name = PyUnicode_FromString(self->extension_names[i]);
+            PySet_Add(self->extensions, name);
+            Py_DECREF(name);
+        }
+    }
+
     Py_INCREF(self->extensions);
     return self->extensions;
 }
@@ -8727,6 +12821,15 @@ static void set_info_int_xyz(MGLContext * self, PyObject * info, const char * na
 }
 
 static PyObject * MGLContext_get_info(MGLContext * self, void * closure) {
+    if (!check_context_thread(self)) {
+        return NULL;
+    }
+    // Callers get a copy, the cached dict cannot be changed from Python
+    if (self->info) {
+        return PyDict_Copy(self->info);
+    }
+
+    MGLCurrentScope current(self);
     PyObject * info = PyDict_New();
 
     set_info_str(self, info, "GL_VENDOR", GL_VENDOR);
@@ -8843,7 +12946,8 @@ static PyObject * MGLContext_get_info(MGLContext * self, void * closure) {
 
     // GL_EXT_debug_label doesn't define a MAX_LABEL_LENGTH constant
 
-    return info;
+    self->info = info;
+    return PyDict_Copy(info);
 }
 
 static PyObject * strsize(PyObject * self, PyObject * args) {
@@ -8924,19 +13028,369 @@ static PyObject * expected_size(PyObject * self, PyObject * args) {
     unsigned long long expected_size = (unsigned long long)width * components * data_type->size;
     expected_size = (expected_size + alignment - 1) / alignment * alignment;
     expected_size = expected_size * height * depth;
-    return PyLong_FromLong(expected_size);
+    return PyLong_FromUnsignedLongLong(expected_size);
 }
 
 static PyObject * writable_bytes(PyObject * self, PyObject * arg) {
-    PyObject * bytes = PyBytes_FromStringAndSize(NULL, PyLong_AsLong(arg));
+    PyObject * bytes = PyBytes_FromStringAndSize(NULL, PyLong_AsSsize_t(arg));
     PyObject * mem = PyMemoryView_FromMemory(PyBytes_AsString(bytes), PyBytes_Size(bytes), PyBUF_WRITE);
     return Py_BuildValue("(NN)", bytes, mem);
 }
 
+struct MGLNativeEGL {
+    PyObject_HEAD
+    bool standalone;
+    bool owned;
+    PyObject * device;
+
+#ifdef MGL_NATIVE_EGL
+    EGLDisplay display;
+    EGLContext context;
+    EGLSurface draw_surface;
+    EGLSurface read_surface;
+
+    // The bindings restored by __exit__
+    EGLDisplay previous_display;
+    EGLContext previous_context;
+    EGLSurface previous_draw;
+    EGLSurface previous_read;
+#endif
+};
+
+#ifdef MGL_NATIVE_EGL
+
+static EGLDisplay native_egl_display(PyObject * device) {
+    bool surfaceless = egl_client_extension("EGL_MESA_platform_surfaceless");
+
+    if (egl.GetPlatformDisplayEXT && (device != Py_None || !surfaceless)) {
+        EGLDeviceEXT devices[64];
+        int num_devices = query_egl_devices(devices, 64);
+        int index = device != Py_None ? PyLong_AsLong(device) : 0;
+
+        if (PyErr_Occurred()) {
+            return NULL;
+        }
+
+        // Without a requested device and without device enumeration the default display is used
+        if (device == Py_None && !num_devices) {
+            return egl.GetDisplay(NULL);
+        }
+
+        if (index < 0 || index >= num_devices) {
+            MGLError_Set("EGL device %d is not available, found %d devices", index, num_devices);
+            return NULL;
+        }
+
+        return egl.GetPlatformDisplayEXT(EGL_PLATFORM_DEVICE_EXT, devices[index], NULL);
+    }
+
+    if (egl.GetPlatformDisplayEXT && surfaceless) {
+        return egl.GetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, NULL, NULL);
+    }
+
+    return egl.GetDisplay(NULL);
+}
+
+static PyObject * native_egl_context(ModuleState * state, PyObject * kwargs) {
+    PyObject * glversion_obj = PyDict_GetItemString(kwargs, "glversion");
+    PyObject * mode_obj = PyDict_GetItemString(kwargs, "mode");
+    PyObject * device = PyDict_GetItemString(kwargs, "device");
+    PyObject * libegl_obj = PyDict_GetItemString(kwargs, "libegl");
+
+    int glversion = glversion_obj && glversion_obj != Py_None ? PyLong_AsLong(glversion_obj) : 330;
+    const char * mode = mode_obj ? PyUnicode_AsUTF8(mode_obj) : "detect";
+    const char * libegl = libegl_obj && libegl_obj != Py_None ? PyUnicode_AsUTF8(libegl_obj) : NULL;
+
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
+    if (!device) {
+        device = Py_None;
+    }
+
+    const char * error = load_egl_methods(libegl);
+    if (error) {
+        MGLError_Set("native-egl: %s", error);
+        return NULL;
+    }
+
+    MGLNativeEGL * res = PyObject_New(MGLNativeEGL, state->MGLNativeEGL_type);
+    res->standalone = !strcmp(mode, "standalone");
+    res->owned = false;
+    res->context = NULL;
+    res->draw_surface = NULL;
+    res->read_surface = NULL;
+    res->previous_display = NULL;
+    res->previous_context = NULL;
+    res->previous_draw = NULL;
+    res->previous_read = NULL;
+    Py_INCREF(device);
+    res->device = device;
+
+    if (!strcmp(mode, "detect")) {
+        res->display = egl.GetCurrentDisplay();
+        res->context = egl.GetCurrentContext();
+        res->draw_surface = egl.GetCurrentSurface(EGL_DRAW);
+        res->read_surface = egl.GetCurrentSurface(EGL_READ);
+
+        if (!res->context) {
+            MGLError_Set("native-egl: cannot detect the current EGL context");
+            Py_DECREF(res);
+            return NULL;
+        }
+
+        return (PyObject *)res;
+    }
+
+    EGLContext share_context = NULL;
+
+    if (!strcmp(mode, "share")) {
+        // The shared context dictates the display
+        res->display = egl.GetCurrentDisplay();
+        share_context = egl.GetCurrentContext();
+
+        if (!share_context) {
+            MGLError_Set("native-egl: there is no current EGL context to share with");
+            Py_DECREF(res);
+            return NULL;
+        }
+    } else if (!strcmp(mode, "standalone")) {
+        res->display = native_egl_display(device);
+        if (!res->display) {
+            if (!PyErr_Occurred()) {
+                MGLError_Set("native-egl: cannot get an EGL display (0x%x)", egl.GetError());
+            }
+            Py_DECREF(res);
+            return NULL;
+        }
+
+        EGLint major = 0;
+        EGLint minor = 0;
+        if (!egl.Initialize(res->display, &major, &minor)) {
+            MGLError_Set("native-egl: eglInitialize failed (0x%x)", egl.GetError());
+            Py_DECREF(res);
+            return NULL;
+        }
+    } else {
+        MGLError_Set("native-egl: invalid mode %s", mode);
+        Py_DECREF(res);
+        return NULL;
+    }
+
+    // Headless contexts render to framebuffers only, any surface type is fine
+    EGLint config_attribs[] = {
+        EGL_SURFACE_TYPE, 0,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE,
+    };
+
+    EGLConfig config = NULL;
+    EGLint num_configs = 0;
+    if (!egl.ChooseConfig(res->display, config_attribs, &config, 1, &num_configs) || !num_configs) {
+        MGLError_Set("native-egl: eglChooseConfig failed (0x%x)", egl.GetError());
+        Py_DECREF(res);
+        return NULL;
+    }
+
+    if (!egl.BindAPI(EGL_OPENGL_API)) {
+        MGLError_Set("native-egl: eglBindAPI failed (0x%x)", egl.GetError());
+        Py_DECREF(res);
+        return NULL;
+    }
+
+    EGLint context_attribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, glversion / 100,
+        EGL_CONTEXT_MINOR_VERSION, glversion % 100 / 10,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE,
+    };
+
+    res->context = egl.CreateContext(res->display, config, share_context, context_attribs);
+    if (!res->context) {
+        MGLError_Set("native-egl: eglCreateContext failed (0x%x)", egl.GetError());
+        Py_DECREF(res);
+        return NULL;
+    }
+
+    res->owned = true;
+
+    if (!egl.MakeCurrent(res->display, NULL, NULL, res->context)) {
+        MGLError_Set("native-egl: eglMakeCurrent failed (0x%x)", egl.GetError());
+        egl.DestroyContext(res->display, res->context);
+        res->owned = false;
+        Py_DECREF(res);
+        return NULL;
+    }
+
+    return (PyObject *)res;
+}
+
+static PyObject * MGLNativeEGL_enter(MGLNativeEGL * self, PyObject * args) {
+    self->previous_display = egl.GetCurrentDisplay();
+    self->previous_context = egl.GetCurrentContext();
+    self->previous_draw = egl.GetCurrentSurface(EGL_DRAW);
+    self->previous_read = egl.GetCurrentSurface(EGL_READ);
+
+    if (!egl.MakeCurrent(self->display, self->draw_surface, self->read_surface, self->context)) {
+        MGLError_Set("native-egl: eglMakeCurrent failed (0x%x)", egl.GetError());
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLNativeEGL_exit(MGLNativeEGL * self, PyObject * args) {
+    if (self->previous_display) {
+        egl.MakeCurrent(self->previous_display, self->previous_draw, self->previous_read, self->previous_context);
+    } else {
+        egl.MakeCurrent(self->display, NULL, NULL, NULL);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLNativeEGL_release(MGLNativeEGL * self, PyObject * args) {
+    if (self->owned) {
+        if (egl.GetCurrentContext() == self->context) {
+            egl.MakeCurrent(self->display, NULL, NULL, NULL);
+        }
+        // The display is shared with other contexts and is not terminated
+        egl.DestroyContext(self->display, self->context);
+        self->owned = false;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLNativeEGL_load_opengl_function(MGLNativeEGL * self, PyObject * arg) {
+    const char * name = PyUnicode_AsUTF8(arg);
+    if (!name) {
+        return NULL;
+    }
+    return PyLong_FromVoidPtr(egl_proc_address(name));
+}
+
+static PyObject * MGLNativeEGL_get_proc_address(MGLNativeEGL * self, void * closure) {
+    return PyCapsule_New((void *)egl_proc_address, "proc_address", NULL);
+}
+
+static PyObject * egl_devices(PyObject * self, PyObject * args) {
+    const char * libegl = NULL;
+
+    if (!PyArg_ParseTuple(args, "|z", &libegl)) {
+        return NULL;
+    }
+
+    const char * error = load_egl_methods(libegl);
+    if (error) {
+        MGLError_Set("native-egl: %s", error);
+        return NULL;
+    }
+
+    EGLDeviceEXT devices[64];
+    int num_devices = query_egl_devices(devices, 64);
+
+    PyObject * res = PyList_New(num_devices);
+    for (int i = 0; i < num_devices; ++i) {
+        const char * device_file = egl.QueryDeviceStringEXT(devices[i], EGL_DRM_DEVICE_FILE_EXT);
+        const char * extensions = egl.QueryDeviceStringEXT(devices[i], EGL_EXTENSIONS);
+        PyList_SET_ITEM(res, i, Py_BuildValue("{siszss}", "index", i, "device_file", device_file, "extensions", extensions ? extensions : ""));
+    }
+
+    // Some drivers set an error for the strings a device does not have
+    egl.GetError();
+    return res;
+}
+
+#else
+
+static PyObject * native_egl_context(ModuleState * state, PyObject * kwargs) {
+    MGLError_Set("the native-egl backend is not supported on this platform");
+    return NULL;
+}
+
+static PyObject * MGLNativeEGL_enter(MGLNativeEGL * self, PyObject * args) {
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLNativeEGL_exit(MGLNativeEGL * self, PyObject * args) {
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLNativeEGL_release(MGLNativeEGL * self, PyObject * args) {
+    Py_RETURN_NONE;
+}
+
+static PyObject * MGLNativeEGL_load_opengl_function(MGLNativeEGL * self, PyObject * arg) {
+    return PyLong_FromVoidPtr(NULL);
+}
+
+static PyObject * MGLNativeEGL_get_proc_address(MGLNativeEGL * self, void * closure) {
+    Py_RETURN_NONE;
+}
+
+static PyObject * egl_devices(PyObject * self, PyObject * args) {
+    MGLError_Set("the native-egl backend is not supported on this platform");
+    return NULL;
+}
+
+#endif
+
+static PyObject * MGLNativeEGL_get_standalone(MGLNativeEGL * self, void * closure) {
+    return PyBool_FromLong(self->standalone);
+}
+
+static PyObject * MGLNativeEGL_get_device(MGLNativeEGL * self, void * closure) {
+    Py_INCREF(self->device);
+    return self->device;
+}
+
+static void MGLNativeEGL_dealloc(MGLNativeEGL * self) {
+    // A context that was not released is destroyed with its owner
+    Py_XDECREF(MGLNativeEGL_release(self, NULL));
+    Py_XDECREF(self->device);
+    PyTypeObject * type = Py_TYPE(self);
+    type->tp_free(self);
+#if PY_VERSION_HEX >= 0x03080000
+    Py_DECREF(type);
+#endif
+}
+
 static PyObject * create_context(PyObject * self, PyObject * args, PyObject * kwargs) {
+    ModuleState * state = (ModuleState *)PyModule_GetState(self);
     PyObject * context = PyDict_GetItemString(kwargs, "context");
 
-    if (!context) {
+    PyObject * backend_name = PyDict_GetItemString(kwargs, "backend");
+
+    // The keyword arguments are a new dict for every call, the flag is not forwarded to the backend
+    int profile_startup = 0;
+    PyObject * profile_startup_arg = PyDict_GetItemString(kwargs, "profile_startup");
+    if (profile_startup_arg) {
+        profile_startup = PyObject_IsTrue(profile_startup_arg);
+        if (profile_startup < 0) {
+            return NULL;
+        }
+        PyDict_DelItemString(kwargs, "profile_startup");
+    }
+
+    int check_thread = 1;
+    PyObject * check_thread_arg = PyDict_GetItemString(kwargs, "check_thread");
+    if (check_thread_arg) {
+        check_thread = PyObject_IsTrue(check_thread_arg);
+        if (check_thread < 0) {
+            return NULL;
+        }
+        PyDict_DelItemString(kwargs, "check_thread");
+    }
+
+    long long context_begin = trace_clock();
+
+    // The built-in EGL backend does not need the glcontext package
+    if (!context && backend_name && PyUnicode_Check(backend_name) && !PyUnicode_CompareWithASCIIString(backend_name, "native-egl")) {
+        context = native_egl_context(state, kwargs);
+        if (!context) {
+            return NULL;
+        }
+    } else if (!context) {
         PyObject * glcontext = PyImport_ImportModule("glcontext");
         if (!glcontext) {
             // Displayed to user: ModuleNotFoundError: No module named 'glcontext'
@@ -8944,7 +13398,6 @@ static PyObject * create_context(PyObject * self, PyObject * args, PyObject * kw
         }
 
         PyObject * backend = NULL;
-        PyObject * backend_name = PyDict_GetItemString(kwargs, "backend");
 
         // Use the specified backend
         if (backend_name) {
@@ -8975,15 +13428,23 @@ static PyObject * create_context(PyObject * self, PyObject * args, PyObject * kw
         Py_INCREF(context);
     }
 
-    MGLContext * ctx = PyObject_New(MGLContext, MGLContext_type);
+    MGLContext * ctx = PyObject_New(MGLContext, state->MGLContext_type);
+    Py_INCREF(self);
+    ctx->module = self;
+    ctx->state = state;
     ctx->released = false;
     ctx->wireframe = false;
+    ctx->owner_thread = PyThread_get_thread_ident();
+    ctx->check_thread = check_thread ? true : false;
     ctx->ctx = context;
+    ctx->startup = NULL;
 
+    long long load_begin = trace_clock();
     ctx->gl = load_gl_methods(context);
     if (PyErr_Occurred()) {
         return NULL;
     }
+    long long setup_begin = trace_clock();
 
     const GLMethods & gl = ctx->gl;
 
@@ -8995,16 +13456,39 @@ static PyObject * create_context(PyObject * self, PyObject * args, PyObject * kw
 
     ctx->version_code = major * 100 + minor * 10;
 
-    // Load extensions
-    int num_extensions = 0;
-    gl.GetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
-    ctx->extensions = PySet_New(NULL);
-
-    for(int i = 0; i < num_extensions; i++) {
-        const char * ext = (const char *)gl.GetStringi(GL_EXTENSIONS, i);
-        PyObject * ext_name = PyUnicode_FromString(ext);
-        PySet_Add(ctx->extensions, ext_name);
-    }
+    ctx->dsa = dsa_supported(ctx);
+
+    memset(&ctx->release_batch, 0, sizeof(MGLReleaseQueue));
+    memset(&ctx->release_deferred, 0, sizeof(MGLReleaseQueue));
+    ctx->release_fence = NULL;
+    ctx->released_objects = 0;
+    ctx->released_bytes = 0;
+    ctx->buffer_names.count = 0;
+    ctx->texture_names.count = 0;
+    ctx->vertex_array_names.count = 0;
+    memset(&ctx->stats, 0, sizeof(MGLStats));
+    memset(&ctx->memory, 0, sizeof(MGLMemory));
+    ctx->memory.live.prev = &ctx->memory.live;
+    ctx->memory.live.next = &ctx->memory.live;
+    memset(&ctx->timestamp_queries, 0, sizeof(MGLQueryPool));
+    ctx->tracer = NULL;
+    ctx->capture = NULL;
+    ctx->debug_output = NULL;
+
+    if (profile_startup) {
+        ctx->startup = (MGLStartupProfile *)PyMem_Calloc(1, sizeof(MGLStartupProfile));
+        if (!ctx->startup) {
+            return PyErr_NoMemory();
+        }
+    }
+
+    // The extensions and the rarely used limits are queried on first use
+    ctx->extensions = NULL;
+    ctx->info = NULL;
+    ctx->extension_names = NULL;
+    ctx->num_extensions = 0;
+    ctx->previous_current = NULL;
+    ctx->nested_enters = 0;
 
     gl.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
@@ -9017,31 +13501,18 @@ static PyObject * create_context(PyObject * self, PyObject * args, PyObject * kw
         gl.Enable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
     }
 
-    ctx->max_samples = 0;
-    gl.GetIntegerv(GL_MAX_SAMPLES, (GLint *)&ctx->max_samples);
-
-    ctx->max_integer_samples = 0;
-    gl.GetIntegerv(GL_MAX_INTEGER_SAMPLES, (GLint *)&ctx->max_integer_samples);
-
-    ctx->max_color_attachments = 0;
-    gl.GetIntegerv(GL_MAX_COLOR_ATTACHMENTS, (GLint *)&ctx->max_color_attachments);
+    ctx->max_samples = -1;
+    ctx->max_integer_samples = -1;
+    ctx->max_color_attachments = -1;
+    ctx->max_label_length = -1;
+    ctx->max_debug_message_length = -1;
+    ctx->max_debug_group_stack_depth = -1;
+    ctx->max_anisotropy = -1.0f;
 
     ctx->max_texture_units = 0;
     gl.GetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, (GLint *)&ctx->max_texture_units);
     ctx->default_texture_unit = ctx->max_texture_units - 1;
 
-    ctx->max_label_length = 0;
-    gl.GetIntegerv(GL_MAX_LABEL_LENGTH, (GLint *)&ctx->max_label_length);
-
-    ctx->max_debug_message_length = 0;
-    gl.GetIntegerv(GL_MAX_DEBUG_MESSAGE_LENGTH, (GLint *)&ctx->max_debug_message_length);
-
-    ctx->max_debug_group_stack_depth = 0;
-    gl.GetIntegerv(GL_MAX_DEBUG_GROUP_STACK_DEPTH, (GLint *)&ctx->max_debug_group_stack_depth);
-
-    ctx->max_anisotropy = 0.0;
-    gl.GetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, (GLfloat *)&ctx->max_anisotropy);
-
     int bound_framebuffer = 0;
     gl.GetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &bound_framebuffer);
 
@@ -9060,8 +13531,9 @@ static PyObject * create_context(PyObject * self, PyObject * args, PyObject * kw
     #endif
 
     {
-        MGLFramebuffer * framebuffer = PyObject_New(MGLFramebuffer, MGLFramebuffer_type);
+        MGLFramebuffer * framebuffer = PyObject_New(MGLFramebuffer, state->MGLFramebuffer_type);
         framebuffer->released = false;
+        framebuffer->scaled = {};
 
         framebuffer->framebuffer_obj = 0;
         framebuffer->draw_buffers_len = 1;
@@ -9132,11 +13604,25 @@ static PyObject * create_context(PyObject * self, PyObject * args, PyObject * kw
         return 0;
     }
 
+    if (ctx->startup) {
+        startup_record(ctx->startup, MGL_STARTUP_CONTEXT, load_begin - context_begin);
+        startup_record(ctx->startup, MGL_STARTUP_LOAD_GL_METHODS, setup_begin - load_begin);
+        startup_record(ctx->startup, MGL_STARTUP_SETUP, trace_clock() - setup_begin);
+    }
+
+    // Creating or detecting a context leaves it current, the backend has nothing to restore yet
+    current_context = ctx;
+
     return Py_BuildValue("(Oi)", ctx, ctx->version_code);
 }
 
 static void default_dealloc(PyObject * self) {
-    Py_TYPE(self)->tp_free(self);
+    // The instances of heap types own a reference to their type
+    PyTypeObject * type = Py_TYPE(self);
+    type->tp_free(self);
+#if PY_VERSION_HEX >= 0x03080000
+    Py_DECREF(type);
+#endif
 }
 
 static PyMethodDef MGL_module_methods[] = {
@@ -9144,6 +13630,7 @@ static PyMethodDef MGL_module_methods[] = {
     {(char *)"create_context", (PyCFunction)create_context, METH_VARARGS | METH_KEYWORDS},
     {(char *)"writable_bytes", (PyCFunction)writable_bytes, METH_O},
     {(char *)"expected_size", (PyCFunction)expected_size, METH_VARARGS},
+    {(char *)"egl_devices", (PyCFunction)egl_devices, METH_VARARGS},
     {},
 };
 
@@ -9168,18 +13655,37 @@ static PyMethodDef MGLBuffer_methods[] = {
 };
 
 static PyMethodDef MGLContext_methods[] = {
+    {(char *)"has_extension", (PyCFunction)MGLContext_has_extension, METH_VARARGS},
     {(char *)"enable_only", (PyCFunction)MGLContext_enable_only, METH_VARARGS},
     {(char *)"enable", (PyCFunction)MGLContext_enable, METH_VARARGS},
     {(char *)"disable", (PyCFunction)MGLContext_disable, METH_VARARGS},
     {(char *)"enable_direct", (PyCFunction)MGLContext_enable_direct, METH_VARARGS},
     {(char *)"disable_direct", (PyCFunction)MGLContext_disable_direct, METH_VARARGS},
     {(char *)"finish", (PyCFunction)MGLContext_finish, METH_NOARGS},
+    {(char *)"adopt", (PyCFunction)MGLContext_adopt, METH_VARARGS},
+    {(char *)"release_objects", (PyCFunction)MGLContext_release_objects, METH_VARARGS},
+    {(char *)"reset_stats", (PyCFunction)MGLContext_reset_stats, METH_NOARGS},
+    {(char *)"memory_report", (PyCFunction)MGLContext_memory_report, METH_VARARGS},
+    {(char *)"set_memory_alarm", (PyCFunction)MGLContext_set_memory_alarm, METH_VARARGS},
+    {(char *)"startup_profile", (PyCFunction)MGLContext_startup_profile, METH_NOARGS},
+    {(char *)"timestamp", (PyCFunction)MGLContext_timestamp, METH_NOARGS},
+    {(char *)"read_timestamps", (PyCFunction)MGLContext_read_timestamps, METH_VARARGS},
+    {(char *)"start_trace", (PyCFunction)MGLContext_start_trace, METH_VARARGS},
+    {(char *)"start_capture", (PyCFunction)MGLContext_start_capture, METH_VARARGS},
+    {(char *)"stop_capture", (PyCFunction)MGLContext_stop_capture, METH_NOARGS},
+    {(char *)"capture_frame", (PyCFunction)MGLContext_capture_frame, METH_VARARGS},
+    {(char *)"replay", (PyCFunction)MGLContext_replay, METH_VARARGS},
+    {(char *)"stop_trace", (PyCFunction)MGLContext_stop_trace, METH_NOARGS},
+    {(char *)"trace_events", (PyCFunction)MGLContext_trace_events, METH_NOARGS},
+    {(char *)"trace_begin", (PyCFunction)MGLContext_trace_begin, METH_VARARGS},
+    {(char *)"trace_end", (PyCFunction)MGLContext_trace_end, METH_NOARGS},
     {(char *)"copy_buffer", (PyCFunction)MGLContext_copy_buffer, METH_VARARGS},
     {(char *)"copy_framebuffer", (PyCFunction)MGLContext_copy_framebuffer, METH_VARARGS},
     {(char *)"detect_framebuffer", (PyCFunction)MGLContext_detect_framebuffer, METH_VARARGS},
     {(char *)"clear_samplers", (PyCFunction)MGLContext_clear_samplers, METH_VARARGS},
 
     {(char *)"buffer", (PyCFunction)MGLContext_buffer, METH_VARARGS},
+    {(char *)"buffers", (PyCFunction)MGLContext_buffers, METH_VARARGS},
     {(char *)"external_buffer", (PyCFunction)MGLContext_external_buffer, METH_VARARGS},
     {(char *)"texture", (PyCFunction)MGLContext_texture, METH_VARARGS},
     {(char *)"texture3d", (PyCFunction)MGLContext_texture3d, METH_VARARGS},
@@ -9199,6 +13705,10 @@ static PyMethodDef MGLContext_methods[] = {
     {(char *)"get_label", (PyCFunction)MGLContext_get_label, METH_VARARGS},
     {(char *)"set_label", (PyCFunction)MGLContext_set_label, METH_VARARGS},
     {(char *)"push_debug_scope", (PyCFunction)MGLContext_push_debug_scope, METH_VARARGS},
+    {(char *)"enable_debug_output", (PyCFunction)MGLContext_enable_debug_output, METH_VARARGS},
+    {(char *)"disable_debug_output", (PyCFunction)MGLContext_disable_debug_output, METH_NOARGS},
+    {(char *)"process_debug_output", (PyCFunction)MGLContext_process_debug_output, METH_NOARGS},
+    {(char *)"debug_message_counts", (PyCFunction)MGLContext_debug_message_counts, METH_NOARGS},
     {(char *)"pop_debug_scope", (PyCFunction)MGLContext_pop_debug_scope, METH_NOARGS},
 
     {(char *)"__enter__", (PyCFunction)MGLContext_enter, METH_NOARGS},
@@ -9230,6 +13740,8 @@ static PyGetSetDef MGLContext_getset[] = {
     {(char *)"polygon_offset", (getter)MGLContext_get_polygon_offset, (setter)MGLContext_set_polygon_offset},
 
     {(char *)"default_texture_unit", (getter)MGLContext_get_default_texture_unit, (setter)MGLContext_set_default_texture_unit},
+    {(char *)"release_stats", (getter)MGLContext_get_release_stats, NULL},
+    {(char *)"stats", (getter)MGLContext_get_stats, NULL},
     {(char *)"max_samples", (getter)MGLContext_get_max_samples, NULL},
     {(char *)"max_integer_samples", (getter)MGLContext_get_max_integer_samples, NULL},
     {(char *)"max_texture_units", (getter)MGLContext_get_max_texture_units, NULL},
@@ -9237,6 +13749,7 @@ static PyGetSetDef MGLContext_getset[] = {
     {(char *)"max_label_length", (getter)MGLContext_get_max_label_length, NULL},
     {(char *)"max_debug_message_length", (getter)MGLContext_get_max_debug_message_length, NULL},
     {(char *)"max_debug_group_stack_depth", (getter)MGLContext_get_max_debug_group_stack_depth, NULL},
+    {(char *)"dsa", (getter)MGLContext_get_dsa, (setter)MGLContext_set_dsa},
 
     {(char *)"fbo", (getter)MGLContext_get_fbo, (setter)MGLContext_set_fbo},
 
@@ -9269,6 +13782,7 @@ static PyMethodDef MGLFramebuffer_methods[] = {
     {(char *)"clear", (PyCFunction)MGLFramebuffer_clear, METH_VARARGS},
     {(char *)"use", (PyCFunction)MGLFramebuffer_use, METH_NOARGS},
     {(char *)"read_into", (PyCFunction)MGLFramebuffer_read_into, METH_VARARGS},
+    {(char *)"color_dtype", (PyCFunction)MGLFramebuffer_color_dtype, METH_VARARGS},
     {(char *)"release", (PyCFunction)MGLFramebuffer_release, METH_NOARGS},
     {},
 };
@@ -9291,6 +13805,7 @@ static PyGetSetDef MGLQuery_getset[] = {
     {(char *)"samples", (getter)MGLQuery_get_samples, NULL},
     {(char *)"primitives", (getter)MGLQuery_get_primitives, NULL},
     {(char *)"elapsed", (getter)MGLQuery_get_elapsed, NULL},
+    {(char *)"available", (getter)MGLQuery_get_available, NULL},
     {},
 };
 
@@ -9299,7 +13814,9 @@ static PyMethodDef MGLQuery_methods[] = {
     {(char *)"end", (PyCFunction)MGLQuery_end, METH_NOARGS},
     {(char *)"begin_render", (PyCFunction)MGLQuery_begin_render, METH_NOARGS},
     {(char *)"end_render", (PyCFunction)MGLQuery_end_render, METH_NOARGS},
-    // {(char *)"release", (PyCFunction)MGLQuery_release, METH_NOARGS},
+    {(char *)"result", (PyCFunction)MGLQuery_result, METH_VARARGS},
+    {(char *)"read_into", (PyCFunction)MGLQuery_read_into, METH_VARARGS},
+    {(char *)"release", (PyCFunction)MGLQuery_release, METH_NOARGS},
     {},
 };
 
@@ -9351,6 +13868,7 @@ static PyGetSetDef MGLTexture_getset[] = {
 
 static PyMethodDef MGLTexture_methods[] = {
     {(char *)"write", (PyCFunction)MGLTexture_write, METH_VARARGS},
+    {(char *)"write_regions", (PyCFunction)MGLTexture_write_regions, METH_VARARGS},
     {(char *)"bind", (PyCFunction)MGLTexture_meth_bind, METH_VARARGS},
     {(char *)"use", (PyCFunction)MGLTexture_use, METH_VARARGS},
     {(char *)"build_mipmaps", (PyCFunction)MGLTexture_build_mipmaps, METH_VARARGS},
@@ -9533,6 +14051,28 @@ static PyType_Slot MGLSampler_slots[] = {
     {},
 };
 
+static PyMethodDef MGLNativeEGL_methods[] = {
+    {(char *)"__enter__", (PyCFunction)MGLNativeEGL_enter, METH_NOARGS},
+    {(char *)"__exit__", (PyCFunction)MGLNativeEGL_exit, METH_VARARGS},
+    {(char *)"release", (PyCFunction)MGLNativeEGL_release, METH_NOARGS},
+    {(char *)"load_opengl_function", (PyCFunction)MGLNativeEGL_load_opengl_function, METH_O},
+    {},
+};
+
+static PyGetSetDef MGLNativeEGL_getset[] = {
+    {(char *)"proc_address", (getter)MGLNativeEGL_get_proc_address, NULL},
+    {(char *)"standalone", (getter)MGLNativeEGL_get_standalone, NULL},
+    {(char *)"device", (getter)MGLNativeEGL_get_device, NULL},
+    {},
+};
+
+static PyType_Slot MGLNativeEGL_slots[] = {
+    {Py_tp_methods, MGLNativeEGL_methods},
+    {Py_tp_getset, MGLNativeEGL_getset},
+    {Py_tp_dealloc, (void *)MGLNativeEGL_dealloc},
+    {},
+};
+
 static PyType_Spec MGLBuffer_spec = {"mgl.Buffer", sizeof(MGLBuffer), 0, Py_TPFLAGS_DEFAULT, MGLBuffer_slots};
 static PyType_Spec MGLContext_spec = {"mgl.Context", sizeof(MGLContext), 0, Py_TPFLAGS_DEFAULT, MGLContext_slots};
 static PyType_Spec MGLFramebuffer_spec = {"mgl.Framebuffer", sizeof(MGLFramebuffer), 0, Py_TPFLAGS_DEFAULT, MGLFramebuffer_slots};
@@ -9546,46 +14086,126 @@ static PyType_Spec MGLTextureCube_spec = {"mgl.TextureCube", sizeof(MGLTextureCu
 static PyType_Spec MGLTexture3D_spec = {"mgl.Texture3D", sizeof(MGLTexture3D), 0, Py_TPFLAGS_DEFAULT, MGLTexture3D_slots};
 static PyType_Spec MGLVertexArray_spec = {"mgl.VertexArray", sizeof(MGLVertexArray), 0, Py_TPFLAGS_DEFAULT, MGLVertexArray_slots};
 static PyType_Spec MGLSampler_spec = {"mgl.Sampler", sizeof(MGLSampler), 0, Py_TPFLAGS_DEFAULT, MGLSampler_slots};
+static PyType_Spec MGLNativeEGL_spec = {"mgl.NativeEGL", sizeof(MGLNativeEGL), 0, Py_TPFLAGS_DEFAULT, MGLNativeEGL_slots};
+
+static int MGL_exec(PyObject * module) {
+    ModuleState * state = (ModuleState *)PyModule_GetState(module);
+
+    state->helper = PyImport_ImportModule("_moderngl");
+    if (!state->helper) {
+        return -1;
+    }
+
+    state->MGLBuffer_type = (PyTypeObject *)PyType_FromSpec(&MGLBuffer_spec);
+    state->MGLContext_type = (PyTypeObject *)PyType_FromSpec(&MGLContext_spec);
+    state->MGLFramebuffer_type = (PyTypeObject *)PyType_FromSpec(&MGLFramebuffer_spec);
+    state->MGLProgram_type = (PyTypeObject *)PyType_FromSpec(&MGLProgram_spec);
+    state->MGLQuery_type = (PyTypeObject *)PyType_FromSpec(&MGLQuery_spec);
+    state->MGLRenderbuffer_type = (PyTypeObject *)PyType_FromSpec(&MGLRenderbuffer_spec);
+    state->MGLScope_type = (PyTypeObject *)PyType_FromSpec(&MGLScope_spec);
+    state->MGLTexture_type = (PyTypeObject *)PyType_FromSpec(&MGLTexture_spec);
+    state->MGLTextureArray_type = (PyTypeObject *)PyType_FromSpec(&MGLTextureArray_spec);
+    state->MGLTextureCube_type = (PyTypeObject *)PyType_FromSpec(&MGLTextureCube_spec);
+    state->MGLTexture3D_type = (PyTypeObject *)PyType_FromSpec(&MGLTexture3D_spec);
+    state->MGLVertexArray_type = (PyTypeObject *)PyType_FromSpec(&MGLVertexArray_spec);
+    state->MGLSampler_type = (PyTypeObject *)PyType_FromSpec(&MGLSampler_spec);
+    state->MGLNativeEGL_type = (PyTypeObject *)PyType_FromSpec(&MGLNativeEGL_spec);
+
+    // The types created before a failure are cleared with the module state
+    PyTypeObject * types[] = {
+        state->MGLBuffer_type, state->MGLContext_type, state->MGLFramebuffer_type, state->MGLProgram_type,
+        state->MGLQuery_type, state->MGLRenderbuffer_type, state->MGLScope_type, state->MGLTexture_type,
+        state->MGLTextureArray_type, state->MGLTextureCube_type, state->MGLTexture3D_type,
+        state->MGLVertexArray_type, state->MGLSampler_type, state->MGLNativeEGL_type,
+    };
+    for (PyTypeObject * type : types) {
+        if (!type) {
+            return -1;
+        }
+    }
+
+    PyObject * InvalidObject = PyObject_GetAttrString(state->helper, "InvalidObject");
+    if (!InvalidObject) {
+        return -1;
+    }
+    if (PyModule_AddObject(module, "InvalidObject", InvalidObject) < 0) {
+        Py_DECREF(InvalidObject);
+        return -1;
+    }
+    Py_INCREF(InvalidObject);
+
+    return 0;
+}
+
+static int MGL_traverse(PyObject * module, visitproc visit, void * arg) {
+    ModuleState * state = (ModuleState *)PyModule_GetState(module);
+    Py_VISIT(state->helper);
+    Py_VISIT(state->MGLBuffer_type);
+    Py_VISIT(state->MGLContext_type);
+    Py_VISIT(state->MGLFramebuffer_type);
+    Py_VISIT(state->MGLProgram_type);
+    Py_VISIT(state->MGLQuery_type);
+    Py_VISIT(state->MGLRenderbuffer_type);
+    Py_VISIT(state->MGLScope_type);
+    Py_VISIT(state->MGLTexture_type);
+    Py_VISIT(state->MGLTextureArray_type);
+    Py_VISIT(state->MGLTextureCube_type);
+    Py_VISIT(state->MGLTexture3D_type);
+    Py_VISIT(state->MGLVertexArray_type);
+    Py_VISIT(state->MGLSampler_type);
+    Py_VISIT(state->MGLNativeEGL_type);
+    return 0;
+}
+
+static int MGL_clear(PyObject * module) {
+    ModuleState * state = (ModuleState *)PyModule_GetState(module);
+    Py_CLEAR(state->helper);
+    Py_CLEAR(state->MGLBuffer_type);
+    Py_CLEAR(state->MGLContext_type);
+    Py_CLEAR(state->MGLFramebuffer_type);
+    Py_CLEAR(state->MGLProgram_type);
+    Py_CLEAR(state->MGLQuery_type);
+    Py_CLEAR(state->MGLRenderbuffer_type);
+    Py_CLEAR(state->MGLScope_type);
+    Py_CLEAR(state->MGLTexture_type);
+    Py_CLEAR(state->MGLTextureArray_type);
+    Py_CLEAR(state->MGLTextureCube_type);
+    Py_CLEAR(state->MGLTexture3D_type);
+    Py_CLEAR(state->MGLVertexArray_type);
+    Py_CLEAR(state->MGLSampler_type);
+    Py_CLEAR(state->MGLNativeEGL_type);
+    return 0;
+}
+
+// The module is freed without a clear when it is not part of a cycle
+static void MGL_free(void * module) {
+    MGL_clear((PyObject *)module);
+}
+
+static PyModuleDef_Slot MGL_slots[] = {
+    {Py_mod_exec, (void *)MGL_exec},
+#if PY_VERSION_HEX >= 0x030C0000
+    {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+#endif
+#ifdef Py_GIL_DISABLED
+    // Contexts are bound to a single thread and the module state is only written by MGL_exec
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
+    {},
+};
 
 static PyModuleDef MGL_moduledef = {
     PyModuleDef_HEAD_INIT,
     "mgl",
     0,
-    -1,
+    sizeof(ModuleState),
     MGL_module_methods,
-    0,
-    0,
-    0,
-    0,
+    MGL_slots,
+    MGL_traverse,
+    MGL_clear,
+    MGL_free,
 };
 
 extern "C" PyObject * PyInit_mgl() {
-    PyObject * module = PyModule_Create(&MGL_moduledef);
-
-    helper = PyImport_ImportModule("_moderngl");
-    if (!helper) {
-        return NULL;
-    }
-
-    moderngl_error = PyObject_GetAttrString(helper, "Error");
-
-    MGLBuffer_type = (PyTypeObject *)PyType_FromSpec(&MGLBuffer_spec);
-    MGLContext_type = (PyTypeObject *)PyType_FromSpec(&MGLContext_spec);
-    MGLFramebuffer_type = (PyTypeObject *)PyType_FromSpec(&MGLFramebuffer_spec);
-    MGLProgram_type = (PyTypeObject *)PyType_FromSpec(&MGLProgram_spec);
-    MGLQuery_type = (PyTypeObject *)PyType_FromSpec(&MGLQuery_spec);
-    MGLRenderbuffer_type = (PyTypeObject *)PyType_FromSpec(&MGLRenderbuffer_spec);
-    MGLScope_type = (PyTypeObject *)PyType_FromSpec(&MGLScope_spec);
-    MGLTexture_type = (PyTypeObject *)PyType_FromSpec(&MGLTexture_spec);
-    MGLTextureArray_type = (PyTypeObject *)PyType_FromSpec(&MGLTextureArray_spec);
-    MGLTextureCube_type = (PyTypeObject *)PyType_FromSpec(&MGLTextureCube_spec);
-    MGLTexture3D_type = (PyTypeObject *)PyType_FromSpec(&MGLTexture3D_spec);
-    MGLVertexArray_type = (PyTypeObject *)PyType_FromSpec(&MGLVertexArray_spec);
-    MGLSampler_type = (PyTypeObject *)PyType_FromSpec(&MGLSampler_spec);
-
-    PyObject * InvalidObject = PyObject_GetAttrString(helper, "InvalidObject");
-    PyModule_AddObject(module, "InvalidObject", InvalidObject);
-    Py_INCREF(InvalidObject);
-
-    return module;
+    return PyModuleDef_Init(&MGL_moduledef);
 }
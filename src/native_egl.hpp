@@ -0,0 +1,189 @@
+#pragma once
+
+// Headless EGL contexts without the glcontext package.
+// libEGL is opened at runtime, the extension does not link against it.
+
+#if defined(__linux__) || defined(__FreeBSD__)
+#define MGL_NATIVE_EGL
+#endif
+
+#ifdef MGL_NATIVE_EGL
+
+#include <dlfcn.h>
+#include <mutex>
+
+typedef void * EGLDisplay;
+typedef void * EGLContext;
+typedef void * EGLSurface;
+typedef void * EGLConfig;
+typedef void * EGLDeviceEXT;
+typedef int EGLint;
+typedef unsigned EGLBoolean;
+typedef unsigned EGLenum;
+
+#define EGL_NONE 0x3038
+#define EGL_EXTENSIONS 0x3055
+#define EGL_DRAW 0x3059
+#define EGL_READ 0x305A
+#define EGL_SURFACE_TYPE 0x3033
+#define EGL_RENDERABLE_TYPE 0x3040
+#define EGL_OPENGL_BIT 0x0008
+#define EGL_OPENGL_API 0x30A2
+#define EGL_CONTEXT_MAJOR_VERSION 0x3098
+#define EGL_CONTEXT_MINOR_VERSION 0x30FB
+#define EGL_CONTEXT_OPENGL_PROFILE_MASK 0x30FD
+#define EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT 0x0001
+#define EGL_PLATFORM_DEVICE_EXT 0x313F
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#define EGL_DRM_DEVICE_FILE_EXT 0x3233
+
+typedef void * (* PFNEGLGETPROCADDRESSPROC)(const char * name);
+typedef EGLint (* PFNEGLGETERRORPROC)();
+typedef EGLDisplay (* PFNEGLGETDISPLAYPROC)(void * native_display);
+typedef EGLDisplay (* PFNEGLGETPLATFORMDISPLAYEXTPROC)(EGLenum platform, void * native_display, const EGLint * attrib_list);
+typedef EGLBoolean (* PFNEGLQUERYDEVICESEXTPROC)(EGLint max_devices, EGLDeviceEXT * devices, EGLint * num_devices);
+typedef const char * (* PFNEGLQUERYDEVICESTRINGEXTPROC)(EGLDeviceEXT device, EGLint name);
+typedef EGLBoolean (* PFNEGLINITIALIZEPROC)(EGLDisplay display, EGLint * major, EGLint * minor);
+typedef const char * (* PFNEGLQUERYSTRINGPROC)(EGLDisplay display, EGLint name);
+typedef EGLBoolean (* PFNEGLBINDAPIPROC)(EGLenum api);
+typedef EGLBoolean (* PFNEGLCHOOSECONFIGPROC)(EGLDisplay display, const EGLint * attrib_list, EGLConfig * configs, EGLint config_size, EGLint * num_config);
+typedef EGLContext (* PFNEGLCREATECONTEXTPROC)(EGLDisplay display, EGLConfig config, EGLContext share_context, const EGLint * attrib_list);
+typedef EGLBoolean (* PFNEGLDESTROYCONTEXTPROC)(EGLDisplay display, EGLContext context);
+typedef EGLBoolean (* PFNEGLMAKECURRENTPROC)(EGLDisplay display, EGLSurface draw, EGLSurface read, EGLContext context);
+typedef EGLContext (* PFNEGLGETCURRENTCONTEXTPROC)();
+typedef EGLDisplay (* PFNEGLGETCURRENTDISPLAYPROC)();
+typedef EGLSurface (* PFNEGLGETCURRENTSURFACEPROC)(EGLint readdraw);
+
+struct EGLMethods {
+    void * library;
+    void * libgl;
+    PFNEGLGETPROCADDRESSPROC GetProcAddress;
+    PFNEGLGETERRORPROC GetError;
+    PFNEGLGETDISPLAYPROC GetDisplay;
+    PFNEGLGETPLATFORMDISPLAYEXTPROC GetPlatformDisplayEXT;
+    PFNEGLQUERYDEVICESEXTPROC QueryDevicesEXT;
+    PFNEGLQUERYDEVICESTRINGEXTPROC QueryDeviceStringEXT;
+    PFNEGLINITIALIZEPROC Initialize;
+    PFNEGLQUERYSTRINGPROC QueryString;
+    PFNEGLBINDAPIPROC BindAPI;
+    PFNEGLCHOOSECONFIGPROC ChooseConfig;
+    PFNEGLCREATECONTEXTPROC CreateContext;
+    PFNEGLDESTROYCONTEXTPROC DestroyContext;
+    PFNEGLMAKECURRENTPROC MakeCurrent;
+    PFNEGLGETCURRENTCONTEXTPROC GetCurrentContext;
+    PFNEGLGETCURRENTDISPLAYPROC GetCurrentDisplay;
+    PFNEGLGETCURRENTSURFACEPROC GetCurrentSurface;
+};
+
+// libEGL is loaded once per process, every interpreter shares the same entry points
+static EGLMethods egl;
+static char egl_library_name[1024];
+static std::mutex egl_lock;
+
+static bool has_egl_extension(const char * extensions, const char * name) {
+    if (!extensions) {
+        return false;
+    }
+    size_t length = strlen(name);
+    const char * ptr = extensions;
+    while ((ptr = strstr(ptr, name))) {
+        if ((ptr == extensions || ptr[-1] == ' ') && (ptr[length] == ' ' || ptr[length] == 0)) {
+            return true;
+        }
+        ptr += length;
+    }
+    return false;
+}
+
+static const char * load_egl_methods(const char * libegl) {
+    // Subinterpreters and free-threaded builds may create their first context concurrently
+    std::lock_guard<std::mutex> guard(egl_lock);
+
+    if (egl.library) {
+        if (libegl && strcmp(libegl, egl_library_name)) {
+            return "libEGL is already loaded from another library";
+        }
+        return NULL;
+    }
+
+    const char * name = libegl ? libegl : "libEGL.so.1";
+    if (strlen(name) >= sizeof(egl_library_name)) {
+        return "the libEGL path is too long";
+    }
+
+    void * library = dlopen(name, RTLD_LAZY | RTLD_GLOBAL);
+    if (!library) {
+        return "cannot load libEGL";
+    }
+
+    EGLMethods res = {};
+    res.library = library;
+    res.GetProcAddress = (PFNEGLGETPROCADDRESSPROC)dlsym(library, "eglGetProcAddress");
+    if (!res.GetProcAddress) {
+        dlclose(library);
+        return "eglGetProcAddress is missing";
+    }
+
+    #define load_egl(name) res.name = (decltype(res.name))res.GetProcAddress("egl" # name);
+
+    load_egl(GetError);
+    load_egl(GetDisplay);
+    load_egl(GetPlatformDisplayEXT);
+    load_egl(QueryDevicesEXT);
+    load_egl(QueryDeviceStringEXT);
+    load_egl(Initialize);
+    load_egl(QueryString);
+    load_egl(BindAPI);
+    load_egl(ChooseConfig);
+    load_egl(CreateContext);
+    load_egl(DestroyContext);
+    load_egl(MakeCurrent);
+    load_egl(GetCurrentContext);
+    load_egl(GetCurrentDisplay);
+    load_egl(GetCurrentSurface);
+
+    #undef load_egl
+
+    if (!res.GetError || !res.Initialize || !res.QueryString || !res.CreateContext || !res.MakeCurrent) {
+        dlclose(library);
+        return "libEGL is incomplete";
+    }
+
+    // Without EGL_KHR_client_get_all_proc_addresses the core functions come from libOpenGL
+    const char * client_extensions = res.QueryString(NULL, EGL_EXTENSIONS);
+    if (!has_egl_extension(client_extensions, "EGL_KHR_client_get_all_proc_addresses")) {
+        res.libgl = dlopen("libOpenGL.so.0", RTLD_LAZY | RTLD_GLOBAL);
+        if (!res.libgl) {
+            res.libgl = dlopen("libGL.so.1", RTLD_LAZY | RTLD_GLOBAL);
+        }
+    }
+
+    strcpy(egl_library_name, name);
+    egl = res;
+    return NULL;
+}
+
+static void * egl_proc_address(const char * name) {
+    void * proc = egl.libgl ? dlsym(egl.libgl, name) : NULL;
+    if (!proc) {
+        proc = egl.GetProcAddress(name);
+    }
+    return proc;
+}
+
+static bool egl_client_extension(const char * name) {
+    return has_egl_extension(egl.QueryString(NULL, EGL_EXTENSIONS), name);
+}
+
+static int query_egl_devices(EGLDeviceEXT * devices, int max_devices) {
+    if (!egl.QueryDevicesEXT || !egl_client_extension("EGL_EXT_device_enumeration")) {
+        return 0;
+    }
+    EGLint num_devices = 0;
+    if (!egl.QueryDevicesEXT(max_devices, devices, &num_devices)) {
+        return 0;
+    }
+    return num_devices;
+}
+
+#endif
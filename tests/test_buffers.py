@@ -0,0 +1,29 @@
+import moderngl
+import pytest
+
+
+def test_buffers(ctx):
+    buffers = ctx.buffers([b'abcd', 16, bytearray(b'xy')], dynamic=True)
+    assert [buf.size for buf in buffers] == [4, 16, 2]
+    assert buffers[0].read() == b'abcd'
+    assert buffers[2].read() == b'xy'
+    assert all(buf.dynamic for buf in buffers)
+    assert len({buf.glo for buf in buffers}) == 3
+
+
+def test_buffers_errors(ctx):
+    with pytest.raises(moderngl.Error, match='empty'):
+        ctx.buffers([b'abcd', b''])
+    with pytest.raises(moderngl.Error, match='empty'):
+        ctx.buffers([0])
+    with pytest.raises(TypeError):
+        ctx.buffers([b'abcd', 'text'])
+
+
+def test_name_pool(ctx):
+    # more objects than a single batch of pooled names
+    buffers = [ctx.buffer(reserve=4) for _ in range(100)]
+    textures = [ctx.texture((1, 1), 1) for _ in range(100)]
+    assert len({buf.glo for buf in buffers}) == 100
+    assert len({texture.glo for texture in textures}) == 100
+    assert all(glo > 0 for glo in [buf.glo for buf in buffers] + [texture.glo for texture in textures])
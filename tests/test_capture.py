@@ -0,0 +1,207 @@
+import os
+import struct
+
+import moderngl
+import moderngl.replay
+import pytest
+
+
+def record(ctx, path, frames=3):
+    with ctx.capture(path) as capture:
+        prog = ctx.program(
+            vertex_shader='''
+                #version 330
+                in vec2 in_vert;
+                uniform float scale;
+                void main() {
+                    gl_Position = vec4(in_vert * scale, 0.0, 1.0);
+                }
+            ''',
+            fragment_shader='''
+                #version 330
+                uniform sampler2D tex;
+                out vec4 color;
+                void main() {
+                    color = texture(tex, vec2(0.5));
+                }
+            ''',
+        )
+        vbo = ctx.buffer(struct.pack('6f', -1, -1, 3, -1, -1, 3))
+        vao = ctx.vertex_array(prog, [(vbo, '2f', 'in_vert')])
+        texture = ctx.texture((3, 3), 3, bytes(range(27)))
+        fbo = ctx.framebuffer([ctx.texture((16, 16), 4)])
+
+        for i in range(frames):
+            with capture.frame():
+                fbo.use()
+                fbo.clear(0.0, 0.0, 0.0, 1.0)
+                texture.use(0)
+                prog['scale'] = 1.0 - i * 0.1
+                vbo.write(struct.pack('2f', -1, -1))
+                vao.render()
+                fbo.read()
+
+        vbo.release()
+        texture.release()
+
+
+def test_capture_replay(ctx, ctx_new, tmp_path):
+    ctx.__enter__()
+    record(ctx, tmp_path / 'capture.bin')
+    data = (tmp_path / 'capture.bin').read_bytes()
+    assert data.startswith(b'MGLCAPT')
+
+    ctx_new.__enter__()
+    stats = ctx_new.replay(data, loops=4)
+    assert ctx_new.error == 'GL_NO_ERROR'
+    assert stats['version_code'] == ctx.version_code
+    assert stats['frames_per_loop'] == 3
+    assert len(stats['frames']) == 12
+    assert stats['calls']['glDrawArraysInstanced'][0] == 12
+    assert stats['calls']['glLinkProgram'][0] == 1
+    assert stats['setup'] > 0
+    ctx.__enter__()
+
+
+def test_capture_stops(ctx, tmp_path):
+    with ctx.capture(tmp_path / 'capture.bin'):
+        with pytest.raises(moderngl.Error, match='already capturing'):
+            ctx.capture(tmp_path / 'other.bin')
+    size = (tmp_path / 'capture.bin').stat().st_size
+    ctx.buffer(b'abcd').release()
+    assert (tmp_path / 'capture.bin').stat().st_size == size
+
+
+def test_replay_errors(ctx_new):
+    ctx_new.__enter__()
+    with pytest.raises(moderngl.Error, match='not a capture'):
+        ctx_new.replay(b'not a capture file')
+
+
+def test_replay_command(ctx, ctx_static, tmp_path, capsys):
+    record(ctx, tmp_path / 'capture.bin', frames=2)
+    moderngl.replay.main([str(tmp_path / 'capture.bin'), '--loops', '3'])
+    ctx_static.__enter__()
+    output = capsys.readouterr().out
+    assert 'frames: 6' in output
+    assert 'glDrawArraysInstanced' in output
+
+
+def varint(value):
+    res = bytearray()
+    while value > 0x7F:
+        res.append((value & 0x7F) | 0x80)
+        value >>= 7
+    res.append(value)
+    return bytes(res)
+
+
+def signed(value):
+    return varint((value << 1) ^ (value >> 63) & (2 ** 64 - 1))
+
+
+def blob(data):
+    return varint(len(data) + 1) + data
+
+
+def capture_file(names, calls):
+    header = b'MGLCAPT\0' + varint(1) + varint(330) + varint(len(names))
+    header += b''.join(blob(name.encode()) for name in names)
+    return header + b''.join(calls)
+
+
+def test_replay_invalid_files(ctx_new):
+    ctx_new.__enter__()
+    # the size argument is larger than the stored data
+    data = capture_file(['glBufferSubData'], [varint(0) + signed(0x8892) + signed(0) + signed(1000) + signed(0) + blob(b'abcd')])
+    with pytest.raises(moderngl.Error, match='data does not match'):
+        ctx_new.replay(data)
+
+    # five names are generated but one is stored
+    data = capture_file(['glGenBuffers'], [varint(0) + signed(5) + signed(0) + varint(1) + varint(1)])
+    with pytest.raises(moderngl.Error, match='names do not match'):
+        ctx_new.replay(data)
+
+    data = capture_file(['glBindFragDataLocation'], [varint(0) + signed(0) + signed(0) + signed(0) + blob(b'color')])
+    with pytest.raises(moderngl.Error, match='not terminated'):
+        ctx_new.replay(data)
+
+    # the pixels of a 64x64 upload are four bytes
+    args = [0x0DE1, 0, 0, 0, 64, 64, 0x1908, 0x1401, 0]
+    data = capture_file(['glTexSubImage2D'], [varint(0) + b''.join(signed(x) for x in args) + blob(b'abcd')])
+    with pytest.raises(moderngl.Error, match='pixels do not match'):
+        ctx_new.replay(data)
+
+    # an offset without a pixel unpack buffer would be read as a pointer
+    args = [0x0DE1, 0, 0, 0, 1, 1, 0x1908, 0x1401, 0x1000]
+    data = capture_file(['glTexSubImage2D'], [varint(0) + b''.join(signed(x) for x in args) + varint(0)])
+    with pytest.raises(moderngl.Error, match='not bound'):
+        ctx_new.replay(data)
+
+
+def test_capture_write_error(ctx):
+    if not os.path.exists('/dev/full'):
+        pytest.skip('requires /dev/full')
+    capture = ctx.capture('/dev/full')
+    ctx.buffer(b'abcd').release()
+    with pytest.raises(moderngl.Error, match='cannot write'):
+        capture.stop()
+
+
+def test_capture_conditional_render(ctx, ctx_new, tmp_path):
+    ctx.__enter__()
+    with ctx.capture(tmp_path / 'capture.bin') as capture:
+        query = ctx.query(any_samples=True)
+        fbo = ctx.framebuffer([ctx.texture((4, 4), 4)])
+        with capture.frame():
+            fbo.use()
+            with query:
+                fbo.clear()
+            with query.crender:
+                fbo.clear()
+        query.mglo.release()
+
+    ctx_new.__enter__()
+    stats = ctx_new.replay((tmp_path / 'capture.bin').read_bytes())
+    assert ctx_new.error == 'GL_NO_ERROR'
+    assert stats['calls']['glBeginConditionalRender'][0] == 1
+    assert stats['calls']['glBeginQuery'][0] == 1
+    ctx.__enter__()
+
+
+def test_capture_several_contexts(ctx, ctx_new, tmp_path):
+    ctx_new.__enter__()
+    with ctx_new.capture(tmp_path / 'other.bin'):
+        ctx.__enter__()
+        record(ctx, tmp_path / 'capture.bin', frames=1)
+        ctx_new.__enter__()
+        ctx_new.buffer(b'abcd').release()
+    ctx.__enter__()
+    assert b'glGenBuffers' in (tmp_path / 'other.bin').read_bytes()
+
+
+def test_capture_dsa_writes(ctx, ctx_new, tmp_path):
+    if not ctx.dsa:
+        pytest.skip('requires direct state access')
+    ctx.__enter__()
+    with ctx.capture(tmp_path / 'capture.bin') as capture:
+        texture_3d = ctx.texture3d((2, 2, 2), 1)
+        texture_array = ctx.texture_array((2, 2, 2), 1)
+        texture_cube = ctx.texture_cube((2, 2), 1)
+        src = ctx.framebuffer([ctx.texture((4, 4), 4), ctx.texture((4, 4), 4)])
+        dst = ctx.framebuffer([ctx.texture((4, 4), 4), ctx.texture((4, 4), 4)])
+        copy = ctx.texture((4, 4), 4)
+        with capture.frame():
+            texture_3d.write(bytes(range(8)))
+            texture_array.write(bytes(range(8)))
+            texture_cube.write(0, bytes(range(4)))
+            ctx.copy_framebuffer(dst, src)
+            ctx.copy_framebuffer(copy, src)
+
+    ctx_new.__enter__()
+    stats = ctx_new.replay((tmp_path / 'capture.bin').read_bytes())
+    assert ctx_new.error == 'GL_NO_ERROR'
+    assert stats['calls']['glTextureSubImage3D'][0] == 3
+    assert stats['calls']['glNamedFramebufferDrawBuffers'][0] == 1
+    assert stats['calls']['glCopyTextureSubImage2D'][0] == 1
+    ctx.__enter__()
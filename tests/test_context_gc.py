@@ -0,0 +1,54 @@
+import moderngl
+
+
+def test_gc_batched(ctx_new):
+    ctx_new.gc_mode = 'context_gc'
+    before = ctx_new.release_stats
+
+    for _ in range(3):
+        ctx_new.buffer(reserve=1024)
+        ctx_new.texture((4, 4), 4)
+        ctx_new.renderbuffer((2, 2), 1)
+        ctx_new.sampler()
+    ctx_new.simple_framebuffer((2, 2))
+
+    assert len(ctx_new.objects) > 0
+    count = len(ctx_new.objects)
+    assert ctx_new.gc() == count
+    assert len(ctx_new.objects) == 0
+
+    stats = ctx_new.release_stats
+    assert stats['objects'] - before['objects'] == count
+    assert stats['bytes'] - before['bytes'] >= 3 * (1024 + 64 + 4)
+    assert stats['pending'] == 0
+
+
+def test_gc_released_objects(ctx_new):
+    ctx_new.gc_mode = 'context_gc'
+    buf = ctx_new.buffer(b'abcd')
+    mglo = buf.mglo
+    buf.release()
+    ctx_new.objects.append(mglo)
+    assert ctx_new.gc() == 1
+
+
+def test_gc_deferred(ctx_new):
+    ctx_new.gc_mode = 'context_gc'
+    ctx_new.buffer(reserve=16)
+    ctx_new.vertex_array(
+        ctx_new.program(
+            vertex_shader='#version 330\nin vec2 v;\nvoid main() { gl_Position = vec4(v, 0.0, 1.0); }',
+        ),
+        [],
+    )
+
+    count = len(ctx_new.objects)
+    assert ctx_new.gc(defer=True) == count
+    assert ctx_new.release_stats['pending'] > 0
+
+    ctx_new.finish()
+    ctx_new.gc()
+    assert ctx_new.release_stats['pending'] == 0
+
+    # the names can be reused after they were deleted
+    assert ctx_new.buffer(b'abcd').read() == b'abcd'
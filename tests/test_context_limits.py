@@ -0,0 +1,56 @@
+import moderngl
+
+
+def test_has_extension(ctx):
+    extensions = ctx.extensions
+    assert isinstance(extensions, set)
+    assert len(extensions) > 0
+    for name in extensions:
+        assert ctx.has_extension(name)
+    assert not ctx.has_extension('GL_MODERNGL_not_an_extension')
+    assert not ctx.has_extension('')
+
+
+def test_limits(ctx):
+    assert ctx.max_samples >= 0
+    assert ctx.max_integer_samples >= 0
+    assert ctx.max_anisotropy >= 0.0
+    assert ctx.max_texture_units > 0
+
+
+def test_info_copy(ctx):
+    info = ctx.info
+    assert info is not ctx.info
+    assert info == ctx.info
+    info['GL_MAX_COLOR_ATTACHMENTS'] = -1
+    assert ctx.info['GL_MAX_COLOR_ATTACHMENTS'] >= 1
+
+
+def test_limits_owning_context(ctx_static):
+    texture = ctx_static.texture((2, 2), 1, b'abcd')
+    other = moderngl.create_context(standalone=True)
+    ctx_static.__enter__()
+    try:
+        # first use of the limits while ctx_static is current
+        assert other.max_samples >= 0
+        assert other.info['GL_MAX_TEXTURE_SIZE'] > 0
+        assert texture.read() == b'abcd'
+    finally:
+        other.release()
+        ctx_static.__enter__()
+
+
+def test_limits_current_context(ctx_static):
+    texture = ctx_static.texture((2, 2), 1, b'abcd')
+    other = moderngl.create_context(standalone=True)
+    ctx_static.__enter__()
+    try:
+        # first use of the limits while other is already current
+        with other:
+            assert other.info['GL_MAX_TEXTURE_SIZE'] > 0
+            assert other.max_anisotropy >= 0.0
+            assert len(other.extensions) > 0
+        assert texture.read() == b'abcd'
+    finally:
+        other.release()
+        ctx_static.__enter__()
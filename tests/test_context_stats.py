@@ -0,0 +1,122 @@
+import struct
+
+import pytest
+
+
+@pytest.fixture
+def stats_ctx(ctx):
+    ctx.reset_stats()
+    return ctx
+
+
+def test_stats_keys(stats_ctx):
+    stats = stats_ctx.stats
+    assert set(stats) == {
+        'draws', 'dispatches', 'program_binds', 'vertex_array_binds', 'texture_binds', 'sampler_binds',
+        'framebuffer_binds', 'uniform_writes', 'bytes_uploaded', 'bytes_downloaded', 'objects_created',
+        'objects_released',
+    }
+    assert all(value == 0 for value in stats.values())
+
+
+def test_stats_transfers(stats_ctx):
+    buf = stats_ctx.buffer(b'\x00' * 64)
+    buf.write(b'\x01' * 16)
+    buf.read(8)
+    texture = stats_ctx.texture((4, 4), 4)
+    texture.write(b'\x02' * 64)
+    texture.read()
+
+    stats = stats_ctx.stats
+    assert stats['bytes_uploaded'] == 64 + 16 + 64
+    assert stats['bytes_downloaded'] == 8 + 64
+    assert stats['objects_created'] == 2
+
+    buf.release()
+    texture.release()
+    assert stats_ctx.stats['objects_released'] == 2
+
+    # pixel buffer transfers stay on the GPU
+    pbo = stats_ctx.buffer(reserve=64)
+    stats_ctx.reset_stats()
+    texture = stats_ctx.texture((4, 4), 4)
+    texture.write(pbo)
+    assert stats_ctx.stats['bytes_uploaded'] == 0
+
+
+def test_stats_draws(stats_ctx):
+    prog = stats_ctx.program(
+        vertex_shader='''
+            #version 330
+            in vec2 in_vert;
+            uniform float scale;
+            void main() {
+                gl_Position = vec4(in_vert * scale, 0.0, 1.0);
+            }
+        ''',
+        fragment_shader='''
+            #version 330
+            out vec4 color;
+            void main() {
+                color = vec4(1.0);
+            }
+        ''',
+    )
+    vao = stats_ctx.vertex_array(prog, [(stats_ctx.buffer(struct.pack('6f', 0, 0, 1, 0, 0, 1)), '2f', 'in_vert')])
+    fbo = stats_ctx.simple_framebuffer((4, 4))
+    texture = stats_ctx.texture((1, 1), 4)
+
+    stats_ctx.reset_stats()
+    fbo.use()
+    texture.use(0)
+    prog['scale'] = 0.5
+    vao.render()
+    vao.render()
+
+    stats = stats_ctx.reset_stats()
+    assert stats['draws'] == 2
+    assert stats['program_binds'] >= 2
+    assert stats['vertex_array_binds'] == 2
+    assert stats['framebuffer_binds'] == 1
+    assert stats['texture_binds'] == 1
+    assert stats['uniform_writes'] == 1
+    assert stats_ctx.stats['draws'] == 0
+
+
+def test_stats_read_into(stats_ctx):
+    buf = stats_ctx.buffer(b'\x00' * 16)
+    out = bytearray(16)
+    dsa = stats_ctx.dsa
+    for mode in {False, dsa}:
+        stats_ctx.dsa = mode
+        stats_ctx.reset_stats()
+        buf.read_into(out, 8)
+        assert stats_ctx.stats['bytes_downloaded'] == 8
+    stats_ctx.dsa = dsa
+
+
+def test_stats_scope(stats_ctx):
+    fbo = stats_ctx.simple_framebuffer((4, 4))
+    sampler = stats_ctx.sampler()
+    scope = stats_ctx.scope(fbo, samplers=[(sampler, 0)])
+
+    stats_ctx.reset_stats()
+    with scope:
+        pass
+
+    # begin binds the scope framebuffer, end restores the previous one
+    stats = stats_ctx.stats
+    assert stats['framebuffer_binds'] == 2
+    assert stats['sampler_binds'] == 1
+
+
+def test_stats_gc(stats_ctx):
+    gc_mode = stats_ctx.gc_mode
+    stats_ctx.gc_mode = 'context_gc'
+    try:
+        buf = stats_ctx.buffer(reserve=4)
+        del buf
+        stats_ctx.gc()
+        assert stats_ctx.stats['objects_released'] == 1
+    finally:
+        stats_ctx.gc_mode = gc_mode
@@ -0,0 +1,104 @@
+import threading
+
+import moderngl
+import pytest
+
+
+def run_on_thread(fn):
+    result = {}
+
+    def target():
+        try:
+            result['value'] = fn()
+        except Exception as exc:
+            result['error'] = exc
+
+    thread = threading.Thread(target=target)
+    thread.start()
+    thread.join()
+    return result
+
+
+def test_context_wrong_thread(ctx):
+    buf = ctx.buffer(b'abcd')
+
+    result = run_on_thread(lambda: ctx.buffer(b'1234'))
+    assert isinstance(result['error'], moderngl.Error)
+    assert 'another thread' in str(result['error'])
+
+    result = run_on_thread(lambda: buf.write(b'1234'))
+    assert isinstance(result['error'], moderngl.Error)
+
+    assert buf.read() == b'abcd'
+
+
+
+def test_context_wrong_thread_state(ctx):
+    calls = [
+        lambda: ctx.has_extension('GL_ARB_debug_output'),
+        lambda: ctx.info,
+        lambda: ctx.max_anisotropy,
+        lambda: setattr(ctx, 'blend_func', moderngl.DEFAULT_BLENDING),
+        lambda: ctx.detect_framebuffer(),
+        lambda: ctx.error,
+    ]
+    for call in calls:
+        result = run_on_thread(call)
+        assert isinstance(result['error'], moderngl.Error)
+
+
+def test_query_wrong_thread(ctx):
+    pool = ctx.query_pool(samples=True)
+    with pool.query('frame'):
+        pass
+    calls = [
+        lambda: pool.collect(wait=True),
+        pool.release,
+    ]
+    for call in calls:
+        result = run_on_thread(call)
+        assert isinstance(result['error'], moderngl.Error)
+    assert [key for key, _ in pool.collect(wait=True)] == ['frame']
+    pool.release()
+
+    query = ctx.query(samples=True)
+    with query:
+        pass
+    result = run_on_thread(lambda: query.available)
+    assert isinstance(result['error'], moderngl.Error)
+    query.release()
+
+
+def test_release_wrong_thread(ctx_static):
+    other = moderngl.create_context(standalone=True)
+    ctx_static.__enter__()
+    try:
+        result = run_on_thread(other.release)
+        assert isinstance(result['error'], moderngl.Error)
+    finally:
+        other.__enter__()
+        other.release()
+        ctx_static.__enter__()
+
+
+def test_check_thread_disabled(ctx_static):
+    other = moderngl.create_context(standalone=True, check_thread=False)
+    ctx_static.__enter__()
+
+    def toolkit_thread():
+        # an external toolkit makes the context current without entering the moderngl context
+        other.mglo._context.__enter__()
+        try:
+            buf = other.buffer(b'abcd')
+            other.blend_func = moderngl.DEFAULT_BLENDING
+            return buf.read()
+        finally:
+            other.mglo._context.__exit__()
+
+    try:
+        result = run_on_thread(toolkit_thread)
+        assert result == {'value': b'abcd'}
+    finally:
+        other.__enter__()
+        other.release()
+        ctx_static.__enter__()
@@ -0,0 +1,75 @@
+import logging
+
+import pytest
+
+
+@pytest.fixture
+def ctx_debug(ctx):
+    if not ctx.supports_debug_scopes or ctx.version_code < 430:
+        pytest.skip('debug output is not supported')
+    yield ctx
+    ctx.disable_debug_output()
+
+
+def push_scopes(ctx, label, count=1, group_id=7):
+    for _ in range(count):
+        with ctx.debug_scope(label, group_id=group_id):
+            pass
+
+
+def test_debug_output_callback(ctx_debug):
+    messages = []
+    ctx_debug.enable_debug_output('notification', types='push_group', callback=lambda *args: messages.append(args))
+    push_scopes(ctx_debug, 'hello')
+    ctx_debug.process_debug_output()
+    assert ('application', 'push_group', 7, 'notification', 'hello') in messages
+    assert all(message[1] == 'push_group' for message in messages)
+
+
+def test_debug_output_filters_severity(ctx_debug):
+    messages = []
+    ctx_debug.enable_debug_output('high', callback=lambda *args: messages.append(args))
+    push_scopes(ctx_debug, 'hidden')
+    ctx_debug.process_debug_output()
+    assert messages == []
+
+
+def test_debug_output_rate_limit(ctx_debug):
+    messages = []
+    ctx_debug.enable_debug_output('notification', types=['push_group'], callback=lambda *args: messages.append(args), rate_limit=2)
+    push_scopes(ctx_debug, 'repeated', 5, group_id=11)
+    ctx_debug.process_debug_output()
+    assert len(messages) == 2
+    assert ctx_debug.debug_message_counts[11] == 5
+
+
+def test_debug_output_logging(ctx_debug, caplog):
+    ctx_debug.enable_debug_output('notification', types='push_group', sources='application')
+    with caplog.at_level(logging.DEBUG, logger='moderngl'):
+        push_scopes(ctx_debug, 'logged')
+        ctx_debug.process_debug_output()
+    assert any('logged' in record.getMessage() for record in caplog.records)
+
+
+def test_debug_output_disable(ctx_debug):
+    messages = []
+    ctx_debug.enable_debug_output('notification', callback=lambda *args: messages.append(args))
+    ctx_debug.disable_debug_output()
+    push_scopes(ctx_debug, 'after')
+    assert ctx_debug.process_debug_output() == 0
+    assert ctx_debug.debug_message_counts == {}
+
+
+def test_debug_output_invalid(ctx):
+    with pytest.raises(ValueError, match='severity'):
+        ctx.enable_debug_output('critical')
+    with pytest.raises(ValueError, match='type'):
+        ctx.enable_debug_output(types=['errors'])
+
+
+def test_debug_output_pending_call(ctx_debug):
+    messages = []
+    ctx_debug.enable_debug_output('notification', types='push_group', callback=lambda *args: messages.append(args), synchronous=True)
+    push_scopes(ctx_debug, 'later')
+    assert len(messages) == 1
+
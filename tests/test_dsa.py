@@ -0,0 +1,141 @@
+import struct
+
+import pytest
+
+
+@pytest.fixture(params=[True, False], ids=['dsa', 'bind'])
+def ctx_dsa(request, ctx):
+    if request.param and ctx.version_code < 450:
+        pytest.skip('direct state access is not supported')
+    dsa = ctx.dsa
+    ctx.dsa = request.param
+    yield ctx
+    ctx.dsa = dsa
+
+
+def test_dsa_default(ctx):
+    assert ctx.dsa == (ctx.version_code >= 450)
+
+
+def test_dsa_buffer(ctx_dsa):
+    buf = ctx_dsa.buffer(b'abcdefgh')
+    buf.write(b'XY', offset=2)
+    assert buf.read() == b'abXYefgh'
+    assert buf.read(2, offset=6) == b'gh'
+
+    data = bytearray(4)
+    buf.read_into(data, 4, offset=1)
+    assert data == b'bXYe'
+
+    buf.write_chunks(b'1234', 0, 2, 4)
+    assert buf.read_chunks(1, 0, 2, 4) == b'1234'
+    assert bytes(memoryview(buf.mglo)) == b'1b2Y3f4h'
+
+    buf.clear(4, offset=2)
+    assert buf.read() == b'1b\x00\x00\x00\x004h'
+    buf.clear(chunk=b'ab')
+    assert buf.read() == b'abababab'
+
+    dst = ctx_dsa.buffer(reserve=8)
+    ctx_dsa.copy_buffer(dst, buf, 4, read_offset=2, write_offset=4)
+    assert dst.read() == b'\x00\x00\x00\x00abab'
+
+    buf.orphan(16)
+    assert buf.size == 16
+
+
+def test_dsa_texture(ctx_dsa):
+    texture = ctx_dsa.texture((4, 4), 1, bytes(range(16)))
+    texture.write(b'\xff' * 4, viewport=(1, 1, 2, 2))
+    data = texture.read()
+    assert data[5:7] == b'\xff\xff' and data[9:11] == b'\xff\xff'
+
+    texture.write_regions(b'\x10\x20', [(0, 0, 1, 1, 0), (3, 3, 1, 1, 1)])
+    data = texture.read()
+    assert data[0] == 0x10 and data[15] == 0x20
+
+    texture.repeat_x = False
+    texture.swizzle = 'RRR1'
+    assert texture.swizzle == 'RRR1'
+    texture.build_mipmaps()
+    assert len(texture.read(level=1)) == 4
+
+
+def test_dsa_framebuffer(ctx_dsa):
+    fbo = ctx_dsa.framebuffer(
+        [ctx_dsa.renderbuffer((4, 4), 4, dtype='f4'), ctx_dsa.texture((4, 4), 4)],
+        ctx_dsa.depth_renderbuffer((4, 4)),
+    )
+    fbo.clear(0.25, 0.5, 1.0, 1.0)
+    assert struct.unpack('4f', fbo.read(components=4, dtype='f4')[:16]) == (0.25, 0.5, 1.0, 1.0)
+    assert fbo.read(attachment=1)[:3] == bytes([64, 128, 255])
+    assert fbo.read(components=1, scale=(2, 2), attachment=1) == bytes([64]) * 4
+
+    # reading does not change the framebuffer in use
+    other = ctx_dsa.simple_framebuffer((4, 4), 4)
+    other.use()
+    fbo.read(attachment=1)
+    fbo.read(components=1, scale=(2, 2), attachment=1)
+    ctx_dsa.clear(1.0, 0.0, 0.0, 1.0)
+    assert other.read(components=4)[:4] == b'\xff\x00\x00\xff'
+    assert fbo.read(attachment=1)[:3] == bytes([64, 128, 255])
+
+
+def test_dsa_texture_layers(ctx_dsa):
+    volume = ctx_dsa.texture3d((2, 2, 2), 1, bytes(range(8)))
+    volume.write(b'\xff\xfe', viewport=(0, 1, 1, 2, 1, 1))
+    assert volume.read() == bytes([0, 1, 2, 3, 4, 5, 0xff, 0xfe])
+    volume.repeat_z = False
+    volume.swizzle = 'R001'
+    assert volume.swizzle == 'R001'
+    volume.build_mipmaps()
+
+    array = ctx_dsa.texture_array((2, 2, 3), 1, bytes(12))
+    array.write(b'\x01\x02\x03\x04', viewport=(0, 0, 2, 2, 2, 1))
+    assert array.read() == bytes(8) + b'\x01\x02\x03\x04'
+    data = bytearray(12)
+    array.read_into(data)
+    assert data == bytes(8) + b'\x01\x02\x03\x04'
+    array.filter = (ctx_dsa.NEAREST, ctx_dsa.NEAREST)
+    array.build_mipmaps()
+
+    cube = ctx_dsa.texture_cube((2, 2), 1, bytes(range(24)))
+    cube.write(3, b'\xaa\xbb', viewport=(0, 1, 2, 1))
+    assert cube.read(3) == bytes([12, 13, 0xaa, 0xbb])
+    assert cube.read(5) == bytes(range(20, 24))
+    buf = ctx_dsa.buffer(reserve=4)
+    cube.read_into(buf, 1)
+    assert buf.read() == bytes(range(4, 8))
+    cube.swizzle = 'RRR1'
+    assert cube.swizzle == 'RRR1'
+    cube.build_mipmaps()
+
+
+def test_dsa_copy_and_detect(ctx_dsa):
+    src = ctx_dsa.simple_framebuffer((4, 4), 4)
+    dst = ctx_dsa.simple_framebuffer((4, 4), 4)
+    other = ctx_dsa.simple_framebuffer((4, 4), 4)
+    other.use()
+    src.clear(0.0, 1.0, 0.0, 1.0)
+    ctx_dsa.copy_framebuffer(dst, src)
+    assert dst.read(components=4)[:4] == b'\x00\xff\x00\xff'
+
+    texture = ctx_dsa.texture((4, 4), 4)
+    ctx_dsa.copy_framebuffer(texture, src)
+    assert texture.read()[:4] == b'\x00\xff\x00\xff'
+
+    detected = ctx_dsa.detect_framebuffer(src.glo)
+    assert detected.size == (4, 4)
+    assert detected.samples == 0
+
+    # the framebuffer in use still receives the clear
+    ctx_dsa.clear(1.0, 0.0, 0.0, 1.0)
+    assert other.read(components=4)[:4] == b'\xff\x00\x00\xff'
+    assert src.read(components=4)[:4] == b'\x00\xff\x00\xff'
+
+
+def test_dsa_requires_gl45(ctx):
+    if ctx.version_code >= 450:
+        pytest.skip('direct state access is supported')
+    with pytest.raises(Exception, match='4.5'):
+        ctx.dsa = True
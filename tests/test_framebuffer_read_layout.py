@@ -0,0 +1,97 @@
+import struct
+
+import pytest
+
+
+@pytest.fixture
+def texture(ctx):
+    pixels = b''.join(bytes([y, 10 + y, 20 + y, 30 + y]) * 3 for y in range(4))
+    return ctx.texture((3, 4), 4, pixels)
+
+
+def test_framebuffer_read_flip_y(ctx, texture):
+    fbo = ctx.framebuffer([texture])
+    data = fbo.read(components=1)
+    assert fbo.read(components=1, flip_y=True) == b''.join(data[y * 3:y * 3 + 3] for y in reversed(range(4)))
+    assert fbo.read(components=4, flip_y=True)[:4] == bytes([3, 13, 23, 33])
+
+
+def test_framebuffer_read_channels(ctx, texture):
+    fbo = ctx.framebuffer([texture])
+    assert fbo.read(channels='BGR')[:3] == bytes([20, 10, 0])
+    assert fbo.read(channels='BGRA')[:4] == bytes([20, 10, 0, 30])
+    assert fbo.read(channels='A') == b''.join(bytes([30 + y]) * 3 for y in range(4))
+    assert fbo.read(channels='AGR', flip_y=True)[:3] == bytes([33, 13, 3])
+    assert fbo.read(channels='ga')[:2] == bytes([10, 30])
+
+
+def test_framebuffer_read_into_row_stride(ctx, texture):
+    fbo = ctx.framebuffer([texture])
+
+    # stride expressible with GL_PACK_ROW_LENGTH
+    data = bytearray(b'\xee' * 64)
+    assert fbo.read_into(data, (0, 0, 2, 4), components=4, row_stride=16) == 16 * 3 + 8
+    for y in range(4):
+        assert data[y * 16:y * 16 + 8] == bytes([y, 10 + y, 20 + y, 30 + y]) * 2
+        assert data[y * 16 + 8:y * 16 + 16] == b'\xee' * 8
+
+    # stride that is not a multiple of the pixel size
+    data = bytearray(b'\xee' * 64)
+    fbo.read_into(data, (0, 0, 2, 4), components=3, row_stride=13, flip_y=True)
+    for y in range(4):
+        assert data[y * 13:y * 13 + 6] == bytes([3 - y, 13 - y, 23 - y]) * 2
+        assert data[y * 13 + 6:y * 13 + 13] == b'\xee' * 7
+
+    # swizzled write with a stride
+    data = bytearray(b'\xee' * 64)
+    fbo.read_into(data, (1, 0, 2, 4), row_stride=10, channels='AB', write_offset=3)
+    for y in range(4):
+        assert data[3 + y * 10:3 + y * 10 + 4] == bytes([30 + y, 20 + y]) * 2
+
+
+def test_framebuffer_read_into_buffer_flip_y(ctx, texture):
+    fbo = ctx.framebuffer([texture])
+    buf = ctx.buffer(reserve=48)
+    fbo.read_into(buf, components=4, flip_y=True)
+    assert buf.read() == b''.join(bytes([y, 10 + y, 20 + y, 30 + y]) * 3 for y in reversed(range(4)))
+    fbo.read_into(buf, components=4, channels='BGRA')
+    assert buf.read(4) == bytes([20, 10, 0, 30])
+
+
+def test_framebuffer_read_errors(ctx, texture):
+    fbo = ctx.framebuffer([texture])
+    with pytest.raises(Exception, match='row_stride'):
+        fbo.read_into(bytearray(64), components=4, row_stride=8)
+    with pytest.raises(Exception, match='channel'):
+        fbo.read(channels='RGBX')
+    with pytest.raises(Exception, match='Buffer'):
+        fbo.read_into(ctx.buffer(reserve=48), channels='GR')
+
+
+def test_framebuffer_read_float_to_bytes(ctx):
+    fbo = ctx.framebuffer([ctx.renderbuffer((2, 2), 4, dtype='f4')])
+    fbo.clear(1.0, 0.5, 0.0, 2.0)
+    assert fbo.read(channels='BAR', dtype='f1', clamp=True) == b'\x00\xff\xff' * 4
+    assert struct.unpack('2f', fbo.read(channels='AG', dtype='f4')[:8]) == (2.0, 0.5)
+
+
+def test_texture_read_layout(ctx, texture):
+    assert texture.read(flip_y=True)[:4] == bytes([3, 13, 23, 33])
+    assert texture.read(channels='BGR')[:3] == bytes([20, 10, 0])
+    assert texture.read(channels='A', flip_y=True) == b''.join(bytes([30 + y]) * 3 for y in reversed(range(4)))
+
+    data = bytearray(b'\xee' * 80)
+    texture.read_into(data, row_stride=20)
+    for y in range(4):
+        assert data[y * 20:y * 20 + 12] == bytes([y, 10 + y, 20 + y, 30 + y]) * 3
+        assert data[y * 20 + 12:y * 20 + 20] == b'\xee' * 8
+
+    data = bytearray(b'\xee' * 80)
+    texture.read_into(data, row_stride=13, channels='RGBA', flip_y=True)
+    for y in range(4):
+        assert data[y * 13:y * 13 + 12] == bytes([3 - y, 13 - y, 23 - y, 33 - y]) * 3
+
+
+def test_texture_read_into_buffer_errors(ctx, texture):
+    with pytest.raises(Exception, match='flip_y'):
+        texture.read_into(ctx.buffer(reserve=48), flip_y=True)
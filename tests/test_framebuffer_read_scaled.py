@@ -0,0 +1,97 @@
+import struct
+
+import pytest
+
+
+@pytest.fixture
+def checker(ctx):
+    # 8 x 8 texture of alternating 0 and 200 pixels
+    pixels = bytes((0 if (x + y) % 2 else 200) for y in range(8) for x in range(8))
+    return ctx.framebuffer([ctx.texture((8, 8), 1, pixels)])
+
+
+def test_read_scaled_box(ctx, checker):
+    data = checker.read(components=1, scale=(2, 2))
+    assert len(data) == 4
+    assert all(abs(x - 100) <= 1 for x in data)
+
+
+def test_read_scaled_non_uniform(ctx, checker):
+    data = checker.read(components=1, scale=(4, 1), filter='box')
+    assert len(data) == 4
+    assert all(abs(x - 100) <= 1 for x in data)
+
+
+def test_read_scaled_viewport(ctx):
+    pixels = bytes([10] * 16 + [250] * 16)
+    fbo = ctx.framebuffer([ctx.texture((4, 8), 1, pixels)])
+    assert fbo.read((0, 0, 4, 4), components=1, scale=(1, 1)) == b'\x0a'
+    assert fbo.read((0, 4, 4, 4), components=1, scale=(1, 1)) == b'\xfa'
+    assert fbo.read(components=1, scale=(1, 2), filter='nearest') == b'\x0a\xfa'
+
+
+def test_read_scaled_float(ctx):
+    fbo = ctx.framebuffer([ctx.renderbuffer((16, 16), 4, dtype='f4')])
+    fbo.clear(4.0, 0.25, 0.0, 1.0)
+    data = fbo.read(components=4, dtype='f4', scale=(3, 3))
+    assert struct.unpack('4f', data[:16]) == (4.0, 0.25, 0.0, 1.0)
+
+
+def test_read_scaled_into(ctx, checker):
+    buf = ctx.buffer(reserve=8)
+    assert checker.read_into(buf, components=1, scale=(4, 2), flip_y=True) == 8
+    assert all(abs(x - 100) <= 1 for x in buf.read())
+
+
+def test_read_scaled_multisample(ctx):
+    if ctx.max_samples < 2:
+        pytest.skip('multisampling is not supported')
+    fbo = ctx.framebuffer([ctx.renderbuffer((8, 8), 4, samples=2)])
+    fbo.clear(1.0, 0.0, 0.0, 1.0)
+    assert fbo.read(scale=(2, 2)) == b'\xff\x00\x00' * 4
+
+
+def test_read_scaled_reuses_targets(ctx):
+    fbo = ctx.framebuffer([ctx.renderbuffer((16, 16), 4)])
+    fbo.clear(0.0, 1.0, 0.0, 1.0)
+    assert fbo.read(scale=(8, 8), filter='linear') == b'\x00\xff\x00' * 64
+    assert fbo.read(scale=(2, 2)) == b'\x00\xff\x00' * 4
+    assert fbo.read(scale=(5, 3)) == b'\x00\xff\x00' * 15
+    fbo.clear(1.0, 0.0, 0.0, 1.0)
+    assert fbo.read(scale=(1, 1)) == b'\xff\x00\x00'
+    fbo.release()
+
+
+def test_read_scaled_errors(ctx, checker):
+    with pytest.raises(Exception, match='filter'):
+        checker.read(scale=(2, 2), filter='cubic')
+    with pytest.raises(Exception, match='scale'):
+        checker.read(scale=(0, 2))
+
+
+def test_read_scaled_memory(ctx):
+    def renderbuffer_bytes():
+        return ctx.memory_report(labels=False)['types']['renderbuffer']['bytes']
+
+    fbo = ctx.framebuffer([ctx.texture((16, 16), 4)])
+    before = renderbuffer_bytes()
+    fbo.read(scale=(5, 5), filter='linear')
+    # one RGBA8 target for an 8 bit source read in a single step
+    assert renderbuffer_bytes() == before + 5 * 5 * 4
+    fbo.release()
+    assert renderbuffer_bytes() == before
+
+
+def test_read_scaled_gc(ctx):
+    gc_mode = ctx.gc_mode
+    ctx.gc_mode = 'context_gc'
+    try:
+        before = ctx.memory_report(labels=False)['types']['renderbuffer']
+        fbo = ctx.framebuffer([ctx.texture((16, 16), 4, dtype='f4')])
+        fbo.read(scale=(2, 2))
+        assert ctx.memory_report(labels=False)['types']['renderbuffer']['count'] > before['count']
+        del fbo
+        ctx.gc()
+        assert ctx.memory_report(labels=False)['types']['renderbuffer'] == before
+    finally:
+        ctx.gc_mode = gc_mode
@@ -0,0 +1,80 @@
+import moderngl
+import pytest
+from moderngl import mgl
+
+GB = 1024 ** 3
+
+
+@pytest.fixture
+def vao(ctx):
+    prog = ctx.program(
+        vertex_shader='''
+            #version 330
+            in vec2 in_vert;
+            void main() {
+                gl_Position = vec4(in_vert, 0.0, 1.0);
+            }
+        ''',
+        fragment_shader='''
+            #version 330
+            out vec4 color;
+            void main() {
+                color = vec4(1.0);
+            }
+        ''',
+    )
+    return ctx.vertex_array(prog, [(ctx.buffer(reserve=64), '2f', 'in_vert')])
+
+
+def test_large_buffer(ctx):
+    try:
+        buf = ctx.buffer(reserve=5 * GB)
+    except (moderngl.Error, MemoryError):
+        pytest.skip('the driver cannot allocate a 5 GB buffer')
+
+    if ctx.error != 'GL_NO_ERROR':
+        buf.release()
+        pytest.skip('the driver cannot allocate a 5 GB buffer')
+
+    try:
+        assert buf.size == 5 * GB
+        buf.write(b'abcd', offset=4 * GB + 16)
+        assert buf.read(4, offset=4 * GB + 16) == b'abcd'
+    finally:
+        buf.release()
+
+
+def test_external_buffer_size(ctx):
+    buf = ctx.buffer(reserve=16)
+    external = ctx.external_buffer(buf.glo, 8 * GB)
+    assert external.size == 8 * GB
+
+
+def test_expected_size():
+    assert mgl.expected_size(65536, 65536, 1, 4, 1, 'f4') == 64 * GB
+
+
+def test_vertices_64bit(vao):
+    vao.vertices = 3 * GB
+    assert vao.vertices == 3 * GB
+    with pytest.raises(moderngl.Error):
+        vao.vertices = -1
+
+
+def test_draw_limits(vao):
+    with pytest.raises(moderngl.Error, match='limited'):
+        vao.render(vertices=2 ** 31)
+    with pytest.raises(moderngl.Error, match='limited'):
+        vao.render(first=2 ** 31, vertices=3)
+    with pytest.raises(moderngl.Error, match='negative'):
+        vao.render(first=-1, vertices=3)
+
+    vao.vertices = 2 ** 32
+    with pytest.raises(moderngl.Error, match='limited'):
+        vao.render()
+
+
+def test_render_indirect_first(ctx, vao):
+    commands = ctx.buffer(reserve=40)
+    with pytest.raises(moderngl.Error, match='negative'):
+        vao.render_indirect(commands, first=-1)
@@ -0,0 +1,94 @@
+import ctypes
+import sys
+
+import moderngl
+import pytest
+from glcontext import egl
+
+GL_PROC_ADDRESS = ctypes.CFUNCTYPE(ctypes.c_void_p, ctypes.c_char_p)
+
+PyCapsule_New = ctypes.pythonapi.PyCapsule_New
+PyCapsule_New.restype = ctypes.py_object
+PyCapsule_New.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_void_p]
+
+
+class Loader:
+    """Wraps a glcontext backend and records the resolved functions."""
+
+    def __init__(self, native, capsule_name=b"proc_address"):
+        self.backend = egl.create_context(glversion=330, mode="standalone")
+        self.names = []
+        self.native_names = []
+        if native:
+            self._callback = GL_PROC_ADDRESS(self._proc_address)
+            self.proc_address = PyCapsule_New(ctypes.cast(self._callback, ctypes.c_void_p), capsule_name, None)
+
+    def _proc_address(self, name):
+        self.native_names.append(name.decode())
+        return self.load_opengl_function(name.decode())
+
+    def load_opengl_function(self, name):
+        self.names.append(name)
+        if name.endswith("ARB") or name.endswith("NV"):
+            return 0
+        return self.backend.load_opengl_function(name)
+
+    def __enter__(self):
+        self.backend.__enter__()
+
+    def __exit__(self, *args):
+        self.backend.__exit__(*args)
+
+    def release(self):
+        self.backend.release()
+
+
+@pytest.fixture(params=[True, False], ids=["native", "python"])
+def loader_ctx(request, ctx_static):
+    loader = Loader(request.param)
+    ctx = moderngl.create_context(standalone=True, context=loader)
+    yield ctx, loader
+    ctx.release()
+    ctx_static.__enter__()
+
+
+def test_loader(loader_ctx):
+    ctx, loader = loader_ctx
+    assert "glDrawArrays" in loader.names
+    assert ctx.buffer(b"abcd").read() == b"abcd"
+
+
+def test_loader_lazy_groups(loader_ctx):
+    ctx, loader = loader_ctx
+    assert "glGetTextureHandleARB" not in loader.names
+    assert "glDrawMeshTasksNV" not in loader.names
+
+    texture = ctx.texture((4, 4), 4)
+    with pytest.raises(moderngl.Error, match="bindless"):
+        texture.get_handle()
+    assert loader.names.count("glGetTextureHandleARB") == 1
+
+    with pytest.raises(moderngl.Error, match="bindless"):
+        texture.get_handle()
+    assert loader.names.count("glGetTextureHandleARB") == 1
+
+
+def test_loader_capsule_name(ctx_static):
+    loader = Loader(True, capsule_name=b"other")
+    ctx = moderngl.create_context(standalone=True, context=loader)
+    try:
+        assert "glDrawArrays" in loader.names
+        assert loader.native_names == []
+    finally:
+        ctx.release()
+        ctx_static.__enter__()
+
+
+def test_loader_release(ctx_static):
+    loader = Loader(False)
+    ctx = moderngl.create_context(standalone=True, context=loader)
+    refs = sys.getrefcount(loader)
+    ctx.release()
+    ctx_static.__enter__()
+    # the bound load_opengl_function held a reference to the loader
+    assert sys.getrefcount(loader) == refs - 1
@@ -0,0 +1,90 @@
+import logging
+
+import pytest
+
+
+def delta(ctx, before, kind):
+    after = ctx.memory_report(labels=False)['types'][kind]
+    return after['count'] - before['types'][kind]['count'], after['bytes'] - before['types'][kind]['bytes']
+
+
+def test_memory_report_buffer(ctx):
+    before = ctx.memory_report(labels=False)
+    buf = ctx.buffer(reserve=1024)
+    assert delta(ctx, before, 'buffer') == (1, 1024)
+    buf.orphan(4096)
+    assert delta(ctx, before, 'buffer') == (1, 4096)
+    buf.release()
+    assert delta(ctx, before, 'buffer') == (0, 0)
+    assert ctx.memory_report(labels=False)['peak'] >= before['total'] + 4096
+
+
+def test_memory_report_textures(ctx):
+    before = ctx.memory_report(labels=False)
+    texture = ctx.texture((4, 4), 4)
+    assert delta(ctx, before, 'texture') == (1, 64)
+    texture.build_mipmaps()
+    assert delta(ctx, before, 'texture') == (1, (16 + 4 + 1) * 4)
+    texture.release()
+
+    objects = [
+        ctx.texture((8, 8), 2, dtype='f4'),
+        ctx.texture3d((4, 4, 4), 1),
+        ctx.texture_array((4, 4, 3), 1),
+        ctx.texture_cube((4, 4), 4),
+        ctx.depth_texture((8, 8)),
+        ctx.renderbuffer((8, 8), 4),
+    ]
+    assert delta(ctx, before, 'texture') == (2, 8 * 8 * 2 * 4 + 8 * 8 * 4)
+    assert delta(ctx, before, 'texture_3d') == (1, 64)
+    assert delta(ctx, before, 'texture_array') == (1, 48)
+    assert delta(ctx, before, 'texture_cube') == (1, 6 * 64)
+    assert delta(ctx, before, 'renderbuffer') == (1, 256)
+
+    for obj in objects:
+        obj.release()
+    assert ctx.memory_report(labels=False)['total'] == before['total']
+
+
+def test_memory_report_labels(ctx):
+    if not ctx.supports_labels:
+        pytest.skip('labels are not supported')
+    buf = ctx.buffer(reserve=100)
+    buf.label = 'vertices'
+    texture = ctx.texture((2, 2), 1)
+    texture.label = 'vertices'
+    report = ctx.memory_report()
+    assert report['labels']['vertices'] == {'count': 2, 'bytes': 104}
+    buf.release()
+    texture.release()
+    assert 'vertices' not in ctx.memory_report()['labels']
+
+
+def test_memory_alarm(ctx):
+    alarms = []
+    limit = ctx.memory_report(labels=False)['total'] + 1000
+    ctx.set_memory_alarm(limit, lambda total, limit: alarms.append((total, limit)))
+    try:
+        first = ctx.buffer(reserve=600)
+        second = ctx.buffer(reserve=600)
+        third = ctx.buffer(reserve=600)
+        assert alarms == [(limit + 200, limit)]
+
+        second.release()
+        third.release()
+        second = ctx.buffer(reserve=600)
+        assert len(alarms) == 2
+        first.release()
+        second.release()
+    finally:
+        ctx.set_memory_alarm(None)
+    assert ctx.memory_report(labels=False)['alarm'] is None
+
+
+def test_memory_alarm_logging(ctx, caplog):
+    buf = ctx.buffer(reserve=64)
+    with caplog.at_level(logging.WARNING, logger='moderngl'):
+        ctx.set_memory_alarm(1)
+    ctx.set_memory_alarm(None)
+    buf.release()
+    assert any('alarm' in record.getMessage() for record in caplog.records)
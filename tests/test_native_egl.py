@@ -0,0 +1,58 @@
+import moderngl
+import pytest
+
+
+@pytest.fixture
+def egl_ctx(ctx_static):
+    try:
+        ctx = moderngl.create_context(standalone=True, backend='native-egl')
+    except moderngl.Error as e:
+        pytest.skip(str(e))
+    yield ctx
+    ctx.release()
+    ctx_static.__enter__()
+
+
+def test_native_egl(egl_ctx):
+    assert egl_ctx.version_code >= 330
+    assert egl_ctx.buffer(b'abcd').read() == b'abcd'
+    assert egl_ctx.info['GL_RENDERER']
+
+
+def test_native_egl_devices(egl_ctx):
+    devices = moderngl.egl_devices()
+    for index, device in enumerate(devices):
+        assert device['index'] == index
+        assert isinstance(device['extensions'], str)
+
+    if not devices:
+        pytest.skip('EGL device enumeration is not supported')
+
+    ctx = moderngl.create_context(standalone=True, backend='native-egl', device=0)
+    assert ctx.buffer(b'abcd').read() == b'abcd'
+    ctx.release()
+
+    with pytest.raises(moderngl.Error, match='not available'):
+        moderngl.create_context(standalone=True, backend='native-egl', device=len(devices))
+
+
+def test_native_egl_enter_exit(egl_ctx):
+    other = moderngl.create_context(standalone=True, backend='native-egl')
+    with egl_ctx:
+        assert egl_ctx.buffer(b'ab').read() == b'ab'
+    # leaving the context restores the previous one
+    assert other.buffer(b'cd').read() == b'cd'
+    other.release()
+
+
+def test_native_egl_loader(egl_ctx):
+    with egl_ctx.create_loader(backend='native-egl') as loader:
+        buf = loader.submit(lambda ctx: ctx.buffer(b'shared')).result()
+    assert buf.ctx is egl_ctx
+    assert buf.read() == b'shared'
+
+
+def test_native_egl_libegl(egl_ctx):
+    assert isinstance(moderngl.egl_devices('libEGL.so.1'), list)
+    with pytest.raises(moderngl.Error, match='already loaded'):
+        moderngl.egl_devices('libEGL_other.so.1')
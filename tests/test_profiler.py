@@ -0,0 +1,81 @@
+import struct
+
+import pytest
+
+
+@pytest.fixture
+def ctx_timer(ctx):
+    if ctx.version_code < 330:
+        pytest.skip('timestamp queries are not supported')
+    return ctx
+
+
+@pytest.fixture
+def vao(ctx_timer):
+    prog = ctx_timer.program(
+        vertex_shader='''
+            #version 330
+            in vec2 in_vert;
+            void main() {
+                gl_Position = vec4(in_vert, 0.0, 1.0);
+            }
+        ''',
+        fragment_shader='''
+            #version 330
+            out vec4 color;
+            void main() {
+                color = vec4(1.0);
+            }
+        ''',
+    )
+    vbo = ctx_timer.buffer(struct.pack('6f', -1, -1, 3, -1, -1, 3))
+    return ctx_timer.vertex_array(prog, [(vbo, '2f', 'in_vert')])
+
+
+def test_profiler_sections(ctx_timer, vao):
+    fbo = ctx_timer.simple_framebuffer((64, 64))
+    fbo.use()
+    profiler = ctx_timer.profiler(latency=2)
+
+    for _ in range(4):
+        with profiler.frame():
+            with profiler.section('shadows'):
+                vao.render()
+            with profiler.section('scene'):
+                with profiler.section('opaque'):
+                    vao.render()
+                with profiler.section('transparent'):
+                    vao.render()
+
+    # at most latency frames are still in flight
+    assert profiler.frames >= 2
+    profiler.collect(wait=True)
+    assert profiler.frames == 4
+
+    frame = profiler.results
+    assert frame.name == 'frame'
+    assert [section.name for section in frame] == ['shadows', 'scene']
+    assert [section.name for section in frame['scene']] == ['opaque', 'transparent']
+    assert frame.gpu_time >= frame['scene'].gpu_time >= frame['scene']['opaque'].gpu_time >= 0
+    assert frame.cpu_time >= frame['scene'].cpu_time > 0
+    assert 'transparent' in profiler.report()
+
+
+def test_timestamps_recycled(ctx_timer):
+    first = ctx_timer.mglo.timestamp()
+    second = ctx_timer.mglo.timestamp()
+    assert first != second
+    start, end = ctx_timer.mglo.read_timestamps([first, second], True)
+    assert end >= start
+    assert ctx_timer.mglo.timestamp() in (first, second)
+
+
+def test_profiler_errors(ctx_timer):
+    profiler = ctx_timer.profiler()
+    with pytest.raises(RuntimeError):
+        with profiler.section('outside'):
+            pass
+    with pytest.raises(RuntimeError):
+        profiler.end_frame()
+    with pytest.raises(ValueError):
+        ctx_timer.profiler(latency=0)
@@ -0,0 +1,103 @@
+import struct
+
+import moderngl
+import numpy as np
+import pytest
+
+
+@pytest.fixture
+def scene(ctx):
+    prog = ctx.program(
+        vertex_shader="""
+            #version 330
+            in vec2 in_vert;
+            void main() {
+                gl_Position = vec4(in_vert, 0.0, 1.0);
+            }
+        """,
+        fragment_shader="""
+            #version 330
+            out vec4 fragColor;
+            void main() {
+                fragColor = vec4(1.0);
+            }
+        """,
+    )
+    vbo = ctx.buffer(np.array([-1.0, -1.0, 1.0, -1.0, -1.0, 1.0], "f4"))
+    vao = ctx.vertex_array(prog, [(vbo, "2f", "in_vert")])
+    fbo = ctx.simple_framebuffer((16, 16))
+    fbo.use()
+    return vao
+
+
+def test_query_results(ctx, scene):
+    query = ctx.query(samples=True, time=True, primitives=True)
+    assert not query.available
+    with query:
+        scene.render()
+    ctx.finish()
+    assert query.available
+    assert 120 <= query.samples <= 136
+    assert query.primitives == 1
+    assert query.elapsed >= 0
+    query.release()
+
+
+def test_query_not_stopped(ctx, scene):
+    query = ctx.query(samples=True)
+    query.mglo.begin()
+    assert not query.available
+    with pytest.raises(moderngl.Error, match="not stopped"):
+        query.samples
+    query.mglo.end()
+    query.release()
+
+
+def test_query_read_into(ctx, scene):
+    if ctx.version_code < 440 and not ctx.has_extension("GL_ARB_query_buffer_object"):
+        pytest.skip("query buffers are not supported")
+
+    query = ctx.query(samples=True, primitives=True)
+    with query:
+        scene.render()
+
+    buf = ctx.buffer(reserve=16)
+    query.read_into(buf, 0, "samples")
+    query.read_into(buf, 8, "primitives", dtype="u4")
+    samples, primitives = struct.unpack("QI4x", buf.read())
+    assert samples == query.samples
+    assert primitives == 1
+
+    with pytest.raises(ValueError, match="invalid result"):
+        query.read_into(buf, 0, "time")
+    with pytest.raises(moderngl.Error, match="without this result"):
+        query.read_into(buf, 0, "elapsed")
+    with pytest.raises(moderngl.Error, match="out of range"):
+        query.read_into(buf, 12, "samples")
+    query.release()
+
+
+def test_query_pool(ctx, scene):
+    pool = ctx.query_pool(samples=True)
+    for frame in range(3):
+        for key in ("a", "b"):
+            with pool.query(key):
+                scene.render()
+        if frame == 0:
+            assert pool.size == 2
+            assert pool.pending == 2
+            results = pool.collect(wait=True)
+            assert [key for key, _ in results] == ["a", "b"]
+            assert results[0][1].elapsed is None
+            assert 120 <= results[0][1].samples <= 136
+
+    # The queries of the first frame were reused
+    assert pool.size == 4
+    assert pool.pending == 4
+    ctx.finish()
+    results = pool.collect()
+    assert [key for key, _ in results] == ["a", "b", "a", "b"]
+    assert pool.pending == 0
+    assert pool.collect() == []
+    pool.release()
+    assert pool.size == 0
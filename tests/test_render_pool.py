@@ -0,0 +1,68 @@
+import threading
+
+import moderngl
+import pytest
+
+
+def clear_and_read(ctx, value):
+    fbo = ctx.simple_framebuffer((4, 4))
+    fbo.use()
+    fbo.clear(value / 255.0, 0.0, 0.0, 1.0)
+    return fbo.read()[0]
+
+
+def test_render_pool_map():
+    with moderngl.RenderPool(2) as pool:
+        assert pool.workers == 2
+        assert list(pool.map(clear_and_read, range(16))) == list(range(16))
+
+
+def test_render_pool_contexts():
+    with moderngl.RenderPool(3) as pool:
+        barrier = threading.Barrier(3)
+
+        def worker_context(ctx):
+            barrier.wait(timeout=10)
+            return threading.get_ident(), ctx.gc_mode
+
+        results = [future.result() for future in [pool.submit(worker_context) for _ in range(3)]]
+        assert len({ident for ident, _ in results}) == 3
+        assert all(gc_mode == "context_gc" for _, gc_mode in results)
+
+
+def test_render_pool_exception():
+    def fail(ctx):
+        raise KeyError("job")
+
+    with moderngl.RenderPool(1) as pool:
+        with pytest.raises(KeyError):
+            pool.submit(fail).result()
+        assert pool.submit(clear_and_read, 7).result() == 7
+
+
+def test_render_pool_shutdown():
+    pool = moderngl.RenderPool(1)
+    pool.shutdown()
+    with pytest.raises(RuntimeError):
+        pool.submit(clear_and_read, 1)
+
+    with pytest.raises(ValueError):
+        moderngl.RenderPool(0)
+
+
+def test_render_pool_cancel():
+    started = threading.Event()
+    release = threading.Event()
+
+    def block(ctx):
+        started.set()
+        release.wait(timeout=10)
+
+    pool = moderngl.RenderPool(1)
+    first = pool.submit(block)
+    started.wait(timeout=10)
+    second = pool.submit(clear_and_read, 1)
+    pool.shutdown(wait=False, cancel_futures=True)
+    release.set()
+    pool.shutdown()
+    assert first.done() and second.cancelled()
@@ -0,0 +1,128 @@
+import struct
+import sys
+
+import moderngl
+import pytest
+
+
+def load_mesh(ctx, count):
+    return {
+        'vertices': ctx.buffer(struct.pack('%df' % count, *range(count))),
+        'texture': ctx.texture((4, 4), 4, bytes(range(64))),
+        'program': ctx.program(
+            vertex_shader='''
+                #version 330
+                uniform float scale;
+                in float value;
+                out float result;
+                void main() {
+                    result = value * scale;
+                }
+            ''',
+            varyings=['result'],
+        ),
+    }
+
+
+def test_loader_objects(ctx):
+    with ctx.create_loader() as loader:
+        mesh = loader.submit(load_mesh, 8).result()
+
+    assert all(obj.ctx is ctx for obj in mesh.values())
+    assert mesh['texture'].read()[:4] == bytes([0, 1, 2, 3])
+
+    program = mesh['program']
+    program['scale'] = 2.0
+
+    ctx.simple_framebuffer((2, 2)).use()
+    result = ctx.buffer(reserve=32)
+    vao = ctx.vertex_array(program, [(mesh['vertices'], 'f', 'value')])
+    vao.transform(result, vertices=8)
+    assert struct.unpack('8f', result.read()) == tuple(float(i) * 2.0 for i in range(8))
+
+
+def test_loader_write(ctx):
+    buf = ctx.buffer(reserve=4)
+
+    def upload(loader_ctx):
+        staging = loader_ctx.buffer(b'abcd')
+        loader_ctx.copy_buffer(buf, staging)
+
+    with ctx.create_loader() as loader:
+        loader.submit(upload).result()
+
+    assert buf.read() == b'abcd'
+
+
+def test_loader_not_shared(ctx):
+    def framebuffer(loader_ctx):
+        return loader_ctx.simple_framebuffer((4, 4))
+
+    with ctx.create_loader() as loader:
+        with pytest.raises(TypeError, match='Framebuffer'):
+            loader.submit(framebuffer).result()
+
+
+def test_loader_done_callback(ctx):
+    adopted = []
+    with ctx.create_loader() as loader:
+        future = loader.submit(load_mesh, 4)
+        future.add_done_callback(lambda f: adopted.append(all(obj.ctx is ctx for obj in f.result().values())))
+        loader.shutdown()
+
+    assert adopted == [True]
+    assert future.result()['vertices'].read() == struct.pack('4f', 0.0, 1.0, 2.0, 3.0)
+
+
+def test_loader_restores_current_context(ctx_static):
+    other = moderngl.create_context(standalone=True)
+    try:
+        # other does not share with ctx_static, its texture is only readable while it is current
+        texture = other.texture((2, 2), 1, b'abcd')
+        with ctx_static:
+            ctx_static.create_loader().shutdown()
+        assert texture.read() == b'abcd'
+    finally:
+        other.release()
+        ctx_static.__enter__()
+
+
+def test_loader_result_adopted(ctx):
+    # result() returns only after the uploads completed and the objects changed owner
+    with ctx.create_loader() as loader:
+        for count in range(1, 21):
+            mesh = loader.submit(load_mesh, count).result()
+            assert all(obj.ctx is ctx for obj in mesh.values())
+            assert mesh['vertices'].read() == struct.pack('%df' % count, *range(count))
+
+
+def test_loader_nested_enter(ctx_static):
+    other = moderngl.create_context(standalone=True)
+    try:
+        texture = other.texture((2, 2), 1, b'abcd')
+        with ctx_static:
+            with ctx_static:
+                ctx_static.create_loader().shutdown()
+            assert ctx_static.buffer(b'1234').read() == b'1234'
+        assert texture.read() == b'abcd'
+    finally:
+        other.release()
+        ctx_static.__enter__()
+
+
+def test_loader_native_egl(ctx_static, monkeypatch):
+    try:
+        egl_ctx = moderngl.create_context(standalone=True, backend='native-egl')
+    except Exception:
+        ctx_static.__enter__()
+        pytest.skip('native-egl is not available')
+
+    try:
+        # The shared context uses the backend of egl_ctx, glcontext is not imported
+        monkeypatch.setitem(sys.modules, 'glcontext', None)
+        with egl_ctx.create_loader() as loader:
+            buf = loader.submit(lambda loader_ctx: loader_ctx.buffer(b'abcd')).result()
+        assert buf.read() == b'abcd'
+    finally:
+        egl_ctx.release()
+        ctx_static.__enter__()
@@ -0,0 +1,102 @@
+import os
+import subprocess
+import sys
+
+import moderngl
+import pytest
+
+PHASES = [
+    "context",
+    "load_gl_methods",
+    "setup",
+    "compile",
+    "link",
+    "reflection",
+    "buffers",
+    "textures",
+    "vertex_arrays",
+]
+
+
+@pytest.fixture
+def profiled_ctx(ctx_static):
+    ctx = moderngl.create_context(standalone=True, profile_startup=True)
+    yield ctx
+    ctx.release()
+    ctx_static.__enter__()
+
+
+def test_startup_profile_disabled(ctx):
+    assert ctx.startup_profile is None
+
+
+def test_startup_profile_context(profiled_ctx):
+    profile = profiled_ctx.startup_profile
+    assert list(profile) == PHASES
+    for phase in ("context", "load_gl_methods", "setup"):
+        assert profile[phase]["count"] == 1
+        assert profile[phase]["total"] > 0
+        assert profile[phase]["first"] == profile[phase]["total"] == profile[phase]["max"]
+    for phase in PHASES[3:]:
+        assert profile[phase] == {"count": 0, "total": 0, "first": 0, "max": 0}
+
+
+def test_startup_profile_resources(profiled_ctx):
+    ctx = profiled_ctx
+    prog = ctx.program(
+        vertex_shader="""
+            #version 330
+            uniform float scale;
+            in vec2 in_vert;
+            void main() {
+                gl_Position = vec4(in_vert * scale, 0.0, 1.0);
+            }
+        """,
+        fragment_shader="""
+            #version 330
+            out vec4 fragColor;
+            void main() {
+                fragColor = vec4(1.0);
+            }
+        """,
+    )
+    buf = ctx.buffer(reserve=64)
+    ctx.vertex_array(prog, [(buf, "2f", "in_vert")])
+    ctx.texture((16, 16), 4)
+    ctx.texture_array((16, 16, 2), 4)
+    ctx.depth_texture((16, 16))
+
+    profile = ctx.startup_profile
+    assert profile["compile"]["count"] == 2
+    assert profile["link"]["count"] == 1
+    assert profile["reflection"]["count"] == 1
+    assert profile["buffers"]["count"] == 1
+    assert profile["textures"]["count"] == 3
+    assert profile["vertex_arrays"]["count"] == 1
+    textures = profile["textures"]
+    assert textures["total"] >= textures["max"] >= textures["first"] > 0
+
+
+def test_startup_profile_failed_compile(profiled_ctx):
+    with pytest.raises(moderngl.Error):
+        profiled_ctx.program(vertex_shader="#version 330\nvoid main() { error }")
+    assert profiled_ctx.startup_profile["compile"]["count"] == 1
+    assert profiled_ctx.startup_profile["link"]["count"] == 0
+
+
+def test_startup_profile_environment():
+    code = "import moderngl; moderngl.create_context(standalone=True).texture((4, 4), 4)"
+    env = dict(os.environ, MODERNGL_PROFILE_STARTUP="1")
+    result = subprocess.run([sys.executable, "-c", code], env=env, capture_output=True, text=True, check=True)
+    assert "moderngl startup profile" in result.stderr
+    assert "load_gl_methods" in result.stderr
+    assert "textures" in result.stderr
+
+
+def test_startup_profile_invalid(ctx):
+    class Invalid:
+        def __bool__(self):
+            raise ZeroDivisionError()
+
+    with pytest.raises(ZeroDivisionError):
+        moderngl.create_context(standalone=True, profile_startup=Invalid())
@@ -0,0 +1,44 @@
+import sys
+
+import pytest
+
+CODE = '''
+import sys
+sys.path[:] = %r
+
+import moderngl
+from glcontext import egl
+
+ctx = moderngl.create_context(standalone=True, context=egl.create_context(glversion=330, mode='standalone'))
+assert ctx.buffer(b'abcd').read() == b'abcd'
+
+try:
+    ctx.texture((4, 4), 5)
+except moderngl.Error:
+    pass
+else:
+    raise AssertionError('expected moderngl.Error')
+
+ctx.release()
+'''
+
+
+def test_instances_release_type(ctx):
+    # the types live in the module state of every interpreter, instances must not keep them alive
+    buffer_type = type(ctx.buffer(reserve=4).mglo)
+    before = sys.getrefcount(buffer_type)
+    for _ in range(100):
+        ctx.buffer(reserve=4).release()
+    assert sys.getrefcount(buffer_type) == before
+
+
+def test_subinterpreter(ctx_static):
+    interpreters = pytest.importorskip('_xxsubinterpreters')
+    interp = interpreters.create()
+    try:
+        interpreters.run_string(interp, CODE % sys.path)
+    finally:
+        interpreters.destroy(interp)
+        ctx_static.__enter__()
+
+    assert ctx_static.buffer(b'abcd').read() == b'abcd'
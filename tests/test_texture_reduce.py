@@ -0,0 +1,138 @@
+import struct
+
+import pytest
+
+
+@pytest.fixture
+def ctx_430(ctx):
+    if ctx.version_code < 430:
+        pytest.skip('compute shaders are not supported')
+    return ctx
+
+
+def test_reduce_ops(ctx_430):
+    values = [float(i) for i in range(100 * 70)]
+    texture = ctx_430.texture((100, 70), 1, struct.pack('%df' % len(values), *values), dtype='f4')
+
+    assert texture.reduce('min') == (0.0,)
+    assert texture.reduce('max') == (6999.0,)
+    assert texture.reduce('sum')[0] == pytest.approx(sum(values))
+    assert texture.reduce('mean')[0] == pytest.approx(sum(values) / len(values))
+
+
+def test_reduce_components(ctx_430):
+    pixels = bytes([0, 255, 51, 102]) * 64
+    texture = ctx_430.texture((8, 8), 4, pixels)
+    assert texture.reduce('mean') == pytest.approx((0.0, 1.0, 0.2, 0.4))
+    assert texture.reduce('max', level=0) == pytest.approx((0.0, 1.0, 0.2, 0.4))
+
+
+def test_reduce_integer(ctx_430):
+    texture = ctx_430.texture((3, 3), 1, struct.pack('9i', *range(-4, 5)), dtype='i4')
+    assert texture.reduce('min') == (-4.0,)
+    assert texture.reduce('max') == (4.0,)
+
+
+def test_reduce_into_buffer(ctx_430):
+    texture = ctx_430.texture((4, 4), 2, bytes([255, 0]) * 16)
+    buf = ctx_430.buffer(reserve=32)
+    assert texture.reduce('sum', buffer=buf, offset=16) is None
+    assert struct.unpack('4f', buf.read(16, offset=16))[:2] == (16.0, 0.0)
+
+
+def test_checksum(ctx_430):
+    a = ctx_430.texture((65, 33), 4, bytes(range(256)) * 33 + bytes(65 * 33 * 4 - 256 * 33))
+    b = ctx_430.texture((65, 33), 4, a.read())
+    assert a.reduce('checksum') == b.reduce('checksum')
+
+    data = bytearray(a.read())
+    data[1000] ^= 1
+    b.write(data)
+    assert a.reduce('checksum') != b.reduce('checksum')
+
+
+def test_histogram(ctx_430):
+    texture = ctx_430.texture((16, 16), 2, bytes([0, 255, 128, 255]) * 128)
+    red, green = texture.histogram(bins=4)
+    assert red == (128, 0, 128, 0)
+    assert green == (0, 0, 0, 256)
+
+    buf = ctx_430.buffer(reserve=32)
+    texture.histogram(bins=4, buffer=buf)
+    assert struct.unpack('8I', buf.read()) == red + green
+
+
+def test_statistics(ctx_430):
+    fbo = ctx_430.framebuffer([ctx_430.renderbuffer((20, 20), 4, dtype='f4')])
+    fbo.clear(0.5, 2.0, -1.0, 1.0)
+    stats = fbo.statistics()
+    assert stats['min'] == (0.5, 2.0, -1.0, 1.0)
+    assert stats['max'] == (0.5, 2.0, -1.0, 1.0)
+    assert stats['mean'] == pytest.approx((0.5, 2.0, -1.0, 1.0))
+    assert isinstance(stats['checksum'], int)
+
+
+def test_statistics_detected(ctx_430):
+    fbo = ctx_430.framebuffer([ctx_430.renderbuffer((8, 8), 4)])
+    fbo.clear(1.0, 0.0, 0.0, 1.0)
+    fbo.use()
+    detected = ctx_430.detect_framebuffer()
+    assert detected.color_attachments is None
+    stats = detected.statistics()
+    assert stats['mean'] == pytest.approx((1.0, 0.0, 0.0, 1.0))
+    with pytest.raises(Exception, match='attachment'):
+        detected.statistics(1)
+    with pytest.raises(Exception, match='attachment'):
+        fbo.statistics(2)
+
+
+def test_statistics_detected_float(ctx_430):
+    fbo = ctx_430.framebuffer([ctx_430.renderbuffer((8, 8), 4, dtype='f4')])
+    fbo.clear(0.1234, 3.5, -2.0, 1.0)
+    fbo.use()
+    stats = ctx_430.detect_framebuffer().statistics()
+    assert stats['max'] == pytest.approx((0.1234, 3.5, -2.0, 1.0))
+
+
+def test_statistics_into_buffer(ctx_430):
+    fbo = ctx_430.framebuffer([ctx_430.texture((4, 4), 2, dtype='f4')])
+    fbo.clear(0.25, 4.0)
+    buf = ctx_430.buffer(reserve=68)
+    assert fbo.statistics(buffer=buf, offset=16) is None
+    values = struct.unpack('12fI', buf.read(52, offset=16))
+    assert values[0:2] == (0.25, 4.0)
+    assert values[4:6] == (0.25, 4.0)
+    assert values[8:10] == pytest.approx((0.25, 4.0))
+    assert values[12] == fbo.statistics()['checksum']
+
+
+def test_reduce_keeps_storage_bindings(ctx_430):
+    compute = ctx_430.compute_shader('''
+        #version 430
+        layout (local_size_x = 1) in;
+        layout (std430, binding = 0) buffer A { float a; };
+        layout (std430, binding = 1) buffer B { float b; };
+        void main() {
+            b = a * 2.0;
+        }
+    ''')
+    a = ctx_430.buffer(struct.pack('f', 21.0))
+    b = ctx_430.buffer(reserve=4)
+    a.bind_to_storage_buffer(0)
+    b.bind_to_storage_buffer(1)
+
+    texture = ctx_430.texture((4, 4), 1, dtype='f4')
+    texture.reduce('max')
+    texture.histogram(bins=4)
+    ctx_430.framebuffer([texture]).statistics()
+
+    compute.run()
+    assert struct.unpack('f', b.read()) == (42.0,)
+
+
+def test_reduce_errors(ctx_430):
+    texture = ctx_430.texture((4, 4), 1)
+    with pytest.raises(Exception, match='op'):
+        texture.reduce('median')
+    with pytest.raises(Exception, match='bins'):
+        texture.histogram(bins=1000)
@@ -0,0 +1,75 @@
+import struct
+
+import numpy as np
+import pytest
+
+
+def test_write_regions(ctx):
+    texture = ctx.texture((8, 8), 1)
+    data = bytes([1, 2, 3, 4]) + bytes([5, 6, 7, 8])
+    texture.write_regions(data, [(0, 0, 2, 2, 0), (6, 7, 2, 1, 4), (3, 3, 1, 1, 7)])
+
+    pixels = texture.read()
+    assert pixels[0:2] == b'\x01\x02'
+    assert pixels[8:10] == b'\x03\x04'
+    assert pixels[7 * 8 + 6:7 * 8 + 8] == b'\x05\x06'
+    assert pixels[3 * 8 + 3] == 8
+    assert pixels.count(0) == 64 - 7
+
+
+def test_write_regions_stats(ctx):
+    texture = ctx.texture((8, 8), 2)
+    data = bytes(1000)
+    ctx.reset_stats()
+    # 2 x 2 and 3 x 1 regions of a two byte format with rows padded to 4 bytes
+    texture.write_regions(data, [(0, 0, 2, 2, 0), (4, 4, 3, 1, 100)], alignment=4)
+    assert ctx.stats['bytes_uploaded'] == (4 + 4) + 6
+
+
+def test_write_regions_packed(ctx):
+    texture = ctx.texture((4, 4), 4, dtype='f4')
+    data = struct.pack('8f', *range(8))
+    regions = np.array([[0, 0, 1, 1, 0], [3, 3, 1, 1, 16]], 'i4')
+    texture.write_regions(data, regions)
+
+    pixels = struct.unpack('64f', texture.read())
+    assert pixels[0:4] == (0.0, 1.0, 2.0, 3.0)
+    assert pixels[60:64] == (4.0, 5.0, 6.0, 7.0)
+
+
+def test_write_regions_alignment(ctx):
+    texture = ctx.texture((4, 4), 3)
+    # one 1 x 2 rgb region with rows padded to 4 bytes
+    data = b'\xaa\xbb\xcc\x00\xdd\xee\xff'
+    texture.write_regions(data, [(1, 1, 1, 2, 0)], alignment=4)
+    pixels = texture.read()
+    assert pixels[(1 * 4 + 1) * 3:(1 * 4 + 1) * 3 + 3] == b'\xaa\xbb\xcc'
+    assert pixels[(2 * 4 + 1) * 3:(2 * 4 + 1) * 3 + 3] == b'\xdd\xee\xff'
+
+
+def test_write_regions_buffer(ctx):
+    texture = ctx.texture((4, 4), 1)
+    buf = ctx.buffer(bytes(range(16)))
+    texture.write_regions(buf, [(0, 0, 4, 2, 8), (0, 2, 4, 2, 0)])
+    assert texture.read() == bytes(range(8, 16)) + bytes(range(8))
+
+
+def test_write_regions_errors(ctx):
+    texture = ctx.texture((4, 4), 1)
+    with pytest.raises(Exception, match='past the end'):
+        texture.write_regions(bytes(4), [(0, 0, 2, 2, 1)])
+    with pytest.raises(Exception, match='regions\\[1\\]'):
+        texture.write_regions(bytes(4), [(0, 0, 1, 1, 0), (0, 0, 1)])
+    with pytest.raises(Exception, match='int32'):
+        texture.write_regions(bytes(4), b'\x00' * 7)
+    with pytest.raises(Exception, match='int32'):
+        texture.write_regions(bytes(4), np.zeros((1, 5), 'i8'))
+    with pytest.raises(Exception, match='int32'):
+        texture.write_regions(bytes(4), np.zeros((1, 5), 'f4'))
+    with pytest.raises(Exception, match='outside'):
+        texture.write_regions(bytes(4), [(3, 3, 2, 2, 0)])
+    with pytest.raises(Exception, match='outside'):
+        texture.write_regions(bytes(4), [(-1, 0, 1, 1, 0)])
+    texture.build_mipmaps()
+    with pytest.raises(Exception, match='outside'):
+        texture.write_regions(bytes(4), [(0, 0, 4, 1, 0)], level=1)
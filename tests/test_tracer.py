@@ -0,0 +1,159 @@
+import json
+import struct
+
+import pytest
+
+
+@pytest.fixture
+def vao(ctx):
+    prog = ctx.program(
+        vertex_shader='''
+            #version 330
+            in vec2 in_vert;
+            void main() {
+                gl_Position = vec4(in_vert, 0.0, 1.0);
+            }
+        ''',
+        fragment_shader='''
+            #version 330
+            out vec4 color;
+            void main() {
+                color = vec4(1.0);
+            }
+        ''',
+    )
+    vbo = ctx.buffer(struct.pack('6f', -1, -1, 3, -1, -1, 3))
+    return ctx.vertex_array(prog, [(vbo, '2f', 'in_vert')])
+
+
+def read_varint(data, offset):
+    value = shift = 0
+    while True:
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if byte < 0x80:
+            return value, offset
+
+
+def read_message(data):
+    offset = 0
+    fields = []
+    while offset < len(data):
+        key, offset = read_varint(data, offset)
+        if key & 7 == 2:
+            size, offset = read_varint(data, offset)
+            fields.append((key >> 3, data[offset:offset + size]))
+            offset += size
+        else:
+            value, offset = read_varint(data, offset)
+            fields.append((key >> 3, value))
+    return fields
+
+
+def test_tracer_events(ctx, vao):
+    buf = ctx.buffer(reserve=16)
+    if ctx.supports_labels:
+        buf.label = 'staging'
+
+    with ctx.tracer() as tracer:
+        with tracer.section('upload'):
+            buf.write(b'\x00' * 16)
+        vao.render()
+
+    events = tracer.events()
+    assert [event['name'] for event in events] == ['Buffer.write', 'upload', 'VertexArray.render']
+    write, upload, render = events
+    assert upload['cpu_begin'] <= write['cpu_begin'] <= write['cpu_end'] <= upload['cpu_end']
+    assert render['glo'] == vao.glo
+    assert render['gpu_begin'] <= render['gpu_end']
+    if ctx.supports_labels:
+        assert write['label'] == 'staging'
+
+    # tracing has stopped
+    vao.render()
+    assert len(tracer.events()) == 3
+
+
+def test_tracer_ring(ctx, vao):
+    tracer = ctx.tracer(capacity=4, gpu=False)
+    for _ in range(10):
+        vao.render()
+    assert tracer.active
+    tracer.stop()
+    events = tracer.events()
+    assert len(events) == 4
+    assert all(event['gpu_begin'] is None for event in events)
+
+
+def test_tracer_state(ctx, vao):
+    texture = ctx.texture((2, 2), 4)
+    buf = ctx.buffer(reserve=16)
+    scope = ctx.scope(ctx.screen or ctx.simple_framebuffer((2, 2)))
+
+    def frame():
+        ctx.enable_only(ctx.BLEND)
+        ctx.blend_func = ctx.SRC_ALPHA, ctx.ONE_MINUS_SRC_ALPHA
+        texture.use(0)
+        buf.bind_to_uniform_block(0)
+        with scope:
+            vao.render()
+
+    # the scope binds its framebuffer with Framebuffer.use, which is always recorded
+    with ctx.tracer() as tracer:
+        frame()
+    assert [event['name'] for event in tracer.events() if event['name'] != 'Framebuffer.use'] == ['VertexArray.render']
+
+    with ctx.tracer(state=True) as tracer:
+        frame()
+    events = [event for event in tracer.events() if event['name'] != 'Framebuffer.use']
+    assert [event['name'] for event in events] == [
+        'Context.enable_only', 'Context.blend_func', 'Texture.use', 'Buffer.bind_to_uniform_block',
+        'Scope.begin', 'VertexArray.render', 'Scope.end',
+    ]
+    assert events[2]['glo'] == texture.glo
+    assert all(event['gpu_begin'] is None for event in events if event['name'] != 'VertexArray.render')
+    assert events[5]['gpu_begin'] is not None
+
+
+def test_tracer_profiler_sections(ctx, vao):
+    if ctx.version_code < 330:
+        pytest.skip('timestamp queries are not supported')
+    profiler = ctx.profiler()
+    with ctx.tracer() as tracer:
+        with profiler.frame():
+            with profiler.section('scene'):
+                vao.render()
+    assert [event['name'] for event in tracer.events()] == ['VertexArray.render', 'scene', 'frame']
+
+
+def test_tracer_export(ctx, vao, tmp_path):
+    with ctx.tracer() as tracer:
+        with tracer.section('frame'):
+            vao.render()
+            vao.render()
+
+    tracer.save(tmp_path / 'trace.json')
+    trace = json.loads((tmp_path / 'trace.json').read_text())
+    slices = [event for event in trace['traceEvents'] if event['ph'] == 'X']
+    assert [event['name'] for event in slices if event['tid'] == 1].count('VertexArray.render') == 2
+    assert all(event['dur'] >= 0 for event in slices)
+
+    tracer.save(tmp_path / 'trace.pftrace')
+    packets = [read_message(value) for field, value in read_message((tmp_path / 'trace.pftrace').read_bytes())]
+    track_events = [dict(read_message(dict(packet)[11])) for packet in packets if 11 in dict(packet)]
+    begins = [event for event in track_events if event[9] == 1]
+    ends = [event for event in track_events if event[9] == 2]
+    assert len(begins) == len(ends) == 6
+    assert sorted(event[23] for event in begins if event[11] == 1) == [b'VertexArray.render'] * 2 + [b'frame']
+
+
+def test_tracer_errors(ctx):
+    with ctx.tracer():
+        with pytest.raises(Exception, match='already tracing'):
+            ctx.tracer()
+    with ctx.tracer() as tracer:
+        pass
+    with pytest.raises(ValueError):
+        tracer.save('trace.txt', format='xml')